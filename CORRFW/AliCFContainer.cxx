@@ -35,7 +35,8 @@ ClassImp(AliCFContainer)
 AliCFContainer::AliCFContainer() : 
   AliCFFrame(),
   fNStep(0),
-  fGrid(0x0)
+  fGrid(0x0),
+  fFillBuffer(0x0)
 {
   //
   // default constructor
@@ -46,7 +47,8 @@ AliCFContainer::AliCFContainer() :
 AliCFContainer::AliCFContainer(const Char_t* name, const Char_t* title, const Int_t nSelSteps, const Int_t nVarIn, const Int_t* nBinIn) :  
   AliCFFrame(name,title),
   fNStep(nSelSteps),
-  fGrid(0x0)
+  fGrid(0x0),
+  fFillBuffer(0x0)
 {
   //
   // main constructor
@@ -65,7 +67,8 @@ AliCFContainer::AliCFContainer(const Char_t* name, const Char_t* title, const In
 AliCFContainer::AliCFContainer(const AliCFContainer& c) :
   AliCFFrame(c.fName,c.fTitle),
   fNStep(0),
-  fGrid(0x0)
+  fGrid(0x0),
+  fFillBuffer(0x0)
 {
   //
   // copy constructor
@@ -78,6 +81,7 @@ AliCFContainer::~AliCFContainer()
   //
   // destructor
   //
+  delete fFillBuffer;
   if (fGrid) {
     for ( Int_t istep=0; istep<fNStep; istep++ ) 
       delete fGrid[istep];
@@ -100,8 +104,13 @@ void AliCFContainer::Copy(TObject& c) const
   //
   // copy function
   //
+  FlushFillBuffer();
   AliCFFrame::Copy(c);
   AliCFContainer& target = (AliCFContainer &) c;
+  if (target.fFillBuffer) {
+    delete target.fFillBuffer;
+    target.fFillBuffer = 0x0;
+  }
   target.fNStep = fNStep;
   target.fGrid  = new AliCFGridSparse*[fNStep];
   for (Int_t iStep=0; iStep<fNStep; iStep++) {
@@ -120,7 +129,52 @@ void AliCFContainer::Fill(const Double_t *var, Int_t istep, Double_t weight)
     AliError("Non-existent selection step, grid was not filled");
     return;
   }
-  fGrid[istep]->Fill(var,weight);
+  if (fFillBuffer) fFillBuffer->Fill(var,istep,weight);
+  else             fGrid[istep]->Fill(var,weight);
+}
+
+//____________________________________________________________________
+void AliCFContainer::SetFillBuffer(Int_t capacity, Long_t maxDenseBins)
+{
+  //
+  // Stages the fills in a buffer of 'capacity' entries, added to the grids
+  // in sorted batches (see AliCFFillBuffer). The steps whose grid has at most
+  // 'maxDenseBins' bins (including under/overflows) accumulate in dense arrays.
+  // The buffer is flushed automatically by all the functions accessing the grids;
+  // an analysis task must call FlushFillBuffer() before its output is written
+  // (e.g. in FinishTaskOutput()).
+  // capacity=0 adds the staged fills and goes back to direct filling.
+  //
+  if (fFillBuffer) {
+    fFillBuffer->Flush();
+    delete fFillBuffer;
+    fFillBuffer = 0x0;
+  }
+  if (capacity <= 0) return;
+
+  THnSparse** grids = new THnSparse*[fNStep];
+  for (Int_t iStep=0; iStep<fNStep; iStep++) grids[iStep] = (fGrid[iStep] ? fGrid[iStep]->GetGrid() : 0x0);
+  fFillBuffer = new AliCFFillBuffer(fNStep,grids,capacity,maxDenseBins);
+  delete [] grids;
+}
+
+//____________________________________________________________________
+void AliCFContainer::SetGrid(Int_t step, AliCFGridSparse* grid)
+{
+  //
+  // replaces the grid at step 'step'; the staged fills are added first
+  //
+  AliCFFillBuffer* buffer = fFillBuffer;
+  if (buffer) {
+    buffer->Flush();
+    fFillBuffer = 0x0;
+  }
+  if (fGrid[step]) delete fGrid[step];
+  fGrid[step]=grid;
+  if (buffer) {
+    SetFillBuffer(buffer->GetCapacity(),buffer->GetMaxDenseBins());
+    delete buffer;
+  }
 }
 
 //____________________________________________________________________
@@ -134,7 +188,7 @@ TH1* AliCFContainer::Project(Int_t istep, Int_t ivar1, Int_t ivar2, Int_t ivar3)
     AliError("Non-existent selection step, return NULL");
     return 0x0;
   }
-  return fGrid[istep]->Project(ivar1,ivar2,ivar3);
+  return GetGrid(istep)->Project(ivar1,ivar2,ivar3);
 }
 
 //____________________________________________________________________
@@ -172,7 +226,7 @@ AliCFContainer* AliCFContainer::MakeSlice(Int_t nSteps, const Int_t* steps,
 
   // create the output grids
   AliCFGridSparse** grids = new AliCFGridSparse*[nSteps] ;
-  for (Int_t iStep=0; iStep<nSteps; iStep++) grids[iStep] = fGrid[steps[iStep]]->MakeSlice(nVars,vars,varMin,varMax,useBins);
+  for (Int_t iStep=0; iStep<nSteps; iStep++) grids[iStep] = GetGrid(steps[iStep])->MakeSlice(nVars,vars,varMin,varMax,useBins);
 
   TAxis ** axis = new TAxis*[nVars];
   for (Int_t iVar=0; iVar<nVars; iVar++) axis[iVar] = ((AliCFGridSparse*)grids[0])->GetGrid()->GetAxis(iVar); //same axis for every grid
@@ -244,6 +298,7 @@ void AliCFContainer::Add(const AliCFContainer* aContainerToAdd, Double_t c)
       AliError("Different number of steps/sensitive variables/grid elements: cannot add the containers");
       return;
     }
+  FlushFillBuffer();
   for (Int_t istep=0; istep<fNStep; istep++) {
     fGrid[istep]->Add(aContainerToAdd->GetGrid(istep),c);
   }
@@ -258,7 +313,7 @@ Float_t AliCFContainer::GetOverFlows( Int_t ivar, Int_t istep, Bool_t exclusive)
     AliError("Non-existent selection step, return -1");
     return -1.;
   }
-  return fGrid[istep]->GetOverFlows(ivar,exclusive);
+  return GetGrid(istep)->GetOverFlows(ivar,exclusive);
 } 
 //____________________________________________________________________
 Float_t AliCFContainer::GetUnderFlows( Int_t ivar, Int_t istep, Bool_t exclusive) const {
@@ -270,7 +325,7 @@ Float_t AliCFContainer::GetUnderFlows( Int_t ivar, Int_t istep, Bool_t exclusive
     AliError("Non-existent selection step, return -1");
     return -1.;
   }
-  return fGrid[istep]->GetUnderFlows(ivar,exclusive);
+  return GetGrid(istep)->GetUnderFlows(ivar,exclusive);
 } 
 //____________________________________________________________________
 Float_t AliCFContainer::GetEntries(Int_t istep) const {
@@ -281,7 +336,7 @@ Float_t AliCFContainer::GetEntries(Int_t istep) const {
     AliError("Non-existent selection step, return -1");
     return -1.;
   }
-  return fGrid[istep]->GetEntries();
+  return GetGrid(istep)->GetEntries();
 } 
 //_____________________________________________________________________
 Double_t AliCFContainer::GetIntegral( Int_t istep) const 
@@ -293,7 +348,7 @@ Double_t AliCFContainer::GetIntegral( Int_t istep) const
     AliError("Non-existent selection step, return -1");
     return -1.;
   }
-  return fGrid[istep]->GetIntegral();
+  return GetGrid(istep)->GetIntegral();
 }
 
 //_____________________________________________________________________
@@ -12,6 +12,7 @@
 
 #include "AliCFFrame.h"
 #include "AliCFGridSparse.h"
+#include "AliCFFillBuffer.h"
 
 class TH1D;
 class TH2D;
@@ -45,8 +46,8 @@ class AliCFContainer : public AliCFFrame
   virtual Int_t    * GetNBins()                                      const {return fGrid[0]->GetNBins();}
   virtual Float_t    GetBinCenter(Int_t ivar,Int_t ibin)             const {return fGrid[0]->GetBinCenter(ivar,ibin);}
   virtual Float_t    GetBinSize  (Int_t ivar,Int_t ibin)             const {return fGrid[0]->GetBinSize  (ivar,ibin);}
-  virtual Float_t    GetBinContent(const Int_t* coordinates, Int_t step) const {return fGrid[step]->GetGrid()->GetBinContent(coordinates);}
-  virtual Float_t    GetBinError  (const Int_t* coordinates, Int_t step) const {return fGrid[step]->GetGrid()->GetBinError  (coordinates);}
+  virtual Float_t    GetBinContent(const Int_t* coordinates, Int_t step) const {return GetGrid(step)->GetGrid()->GetBinContent(coordinates);}
+  virtual Float_t    GetBinError  (const Int_t* coordinates, Int_t step) const {return GetGrid(step)->GetGrid()->GetBinError  (coordinates);}
   virtual const Char_t* GetBinLabel (Int_t ivar,Int_t ibin)          const {return GetAxis(ivar,0)->GetBinLabel(ibin);}
 
   virtual void       Print(const Option_t*) const ;
@@ -62,11 +63,13 @@ class AliCFContainer : public AliCFFrame
   virtual Int_t GetNStep() const {return fNStep;};
   virtual void  SetNStep(Int_t nStep) {fNStep=nStep;}
   virtual void  Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  virtual void  SetFillBuffer(Int_t capacity=65536, Long_t maxDenseBins=0) ; // stage the fills (see AliCFFillBuffer), capacity=0 to fill directly
+  virtual void  FlushFillBuffer() const {if (fFillBuffer) fFillBuffer->Flush();} // adds the staged fills to the grids
 
   virtual Float_t  GetOverFlows (Int_t var,Int_t istep,Bool_t excl=kFALSE) const;
   virtual Float_t  GetUnderFlows(Int_t var,Int_t istep,Bool_t excl=kFALSE) const ;
   virtual Float_t  GetEntries  (Int_t istep) const ;
-  virtual Long_t   GetEmptyBins(Int_t istep) const {return fGrid[istep]->GetEmptyBins();}
+  virtual Long_t   GetEmptyBins(Int_t istep) const {return GetGrid(istep)->GetEmptyBins();}
   virtual Double_t GetIntegral (Int_t istep) const ;
 
   //basic operations
@@ -83,8 +86,8 @@ class AliCFContainer : public AliCFFrame
   virtual void  SetRangeUser(Int_t ivar, Double_t varMin, Double_t varMax, Bool_t useBins=kFALSE) const ;
   virtual void  SetRangeUser(const Double_t* varMin, const Double_t* varMax, Bool_t useBins=kFALSE) const ;
 
-  virtual void  SetGrid(Int_t step, AliCFGridSparse* grid) {if (fGrid[step]) delete fGrid[step]; fGrid[step]=grid;}
-  virtual AliCFGridSparse * GetGrid(Int_t istep) const {return fGrid[istep];};
+  virtual void  SetGrid(Int_t step, AliCFGridSparse* grid) ;
+  virtual AliCFGridSparse * GetGrid(Int_t istep) const {FlushFillBuffer(); return fGrid[istep];};
 
   virtual void  Scale(Double_t factor) const;
 
@@ -96,8 +99,9 @@ class AliCFContainer : public AliCFFrame
  private:
   Int_t    fNStep; //number of selection steps
   AliCFGridSparse **fGrid;//[fNStep]
+  AliCFFillBuffer  *fFillBuffer; //! staging buffer for Fill()
   
-  ClassDef(AliCFContainer,5);
+  ClassDef(AliCFContainer,6);
 };
 
 inline void AliCFContainer::SetBinLimits(Int_t ivar, const Double_t* array) {
@@ -140,6 +144,7 @@ inline void AliCFContainer::SetBinLabel(Int_t iVar, Int_t iBin, const Char_t* la
 }
 
 inline void  AliCFContainer::Scale(Double_t factor) const {
+  FlushFillBuffer();
   Double_t fact[2] = {factor,0} ;
   for (Int_t iStep=0; iStep<fNStep; iStep++) fGrid[iStep]->Scale(fact);
 }
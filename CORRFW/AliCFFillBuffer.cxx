@@ -0,0 +1,259 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+//--------------------------------------------------------------------//
+//                                                                    //
+// AliCFFillBuffer Class                                              //
+// Staging buffer for the fills of the grids of an AliCFContainer.    //
+// The fills are pre-binned and summed per (step, bin) before being   //
+// added to the THnSparse, so that the sparse hash is looked up once  //
+// per distinct (step, bin) in each flush instead of once per fill.   //
+// Bin contents, errors and entries are the same as with direct       //
+// filling.                                                           //
+//                                                                    //
+//--------------------------------------------------------------------//
+//
+//
+#include "AliCFFillBuffer.h"
+#include "THnSparse.h"
+#include "TAxis.h"
+#include "TMath.h"
+#include "AliLog.h"
+
+//____________________________________________________________________
+ClassImp(AliCFFillBuffer)
+
+//____________________________________________________________________
+AliCFFillBuffer::AliCFFillBuffer() :
+  TObject(),
+  fNStep(0),
+  fNVar(0),
+  fGrids(),
+  fCapacity(0),
+  fMaxDenseBins(0),
+  fMode(),
+  fErrors(),
+  fStride(),
+  fEntries(),
+  fCoord(),
+  fN(0),
+  fKeys(),
+  fW(),
+  fW2(),
+  fIndex(),
+  fDenseOffset(),
+  fDenseW(),
+  fDenseW2(),
+  fDenseOn()
+{
+  //
+  // default constructor
+  //
+}
+
+//____________________________________________________________________
+AliCFFillBuffer::AliCFFillBuffer(Int_t nStep, THnSparse** grids, Int_t capacity, Long_t maxDenseBins) :
+  TObject(),
+  fNStep(nStep),
+  fNVar(0),
+  fGrids(nStep),
+  fCapacity(capacity > 0 ? capacity : 1),
+  fMaxDenseBins(maxDenseBins),
+  fMode(nStep),
+  fErrors(nStep),
+  fStride(),
+  fEntries(nStep),
+  fCoord(),
+  fN(0),
+  fKeys(),
+  fW(),
+  fW2(),
+  fIndex(),
+  fDenseOffset(nStep),
+  fDenseW(),
+  fDenseW2(),
+  fDenseOn()
+{
+  //
+  // main constructor : grids[nStep] are the THnSparse filled at each step
+  //
+
+  for (Int_t iStep=0; iStep<fNStep; iStep++) {
+    if (grids[iStep] && grids[iStep]->GetNdimensions() > fNVar) fNVar = grids[iStep]->GetNdimensions();
+  }
+  fStride.Set(fNStep*fNVar);
+  fCoord .Set(fNVar);
+
+  // linear bins of each step, mixed radix with nbins+2 (under- and overflow) digits per axis
+  Long64_t denseSize = 0;
+  Bool_t   staged    = kFALSE;
+  for (Int_t iStep=0; iStep<fNStep; iStep++) {
+    THnSparse* grid = grids[iStep];
+    fGrids.AddAt(grid,iStep);
+    fMode[iStep]        = kDirect;
+    fDenseOffset[iStep] = -1;
+    if (!grid || grid->GetNdimensions() != fNVar) continue;
+    fErrors[iStep] = grid->GetCalculateErrors();
+
+    Double_t range  = fNStep;
+    Long64_t stride = 1;
+    for (Int_t iVar=0; iVar<fNVar; iVar++) {
+      Int_t n = grid->GetAxis(iVar)->GetNbins() + 2;
+      range *= n;
+      fStride[iStep*fNVar+iVar] = stride;
+      stride *= n;
+      if (range > 9.e18) break;
+    }
+    if (range > 9.e18) {
+      AliWarning(Form("Bins of step %d do not fit into 64 bits, filling directly",iStep));
+      continue;
+    }
+    if (stride <= fMaxDenseBins) {
+      fMode[iStep]        = kDense;
+      fDenseOffset[iStep] = denseSize;
+      denseSize          += stride;
+    }
+    else {
+      fMode[iStep] = kStaged;
+      staged       = kTRUE;
+    }
+  }
+
+  if (staged) {
+    fKeys .Set(fCapacity);
+    fW    .Set(fCapacity);
+    fW2   .Set(fCapacity);
+    fIndex.Set(fCapacity);
+  }
+  if (denseSize > 0) {
+    fDenseW .Set(denseSize);
+    fDenseW2.Set(denseSize);
+    fDenseOn.Set(denseSize);
+  }
+}
+
+//____________________________________________________________________
+AliCFFillBuffer::~AliCFFillBuffer()
+{
+  //
+  // destructor
+  // the grids are not owned and may already be gone, so nothing is flushed
+  //
+}
+
+//____________________________________________________________________
+void AliCFFillBuffer::Fill(const Double_t *var, Int_t istep, Double_t weight)
+{
+  //
+  // Stages the fill of the grid at step istep (istep must be valid)
+  //
+
+  THnSparse* grid = (THnSparse*) fGrids.UncheckedAt(istep);
+  if (!grid) return;
+  if (fMode[istep] == kDirect) {
+    grid->Fill(var,weight);
+    return;
+  }
+
+  const Long64_t* stride = fStride.GetArray() + istep*fNVar;
+  Long64_t linear = 0;
+  for (Int_t iVar=0; iVar<fNVar; iVar++) linear += stride[iVar] * grid->GetAxis(iVar)->FindFixBin(var[iVar]);
+  fEntries[istep] += 1;
+
+  if (fMode[istep] == kDense) {
+    Long64_t i = fDenseOffset[istep] + linear;
+    fDenseW [i] += weight;
+    fDenseW2[i] += weight*weight;
+    fDenseOn[i]  = 1;
+    return;
+  }
+
+  if (fN >= fCapacity) Flush();
+  fKeys[fN] = linear * fNStep + istep;
+  fW   [fN] = weight;
+  fW2  [fN] = weight*weight;
+  fN++;
+}
+
+//____________________________________________________________________
+void AliCFFillBuffer::Flush()
+{
+  //
+  // Adds the staged fills to the grids, once per distinct (step, bin)
+  //
+
+  if (fN > 0) {
+    Long64_t* keys  = fKeys.GetArray();
+    Int_t*    index = fIndex.GetArray();
+    TMath::Sort(fN,keys,index,kFALSE);
+
+    Int_t i = 0;
+    while (i < fN) {
+      Long64_t key = keys[index[i]];
+      Double_t w   = 0.;
+      Double_t w2  = 0.;
+      for (; i < fN && keys[index[i]] == key; i++) {
+        w  += fW [index[i]];
+        w2 += fW2[index[i]];
+      }
+      Int_t iStep = (Int_t)(key % fNStep);
+      Decode(iStep,key/fNStep,fCoord.GetArray());
+      AddBin((THnSparse*)fGrids.UncheckedAt(iStep),iStep,fCoord.GetArray(),w,w2);
+    }
+    fN = 0;
+  }
+
+  for (Int_t iStep=0; iStep<fNStep; iStep++) {
+    if (fEntries[iStep] == 0) continue;
+    THnSparse* grid = (THnSparse*) fGrids.UncheckedAt(iStep);
+    if (fMode[iStep] == kDense) {
+      Long64_t offset = fDenseOffset[iStep];
+      Long64_t nBins  = fStride[iStep*fNVar+fNVar-1] * (grid->GetAxis(fNVar-1)->GetNbins()+2);
+      for (Long64_t i=0; i<nBins; i++) {
+        if (!fDenseOn[offset+i]) continue;
+        Decode(iStep,i,fCoord.GetArray());
+        AddBin(grid,iStep,fCoord.GetArray(),fDenseW[offset+i],fDenseW2[offset+i]);
+        fDenseW [offset+i] = 0.;
+        fDenseW2[offset+i] = 0.;
+        fDenseOn[offset+i] = 0;
+      }
+    }
+    grid->SetEntries(grid->GetEntries() + fEntries[iStep]);
+    fEntries[iStep] = 0;
+  }
+}
+
+//____________________________________________________________________
+void AliCFFillBuffer::Decode(Int_t istep, Long64_t linear, Int_t *coord) const
+{
+  //
+  // bin coordinates of a linear bin of step istep
+  //
+  const Long64_t* stride = fStride.GetArray() + istep*fNVar;
+  for (Int_t iVar=fNVar-1; iVar>=0; iVar--) {
+    coord[iVar] = (Int_t)(linear / stride[iVar]);
+    linear     -= coord[iVar] * stride[iVar];
+  }
+}
+
+//____________________________________________________________________
+void AliCFFillBuffer::AddBin(THnSparse* grid, Int_t istep, const Int_t *coord, Double_t w, Double_t w2)
+{
+  //
+  // adds the summed weights to a bin of the grid
+  //
+  Long64_t bin = grid->GetBin(coord,kTRUE);
+  grid->AddBinContent(bin,w);
+  if (fErrors[istep]) grid->AddBinError2(bin,w2);
+}
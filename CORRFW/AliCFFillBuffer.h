@@ -0,0 +1,77 @@
+#ifndef ALICFFILLBUFFER_H
+#define ALICFFILLBUFFER_H
+
+//--------------------------------------------------------------------//
+//                                                                    //
+// AliCFFillBuffer Class                                              //
+// Staging buffer for the fills of the grids of an AliCFContainer     //
+//                                                                    //
+// Each fill is pre-binned into one 64 bit key (linear bin of the     //
+// step grid, with under/overflow, times the number of steps plus the //
+// step). The keys are kept in a flat buffer; when it is full (or on  //
+// Flush()) it is sorted, equal keys are summed and each distinct     //
+// (step, bin) is added to its THnSparse once. Steps whose grid has   //
+// at most maxDenseBins bins accumulate in a dense array instead.     //
+// The THnSparse of the grids are not owned. All the members are      //
+// per-job work space and are not streamed.                           //
+//                                                                    //
+//--------------------------------------------------------------------//
+
+#include "TObject.h"
+#include "TObjArray.h"
+#include "TArrayC.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
+#include "TArrayL64.h"
+
+class THnSparse;
+
+class AliCFFillBuffer : public TObject
+{
+ public:
+  AliCFFillBuffer();
+  AliCFFillBuffer(Int_t nStep, THnSparse** grids, Int_t capacity=65536, Long_t maxDenseBins=0);
+  virtual ~AliCFFillBuffer();
+
+  void     Fill(const Double_t *var, Int_t istep, Double_t weight=1.);
+  void     Flush();
+
+  Int_t    GetCapacity()     const {return fCapacity;}
+  Long_t   GetMaxDenseBins() const {return fMaxDenseBins;}
+  Int_t    GetN()            const {return fN;}
+
+ private:
+  AliCFFillBuffer(const AliCFFillBuffer& c);            // not implemented
+  AliCFFillBuffer& operator=(const AliCFFillBuffer& c); // not implemented
+
+  void     Decode(Int_t istep, Long64_t linear, Int_t *coord) const;
+  void     AddBin(THnSparse* grid, Int_t istep, const Int_t *coord, Double_t w, Double_t w2);
+
+  enum {kDirect=0, kStaged, kDense};
+
+  Int_t     fNStep;        //! number of steps
+  Int_t     fNVar;         //! number of variables
+  TObjArray fGrids;        //! THnSparse of each step (not owned)
+  Int_t     fCapacity;     //! size of the staging buffer
+  Long_t    fMaxDenseBins; //! max number of bins of a step accumulated in a dense array
+  TArrayC   fMode;         //! kDirect, kStaged or kDense for each step
+  TArrayC   fErrors;       //! whether the grid of each step keeps the sum of w^2
+  TArrayL64 fStride;       //! linear bin strides (nbins+2 per axis) of each step
+  TArrayD   fEntries;      //! entries of each step not yet in the grid
+  TArrayI   fCoord;        //! bin coordinates work space
+  // staged steps
+  Int_t     fN;            //! number of buffered fills
+  TArrayL64 fKeys;         //! buffered keys
+  TArrayD   fW;            //! buffered weights
+  TArrayD   fW2;           //! buffered squared weights
+  TArrayI   fIndex;        //! sort index
+  // dense steps
+  TArrayL64 fDenseOffset;  //! offset of each dense step in the dense arrays
+  TArrayD   fDenseW;       //! sum of weights of the dense bins
+  TArrayD   fDenseW2;      //! sum of squared weights of the dense bins
+  TArrayC   fDenseOn;      //! whether a dense bin has been filled
+
+  ClassDef(AliCFFillBuffer,1);
+};
+
+#endif
@@ -57,6 +57,12 @@
 // found in AliCFUnfolding::CalculateCorrelatedErrors()                //
 // Author: marta.verweij@cern.ch                                       //
 //                                                                     //
+// For large response matrices, UseFlatMatrix() runs the iterations    //
+// on flat arrays : the conditional matrix is converted once into a    //
+// list of cells with indices of their measured and true bins, and     //
+// the spectra are kept in plain arrays. The THnSparse outputs are     //
+// filled as in the default mode.                                      //
+//                                                                     //
 // An optional possibility is to smooth the unfolded spectrum at the   //
 // end of each iteration, either using a fit function                  //
 // (only if #dimensions <=3)                                           //
@@ -130,7 +136,28 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fUseFlatMatrix(kFALSE),
+  fNCells(-1),
+  fStrideM(),
+  fStrideT(),
+  fKeyM(),
+  fKeyT(),
+  fCellM(),
+  fCellT(),
+  fCellCond(),
+  fCellInv(),
+  fCellInvSet(),
+  fFlatEff(),
+  fFlatMeas(),
+  fFlatPriorEff(),
+  fFlatPriorBin(),
+  fFlatPriorVal(),
+  fFlatEst(),
+  fFlatEstOn(),
+  fFlatUnfolded(),
+  fFlatUnfoldedOn(),
+  fFlatUnfoldedBins()
 {
   //
   // default constructor
@@ -174,7 +201,28 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fUseFlatMatrix(kFALSE),
+  fNCells(-1),
+  fStrideM(),
+  fStrideT(),
+  fKeyM(),
+  fKeyT(),
+  fCellM(),
+  fCellT(),
+  fCellCond(),
+  fCellInv(),
+  fCellInvSet(),
+  fFlatEff(),
+  fFlatMeas(),
+  fFlatPriorEff(),
+  fFlatPriorBin(),
+  fFlatPriorVal(),
+  fFlatEst(),
+  fFlatEstOn(),
+  fFlatUnfolded(),
+  fFlatUnfoldedOn(),
+  fFlatUnfoldedBins()
 {
   //
   // named constructor
@@ -353,13 +401,23 @@ void AliCFUnfolding::Unfold() {
   Int_t iIterBayes     = 0 ;
   Double_t convergence = 0.;
 
-  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
+  if (fUseFlatMatrix && !BuildFlatMatrix()) fUseFlatMatrix = kFALSE;
+  if (fUseFlatMatrix) LoadFlatSpectra();
 
-    CreateEstMeasured(); // create measured estimate from prior
-    CreateInvResponse(); // create inverse response  from prior
-    CreateUnfolded();    // create unfoled spectrum  from measured and inverse response
+  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
 
-    convergence = GetConvergence();
+    if (fUseFlatMatrix) {
+      CreateEstMeasuredFlat();
+      CreateInvResponseFlat();
+      CreateUnfoldedFlat();
+      convergence = GetConvergenceFlat();
+    }
+    else {
+      CreateEstMeasured(); // create measured estimate from prior
+      CreateInvResponse(); // create inverse response  from prior
+      CreateUnfolded();    // create unfoled spectrum  from measured and inverse response
+      convergence = GetConvergence();
+    }
     AliDebug(0,Form("convergence at iteration %d is %e",iIterBayes,convergence));
 
     if (fMaxConvergence>0. && convergence<fMaxConvergence && fNCalcCorrErrors == 0) {
@@ -371,6 +429,7 @@ void AliCFUnfolding::Unfold() {
     if (fUseSmoothing) {
       if (Smooth()) {
 	AliError("Couldn't smooth the unfolded spectrum!!");
+	if (fUseFlatMatrix) StoreFlatInvResponse();
 	if (fNCalcCorrErrors>0) {
 	  AliInfo(Form("=======================\nUnfold of randomized distribution finished at iteration %d with convergence %e \n",iIterBayes,convergence));
 	}
@@ -388,6 +447,8 @@ void AliCFUnfolding::Unfold() {
 
   } // end bayes iteration
 
+  if (fUseFlatMatrix) StoreFlatInvResponse();
+
   if (fNCalcCorrErrors==0) fUnfoldedFinal = (THnSparse*) fUnfolded->Clone() ;
 
   //
@@ -512,8 +573,8 @@ void AliCFUnfolding::CreateRandomizedDist() {
   //
 
   for (Long_t iBin=0; iBin<fResponseOrig->GetNbins(); iBin++) {
-    Double_t val = fResponseOrig->GetBinContent(iBin,fCoordinatesN_M); //used as mean
-    Double_t err = fResponseOrig->GetBinError(fCoordinatesN_M);        //used as sigma
+    Double_t val = fResponseOrig->GetBinContent(iBin,fCoordinates2N); //used as mean
+    Double_t err = fResponseOrig->GetBinError(fCoordinates2N);        //used as sigma
     Double_t ran = fRandom3->Gaus(val,err);
     // random        = fRandom3->PoissonD(measuredValue); //doesn't work for normalized spectra, use Gaus (assuming raw counts in bin is large >10)
     fRandomResponse->SetBinContent(iBin,ran);
@@ -862,3 +923,274 @@ void AliCFUnfolding::CreateFlatPrior() {
   delete [] bin;
   delete [] bins;
 }
+
+//______________________________________________________________
+
+Bool_t AliCFUnfolding::BuildFlatMatrix() {
+  //
+  // Builds the flat representation of the conditional matrix used by UseFlatMatrix() :
+  // each cell (filled bin) of fConditional is stored with its probability, its inverse response
+  // and the indices of its measured and true bins in the sorted lists of bins used by the cells.
+  // The cells keep the order of the THnSparse bins, so the sums are done in the same order.
+  // As the conditional matrix is created only once, this is done at the first call.
+  // Returns kFALSE if the bins cannot be numbered in 64 bits.
+  //
+
+  if (fNCells>=0) return kTRUE;
+
+  fStrideM.Set(fNVariables);
+  fStrideT.Set(fNVariables);
+  Double_t rangeM = 1., rangeT = 1.;
+  Long64_t strideM = 1, strideT = 1;
+  for (Int_t iVar=0; iVar<fNVariables; iVar++) {
+    Int_t nM = fConditional->GetAxis(iVar)            ->GetNbins() + 2; // with under/overflow
+    Int_t nT = fConditional->GetAxis(iVar+fNVariables)->GetNbins() + 2;
+    rangeM *= nM;
+    rangeT *= nT;
+    if (rangeM>9.e18 || rangeT>9.e18) {
+      AliWarning("Bins of the response matrix do not fit into 64 bits, using THnSparse look-ups");
+      return kFALSE;
+    }
+    fStrideM[iVar] = strideM; strideM *= nM;
+    fStrideT[iVar] = strideT; strideT *= nT;
+  }
+
+  Int_t nCells = (Int_t) fConditional->GetNbins();
+  TArrayL64 keyM(nCells), keyT(nCells);
+  fCellCond  .Set(nCells);
+  fCellInv   .Set(nCells);
+  fCellInvSet.Set(nCells);
+  fCellInvSet.Reset();
+  for (Int_t iCell=0; iCell<nCells; iCell++) {
+    fCellCond[iCell] = fConditional->GetBinContent(iCell,fCoordinates2N);
+    GetCoordinates();
+    keyM[iCell] = GetFlatKey(fCoordinatesN_M,0,fStrideM);
+    keyT[iCell] = GetFlatKey(fCoordinatesN_T,fNVariables,fStrideT);
+    fCellInv[iCell] = fInverseResponse->GetBinContent(iCell); // clone of the response : same bin order
+  }
+  MakeFlatIndex(nCells,keyM,fKeyM,fCellM);
+  MakeFlatIndex(nCells,keyT,fKeyT,fCellT);
+  fNCells = nCells;
+
+  Int_t nM = fKeyM.GetSize(), nT = fKeyT.GetSize();
+  fFlatMeas        .Set(nM);
+  fFlatEst         .Set(nM);
+  fFlatEstOn       .Set(nM);
+  fFlatEff         .Set(nT);
+  fFlatPriorEff    .Set(nT);
+  fFlatUnfolded    .Set(nT);
+  fFlatUnfoldedOn  .Set(nT);
+  fFlatUnfoldedBins.Set(nT);
+
+  AliInfo(Form("Flat matrix : %d cells, %d measured bins, %d true bins",fNCells,nM,nT));
+  return kTRUE;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::MakeFlatIndex(Int_t n, const TArrayL64& key, TArrayL64& sorted, TArrayI& index) {
+  //
+  // Lists the distinct values of key in increasing order in sorted,
+  // and stores in index the position of each key in this list
+  //
+
+  TArrayI order(n);
+  TMath::Sort(n,key.GetArray(),order.GetArray(),kFALSE);
+  sorted.Set(n);
+  index .Set(n);
+  Int_t nDistinct = 0;
+  for (Int_t i=0; i<n; i++) {
+    Long64_t k = key[order[i]];
+    if (nDistinct==0 || sorted[nDistinct-1]!=k) sorted[nDistinct++] = k;
+    index[order[i]] = nDistinct-1;
+  }
+  sorted.Set(nDistinct);
+}
+
+//______________________________________________________________
+
+Long64_t AliCFUnfolding::GetFlatKey(const Int_t* coord, Int_t offset, const TArrayL64& stride) const {
+  //
+  // Linear bin of coordinates in the measured (offset=0) or true (offset=fNVariables) space
+  // of the response matrix, -1 if outside its binning
+  //
+
+  Long64_t key = 0;
+  for (Int_t iVar=0; iVar<fNVariables; iVar++) {
+    if (coord[iVar]<0 || coord[iVar]>fConditional->GetAxis(iVar+offset)->GetNbins()+1) return -1;
+    key += stride[iVar] * coord[iVar];
+  }
+  return key;
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfolding::FindFlatIndex(const Int_t* coord, Int_t offset, const TArrayL64& stride, const TArrayL64& keys) const {
+  //
+  // Index in keys of the bin with the given coordinates, -1 if no cell uses it
+  //
+
+  Long64_t key = GetFlatKey(coord,offset,stride);
+  if (key<0 || keys.GetSize()==0) return -1;
+  Long64_t i = TMath::BinarySearch((Long64_t)keys.GetSize(),keys.GetArray(),key);
+  return (i>=0 && keys[i]==key) ? (Int_t)i : -1;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::GetFlatCoordinates(Long64_t key, const TArrayL64& stride, Int_t* coord) const {
+  //
+  // Coordinates of a linear bin
+  //
+
+  for (Int_t iVar=fNVariables-1; iVar>=0; iVar--) {
+    coord[iVar] = (Int_t)(key / stride[iVar]);
+    key -= coord[iVar] * stride[iVar];
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::LoadFlatSpectra() {
+  //
+  // Copies the efficiency and the measured spectrum into the flat arrays.
+  // Bins not used by any cell do not enter the unfolding and are dropped.
+  //
+
+  fFlatEff.Reset();
+  for (Long_t iBin=0; iBin<fEfficiency->GetNbins(); iBin++) {
+    Double_t value = fEfficiency->GetBinContent(iBin,fCoordinatesN_T);
+    Int_t t = FindFlatIndex(fCoordinatesN_T,fNVariables,fStrideT,fKeyT);
+    if (t>=0) fFlatEff[t] = value;
+  }
+  fFlatMeas.Reset();
+  for (Long_t iBin=0; iBin<fMeasured->GetNbins(); iBin++) {
+    Double_t value = fMeasured->GetBinContent(iBin,fCoordinatesN_M);
+    Int_t m = FindFlatIndex(fCoordinatesN_M,0,fStrideM,fKeyM);
+    if (m>=0) fFlatMeas[m] = value;
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::CreateEstMeasuredFlat() {
+  //
+  // Flat matrix version of CreateEstMeasured()
+  // The prior is read once per iteration, keeping the order of its bins for GetConvergenceFlat()
+  //
+
+  Int_t nPrior = (Int_t) fPrior->GetNbins();
+  fFlatPriorBin.Set(nPrior);
+  fFlatPriorVal.Set(nPrior);
+  fFlatPriorEff.Reset();
+  for (Int_t iBin=0; iBin<nPrior; iBin++) {
+    fFlatPriorVal[iBin] = fPrior->GetBinContent(iBin,fCoordinatesN_T);
+    Int_t t = FindFlatIndex(fCoordinatesN_T,fNVariables,fStrideT,fKeyT);
+    fFlatPriorBin[iBin] = t;
+    if (t>=0) fFlatPriorEff[t] = fFlatPriorVal[iBin] * fFlatEff[t];
+  }
+
+  fFlatEst  .Reset();
+  fFlatEstOn.Reset();
+  for (Int_t iCell=0; iCell<fNCells; iCell++) {
+    Double_t fill = fCellCond[iCell] * fFlatPriorEff[fCellT[iCell]];
+    if (fill>0.) {
+      fFlatEst  [fCellM[iCell]] += fill;
+      fFlatEstOn[fCellM[iCell]]  = 1;
+    }
+  }
+
+  fMeasuredEstimate->Reset();
+  for (Int_t m=0; m<fKeyM.GetSize(); m++) {
+    if (!fFlatEstOn[m]) continue;
+    GetFlatCoordinates(fKeyM[m],fStrideM,fCoordinatesN_M);
+    fMeasuredEstimate->SetBinContent(fCoordinatesN_M,fFlatEst[m]);
+    fMeasuredEstimate->SetBinError  (fCoordinatesN_M,0.);
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::CreateInvResponseFlat() {
+  //
+  // Flat matrix version of CreateInvResponse()
+  // fInverseResponse is updated by StoreFlatInvResponse() at the end of Unfold()
+  //
+
+  for (Int_t iCell=0; iCell<fNCells; iCell++) {
+    Double_t estMeasuredValue = fFlatEst[fCellM[iCell]];
+    Double_t fill = (estMeasuredValue>0. ? fCellCond[iCell] * fFlatPriorEff[fCellT[iCell]] / estMeasuredValue : 0.) ;
+    if (fill>0. || fCellInv[iCell]>0.) {
+      fCellInv   [iCell] = fill;
+      fCellInvSet[iCell] = 1;
+    }
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::CreateUnfoldedFlat() {
+  //
+  // Flat matrix version of CreateUnfolded()
+  // The bins of fUnfolded are created in the same order as in CreateUnfolded()
+  //
+
+  fFlatUnfolded  .Reset();
+  fFlatUnfoldedOn.Reset();
+  Int_t nFilled = 0;
+  for (Int_t iCell=0; iCell<fNCells; iCell++) {
+    Int_t t = fCellT[iCell];
+    Double_t effValue = fFlatEff[t];
+    Double_t fill = (effValue>0. ? fCellInv[iCell] * fFlatMeas[fCellM[iCell]] / effValue : 0.) ;
+    if (fill>0.) {
+      if (!fFlatUnfoldedOn[t]) {
+	fFlatUnfoldedOn[t] = 1;
+	fFlatUnfoldedBins[nFilled++] = t;
+      }
+      fFlatUnfolded[t] += fill;
+    }
+  }
+
+  fUnfolded->Reset();
+  for (Int_t i=0; i<nFilled; i++) {
+    Int_t t = fFlatUnfoldedBins[i];
+    GetFlatCoordinates(fKeyT[t],fStrideT,fCoordinatesN_T);
+    fUnfolded->SetBinContent(fCoordinatesN_T,fFlatUnfolded[t]);
+    fUnfolded->SetBinError  (fCoordinatesN_T,0.);
+  }
+}
+
+//______________________________________________________________
+
+Double_t AliCFUnfolding::GetConvergenceFlat() {
+  //
+  // Flat matrix version of GetConvergence(), using the prior read in CreateEstMeasuredFlat()
+  //
+
+  Double_t convergence = 0.;
+  for (Int_t iBin=0; iBin<fFlatPriorBin.GetSize(); iBin++) {
+    Double_t priorValue   = fFlatPriorVal[iBin];
+    Double_t currentValue = (fFlatPriorBin[iBin]>=0 ? fFlatUnfolded[fFlatPriorBin[iBin]] : 0.);
+
+    if (priorValue > 0.)
+      convergence += ((priorValue-currentValue)/priorValue)*((priorValue-currentValue)/priorValue);
+    else 
+      AliWarning(Form("priorValue = %f. Adding 0 to convergence criterion.",priorValue)); 
+  }
+  return convergence;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::StoreFlatInvResponse() {
+  //
+  // Copies the inverse response of the cells which have been set into fInverseResponse
+  //
+
+  for (Int_t iCell=0; iCell<fNCells; iCell++) {
+    if (!fCellInvSet[iCell]) continue;
+    fInverseResponse->GetBinContent(iCell,fCoordinates2N);
+    fInverseResponse->SetBinContent(fCoordinates2N,fCellInv[iCell]);
+    fInverseResponse->SetBinError  (fCoordinates2N,0.);
+  }
+}
@@ -12,6 +12,10 @@
 
 #include "TNamed.h"
 #include "THnSparse.h"
+#include "TArrayC.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
+#include "TArrayL64.h"
 #include "AliLog.h"
 
 class TF1;
@@ -36,6 +40,7 @@ class AliCFUnfolding : public TNamed {
   }
 
   void SetNRandomIterations(Int_t n = 100) {fNRandomIterations = n;};
+  void UseFlatMatrix(Bool_t flat = kTRUE)  {fUseFlatMatrix = flat;}  // run the bayes iterations on flat arrays instead of THnSparse look-ups
 
   void UseSmoothing(TF1* fcn=0x0, Option_t* opt="iremn") { // if fcn=0x0 then smooth using neighbouring bins 
     fUseSmoothing=kTRUE;                                   // this function must NOT be used if fNVariables > 3
@@ -112,6 +117,29 @@ class AliCFUnfolding : public TNamed {
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
 
+  /* flat matrix mode */
+  Bool_t         fUseFlatMatrix;     // Run the bayes iterations on flat arrays built once from the conditional matrix
+  Int_t          fNCells;            //! Number of cells of the conditional matrix (-1 if not built)
+  TArrayL64      fStrideM;           //! Linear bin strides in measured space
+  TArrayL64      fStrideT;           //! Linear bin strides in true space
+  TArrayL64      fKeyM;              //! Sorted linear bins of the measured bins used by the cells
+  TArrayL64      fKeyT;              //! Sorted linear bins of the true bins used by the cells
+  TArrayI        fCellM;             //! Measured bin index of each cell
+  TArrayI        fCellT;             //! True bin index of each cell
+  TArrayD        fCellCond;          //! Conditional probability of each cell
+  TArrayD        fCellInv;           //! Inverse response of each cell
+  TArrayC        fCellInvSet;        //! Whether the inverse response of a cell has been set
+  TArrayD        fFlatEff;           //! Efficiency of each true bin
+  TArrayD        fFlatMeas;          //! Measured spectrum in each measured bin
+  TArrayD        fFlatPriorEff;      //! Prior times efficiency of each true bin
+  TArrayI        fFlatPriorBin;      //! True bin index of each bin of fPrior (-1 if not used by the cells)
+  TArrayD        fFlatPriorVal;      //! Content of each bin of fPrior
+  TArrayD        fFlatEst;           //! Measured estimate in each measured bin
+  TArrayC        fFlatEstOn;         //! Whether the measured estimate bin is filled
+  TArrayD        fFlatUnfolded;      //! Unfolded spectrum in each true bin
+  TArrayC        fFlatUnfoldedOn;    //! Whether the unfolded bin is filled
+  TArrayI        fFlatUnfoldedBins;  //! Filled unfolded bins, in filling order
+
 
   // functions
   void     Init();                  // initialisation of the internal settings
@@ -132,7 +160,20 @@ class AliCFUnfolding : public TNamed {
   void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
   void     SetMaxConvergencePerDOF (Double_t val);
 
-  ClassDef(AliCFUnfolding,1);
+  /* flat matrix mode */
+  Bool_t   BuildFlatMatrix();           // Builds the flat cell list from the conditional matrix
+  void     LoadFlatSpectra();           // Copies efficiency and measured spectrum into the flat arrays
+  void     CreateEstMeasuredFlat();     // Flat version of CreateEstMeasured()
+  void     CreateInvResponseFlat();     // Flat version of CreateInvResponse()
+  void     CreateUnfoldedFlat();        // Flat version of CreateUnfolded()
+  Double_t GetConvergenceFlat();        // Flat version of GetConvergence()
+  void     StoreFlatInvResponse();      // Copies the flat inverse response into fInverseResponse
+  Long64_t GetFlatKey(const Int_t* coord, Int_t offset, const TArrayL64& stride) const; // Linear bin of measured (offset=0) or true (offset=N) coordinates
+  Int_t    FindFlatIndex(const Int_t* coord, Int_t offset, const TArrayL64& stride, const TArrayL64& keys) const; // Index of a bin in the flat arrays
+  void     GetFlatCoordinates(Long64_t key, const TArrayL64& stride, Int_t* coord) const; // Coordinates of a linear bin
+  static void MakeFlatIndex(Int_t n, const TArrayL64& key, TArrayL64& sorted, TArrayI& index); // Lists the distinct keys
+
+  ClassDef(AliCFUnfolding,2);
 };
 
 #endif
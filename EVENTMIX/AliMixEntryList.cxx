@@ -0,0 +1,69 @@
+//
+// Class AliMixEntryList
+//
+// AliMixEntryList is sorted list of chain entries of one
+// AliMixEventPool bin, kept in one flat array
+//
+
+#include <TEntryList.h>
+#include <TMath.h>
+
+#include "AliMixEntryList.h"
+
+ClassImp(AliMixEntryList)
+
+//_________________________________________________________________________________________________
+AliMixEntryList::AliMixEntryList() : TObject(),
+   fN(0),
+   fEntries()
+{
+   //
+   // Default constructor.
+   //
+}
+
+//_________________________________________________________________________________________________
+AliMixEntryList::AliMixEntryList(const TEntryList &el) : TObject(),
+   fN(0),
+   fEntries()
+{
+   //
+   // Creates list with entries of el (used for pools stored with TEntryList)
+   //
+   TEntryList &list = const_cast<TEntryList &>(el);
+   Long64_t n = list.GetN();
+   fEntries.Set((Int_t)n);
+   for (Long64_t i = 0; i < n; i++) Enter(list.GetEntry((Int_t)i));
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEntryList::Enter(Long64_t entry)
+{
+   //
+   // Adds entry, keeping the list sorted.
+   // Returns kFALSE when entry is already in the list
+   //
+   if (entry < 0) return kFALSE;
+   Long64_t pos = fN;
+   if (fN > 0 && entry <= fEntries.At(fN - 1)) {
+      pos = TMath::BinarySearch(fN, fEntries.GetArray(), entry);
+      if (pos >= 0 && fEntries.At(pos) == entry) return kFALSE;
+      pos++;
+   }
+   if (fN >= fEntries.GetSize()) fEntries.Set(TMath::Max(16, 2 * fEntries.GetSize()));
+   Long64_t *e = fEntries.GetArray();
+   for (Long64_t i = fN; i > pos; i--) e[i] = e[i - 1];
+   e[pos] = entry;
+   fN++;
+   return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEntryList::Reset()
+{
+   //
+   // Removes all entries
+   //
+   fN = 0;
+   fEntries.Set(0);
+}
@@ -0,0 +1,33 @@
+//
+// Class AliMixEntryList
+//
+// AliMixEntryList is sorted list of chain entries of one
+// AliMixEventPool bin, kept in one flat array
+//
+
+#ifndef ALIMIXENTRYLIST_H
+#define ALIMIXENTRYLIST_H
+
+#include <TObject.h>
+#include <TArrayL64.h>
+
+class TEntryList;
+class AliMixEntryList : public TObject {
+public:
+   AliMixEntryList();
+   AliMixEntryList(const TEntryList &el);
+   virtual ~AliMixEntryList() {}
+
+   Bool_t      Enter(Long64_t entry);
+   Long64_t    GetEntry(Long64_t index) const { return (index >= 0 && index < fN) ? fEntries.At(index) : -1; }
+   Long64_t    GetN() const { return fN; }
+   virtual void Reset();
+
+private:
+   Long64_t    fN;         // number of entries
+   TArrayL64   fEntries;   // entries (sorted), capacity >= fN
+
+   ClassDef(AliMixEntryList, 1)
+};
+
+#endif
@@ -8,6 +8,8 @@
 //          Martin Vala (martin.vala@cern.ch)
 //
 
+#include <TMath.h>
+
 #include "AliLog.h"
 #include "AliESDEvent.h"
 #include "AliAODEvent.h"
@@ -27,7 +29,8 @@ AliMixEventCutObj::AliMixEventCutObj(AliMixEventCutObj::EEPAxis_t type, Float_t
    fCutMax(max),
    fCutStep(step),
    fCutSmallVal(0),
-   fCurrentVal(min)
+   fCurrentVal(min),
+   fBinMin()
 {
    //
    // Default constructor
@@ -45,7 +48,8 @@ AliMixEventCutObj::AliMixEventCutObj(const AliMixEventCutObj &obj) : TObject(obj
    fCutMax(obj.fCutMax),
    fCutStep(obj.fCutStep),
    fCutSmallVal(obj.fCutSmallVal),
-   fCurrentVal(obj.fCurrentVal)
+   fCurrentVal(obj.fCurrentVal),
+   fBinMin()
 {
    //
    // Copy constructor
@@ -69,6 +73,7 @@ AliMixEventCutObj &AliMixEventCutObj::operator=(const AliMixEventCutObj &obj)
       fCutStep = obj.fCutStep;
       fCutSmallVal = obj.fCutSmallVal;
       fCurrentVal = obj.fCurrentVal;
+      fBinMin.Set(0);
 //       fNoMore = obj.fNoMore;
    }
    return *this;
@@ -137,16 +142,35 @@ Int_t AliMixEventCutObj::GetBinNumber(Float_t num) const
    // Returns bin (index) number in current cut.
    // Returns -1 in case of out of range
    //
-   Int_t binNum = 0;
-   for (Float_t iCurrent = fCutMin; iCurrent < fCutMax; iCurrent += fCutStep) {
-      binNum++;
-      if ((num >= iCurrent) && (num < iCurrent + fCutStep - fCutSmallVal)) {
-         return binNum;
-      }
-   }
+   if (!fBinMin.GetSize()) const_cast<AliMixEventCutObj *>(this)->InitBinEdges();
+   Int_t n = fBinMin.GetSize() - 1;
+   if (n <= 0 || !(num >= fBinMin.At(0))) return -1;
+   // bins do not overlap, so only the last one starting below num can contain it
+   Int_t i = (Int_t)TMath::BinarySearch((Long64_t)n, fBinMin.GetArray(), num);
+   if (num < fBinMin.At(i) + fCutStep - fCutSmallVal) return i + 1;
    return -1;
 }
 
+//_________________________________________________________________________________________________
+void AliMixEventCutObj::InitBinEdges()
+{
+   //
+   // Stores lower edges of bins, accumulated in Float_t exactly as the bins
+   // were stepped before, so that GetBinNumber() can use binary search.
+   // Last element is a sentinel (array is never empty once initialized).
+   //
+   Int_t n = 0;
+   if (fCutStep > 0) {
+      for (Float_t iCurrent = fCutMin; iCurrent < fCutMax; iCurrent += fCutStep) n++;
+   }
+   fBinMin.Set(n + 1);
+   n = 0;
+   if (fCutStep > 0) {
+      for (Float_t iCurrent = fCutMin; iCurrent < fCutMax; iCurrent += fCutStep) fBinMin[n++] = iCurrent;
+   }
+   fBinMin[n] = fCutMax;
+}
+
 //_________________________________________________________________________________________________
 Int_t AliMixEventCutObj::GetIndex(AliVEvent *ev)
 {
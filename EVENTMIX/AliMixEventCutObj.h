@@ -13,6 +13,7 @@
 
 #include <TObject.h>
 #include <TString.h>
+#include <TArrayF.h>
 
 class AliVEvent;
 class AliAODEvent;
@@ -64,7 +65,11 @@ private:
 
    Float_t     fCurrentVal;    // current value
 
-   ClassDef(AliMixEventCutObj, 3)
+   TArrayF     fBinMin;        //! lower edges of bins (as stepped in GetBinNumber)
+
+   void        InitBinEdges();
+
+   ClassDef(AliMixEventCutObj, 4)
 };
 
 #endif
@@ -11,6 +11,7 @@
 #include <TEntryList.h>
 
 #include "AliLog.h"
+#include "AliMixEntryList.h"
 #include "AliMixEventCutObj.h"
 
 #include "AliMixEventPool.h"
@@ -94,9 +95,9 @@ void AliMixEventPool::Print(const Option_t *option) const
       cut->Print(option);
    }
    AliDebug(AliLog::kDebug, Form("NumOfEntryList %d", fListOfEntryList.GetEntries()));
-   TEntryList *el;
+   AliMixEntryList *el;
    for (Int_t i = 0; i < fListOfEntryList.GetEntries(); i++) {
-      el = (TEntryList *) fListOfEntryList.At(i);
+      el = (AliMixEntryList *) fListOfEntryList.At(i);
       AliDebug(AliLog::kDebug, Form("EntryList[%d] %lld", i, el->GetN()));
    }
 }
@@ -143,7 +144,7 @@ void AliMixEventPool::CreateEntryListsRecursivly(Int_t index)
 }
 
 //_________________________________________________________________________________________________
-TEntryList *AliMixEventPool::AddEntryList()
+AliMixEntryList *AliMixEventPool::AddEntryList()
 {
    //
    // Adds endtry list
@@ -154,7 +155,7 @@ TEntryList *AliMixEventPool::AddEntryList()
    while ((cut = (AliMixEventCutObj *) next())) {
       if (cut) cut->PrintCurrentInterval();
    }
-   TEntryList *el = new TEntryList;
+   AliMixEntryList *el = new AliMixEntryList;
    fListOfEntryList.Add(el);
    AliDebug(AliLog::kDebug + 1, Form("Number in Entry list -> %lld", el->GetN()));
    AliDebug(AliLog::kDebug + 5, "->");
@@ -174,7 +175,7 @@ Bool_t AliMixEventPool::AddEntry(Long64_t entry, AliVEvent *ev)
       return kFALSE;
    }
    Int_t idEntryList = -1;
-   TEntryList *el =  FindEntryList(ev, idEntryList);
+   AliMixEntryList *el =  FindEntryList(ev, idEntryList);
    if (el) {
       el->Enter(entry);
       AliDebug(AliLog::kDebug, Form("Entry %lld was added with idEntryList %d !!!", entry, idEntryList));
@@ -186,39 +187,44 @@ Bool_t AliMixEventPool::AddEntry(Long64_t entry, AliVEvent *ev)
 }
 
 //_________________________________________________________________________________________________
-TEntryList *AliMixEventPool::FindEntryList(AliVEvent *ev, Int_t &idEntryList)
+Int_t AliMixEventPool::FindBinIndex(AliVEvent *ev)
 {
    //
-   // Find entrlist in list of entrlist
+   // Returns index of bin (entry list) of event, counted from 0,
+   // or -1 when event is out of range of any cut.
+   // Bins are numbered with first cut changing fastest
+   // (same as in CreateEntryListsRecursivly and SetCutValuesFromBinIndex)
    //
-   AliDebug(AliLog::kDebug + 5, "<-");
    Int_t num = fListOfEventCuts.GetEntriesFast();
-   if (num < 1) return 0;
-   Int_t *indexes = new Int_t[num] ;
-   Int_t *lenght = new Int_t[num];
-   Int_t i = 0;
-   TObjArrayIter next(&fListOfEventCuts);
+   if (num < 1) return -1;
+   Long64_t index = 0, stride = 1;
    AliMixEventCutObj *cut;
-   while ((cut = (AliMixEventCutObj *) next())) {
-      indexes[i] = cut->GetIndex(ev);
-      if (indexes[i] < 0) {
-         AliDebug(AliLog::kDebug, Form("idEntryList %d", -1));
-         delete [] indexes;
-         delete [] lenght;
-         return 0;
-      }
-      lenght[i] = cut->GetNumberOfBins();
-      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, indexes[i]));
-      i++;
+   for (Int_t i = 0; i < num; i++) {
+      cut = (AliMixEventCutObj *) fListOfEventCuts.UncheckedAt(i);
+      Int_t bin = cut->GetIndex(ev);
+      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, bin));
+      if (bin < 0) return -1;
+      index += (bin - 1) * stride;
+      stride *= cut->GetNumberOfBins();
    }
-   idEntryList = 0;
-   SearchIndexRecursive(fListOfEventCuts.GetEntries() - 1, &indexes[0], &lenght[0], idEntryList);
-   AliDebug(AliLog::kDebug, Form("idEntryList %d", idEntryList - 1));
-   // index which start with 0 (idEntryList-1)
-   delete [] indexes;
-   delete [] lenght;
+   if (index < 0 || index >= fListOfEntryList.GetEntriesFast()) return -1;
+   return (Int_t) index;
+}
+
+//_________________________________________________________________________________________________
+AliMixEntryList *AliMixEventPool::FindEntryList(AliVEvent *ev, Int_t &idEntryList)
+{
+   //
+   // Find entrlist in list of entrlist
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   Int_t index = FindBinIndex(ev);
+   AliDebug(AliLog::kDebug, Form("idEntryList %d", index));
+   if (index < 0) return 0;
+   // index which start with 1 (idEntryList-1)
+   idEntryList = index + 1;
    AliDebug(AliLog::kDebug + 5, "->");
-   return (TEntryList *) fListOfEntryList.At(idEntryList - 1);
+   return (AliMixEntryList *) fListOfEntryList.UncheckedAt(index);
 }
 
 //_________________________________________________________________________________________________
@@ -229,7 +235,9 @@ void AliMixEventPool::SearchIndexRecursive(Int_t num, Int_t *i, Int_t *d, Int_t
    //
    AliDebug(AliLog::kDebug + 5, "<-");
    if (num > 0) {
-      index += (i[num] - 1) * d[num - 1];
+      Int_t stride = 1;
+      for (Int_t j = 0; j < num; j++) stride *= d[j];
+      index += (i[num] - 1) * stride;
       SearchIndexRecursive(num - 1, i, d, index);
    } else {
       index += i[num];
@@ -237,6 +245,22 @@ void AliMixEventPool::SearchIndexRecursive(Int_t num, Int_t *i, Int_t *d, Int_t
    AliDebug(AliLog::kDebug + 5, "->");
 }
 
+//_________________________________________________________________________________________________
+Bool_t AliMixEventPool::NeedInit()
+{
+   //
+   // Returns kTRUE when bins are not created yet.
+   // Pools stored with TEntryList bins are converted here
+   //
+   for (Int_t i = 0; i < fListOfEntryList.GetEntriesFast(); i++) {
+      TObject *obj = fListOfEntryList.UncheckedAt(i);
+      if (!obj || !obj->InheritsFrom(TEntryList::Class())) continue;
+      fListOfEntryList.AddAt(new AliMixEntryList(*(TEntryList *) obj), i);
+      delete obj;
+   }
+   return (fListOfEntryList.GetEntries() == 0);
+}
+
 //_________________________________________________________________________________________________
 Bool_t AliMixEventPool::SetCutValuesFromBinIndex(Int_t index)
 {
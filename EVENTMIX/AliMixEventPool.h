@@ -14,7 +14,7 @@
 #include <TObjArray.h>
 #include <TNamed.h>
 
-class TEntryList;
+class AliMixEntryList;
 class AliMixEventCutObj;
 class AliVEvent;
 class AliMixEventPool : public TNamed {
@@ -32,14 +32,15 @@ public:
 
    void        CreateEntryListsRecursivly(Int_t index);
    void        SearchIndexRecursive(Int_t num, Int_t *i, Int_t *d, Int_t &index);
-   TEntryList *AddEntryList();
+   AliMixEntryList *AddEntryList();
 
    Bool_t      AddEntry(Long64_t entry, AliVEvent *ev);
-   TEntryList *FindEntryList(AliVEvent *ev, Int_t &idEntryList);
+   Int_t       FindBinIndex(AliVEvent *ev);
+   AliMixEntryList *FindEntryList(AliVEvent *ev, Int_t &idEntryList);
 
    void        AddCut(AliMixEventCutObj *cut);
 
-   Bool_t      NeedInit() { return (fListOfEntryList.GetEntries() == 0); }
+   Bool_t      NeedInit();
    TObjArray  *GetListOfEntryLists() { return &fListOfEntryList; }
    TObjArray  *GetListOfEventCuts() { return &fListOfEventCuts; }
 
@@ -51,14 +52,14 @@ public:
 
 private:
 
-   TObjArray   fListOfEntryList;       // list of entry lists
+   TObjArray   fListOfEntryList;       // list of entry lists (AliMixEntryList, one per bin)
    TObjArray   fListOfEventCuts;       // list of entry lists
 
    Int_t       fBinNumber;             // bin number
    Int_t       fBufferSize;            // buffer size
    Int_t       fMixNumber;             // mixing number
 
-   ClassDef(AliMixEventPool, 1)
+   ClassDef(AliMixEventPool, 2)
 };
 
 #endif
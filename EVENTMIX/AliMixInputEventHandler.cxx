@@ -16,6 +16,7 @@
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 
+#include "AliMixEntryList.h"
 #include "AliMixEventPool.h"
 #include "AliMixInputEventHandler.h"
 #include "AliMixInputHandlerInfo.h"
@@ -37,6 +38,7 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fDoMixExtra(kTRUE),
    fDoMixIfNotEnoughEvents(kTRUE),
    fDoMixEventGetEntryAuto(kTRUE),
+   fMixTreeCacheSize(0),
    fCurrentEntry(0),
    fCurrentEntryMain(0),
    fCurrentEntryMix(0),
@@ -153,6 +155,7 @@ Bool_t AliMixInputEventHandler::Notify(const char *path)
    for (Int_t i = 0; i < fInputHandlers.GetEntries(); i++) {
       AliDebug(AliLog::kDebug + 5, Form("fInputHandlers[%d]", i));
       mixIHI = new AliMixInputHandlerInfo(fMixIntupHandlerInfoTmp->GetName(), fMixIntupHandlerInfoTmp->GetTitle());
+      mixIHI->SetTreeCacheSize(fMixTreeCacheSize);
       if (doPrepareEntry) mixIHI->PrepareEntry(che, -1, (AliInputEventHandler *)InputEventHandler(i), fAnalysisType);
       AliDebug(AliLog::kDebug + 5, Form("chain[%d]->GetEntries() = %lld", i, mixIHI->GetChain()->GetEntries()));
       fMixTrees.Add(mixIHI);
@@ -304,7 +307,7 @@ Bool_t AliMixInputEventHandler::MixBuffer()
    // reset mix number
    fNumberMixed = 0;
    Long64_t elNum = 0;
-   TEntryList *el = 0;
+   AliMixEntryList *el = 0;
    Int_t idEntryList = -1;
    if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
    // return in case of 0 entry in full chain
@@ -405,7 +408,7 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    fNumberMixed = 0;
    Long64_t elNum = 0;
    Int_t idEntryList = -1;
-   TEntryList *el = 0;
+   AliMixEntryList *el = 0;
    if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
@@ -508,6 +511,39 @@ Bool_t AliMixInputEventHandler::FinishEvent()
    return kTRUE;
 }
 
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::TerminateIO()
+{
+   //
+   // TerminateIO() prints statistics of reading of mixed events
+   //
+   PrintMixReadStat();
+   return AliMultiInputEventHandler::TerminateIO();
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::PrintMixReadStat()
+{
+   //
+   // Prints number of mixed entries read, how many of them needed
+   // to open another file and time spent in reading them
+   //
+   Long64_t nReads = 0, nOpens = 0;
+   Double_t readTime = 0;
+   AliMixInputHandlerInfo *mihi = 0;
+   for (Int_t i = 0; i < fMixTrees.GetEntriesFast(); i++) {
+      mihi = (AliMixInputHandlerInfo *) fMixTrees.UncheckedAt(i);
+      if (!mihi) continue;
+      nReads += mihi->GetNumberOfReads();
+      nOpens += mihi->GetNumberOfFileOpens();
+      readTime += mihi->GetReadTime();
+   }
+   if (nReads <= 0) return;
+   AliInfo(Form("Mixed entries read: %lld, from already open file: %.1f%%, files opened: %lld, tree cache: %lld bytes",
+                nReads, 100.0 * (nReads - nOpens) / nReads, nOpens, fMixTreeCacheSize));
+   AliInfo(Form("Time in reading mixed entries: %.2f s (%.3f ms per entry)", readTime, 1000.0 * readTime / nReads));
+}
+
 //_____________________________________________________________________________
 void AliMixInputEventHandler::AddInputEventHandler(AliVEventHandler *)
 {
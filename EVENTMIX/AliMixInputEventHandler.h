@@ -36,6 +36,7 @@ public:
    virtual Bool_t  BeginEvent(Long64_t entry);
    virtual Bool_t  GetEntry();
    virtual Bool_t  FinishEvent();
+   virtual Bool_t  TerminateIO();
 
    // removing default impementation
    virtual void            AddInputEventHandler(AliVEventHandler */*inHandler*/);
@@ -70,6 +71,9 @@ public:
    Bool_t                  IsMixingIfNotEnoughEvents() { return fDoMixIfNotEnoughEvents;}
 
    void                    DoMixEventGetEntryAuto(Bool_t doAuto=kTRUE) { fDoMixEventGetEntryAuto = doAuto; }
+   void                    SetMixTreeCacheSize(Long64_t bytes) { fMixTreeCacheSize = bytes; }
+   Long64_t                GetMixTreeCacheSize() const { return fMixTreeCacheSize; }
+   void                    PrintMixReadStat();
 
    Bool_t                  GetEntryMainEvent();
    Bool_t                  GetEntryMixedEvent(Int_t idHandler=0);
@@ -89,6 +93,7 @@ private:
    Bool_t                  fDoMixExtra;            // mix extra events to get enough combinations
    Bool_t                  fDoMixIfNotEnoughEvents;// mix events if they don't have enough events to mix
    Bool_t                  fDoMixEventGetEntryAuto;// flag for preparing mixed events automatically (default on)
+   Long64_t                fMixTreeCacheSize;      // size of TTreeCache used to read mixed events (0 = off)
 
    // mixing info
    Long64_t fCurrentEntry;       //! current entry number (adds 1 for every event processed on each worker)
@@ -110,7 +115,7 @@ private:
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 6)
 };
 
 #endif
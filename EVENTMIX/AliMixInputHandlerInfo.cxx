@@ -7,6 +7,8 @@
 // author:
 //        Martin Vala (martin.vala@cern.ch)
 //
+#include <algorithm>
+
 #include <TTree.h>
 #include <TChain.h>
 #include <TFile.h>
@@ -24,11 +26,17 @@ AliMixInputHandlerInfo::AliMixInputHandlerInfo(const char *name, const char *tit
    fChain(0),
    fChainEntriesArray(),
    fZeroEntryNumber(0),
-   fNeedNotify(kFALSE)
+   fNeedNotify(kFALSE),
+   fChainEntriesSum(),
+   fTreeCacheSize(0),
+   fNReads(0),
+   fNFileOpens(0),
+   fReadTimer()
 {
    //
    // Default constructor.
    //
+   fReadTimer.Reset();
 }
 //_____________________________________________________________________________
 AliMixInputHandlerInfo::~AliMixInputHandlerInfo()
@@ -81,6 +89,10 @@ void AliMixInputHandlerInfo::AddTreeToChain(const char *path)
    fChainEntriesArray.Set(lastIndex);
    AliDebug(AliLog::kDebug + 3, Form("Adding %lld to id %d", fChain->GetTree()->GetEntries(), lastIndex - 1));
    fChainEntriesArray.AddAt((Int_t)fChain->GetTree()->GetEntries(), (Int_t)lastIndex - 1);
+   // first entry of every tree, for GetEntryInTree()
+   fChainEntriesSum.Set(lastIndex + 1);
+   fChainEntriesSum[0] = 0;
+   for (Int_t i = 0; i < lastIndex; i++) fChainEntriesSum[i + 1] = fChainEntriesSum[i] + fChainEntriesArray.At(i);
    AliDebug(AliLog::kDebug + 5, Form("-> %s", path));
 }
 
@@ -98,8 +110,24 @@ TChainElement *AliMixInputHandlerInfo::GetEntryInTree(Long64_t &entry)
       AliDebug(AliLog::kDebug + 5, "->");
       return 0;
    }
+   // last tree which starts at or before entry: upper bound minus one, so that
+   // empty trees (same first entry as the next tree) are skipped as in the loop below
+   Int_t n = fChainEntriesArray.GetSize();
+   if (fChainEntriesSum.GetSize() == n + 1) {
+      const Long64_t *sum = fChainEntriesSum.GetArray();
+      Int_t i = (Int_t)(std::upper_bound(sum, sum + n + 1, entry - fZeroEntryNumber) - sum) - 1;
+      if (i >= 0 && i < n) {
+         entry -= fZeroEntryNumber + fChainEntriesSum[i];
+         AliDebug(AliLog::kDebug + 1, Form("Entry in current tree num is %lld with i=%d", entry, i));
+         AliDebug(AliLog::kDebug + 5, "->");
+         return (TChainElement *) fChain->GetListOfFiles()->At(i);
+      }
+      entry = -1;
+      AliDebug(AliLog::kDebug + 5, "->");
+      return 0;
+   }
    Long64_t sumTree = fZeroEntryNumber;
-   for (Int_t i = 0; i < fChainEntriesArray.GetSize() ; i++) {
+   for (Int_t i = 0; i < n ; i++) {
       sumTree += fChainEntriesArray.At(i);
       if (sumTree > entry) {
          sumTree = entry - sumTree + fChainEntriesArray.At(i);
@@ -128,9 +156,7 @@ void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, Ali
    if (entry < 0) {
       AliDebug(AliLog::kDebug, Form("We are creating new chain from file %s ...", te->GetTitle()));
       if (!fChain) {
-         fChain = new TChain(te->GetName());
-         fChain->AddFile(te->GetTitle());
-         fChain->GetEntry(0);
+         fChain = OpenChain(te);
          eh->Init(opt);
          eh->Init(fChain->GetTree(), opt);
       }
@@ -139,6 +165,8 @@ void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, Ali
       return;
    }
    if (fChain) {
+      fReadTimer.Start(kFALSE);
+      fNReads++;
       AliDebug(AliLog::kDebug, Form("Filename is %s", fChain->GetTree()->GetCurrentFile()->GetName()));
       TString fn = fChain->GetTree()->GetCurrentFile()->GetName();
       if (fn.CompareTo(te->GetTitle())) {
@@ -146,9 +174,8 @@ void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, Ali
          AliDebug(AliLog::kDebug, Form("We are changing to file %s ...", te->GetTitle()));
          // change file
          delete fChain;
-         fChain = new TChain(te->GetName());
-         fChain->AddFile(te->GetTitle());
-         fChain->GetEntry(0);
+         fChain = OpenChain(te);
+         fNFileOpens++;
          eh->Init(opt);
          eh->Init(fChain->GetTree(), opt);
          eh->Notify(te->GetTitle());
@@ -164,6 +191,7 @@ void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, Ali
          eh->BeginEvent(entry);
          // file is in tree fChain already
       }
+      fReadTimer.Stop();
    }
    AliDebug(AliLog::kDebug, Form("We are USING file %s ...", te->GetTitle()));
    AliDebug(AliLog::kDebug, Form("We are USING file from fChain->GetTree() %s ...", fChain->GetTree()->GetCurrentFile()->GetName()));
@@ -180,3 +208,22 @@ Long64_t AliMixInputHandlerInfo::GetEntries()
    if (fChain) return fChain->GetEntries();
    return -1;
 }
+
+//_____________________________________________________________________________
+TChain *AliMixInputHandlerInfo::OpenChain(TChainElement *te)
+{
+   //
+   // Creates chain with file of te only. If fTreeCacheSize is set, all
+   // branches are read through a TTreeCache, so that one mixed entry is
+   // read in one vectored request instead of one seek per basket
+   //
+   TChain *chain = new TChain(te->GetName());
+   chain->AddFile(te->GetTitle());
+   if (fTreeCacheSize > 0) {
+      chain->SetCacheSize(fTreeCacheSize);
+      chain->AddBranchToCache("*", kTRUE);
+      chain->StopCacheLearningPhase();
+   }
+   chain->GetEntry(0);
+   return chain;
+}
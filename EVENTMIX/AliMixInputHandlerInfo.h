@@ -10,7 +10,9 @@
 #ifndef ALIMIXINPUTHANDLERINFO_H
 #define ALIMIXINPUTHANDLERINFO_H
 #include <TArrayI.h>
+#include <TArrayL64.h>
 #include <TNamed.h>
+#include <TStopwatch.h>
 
 class TTree;
 class TChain;
@@ -33,16 +35,31 @@ public:
    TChainElement *GetEntryInTree(Long64_t &entry);
    Long64_t      GetEntries();
 
+   // reading of mixed entries
+   void     SetTreeCacheSize(Long64_t bytes) { fTreeCacheSize = bytes; }
+   Long64_t GetTreeCacheSize() const { return fTreeCacheSize; }
+   Long64_t GetNumberOfReads() const { return fNReads; }
+   Long64_t GetNumberOfFileOpens() const { return fNFileOpens; }
+   Double_t GetReadTime() { return fReadTimer.RealTime(); }
+
 private:
    TChain    *fChain;              // current chain
    TArrayI   fChainEntriesArray;   // array of entries of every chaing
    Long64_t  fZeroEntryNumber;     // zero entry number (will be used when we will delete not needed chains)
    Bool_t    fNeedNotify;          // flag if Notify is needed for current input handler
 
+   TArrayL64  fChainEntriesSum;    //! first entry of every chain (+ total), for binary search
+   Long64_t   fTreeCacheSize;      // size of TTreeCache for mixed chains (0 = off)
+   Long64_t   fNReads;             //! number of mixed entries read
+   Long64_t   fNFileOpens;         //! number of files opened for mixed entries
+   TStopwatch fReadTimer;          //! time spent in reading mixed entries
+
+   TChain    *OpenChain(TChainElement *te);
+
    AliMixInputHandlerInfo(const AliMixInputHandlerInfo &handler);
    AliMixInputHandlerInfo &operator=(const AliMixInputHandlerInfo &handler);
 
-   ClassDef(AliMixInputHandlerInfo, 1); // Mix Input Handler info
+   ClassDef(AliMixInputHandlerInfo, 2); // Mix Input Handler info
 };
 
 #endif // ALIMIXINPUTHANDLERINFO_H
@@ -1,5 +1,6 @@
 #ifdef __CINT__
 
+#pragma link C++ class AliMixEntryList+;
 #pragma link C++ class AliMixEventCutObj+;
 #pragma link C++ class AliMixEventPool+;
 
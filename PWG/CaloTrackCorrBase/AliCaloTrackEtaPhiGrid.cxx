@@ -0,0 +1,234 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// --- ROOT system ---
+#include <TObjArray.h>
+#include <TMath.h>
+#include <algorithm>
+
+// --- AliRoot system ---
+#include "AliVTrack.h"
+#include "AliVCluster.h"
+#include "AliAODPWG4Particle.h"
+#include "AliMixedEvent.h"
+#include "AliLog.h"
+
+// --- CaloTrackCorrelations ---
+#include "AliCaloTrackReader.h"
+#include "AliCaloTrackEtaPhiGrid.h"
+
+/// \cond CLASSIMP
+ClassImp(AliCaloTrackEtaPhiGrid) ;
+/// \endcond
+
+//____________________________________________________
+/// Default constructor, 0.1 x 0.1 cells in |eta| < 1.
+//____________________________________________________
+AliCaloTrackEtaPhiGrid::AliCaloTrackEtaPhiGrid() :
+TObject(),
+fNEta(20), fEtaMin(-1.), fEtaMax(1.), fNPhi(63),
+fList(0x0), fFilled(kFALSE), fNObjects(0),
+fCellStart(), fCellObjects(), fObjectCell(),
+fMomentum(), fTrackVector()
+{
+  fCellStart.Set(fNEta*fNPhi+1);
+}
+
+//____________________________________________________________________________________________
+/// Constructor.
+/// \param nEta: number of eta bins between etaMin and etaMax.
+/// \param etaMin: lower eta edge, objects below are in the first bin.
+/// \param etaMax: upper eta edge, objects above are in the last bin.
+/// \param nPhi: number of phi bins in [0,2pi].
+//____________________________________________________________________________________________
+AliCaloTrackEtaPhiGrid::AliCaloTrackEtaPhiGrid(Int_t nEta, Float_t etaMin, Float_t etaMax, Int_t nPhi) :
+TObject(),
+fNEta(nEta > 0 ? nEta : 1), fEtaMin(etaMin), fEtaMax(etaMax > etaMin ? etaMax : etaMin+1.), fNPhi(nPhi > 0 ? nPhi : 1),
+fList(0x0), fFilled(kFALSE), fNObjects(0),
+fCellStart(), fCellObjects(), fObjectCell(),
+fMomentum(), fTrackVector()
+{
+  fCellStart.Set(fNEta*fNPhi+1);
+}
+
+//_________________________________________________________________________
+/// Calculate the eta and phi of the objects of the list and sort them by cell.
+/// \param list: CTS tracks or calorimeter clusters of the reader.
+/// \param reader: pointer to AliCaloTrackReader, needed for the cluster vertex.
+/// \return false if an object of unexpected type is found, the grid is not usable then.
+//_________________________________________________________________________
+Bool_t AliCaloTrackEtaPhiGrid::Fill(TObjArray * list, AliCaloTrackReader * reader)
+{
+  Reset();
+
+  if ( !list ) return kFALSE;
+
+  fNObjects = list->GetEntriesFast();
+
+  if ( fObjectCell .GetSize() < fNObjects ) fObjectCell .Set(fNObjects);
+  if ( fCellObjects.GetSize() < fNObjects ) fCellObjects.Set(fNObjects);
+
+  Int_t   nCells = fNEta*fNPhi;
+  Int_t * start  = fCellStart.GetArray();
+  for(Int_t icell = 0; icell <= nCells; icell++) start[icell] = 0;
+
+  Float_t eta = -100. ;
+  Float_t phi = -100. ;
+
+  for(Int_t ipr = 0; ipr < fNObjects; ipr++)
+  {
+    TObject * obj = list->At(ipr);
+
+    // Same kinematics as in AliIsolationCut::MakeIsolationCut
+    AliVTrack   * track = dynamic_cast<AliVTrack*>  (obj) ;
+    AliVCluster * calo  = 0x0;
+    if ( !track ) calo  = dynamic_cast<AliVCluster*>(obj) ;
+
+    if      ( track )
+    {
+      fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+      eta = fTrackVector.Eta();
+      phi = fTrackVector.Phi() ;
+    }
+    else if ( calo )
+    {
+      Int_t evtIndex = 0 ;
+      if (reader->GetMixedEvent())
+        evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+
+      calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+
+      eta = fMomentum.Eta() ;
+      phi = fMomentum.Phi() ;
+    }
+    else
+    {
+      AliAODPWG4Particle * mix = dynamic_cast<AliAODPWG4Particle*>(obj) ;
+      if ( !mix )
+      {
+        AliDebug(1,Form("Object %d of list %s of unexpected type, grid not used",ipr,list->GetName()));
+        return kFALSE;
+      }
+
+      eta = mix->Eta();
+      phi = mix->Phi() ;
+    }
+
+    if ( phi < 0 ) phi+=TMath::TwoPi();
+
+    Int_t icell = GetEtaBin(eta)*fNPhi + GetPhiBin(phi);
+    fObjectCell[ipr] = icell;
+    start[icell+1]++;
+  }
+
+  // Counting sort, keeps the list order inside each cell
+  for(Int_t icell = 0; icell < nCells; icell++) start[icell+1] += start[icell];
+
+  Int_t * cell    = fObjectCell .GetArray();
+  Int_t * objects = fCellObjects.GetArray();
+  for(Int_t ipr = 0; ipr < fNObjects; ipr++) objects[start[cell[ipr]]++] = ipr;
+
+  for(Int_t icell = nCells; icell > 0; icell--) start[icell] = start[icell-1];
+  start[0] = 0;
+
+  fList   = list;
+  fFilled = kTRUE;
+
+  return kTRUE;
+}
+
+//_________________________________________________________________________
+/// \return eta bin, objects out of the grid range are in the edge bins.
+//_________________________________________________________________________
+Int_t AliCaloTrackEtaPhiGrid::GetEtaBin(Float_t eta) const
+{
+  if ( !(eta > fEtaMin) ) return 0; // also NaN
+
+  Int_t bin = Int_t( (eta-fEtaMin) / (fEtaMax-fEtaMin) * fNEta );
+
+  if ( bin >= fNEta ) return fNEta-1;
+
+  return bin;
+}
+
+//_________________________________________________________________________
+/// \return phi bin, phi expected in [0,2pi], out of range in the edge bins.
+//_________________________________________________________________________
+Int_t AliCaloTrackEtaPhiGrid::GetPhiBin(Float_t phi) const
+{
+  if ( !(phi > 0) ) return 0; // also NaN
+
+  Int_t bin = Int_t( phi / TMath::TwoPi() * fNPhi );
+
+  if ( bin >= fNPhi ) return fNPhi-1;
+
+  return bin;
+}
+
+//_________________________________________________________________________
+/// \return true if the grid was filled with this list and its size did not change.
+//_________________________________________________________________________
+Bool_t AliCaloTrackEtaPhiGrid::IsFilled(const TObjArray * list) const
+{
+  return fFilled && list && fList == list && fNObjects == list->GetEntriesFast();
+}
+
+//_________________________________________________________________________
+/// Select the objects of the cells overlapping a window.
+/// \param etaMin, etaMax: eta range of the window.
+/// \param phiMin, phiMax: phi range of the window, not wrapped.
+/// \param bands: if false select the cells in both the eta and phi ranges (cone),
+///               if true the cells in the eta or in the phi range (cone and UE bands).
+/// \param indices: indices in the list of the selected objects, increasing, output.
+/// \return number of selected objects.
+//_________________________________________________________________________
+Int_t AliCaloTrackEtaPhiGrid::SelectObjects(Float_t etaMin, Float_t etaMax, Float_t phiMin, Float_t phiMax,
+                                            Bool_t bands, TArrayI & indices) const
+{
+  if ( indices.GetSize() < fNObjects ) indices.Set(fNObjects);
+
+  Int_t etaBinMin = GetEtaBin(etaMin);
+  Int_t etaBinMax = GetEtaBin(etaMax);
+  Int_t phiBinMin = GetPhiBin(phiMin);
+  Int_t phiBinMax = GetPhiBin(phiMax);
+
+  const Int_t * start   = fCellStart  .GetArray();
+  const Int_t * objects = fCellObjects.GetArray();
+  Int_t       * out     = indices     .GetArray();
+
+  Int_t n = 0;
+  for(Int_t ieta = 0; ieta < fNEta; ieta++)
+  {
+    Bool_t inEta = (ieta >= etaBinMin && ieta <= etaBinMax);
+
+    if ( !bands && !inEta ) continue;
+
+    for(Int_t iphi = 0; iphi < fNPhi; iphi++)
+    {
+      Bool_t inPhi = (iphi >= phiBinMin && iphi <= phiBinMax);
+
+      if (  bands && !inEta && !inPhi ) continue;
+      if ( !bands && !inPhi ) continue;
+
+      Int_t icell = ieta*fNPhi + iphi;
+      for(Int_t i = start[icell]; i < start[icell+1]; i++) out[n++] = objects[i];
+    }
+  }
+
+  // Same order as the list
+  std::sort(out, out+n);
+
+  return n;
+}
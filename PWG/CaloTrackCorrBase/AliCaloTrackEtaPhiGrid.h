@@ -0,0 +1,95 @@
+#ifndef ALICALOTRACKETAPHIGRID_H
+#define ALICALOTRACKETAPHIGRID_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliCaloTrackEtaPhiGrid
+/// \brief Eta-phi binned index of the tracks or clusters of a reader list.
+///
+/// Filled once per event by AliCaloTrackReader for its CTS, EMCAL or PHOS
+/// list, the objects are sorted by (eta,phi) cell so that the isolation
+/// code only visits the objects of the cells overlapping the cone or the
+/// UE bands instead of the full list. The eta and phi of each object are
+/// calculated as in AliIsolationCut::MakeIsolationCut, and the selected
+/// indices are returned in increasing order, so that sums over the selected
+/// objects are done in the same order as over the full list.
+//_________________________________________________________________________
+
+// --- ROOT system ---
+#include <TObject.h>
+#include <TArrayI.h>
+#include <TLorentzVector.h>
+class TObjArray ;
+
+// --- ANALYSIS system ---
+class AliCaloTrackReader ;
+
+class AliCaloTrackEtaPhiGrid : public TObject {
+
+ public:
+
+  AliCaloTrackEtaPhiGrid() ; // default ctor
+
+  AliCaloTrackEtaPhiGrid(Int_t nEta, Float_t etaMin, Float_t etaMax, Int_t nPhi) ; // ctor
+
+  /// Virtual destructor.
+  virtual ~AliCaloTrackEtaPhiGrid() { ; }
+
+  Bool_t     Fill(TObjArray * list, AliCaloTrackReader * reader) ;
+
+  /// Forget the list of the previous event.
+  void       Reset()                            { fList = 0x0 ; fFilled = kFALSE ; }
+
+  /// \return true if the grid was filled with this list and it did not change since.
+  Bool_t     IsFilled(const TObjArray * list) const ;
+
+  Int_t      SelectObjects(Float_t etaMin, Float_t etaMax, Float_t phiMin, Float_t phiMax,
+                           Bool_t bands, TArrayI & indices) const ;
+
+  Int_t      GetEtaBin(Float_t eta)       const ;
+  Int_t      GetPhiBin(Float_t phi)       const ;
+
+  Int_t      GetNEtaBins()                const { return fNEta       ; }
+  Int_t      GetNPhiBins()                const { return fNPhi       ; }
+  Int_t      GetNObjects()                const { return fNObjects   ; }
+
+ private:
+
+  Int_t      fNEta;              ///< Number of eta bins.
+
+  Float_t    fEtaMin;            ///< Lower eta edge, objects below are in the first bin.
+
+  Float_t    fEtaMax;            ///< Upper eta edge, objects above are in the last bin.
+
+  Int_t      fNPhi;              ///< Number of phi bins in [0,2pi].
+
+  const TObjArray * fList;       //!<! List the grid was filled with.
+
+  Bool_t     fFilled;            //!<! Grid filled for fList.
+
+  Int_t      fNObjects;          //!<! Number of entries of fList when filled.
+
+  TArrayI    fCellStart;         //!<! Position of the first object of each cell in fCellObjects, nEta*nPhi+1 entries.
+
+  TArrayI    fCellObjects;       //!<! Indices in fList of the objects, sorted by cell and by index in each cell.
+
+  TArrayI    fObjectCell;        //!<! Cell of each object of fList.
+
+  TLorentzVector fMomentum;      //!<! Momentum of cluster, temporal object.
+
+  TVector3   fTrackVector;       //!<! Track moment, temporal object.
+
+  /// Copy constructor not implemented.
+  AliCaloTrackEtaPhiGrid(              const AliCaloTrackEtaPhiGrid & g) ;
+
+  /// Assignment operator not implemented.
+  AliCaloTrackEtaPhiGrid & operator = (const AliCaloTrackEtaPhiGrid & g) ;
+
+  /// \cond CLASSIMP
+  ClassDef(AliCaloTrackEtaPhiGrid,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALICALOTRACKETAPHIGRID_H
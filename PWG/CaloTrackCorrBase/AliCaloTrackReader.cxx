@@ -47,6 +47,7 @@
 // ---- CaloTrackCorr ---
 #include "AliCalorimeterUtils.h"
 #include "AliCaloTrackReader.h"
+#include "AliCaloTrackEtaPhiGrid.h"
 
 // ---- Jets ----
 #include "AliAODJet.h"
@@ -134,7 +135,9 @@ fFillInputBackgroundJetBranch(kFALSE),
 fBackgroundJets(0x0),fInputBackgroundJetBranchName("jets"),
 fAcceptEventsWithBit(0),     fRejectEventsWithBit(0),         fRejectEMCalTriggerEventsWith2Tresholds(0),
 fMomentum(),                 fOutputContainer(0x0),           fEnergyHistogramNbins(0),
-fhNEventsAfterCut(0),        fNMCGenerToAccept(0),            fMCGenerEventHeaderToAccept("")
+fhNEventsAfterCut(0),        fNMCGenerToAccept(0),            fMCGenerEventHeaderToAccept(""),
+fUseEtaPhiGrid(kTRUE),       fCTSGrid(0x0),                   fEMCALGrid(0x0),
+fPHOSGrid(0x0)
 {
   for(Int_t i = 0; i < 8; i++) fhEMCALClusterCutsE [i]= 0x0 ;    
   for(Int_t i = 0; i < 7; i++) fhPHOSClusterCutsE  [i]= 0x0 ;  
@@ -214,6 +217,10 @@ void AliCaloTrackReader::DeletePointers()
   }
   delete fBackgroundJets ;
 
+  delete fCTSGrid   ;
+  delete fEMCALGrid ;
+  delete fPHOSGrid  ;
+
   fRejectEventsWithBit.Reset();
   fAcceptEventsWithBit.Reset();
   
@@ -3008,6 +3015,7 @@ void AliCaloTrackReader::Print(const Option_t * opt) const
   printf("Use PHOS        =     %d\n",     fFillPHOS) ;
   printf("Use EMCAL Cells =     %d\n",     fFillEMCALCells) ;
   printf("Use PHOS  Cells =     %d\n",     fFillPHOSCells) ;
+  printf("Use eta-phi grid =    %d\n",     fUseEtaPhiGrid) ;
   printf("Track status    =     %d\n", (Int_t) fTrackStatus) ;
 
   printf("Track Mult Eta Cut =  %2.2f\n",  fTrackMultEtaCut) ;
@@ -3112,6 +3120,10 @@ void AliCaloTrackReader::ResetLists()
   if(fEMCALClusters)   fEMCALClusters -> Clear("C");
   if(fPHOSClusters)    fPHOSClusters  -> Clear("C");
   
+  if(fCTSGrid)         fCTSGrid       -> Reset();
+  if(fEMCALGrid)       fEMCALGrid     -> Reset();
+  if(fPHOSGrid)        fPHOSGrid      -> Reset();
+  
   fV0ADC[0] = 0;   fV0ADC[1] = 0;
   fV0Mul[0] = 0;   fV0Mul[1] = 0;
   
@@ -3119,6 +3131,32 @@ void AliCaloTrackReader::ResetLists()
   fBackgroundJets->Reset();
 }
 
+//___________________________________________________________________________
+/// Eta-phi binned index of one of the CTS, EMCAL or PHOS arrays of the event,
+/// filled on the first request in the event.
+/// \param list: array of tracks or clusters.
+/// \return the index, or null if the list is not an array of this reader,
+/// the grid is switched off or the list contains objects of unexpected type.
+//___________________________________________________________________________
+AliCaloTrackEtaPhiGrid * AliCaloTrackReader::GetEtaPhiGrid(TObjArray * list)
+{
+  if ( !fUseEtaPhiGrid || !list ) return 0x0;
+  
+  AliCaloTrackEtaPhiGrid ** grid = 0x0;
+  if      ( list == fCTSTracks     ) grid = &fCTSGrid;
+  else if ( list == fEMCALClusters ) grid = &fEMCALGrid;
+  else if ( list == fPHOSClusters  ) grid = &fPHOSGrid;
+  else return 0x0;
+  
+  if ( !(*grid) ) (*grid) = new AliCaloTrackEtaPhiGrid();
+  
+  if ( (*grid)->IsFilled(list) ) return (*grid);
+  
+  if ( !(*grid)->Fill(list, this) ) return 0x0;
+  
+  return (*grid);
+}
+
 //___________________________________________
 /// Tag event depending on trigger name.
 /// Set also the L1 bit defining the EGA or EJE triggers.
@@ -51,6 +51,7 @@ class AliVCluster;
 #include "AliFiducialCut.h"
 class AliCalorimeterUtils;
 #include "AliAnaWeights.h"
+class AliCaloTrackEtaPhiGrid;
 
 // Jets
 class AliAODJetEventBackground;
@@ -299,6 +300,13 @@ public:
   virtual TObjArray*     GetPHOSClusters()           const { return fPHOSClusters           ; }
   virtual AliVCaloCells* GetEMCALCells()             const { return fEMCALCells             ; }
   virtual AliVCaloCells* GetPHOSCells()              const { return fPHOSCells              ; }
+
+  // Eta-phi binned index of the arrays, filled on first request in the event
+  
+  AliCaloTrackEtaPhiGrid* GetEtaPhiGrid(TObjArray * list) ;
+  void             SwitchOnEtaPhiGrid()                    { fUseEtaPhiGrid = kTRUE        ; }
+  void             SwitchOffEtaPhiGrid()                   { fUseEtaPhiGrid = kFALSE       ; }
+  Bool_t           IsEtaPhiGridOn()                  const { return fUseEtaPhiGrid         ; }
   
   //-------------------------------------
   // Event/track selection methods
@@ -953,6 +961,11 @@ public:
 
   TString          fMCGenerEventHeaderToAccept;    ///<  Accept events that contain at least this event header name
   
+  Bool_t           fUseEtaPhiGrid;                 ///<  Publish eta-phi binned index of the CTS, EMCAL and PHOS arrays.
+  AliCaloTrackEtaPhiGrid * fCTSGrid;               //!<! Eta-phi binned index of CTS tracks.
+  AliCaloTrackEtaPhiGrid * fEMCALGrid;             //!<! Eta-phi binned index of EMCAL clusters.
+  AliCaloTrackEtaPhiGrid * fPHOSGrid;              //!<! Eta-phi binned index of PHOS clusters.
+  
   /// Copy constructor not implemented.
   AliCaloTrackReader(              const AliCaloTrackReader & r) ; 
   
@@ -960,7 +973,7 @@ public:
   AliCaloTrackReader & operator = (const AliCaloTrackReader & r) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliCaloTrackReader,76) ;
+  ClassDef(AliCaloTrackReader,77) ;
   /// \endcond
 
 } ;
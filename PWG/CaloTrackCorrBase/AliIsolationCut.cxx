@@ -27,6 +27,7 @@
 
 // --- CaloTrackCorrelations --- 
 #include "AliCaloTrackReader.h"
+#include "AliCaloTrackEtaPhiGrid.h"
 #include "AliCalorimeterUtils.h"
 #include "AliCaloPID.h"
 #include "AliFiducialCut.h"
@@ -54,7 +55,8 @@ fFracIsThresh(1),
 fIsTMClusterInConeRejected(1),
 fDistMinToTrigger(-1.),
 fMomentum(),
-fTrackVector()
+fTrackVector(),
+fGridIndices()
 {
   InitParameters();
 }
@@ -375,6 +377,45 @@ TString AliIsolationCut::GetICParametersList()
   return parList;
 }
 
+//_________________________________________________________________________________________________
+/// Select the tracks or clusters of a list to be checked for a candidate.
+/// If the reader provides an eta-phi grid of the list, only the objects of the
+/// cells overlapping the cone are kept, or the cone and the UE bands when these are
+/// needed (kSumBkgSubIC), otherwise all the objects of the list. The exact cone and
+/// band selection is done afterwards, the indices are in fGridIndices in increasing order.
+/// \param list: list of tracks or clusters.
+/// \param reader: pointer to AliCaloTrackReader, provides the grid.
+/// \param etaC: pseudorapidity of candidate particle.
+/// \param phiC: azimuthal angle of candidate particle, in [0,2pi].
+/// \return number of objects to check.
+//_________________________________________________________________________________________________
+Int_t AliIsolationCut::GetObjectsToCheck(TObjArray * list, AliCaloTrackReader * reader,
+                                         Float_t etaC, Float_t phiC)
+{
+  Int_t nObjects = list->GetEntries();
+  
+  AliCaloTrackEtaPhiGrid * grid = reader->GetEtaPhiGrid(list);
+  
+  if ( grid )
+  {
+    // Window slightly larger than the cone, to be safe with rounding
+    Float_t size = fConeSize + 0.01;
+    
+    Int_t n = grid->SelectObjects(etaC-size, etaC+size, phiC-size, phiC+size,
+                                  (fICMethod == kSumBkgSubIC), fGridIndices);
+    
+    AliDebug(1,Form("Check %d objects out of %d in %s",n,nObjects,list->GetName()));
+    
+    return n;
+  }
+  
+  if ( fGridIndices.GetSize() < nObjects ) fGridIndices.Set(nObjects);
+  
+  for(Int_t i = 0; i < nObjects; i++) fGridIndices[i] = i;
+  
+  return nObjects;
+}
+
 //____________________________________
 // Initialize the parameters of the analysis.
 //____________________________________
@@ -460,8 +501,13 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   if(plCTS &&
      (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged))
   {
-    for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
+    // Only the tracks of the grid cells around the candidate if the reader provides them
+    Int_t nTracks = GetObjectsToCheck(plCTS, reader, etaC, phiC);
+    
+    for(Int_t itr = 0;itr < nTracks ; itr ++ )
     {
+      Int_t ipr = fGridIndices[itr];
+      
       AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
       
       if(track)
@@ -606,8 +652,13 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
      (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged))
   {
     
-    for(Int_t ipr = 0;ipr < plNe->GetEntries() ; ipr ++ )
+    // Only the clusters of the grid cells around the candidate if the reader provides them
+    Int_t nClusters = GetObjectsToCheck(plNe, reader, etaC, phiC);
+    
+    for(Int_t icl = 0;icl < nClusters ; icl ++ )
     {
+      Int_t ipr = fGridIndices[icl];
+      
       AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
       
       if(calo)
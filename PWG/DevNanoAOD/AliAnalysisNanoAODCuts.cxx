@@ -11,9 +11,32 @@ ClassImp(AliNanoAODSimpleSetter)
 
 
 AliAnalysisNanoAODTrackCuts::AliAnalysisNanoAODTrackCuts():
-AliAnalysisCuts(), fBitMask(1), fMinPt(0), fMaxEta(10)
+AliAnalysisCuts(), fBitMask(1), fMinPt(0), fMaxEta(10),
+  fAdaptiveOrder(kTRUE),
+  fSelectedTracks(),
+  fCandidates(),
+  fNSelected(0),
+  fSelectionEvent(0),
+  fStopwatch()
 {
   // default ctor 
+  for (Int_t icut = 0; icut < kNCuts; icut++) {
+    fOrder[icut]      = icut;
+    fNEvaluated[icut] = 0;
+    fNRejected[icut]  = 0;
+    fCutTime[icut]    = 0;
+  }
+}
+
+Bool_t AliAnalysisNanoAODTrackCuts::PassCut(Int_t icut, AliAODTrack* track) const
+{
+  // Evaluates a single cut, negating the rejection conditions of the original IsSelected (a NaN pt or eta passes)
+  switch (icut) {
+  case kFilterBit : return track->TestFilterBit(fBitMask);
+  case kPt        : return !(track->Pt() < fMinPt);
+  case kEta       : return !(TMath::Abs(track->Eta()) > fMaxEta);
+  default         : return kTRUE;
+  }
 }
 
 Bool_t AliAnalysisNanoAODTrackCuts::IsSelected(TObject* obj)
@@ -21,15 +44,103 @@ Bool_t AliAnalysisNanoAODTrackCuts::IsSelected(TObject* obj)
   // Returns true if the track is good!
   AliAODTrack* track = dynamic_cast<AliAODTrack*>(obj);
   
-  
-  if (!track->TestFilterBit(fBitMask))    return kFALSE;
-  if (track->Pt() < fMinPt)               return kFALSE;
-  if (TMath::Abs(track->Eta()) > fMaxEta) return kFALSE; 
+  for (Int_t iorder = 0; iorder < kNCuts; iorder++) {
+    Int_t icut = fOrder[iorder];
+    fNEvaluated[icut]++;
+    if (!PassCut(icut, track)) {
+      fNRejected[icut]++;
+      return kFALSE;
+    }
+  }
   
   return kTRUE;  
 
 }
 
+Int_t AliAnalysisNanoAODTrackCuts::SelectTracks(const AliAODEvent* evt)
+{
+  // Selects all the tracks of the event in one go: each cut is applied
+  // to the block of tracks which survived the previous ones. This
+  // short-circuits like IsSelected, keeps each cut in a tight loop and
+  // allows the time spent in each cut to be measured. The result is
+  // kept until ResetSelection or the next call, and can be queried with
+  // IsTrackSelected. Returns the number of selected tracks.
+
+  const Int_t ntracks = evt->GetNumberOfTracks();
+  fSelectedTracks.ResetAllBits();
+  if (fCandidates.GetSize() < ntracks) fCandidates.Set(ntracks);
+
+  Int_t * candidates = fCandidates.GetArray();
+  Int_t ncandidates = ntracks;
+  for (Int_t j = 0; j < ntracks; j++) candidates[j] = j;
+
+  for (Int_t iorder = 0; iorder < kNCuts && ncandidates > 0; iorder++) {
+    Int_t icut = fOrder[iorder];
+    fStopwatch.Start(kTRUE);
+    Int_t nsurvivors = 0;
+    for (Int_t k = 0; k < ncandidates; k++) {
+      AliAODTrack * track = (AliAODTrack*) evt->GetTrack(candidates[k]);
+      if (PassCut(icut, track)) candidates[nsurvivors++] = candidates[k];
+    }
+    fStopwatch.Stop();
+    fCutTime[icut]    += fStopwatch.RealTime();
+    fNEvaluated[icut] += ncandidates;
+    fNRejected[icut]  += ncandidates - nsurvivors;
+    ncandidates = nsurvivors;
+  }
+
+  for (Int_t k = 0; k < ncandidates; k++) fSelectedTracks.SetBitNumber(candidates[k]);
+  fNSelected      = ncandidates;
+  fSelectionEvent = evt;
+
+  if (fAdaptiveOrder) UpdateOrder();
+
+  return fNSelected;
+}
+
+void AliAnalysisNanoAODTrackCuts::UpdateOrder()
+{
+  // Orders the cuts by increasing cost per rejected track (time per
+  // evaluation / rejection probability), which minimises the expected
+  // evaluation time of a short-circuited chain of independent cuts.
+  // Cuts which were never evaluated or never rejected anything go last.
+  Double_t rank[kNCuts];
+  for (Int_t icut = 0; icut < kNCuts; icut++) {
+    if (fNEvaluated[icut] == 0 || fNRejected[icut] == 0) {
+      rank[icut] = 1e30;
+      continue;
+    }
+    Double_t cost      = fCutTime[icut] / fNEvaluated[icut];
+    Double_t rejection = Double_t(fNRejected[icut]) / fNEvaluated[icut];
+    rank[icut] = cost / rejection;
+  }
+
+  // insertion sort, stable with respect to the current order
+  for (Int_t i = 1; i < kNCuts; i++) {
+    Int_t icut = fOrder[i];
+    Int_t j = i - 1;
+    while (j >= 0 && rank[fOrder[j]] > rank[icut]) {
+      fOrder[j+1] = fOrder[j];
+      j--;
+    }
+    fOrder[j+1] = icut;
+  }
+}
+
+void AliAnalysisNanoAODTrackCuts::Print(Option_t* /*option*/) const
+{
+  // Prints the settings and the statistics of the individual cuts
+  static const char * kCutNames[kNCuts] = { "FilterBit", "Pt", "Eta" };
+
+  Printf("AliAnalysisNanoAODTrackCuts %s: bit mask %u, min pt %f, max eta %f", GetName(), fBitMask, fMinPt, fMaxEta);
+  Printf(" %-10s %15s %15s %10s %12s", "cut", "evaluated", "rejected", "rej. [%]", "time [s]");
+  for (Int_t iorder = 0; iorder < kNCuts; iorder++) {
+    Int_t icut = fOrder[iorder];
+    Printf(" %-10s %15lld %15lld %10.2f %12.4f", kCutNames[icut], fNEvaluated[icut], fNRejected[icut],
+	   fNEvaluated[icut] > 0 ? 100. * fNRejected[icut] / fNEvaluated[icut] : 0., fCutTime[icut]);
+  }
+}
+
 AliAnalysisNanoAODEventCuts::AliAnalysisNanoAODEventCuts():
   AliAnalysisCuts(), 
   fVertexRange(-1),
@@ -67,9 +178,15 @@ Bool_t AliAnalysisNanoAODEventCuts::IsSelected(TObject* obj)
   if (fTrackCut != 0)
   {
     Int_t trackCount = 0;
-    for (Int_t j=0; j<evt->GetNumberOfTracks(); j++)
-      if (fTrackCut->IsSelected(evt->GetTrack(j)))
-        trackCount++;
+    AliAnalysisNanoAODTrackCuts * nanoTrackCut = dynamic_cast<AliAnalysisNanoAODTrackCuts*>(fTrackCut);
+    if (nanoTrackCut) {
+      // block selection, kept for the replicator if it uses the same cut object
+      trackCount = nanoTrackCut->SelectTracks(evt);
+    } else {
+      for (Int_t j=0; j<evt->GetNumberOfTracks(); j++)
+        if (fTrackCut->IsSelected(evt->GetTrack(j)))
+          trackCount++;
+    }
       
     if (fMinMultiplicity > 0 && trackCount < fMinMultiplicity)
       return kFALSE;
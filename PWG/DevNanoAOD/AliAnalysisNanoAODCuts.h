@@ -1,32 +1,69 @@
 #ifndef _ALIANALYSISNANOAODCUTSANDSETTERS_H_
 #define _ALIANALYSISNANOAODCUTSANDSETTERS_H_
 
+#include "TBits.h"
+#include "TArrayI.h"
+#include "TStopwatch.h"
 #include "AliAnalysisCuts.h"
 #include "AliNanoAODCustomSetter.h"
 #include "AliNanoAODCustomSetter.h"
 
+class AliAODEvent;
+class AliAODTrack;
+
 class AliAnalysisNanoAODTrackCuts : public AliAnalysisCuts
 {
 public:
+  // Individual cuts, evaluated in the order given by fOrder
+  enum { kFilterBit = 0, kPt, kEta, kNCuts };
+
   AliAnalysisNanoAODTrackCuts();
   virtual ~AliAnalysisNanoAODTrackCuts()  {}
   virtual Bool_t IsSelected(TObject* obj); // TObject should be an AliAODTrack
   virtual Bool_t IsSelected(TList*   /* list */ ) { return kTRUE; }
+  virtual void   Print(Option_t* option = "") const;
   UInt_t GetBitMask() { return fBitMask; }
   void  SetBitMask (UInt_t var) { fBitMask = var;}
   Float_t GetMinPt() { return fMinPt; }
   void  SetMinPt (Float_t var) { fMinPt = var;}
   Float_t GetMaxEta() { return fMaxEta; }
   void  SetMaxEta (Float_t var) { fMaxEta = var;}
+  Bool_t GetAdaptiveOrder() { return fAdaptiveOrder; }
+  void  SetAdaptiveOrder (Bool_t var) { fAdaptiveOrder = var;}
+
+  // Block selection of all the tracks of an event (see SelectTracks)
+  Int_t  SelectTracks(const AliAODEvent* evt);
+  Bool_t HasSelection(const AliAODEvent* evt) const { return fSelectionEvent == evt; }
+  Bool_t IsTrackSelected(Int_t i) const { return fSelectedTracks.TestBitNumber(i); }
+  Int_t  GetNSelected() const { return fNSelected; }
+  void   ResetSelection() { fSelectionEvent = 0; }
+
+  // Statistics of the individual cuts
+  Long64_t GetNEvaluated(Int_t icut) const { return fNEvaluated[icut]; }
+  Long64_t GetNRejected(Int_t icut)  const { return fNRejected[icut]; }
+  Double_t GetCutTime(Int_t icut)    const { return fCutTime[icut]; }
 
 private:
+  Bool_t PassCut(Int_t icut, AliAODTrack* track) const;
+  void   UpdateOrder();
+
   UInt_t fBitMask; // Only AOD tracks matching this bit mask are accepted
   Float_t fMinPt; // miminum pt of the tracks
   Float_t fMaxEta; // MaxEta
 
+  Bool_t   fAdaptiveOrder;       // reorder the cuts according to their measured rejection and cost
+  Int_t    fOrder[kNCuts];       // evaluation order of the cuts
+  Long64_t fNEvaluated[kNCuts];  // number of tracks each cut was evaluated on
+  Long64_t fNRejected[kNCuts];   // number of tracks rejected by each cut
+  Double_t fCutTime[kNCuts];     // time (s) spent in each cut in SelectTracks
 
+  TBits               fSelectedTracks; //! selected tracks of the last SelectTracks call
+  TArrayI             fCandidates;     //! tracks surviving the cuts evaluated so far
+  Int_t               fNSelected;      //! number of selected tracks of the last SelectTracks call
+  const AliAODEvent * fSelectionEvent; //! event of the last SelectTracks call, 0 if reset
+  TStopwatch          fStopwatch;      //! timer of the individual cuts
 
-  ClassDef(AliAnalysisNanoAODTrackCuts,1); // track cut object for nano AOD filtering
+  ClassDef(AliAnalysisNanoAODTrackCuts,2); // track cut object for nano AOD filtering
 };
 
 class AliAnalysisNanoAODEventCuts : public AliAnalysisCuts
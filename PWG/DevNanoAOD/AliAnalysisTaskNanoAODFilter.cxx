@@ -41,6 +41,7 @@
 #include "AliAODHandler.h"
 #include "AliNanoAODReplicator.h"
 #include "AliNanoAODTrackMapping.h"
+#include "AliAnalysisNanoAODCuts.h"
 
 using std::cout;
 using std::endl;
@@ -57,7 +58,8 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter() // All data members
   fEvtCuts(0),
   fTrkCuts(0),
   fSetter(0),
-  fSaveCutsFlag(0)
+  fSaveCutsFlag(0),
+  fColumnarTracks(0)
 {
   // Dummy constructor ALWAYS needed for I/O.
 }
@@ -71,7 +73,8 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter(const char *name, Boo
    fEvtCuts(0),
    fTrkCuts(0),
    fSetter(0),
-   fSaveCutsFlag(saveCutsFlag)
+   fSaveCutsFlag(saveCutsFlag),
+   fColumnarTracks(0)
      
 {
   // Constructor
@@ -125,11 +128,13 @@ void AliAnalysisTaskNanoAODFilter::AddFilteredAOD(const char* aodfilename, const
      
   cout<<"rep: "<<rep<<endl;
   rep->SetCustomSetter(fSetter);
+  rep->SetColumnarTracks(fColumnarTracks);
   std::cout << "SETTER: " << fSetter << " " << rep->GetCustomSetter() << std::endl;
   
   ext->DropUnspecifiedBranches(); // all branches not part of a FilterBranch call (below) will be dropped
       
   ext->FilterBranch("tracks",rep);
+  if (fColumnarTracks) ext->FilterBranch("trackColumns",rep);
   ext->FilterBranch("vertices",rep);  
   ext->FilterBranch("header",rep);  
             
@@ -163,6 +168,10 @@ void AliAnalysisTaskNanoAODFilter::UserExec(Option_t *)
   if(fDebug)printf("Nano AOD Filter: Analysing event # %5d\n", (Int_t) ientry);
 
   AliAODEvent *lAODevent=(AliAODEvent*)InputEvent();
+
+  // The input event object is reused: make sure no track selection of the previous event is used
+  AliAnalysisNanoAODTrackCuts * nanoTrkCuts = dynamic_cast<AliAnalysisNanoAODTrackCuts*>(fTrkCuts);
+  if(nanoTrkCuts) nanoTrkCuts->ResetSelection();
   
     
   AliAODHandler* handler = dynamic_cast<AliAODHandler*>(AliAnalysisManager::GetAnalysisManager()->GetOutputEventHandler());
@@ -201,4 +210,7 @@ void AliAnalysisTaskNanoAODFilter::FinishTaskOutput() {
   AliAODExtension *extNanoAOD = handler->GetFilteredAOD("AliAOD.NanoAOD.root");
   extNanoAOD->GetTree()->GetUserInfo()->Add(AliNanoAODTrackMapping::GetInstance());
 
+  // Per-cut rejection and timing statistics (also saved with the cuts if fSaveCutsFlag is set)
+  if(fTrkCuts) fTrkCuts->Print();
+
 }
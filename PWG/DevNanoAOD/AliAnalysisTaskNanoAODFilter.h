@@ -47,12 +47,14 @@ public:
   TString                     GetVarList() { return fVarList; }
   TString                     GetVarListHead() { return fVarListHead; }
   Bool_t                      GetSaveCutsFlag() { return fSaveCutsFlag; }
+  Bool_t                      GetColumnarTracks() { return fColumnarTracks; }
 
   void  SetEvtCuts     (AliAnalysisCuts * var           ) { fEvtCuts = var;}
   void  SetTrkCuts     (AliAnalysisCuts * var           ) { fTrkCuts = var;}
   void  SetSetter      (AliNanoAODCustomSetter * var    ) { fSetter = var;}
   void  SetVarList     (TString var                     ) { fVarList = var;}
   void  SetVarListHead (TString var                     ) { fVarListHead = var;}
+  void  SetColumnarTracks (Bool_t var = kTRUE           ) { fColumnarTracks = var;}
     
 private:
   Int_t fMCMode; // true if processing monte carlo. if > 1 not all MC particles are filtered
@@ -65,12 +67,13 @@ private:
   AliNanoAODCustomSetter * fSetter; // setter for custom variables
   
   Bool_t fSaveCutsFlag; // If true, the event and track cuts are saved to disk. Can only be set in the constructor.
+  Bool_t fColumnarTracks; // If true, tracks are written in columns (AliNanoAODTrackColumns) instead of AliNanoAODTrack objects
 
   
   AliAnalysisTaskNanoAODFilter(const AliAnalysisTaskNanoAODFilter&); // not implemented
   AliAnalysisTaskNanoAODFilter& operator=(const AliAnalysisTaskNanoAODFilter&); // not implemented
     
-  ClassDef(AliAnalysisTaskNanoAODFilter, 1); // example of analysis
+  ClassDef(AliAnalysisTaskNanoAODFilter, 2); // example of analysis
 };
 
 #endif
@@ -49,6 +49,8 @@
 #include <iostream>
 #include "AliNanoAODHeader.h"
 #include "AliNanoAODTrack.h"
+#include "AliNanoAODTrackColumns.h"
+#include "AliNanoAODTrackView.h"
 
 using namespace AliHelperPIDNameSpace;
 using namespace std;
@@ -238,9 +240,19 @@ void AliAnalysisTaskSpectraAllChNanoAOD::UserExec(Option_t *)
   //main loop on tracks
   
   Int_t Nch = 0.;
+
+  // Columnar nanoAODs are read through a single track view, without creating track objects
+  AliNanoAODTrackColumns * trackColumns = isNano ? dynamic_cast<AliNanoAODTrackColumns*>(fAOD->FindListObject("trackColumns")) : 0x0;
+  AliNanoAODTrackView trackView(trackColumns);
+  const Int_t nTracks = trackColumns ? trackColumns->GetNTracks() : fAOD->GetNumberOfTracks();
   
-  for (Int_t iTracks = 0; iTracks < fAOD->GetNumberOfTracks(); iTracks++) {
-    AliVTrack* track = (AliVTrack*) fAOD->GetTrack(iTracks);
+  for (Int_t iTracks = 0; iTracks < nTracks; iTracks++) {
+    AliVTrack* track = 0x0;
+    if(trackColumns) {
+      trackView.SetIndex(iTracks);
+      track = &trackView;
+    }
+    else track = (AliVTrack*) fAOD->GetTrack(iTracks);
     if(fCharge != 0 && track->Charge() != fCharge) continue;//if fCharge != 0 only select fCharge 
     if(!isNano) {
       if (!fTrackCuts->IsSelected((AliAODTrack*)track,kTRUE)) continue; //track selection (rapidity selection NOT in the standard cuts)
@@ -249,7 +261,8 @@ void AliAnalysisTaskSpectraAllChNanoAOD::UserExec(Option_t *)
     if(!fFillOnlyEvents){
       Int_t IDrec=isNano ? GetNanoTrackID (track) : fHelperPID->GetParticleSpecies(track,kTRUE);//id from detector      
       Double_t y= 0;
-      if(isNano) y = ((AliNanoAODTrack*)track)->Y(fHelperPID->GetMass((AliHelperParticleSpecies_t)IDrec));
+      if(trackColumns) y = trackView.Y(fHelperPID->GetMass((AliHelperParticleSpecies_t)IDrec));
+      else if(isNano) y = ((AliNanoAODTrack*)track)->Y(fHelperPID->GetMass((AliHelperParticleSpecies_t)IDrec));
       else y = ((AliAODTrack*)track)->Y(fHelperPID->GetMass((AliHelperParticleSpecies_t)IDrec));
       Int_t IDgen=kSpUndefined;//set if MC
       Int_t isph=-999;
@@ -323,7 +336,8 @@ void   AliAnalysisTaskSpectraAllChNanoAOD::Terminate(Option_t *)
 Int_t AliAnalysisTaskSpectraAllChNanoAOD::GetNanoTrackID(AliVTrack * track) {
   // Applies nsigma PID to nano tracks
   AliNanoAODTrack * nanoTrack = dynamic_cast<AliNanoAODTrack*>(track);
-  if(!nanoTrack) AliFatal("Not a nano AOD track");
+  AliNanoAODTrackView * nanoView = nanoTrack ? 0x0 : dynamic_cast<AliNanoAODTrackView*>(track);
+  if(!nanoTrack && !nanoView) AliFatal("Not a nano AOD track");
 
   // Cache indexes
   static const Int_t kcstNSigmaTPCPi  = AliNanoAODTrackMapping::GetInstance()->GetVarIndex("cstNSigmaTPCPi");
@@ -335,19 +349,24 @@ Int_t AliAnalysisTaskSpectraAllChNanoAOD::GetNanoTrackID(AliVTrack * track) {
 
   Double_t nSigmaPID = 3.0;
 
-
+  Double_t nSigmaTPCPi = nanoTrack ? nanoTrack->GetVar(kcstNSigmaTPCPi) : nanoView->GetVar(kcstNSigmaTPCPi);
+  Double_t nSigmaTPCKa = nanoTrack ? nanoTrack->GetVar(kcstNSigmaTPCKa) : nanoView->GetVar(kcstNSigmaTPCKa);
+  Double_t nSigmaTPCPr = nanoTrack ? nanoTrack->GetVar(kcstNSigmaTPCPr) : nanoView->GetVar(kcstNSigmaTPCPr);
 
   //get the identity of the particle with the minimum Nsigma
   Double_t nsigmaPion=999., nsigmaKaon=999., nsigmaProton=999.;
-  if(nanoTrack->Pt() > fTrackCuts->GetPtTOFMatching()) {
-    nsigmaProton =  TMath::Sqrt(nanoTrack->GetVar(kcstNSigmaTPCPr)*nanoTrack->GetVar(kcstNSigmaTPCPr)+nanoTrack->GetVar(kcstNSigmaTOFPr)*nanoTrack->GetVar(kcstNSigmaTOFPr));
-    nsigmaKaon   =  TMath::Sqrt(nanoTrack->GetVar(kcstNSigmaTPCKa)*nanoTrack->GetVar(kcstNSigmaTPCKa)+nanoTrack->GetVar(kcstNSigmaTOFKa)*nanoTrack->GetVar(kcstNSigmaTOFKa));
-    nsigmaPion   =  TMath::Sqrt(nanoTrack->GetVar(kcstNSigmaTPCPi)*nanoTrack->GetVar(kcstNSigmaTPCPi)+nanoTrack->GetVar(kcstNSigmaTOFPi)*nanoTrack->GetVar(kcstNSigmaTOFPi));
+  if(track->Pt() > fTrackCuts->GetPtTOFMatching()) {
+    Double_t nSigmaTOFPi = nanoTrack ? nanoTrack->GetVar(kcstNSigmaTOFPi) : nanoView->GetVar(kcstNSigmaTOFPi);
+    Double_t nSigmaTOFKa = nanoTrack ? nanoTrack->GetVar(kcstNSigmaTOFKa) : nanoView->GetVar(kcstNSigmaTOFKa);
+    Double_t nSigmaTOFPr = nanoTrack ? nanoTrack->GetVar(kcstNSigmaTOFPr) : nanoView->GetVar(kcstNSigmaTOFPr);
+    nsigmaProton =  TMath::Sqrt(nSigmaTPCPr*nSigmaTPCPr+nSigmaTOFPr*nSigmaTOFPr);
+    nsigmaKaon   =  TMath::Sqrt(nSigmaTPCKa*nSigmaTPCKa+nSigmaTOFKa*nSigmaTOFKa);
+    nsigmaPion   =  TMath::Sqrt(nSigmaTPCPi*nSigmaTPCPi+nSigmaTOFPi*nSigmaTOFPi);
   }
   else {
-    nsigmaProton =  TMath::Abs(nanoTrack->GetVar(kcstNSigmaTPCPr));
-    nsigmaKaon   =  TMath::Abs(nanoTrack->GetVar(kcstNSigmaTPCKa));  
-    nsigmaPion   =  TMath::Abs(nanoTrack->GetVar(kcstNSigmaTPCPi));  
+    nsigmaProton =  TMath::Abs(nSigmaTPCPr);
+    nsigmaKaon   =  TMath::Abs(nSigmaTPCKa);  
+    nsigmaPion   =  TMath::Abs(nSigmaTPCPi);  
   }
 
   
@@ -52,6 +52,8 @@ class AliAODRecoDecay;
 #include "TObjArray.h"
 #include "AliAnalysisFilter.h"
 #include "AliNanoAODTrack.h"
+#include "AliNanoAODTrackColumns.h"
+#include "AliAnalysisNanoAODCuts.h"
 
 #include <TFile.h>
 #include <TDatabasePDG.h>
@@ -93,7 +95,10 @@ AliAODBranchReplicator(),
   fParticleSelected(),
   fVarList(""),
   fVarListHeader(""),
-  fCustomSetter(0){
+  fCustomSetter(0),
+  fColumnarTracks(kFALSE),
+  fTrackColumns(0x0),
+  fVarCodes(){
   // Default ctor. we need it to avoid instantiating a wrong mapping when reading from file 
   }
 
@@ -114,7 +119,10 @@ AliNanoAODReplicator::AliNanoAODReplicator(const char* name, const char* title,
   fParticleSelected(),
   fVarList(varlist),
   fVarListHeader(""),// FIXME: this should be set to a meaningful value: add an arg to the constructor
-  fCustomSetter(0)
+  fCustomSetter(0),
+  fColumnarTracks(kFALSE),
+  fTrackColumns(0x0),
+  fVarCodes()
 {
   // default ctor
   AliNanoAODTrackMapping * tm =new AliNanoAODTrackMapping(fVarList);
@@ -207,7 +215,7 @@ void AliNanoAODReplicator::FilterMC(const AliAODEvent& source)
 
   //  std::cout << "MC Mode: " << fMCMode << ", Tracks " << fTracks->GetEntries() << std::endl;
   
-  if ( fMCMode>=2 && !fTracks->GetEntries() ) {
+  if ( fMCMode>=2 && !GetNumberOfKeptTracks() ) {
     return;
   }
   // for fMCMode==1 we only copy MC information for events where there's at least one muon track
@@ -246,12 +254,11 @@ void AliNanoAODReplicator::FilterMC(const AliAODEvent& source)
       } 
 
       // loop on (kept) tracks to find their ancestors
-      TIter nextTRACK(fTracks);
-      AliNanoAODTrack* track;
+      const Int_t nKeptTracks = GetNumberOfKeptTracks();
     
-      while ( ( track = static_cast<AliNanoAODTrack*>(nextTRACK()) ) )
+      for (Int_t itrack = 0; itrack < nKeptTracks; itrack++)
 	{
-	  Int_t label = TMath::Abs(track->GetLabel()); 
+	  Int_t label = TMath::Abs(GetKeptTrackLabel(itrack)); 
       
 	  while ( label >= 0 ) 
 	    {
@@ -360,14 +367,12 @@ void AliNanoAODReplicator::FilterMC(const AliAODEvent& source)
     
       // now remap the tracks...
     
-      TIter nextTrack(fTracks);
-      AliNanoAODTrack* t;
       //      std::cout << "Remapping tracks" << std::endl;
     
-      while ( ( t = dynamic_cast<AliNanoAODTrack*>(nextTrack()) ) )
+      for (Int_t itrack = 0; itrack < nKeptTracks; itrack++)
 	{
 	  
-	  t->SetLabel(GetNewLabel(t->GetLabel()));
+	  SetKeptTrackLabel(itrack, GetNewLabel(GetKeptTrackLabel(itrack)));
 	}
     
     } // closes fMCMode == 1
@@ -395,6 +400,29 @@ void AliNanoAODReplicator::FilterMC(const AliAODEvent& source)
 
 }
 
+//_____________________________________________________________________________
+Int_t AliNanoAODReplicator::GetNumberOfKeptTracks() const
+{
+  // Number of tracks kept in this event, in either storage mode
+  return fColumnarTracks ? fTrackColumns->GetNTracks() : fTracks->GetEntriesFast();
+}
+
+//_____________________________________________________________________________
+Int_t AliNanoAODReplicator::GetKeptTrackLabel(Int_t i) const
+{
+  // Label of the i-th kept track, in either storage mode
+  if (fColumnarTracks) return fTrackColumns->GetLabel(i);
+  return static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(i))->GetLabel();
+}
+
+//_____________________________________________________________________________
+void AliNanoAODReplicator::SetKeptTrackLabel(Int_t i, Int_t label)
+{
+  // Sets the label of the i-th kept track, in either storage mode
+  if (fColumnarTracks) fTrackColumns->SetLabel(i, label);
+  else static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(i))->SetLabel(label);
+}
+
 // //_____________________________________________________________________________
 TList* AliNanoAODReplicator::GetList() const
 {
@@ -409,6 +437,13 @@ TList* AliNanoAODReplicator::GetList() const
       fTracks->SetName("tracks"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
       fList->Add(fTracks);    
 
+      if ( fColumnarTracks )
+	{
+	  // The "tracks" array is kept (empty) for compatibility with AliAODEvent
+	  fTrackColumns = new AliNanoAODTrackColumns("trackColumns");
+	  fList->Add(fTrackColumns);
+	}
+
       fHeader = new AliNanoAODHeader(3);// TODO: to be customized
       fHeader->SetName("header"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
       fList->Add(fHeader);    
@@ -470,19 +505,53 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   }
 
   const Int_t entries = source.GetNumberOfTracks();
+
+  if(fColumnarTracks) {
+    // Resolve the variable names to AOD variable codes only once
+    if(fVarCodes.GetSize() != fNTracksVariables) {
+      fVarCodes.Set(fNTracksVariables);
+      for (Int_t ivar = 0; ivar < fNTracksVariables; ivar++) {
+	fVarCodes[ivar] = AliNanoAODTrack::GetAODVarCode(AliNanoAODTrackMapping::GetInstance()->GetVarName(ivar));
+      }
+    }
+    fTrackColumns->Reset(fNTracksVariables, entries);
+  }
+
   if(entries<=0) return;
 
+  // Nano AOD track cuts are evaluated in one block for the whole event
+  // (possibly already done by the event cuts for this event)
+  AliAnalysisNanoAODTrackCuts * nanoTrackCut = dynamic_cast<AliAnalysisNanoAODTrackCuts*>(fTrackCut);
+  if(nanoTrackCut && !nanoTrackCut->HasSelection(&source)) nanoTrackCut->SelectTracks(&source);
+
   for(Int_t j=0; j<entries; j++){
     
+    if(nanoTrackCut && !nanoTrackCut->IsTrackSelected(j)) continue;
+
     AliVTrack *track = (AliVTrack*)source.GetTrack(j);
     
     AliAODTrack *aodtrack =(AliAODTrack*)track;// FIXME DYNAMIC CAST?
-    if(fTrackCut && !fTrackCut->IsSelected(aodtrack)) continue;
+    if(!nanoTrackCut && fTrackCut && !fTrackCut->IsSelected(aodtrack)) continue;
+
+    if(fColumnarTracks) {
+      if(fCustomSetter) {
+	// Custom variables are only available through the nano track interface
+	AliNanoAODTrack special(aodtrack, fVarList);
+	fCustomSetter->SetNanoAODTrack(aodtrack, &special);
+	fTrackColumns->AddTrack(&special);
+      } else {
+	fTrackColumns->AddTrack(aodtrack, fVarCodes.GetArray());
+      }
+      ntracks++;
+      continue;
+    }
 
     AliNanoAODTrack * special = new((*fTracks)[ntracks++]) AliNanoAODTrack (aodtrack, fVarList);
     
     if(fCustomSetter) fCustomSetter->SetNanoAODTrack(aodtrack, special);
   }  
+  if(fColumnarTracks) fTrackColumns->Compact();
+  if(nanoTrackCut) nanoTrackCut->ResetSelection();
   //----------------------------------------------------------
   
   TIter nextV(source.GetVertices());
@@ -13,6 +13,9 @@
 #ifndef ROOT_TExMap
 #  include "TExMap.h"
 #endif
+#ifndef ROOT_TArrayI
+#  include "TArrayI.h"
+#endif
 
 #include <iostream>
 
@@ -54,6 +57,7 @@ class AliAODHeader;
 class AliNanoAODHeader;
 class AliAnalysisTaskSE;
 class AliNanoAODTrack;
+class AliNanoAODTrackColumns;
 class AliAODTrack;
 class AliNanoAODCustomSetter;
 
@@ -88,6 +92,10 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   AliNanoAODCustomSetter * GetCustomSetter() { return fCustomSetter; }
   void  SetCustomSetter (AliNanoAODCustomSetter * var) { fCustomSetter = var;  }
 
+  // Columnar track storage (AliNanoAODTrackColumns) instead of one AliNanoAODTrack per track
+  Bool_t GetColumnarTracks() const { return fColumnarTracks; }
+  void   SetColumnarTracks(Bool_t var = kTRUE) { fColumnarTracks = var; }
+
 
  private:
 
@@ -96,6 +104,9 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   void CreateLabelMap(const AliAODEvent& source);
   Int_t GetNewLabel(Int_t i);
   void FilterMC(const AliAODEvent& source);
+  Int_t GetNumberOfKeptTracks() const;
+  Int_t GetKeptTrackLabel(Int_t i) const;
+  void  SetKeptTrackLabel(Int_t i, Int_t label);
  
 
  private:
@@ -121,13 +132,17 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
 
   AliNanoAODCustomSetter * fCustomSetter;  // Setter class for custom variables
 
+  Bool_t fColumnarTracks; // store the tracks in columns (AliNanoAODTrackColumns)
+  mutable AliNanoAODTrackColumns* fTrackColumns; //! internal columnar track storage
+  TArrayI fVarCodes; //! AOD variable codes of the columns (see AliNanoAODTrack::GetAODVarCode)
+
  private:
 
   
   AliNanoAODReplicator(const AliNanoAODReplicator&);
   AliNanoAODReplicator& operator=(const AliNanoAODReplicator&);
   
-  ClassDef(AliNanoAODReplicator,1) // Branch replicator for ESD to muon AOD.
+  ClassDef(AliNanoAODReplicator,2) // Branch replicator for ESD to muon AOD.
 };
 
 #endif
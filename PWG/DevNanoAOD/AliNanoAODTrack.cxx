@@ -67,51 +67,16 @@ AliNanoAODTrack::AliNanoAODTrack(AliAODTrack * aodTrack, const char * vars) :
 {
   // constructor
 
-  Double_t position[3];
-  Bool_t isPosAvailable = aodTrack->GetPosition(position);
   AliNanoAODTrackMapping::GetInstance(vars);
 
   // Create internal structure
   AllocateInternalStorage(AliNanoAODTrackMapping::GetInstance()->GetSize());
 
+  Double_t value = 0;
   for (Int_t index = 0; index<AliNanoAODTrackMapping::GetInstance()->GetSize(); index++) {
-    TString varString = AliNanoAODTrackMapping::GetInstance()->GetVarName(index);
-
-    if     (varString == "pt"                     ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPt()               , aodTrack->Pt()                      );
-    else if(varString == "phi"                    ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi()              , aodTrack->Phi()                     );
-    else if(varString == "theta"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta()            , aodTrack->Theta()                   );
-    else if(varString == "chi2perNDF"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetChi2PerNDF()       , aodTrack->Chi2perNDF()              );  
-    else if(varString == "posx" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX()             , position[0]                         );
-    else if(varString == "posy" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY()             , position[1]                         );
-    else if(varString == "posz" && isPosAvailable ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosZ()             , position[2]                         );
-    else if(varString == "posDCAx"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAx()          , aodTrack->XAtDCA()                  );
-    else if(varString == "posDCAy"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAy()          , aodTrack->YAtDCA()                  );
-    else if(varString == "pDCAx"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAX()            , aodTrack->PxAtDCA()                 );
-    else if(varString == "pDCAy"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAY()            , aodTrack->PyAtDCA()                 );
-    else if(varString == "pDCAz"                  ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAZ()            , aodTrack->PzAtDCA()                 );
-    else if(varString == "RAtAbsorberEnd"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetRAtAbsorberEnd()   , aodTrack->GetRAtAbsorberEnd()       );
-    else if(varString == "TPCncls"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCncls()          , aodTrack->GetTPCNcls()              );
-    else if(varString == "id"                     ) SetVar(AliNanoAODTrackMapping::GetInstance()->Getid()               , aodTrack->GetID()                   );
-    else if(varString == "TPCnclsF"               ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCnclsF()         , aodTrack->GetTPCNclsF()             );
-    else if(varString == "TPCNCrossedRows"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCNCrossedRows()  , aodTrack->GetTPCNCrossedRows()      );
-    else if(varString == "TrackPhiOnEMCal"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPhiOnEMCal()  , aodTrack->GetTrackPhiOnEMCal()      );
-    else if(varString == "TrackEtaOnEMCal"        ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackEtaOnEMCal()  , aodTrack->GetTrackEtaOnEMCal()      );
-    else if(varString == "TrackPtOnEMCal"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPtOnEMCal()   , aodTrack->GetTrackPtOnEMCal()       );
-    else if(varString == "ITSsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetITSsignal()        , aodTrack->GetITSsignal()            );
-    else if(varString == "TPCsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignal()        , aodTrack->GetTPCsignal()            );
-    else if(varString == "TPCsignalTuned"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalTuned()   , aodTrack->GetTPCsignalTunedOnData() );
-    else if(varString == "TPCsignalN"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalN()       , aodTrack->GetTPCsignalN()           );
-    else if(varString == "TPCmomentum"            ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCmomentum()      , aodTrack->GetTPCmomentum()          );
-    else if(varString == "TPCTgl"                 ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCTgl()           , aodTrack->GetTPCTgl()               );
-    else if(varString == "TOFsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignal()        , aodTrack->GetTOFsignal()            );
-    else if(varString == "integratedLength"       ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetintegratedLenght() , aodTrack->GetIntegratedLength()     );
-    else if(varString == "TOFsignalTuned"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignalTuned()   , aodTrack->GetTOFsignalTunedOnData() );
-    else if(varString == "HMPIDsignal"            ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDsignal()      , aodTrack->GetHMPIDsignal()          );
-    else if(varString == "HMPIDoccupancy"         ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDoccupancy()   , aodTrack->GetHMPIDoccupancy()       );
-    else if(varString == "TRDsignal"              ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDsignal()        , aodTrack->GetTRDsignal()            );
-    else if(varString == "TRDChi2"                ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDChi2()          , aodTrack->GetTRDchi2()              );
-    else if(varString == "TRDnSlices"             ) SetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDnSlices()       , aodTrack->GetNumberOfTRDslices()    );  
-    else if(varString == "covmat"                 ) AliFatal("cov matrix To be implemented"                            );
+    Int_t code = GetAODVarCode(AliNanoAODTrackMapping::GetInstance()->GetVarName(index));
+    if(code < 0) continue; // custom variables are set by the AliNanoAODCustomSetter
+    if(GetAODVarValue(aodTrack, code, value)) SetVar(index, value);
   }
 
 
@@ -125,6 +90,77 @@ AliNanoAODTrack::AliNanoAODTrack(AliAODTrack * aodTrack, const char * vars) :
 
 }
 
+//______________________________________________________________________________
+Int_t AliNanoAODTrack::GetAODVarCode(const TString & varString)
+{
+  // Returns the code of a standard AOD track variable, to be used with
+  // GetAODVarValue, or -1 if the variable is not a standard one
+  // (e.g. custom variables). The string comparison is done once per
+  // variable here, so that it can be resolved once per file by
+  // the columnar storage
+  static const char * kAODVarNames[kNAODVars] = {
+    "pt", "phi", "theta", "chi2perNDF", "posx", "posy", "posz", "posDCAx", "posDCAy",
+    "pDCAx", "pDCAy", "pDCAz", "RAtAbsorberEnd", "TPCncls", "id", "TPCnclsF",
+    "TPCNCrossedRows", "TrackPhiOnEMCal", "TrackEtaOnEMCal", "TrackPtOnEMCal",
+    "ITSsignal", "TPCsignal", "TPCsignalTuned", "TPCsignalN", "TPCmomentum", "TPCTgl",
+    "TOFsignal", "integratedLength", "TOFsignalTuned", "HMPIDsignal", "HMPIDoccupancy",
+    "TRDsignal", "TRDChi2", "TRDnSlices", "covmat"
+  };
+
+  for (Int_t icode = 0; icode < kNAODVars; icode++) {
+    if(varString == kAODVarNames[icode]) return icode;
+  }
+  return -1;
+}
+
+//______________________________________________________________________________
+Bool_t AliNanoAODTrack::GetAODVarValue(AliAODTrack * aodTrack, Int_t code, Double_t & value)
+{
+  // Gets the value of the standard variable "code" (see GetAODVarCode)
+  // from the AOD track. Returns kFALSE if the value is not available.
+  Double_t position[3];
+
+  switch (code) {
+  case kAODpt              : value = aodTrack->Pt();                      break;
+  case kAODphi             : value = aodTrack->Phi();                     break;
+  case kAODtheta           : value = aodTrack->Theta();                   break;
+  case kAODchi2perNDF      : value = aodTrack->Chi2perNDF();              break;
+  case kAODposx            : if(!aodTrack->GetPosition(position)) return kFALSE; value = position[0]; break;
+  case kAODposy            : if(!aodTrack->GetPosition(position)) return kFALSE; value = position[1]; break;
+  case kAODposz            : if(!aodTrack->GetPosition(position)) return kFALSE; value = position[2]; break;
+  case kAODposDCAx         : value = aodTrack->XAtDCA();                  break;
+  case kAODposDCAy         : value = aodTrack->YAtDCA();                  break;
+  case kAODpDCAx           : value = aodTrack->PxAtDCA();                 break;
+  case kAODpDCAy           : value = aodTrack->PyAtDCA();                 break;
+  case kAODpDCAz           : value = aodTrack->PzAtDCA();                 break;
+  case kAODRAtAbsorberEnd  : value = aodTrack->GetRAtAbsorberEnd();       break;
+  case kAODTPCncls         : value = aodTrack->GetTPCNcls();              break;
+  case kAODid              : value = aodTrack->GetID();                   break;
+  case kAODTPCnclsF        : value = aodTrack->GetTPCNclsF();             break;
+  case kAODTPCNCrossedRows : value = aodTrack->GetTPCNCrossedRows();      break;
+  case kAODTrackPhiOnEMCal : value = aodTrack->GetTrackPhiOnEMCal();      break;
+  case kAODTrackEtaOnEMCal : value = aodTrack->GetTrackEtaOnEMCal();      break;
+  case kAODTrackPtOnEMCal  : value = aodTrack->GetTrackPtOnEMCal();       break;
+  case kAODITSsignal       : value = aodTrack->GetITSsignal();            break;
+  case kAODTPCsignal       : value = aodTrack->GetTPCsignal();            break;
+  case kAODTPCsignalTuned  : value = aodTrack->GetTPCsignalTunedOnData(); break;
+  case kAODTPCsignalN      : value = aodTrack->GetTPCsignalN();           break;
+  case kAODTPCmomentum     : value = aodTrack->GetTPCmomentum();          break;
+  case kAODTPCTgl          : value = aodTrack->GetTPCTgl();               break;
+  case kAODTOFsignal       : value = aodTrack->GetTOFsignal();            break;
+  case kAODintegratedLength: value = aodTrack->GetIntegratedLength();     break;
+  case kAODTOFsignalTuned  : value = aodTrack->GetTOFsignalTunedOnData(); break;
+  case kAODHMPIDsignal     : value = aodTrack->GetHMPIDsignal();          break;
+  case kAODHMPIDoccupancy  : value = aodTrack->GetHMPIDoccupancy();       break;
+  case kAODTRDsignal       : value = aodTrack->GetTRDsignal();            break;
+  case kAODTRDChi2         : value = aodTrack->GetTRDchi2();              break;
+  case kAODTRDnSlices      : value = aodTrack->GetNumberOfTRDslices();    break;
+  case kAODcovmat          : AliFatalClass("cov matrix To be implemented"); return kFALSE;
+  default                  : return kFALSE;
+  }
+  return kTRUE;
+}
+
 //______________________________________________________________________________
 AliNanoAODTrack::AliNanoAODTrack(AliESDTrack * /*esdTrack*/, const char * /*vars*/) : 
   AliVTrack(), 
@@ -71,6 +71,14 @@ class AliNanoAODTrack : public AliVTrack, public AliNanoAODStorage {
 public:
   
   using TObject::ClassName;
+
+  // Standard AOD track variables which can be filtered (see GetAODVarCode)
+  enum { kAODpt = 0, kAODphi, kAODtheta, kAODchi2perNDF, kAODposx, kAODposy, kAODposz, kAODposDCAx, kAODposDCAy,
+	 kAODpDCAx, kAODpDCAy, kAODpDCAz, kAODRAtAbsorberEnd, kAODTPCncls, kAODid, kAODTPCnclsF,
+	 kAODTPCNCrossedRows, kAODTrackPhiOnEMCal, kAODTrackEtaOnEMCal, kAODTrackPtOnEMCal,
+	 kAODITSsignal, kAODTPCsignal, kAODTPCsignalTuned, kAODTPCsignalN, kAODTPCmomentum, kAODTPCTgl,
+	 kAODTOFsignal, kAODintegratedLength, kAODTOFsignalTuned, kAODHMPIDsignal, kAODHMPIDoccupancy,
+	 kAODTRDsignal, kAODTRDChi2, kAODTRDnSlices, kAODcovmat, kNAODVars };
   
   AliNanoAODTrack();
   AliNanoAODTrack(AliAODTrack * aodTrack, const char * vars);
@@ -83,6 +91,10 @@ public:
 
 
   virtual void Clear(Option_t * opt) ;
+
+  // Access to the standard AOD track variables by code, shared with AliNanoAODTrackColumns
+  static Int_t  GetAODVarCode(const TString & varString);
+  static Bool_t GetAODVarValue(AliAODTrack * aodTrack, Int_t code, Double_t & value);
   
   // kinematics
   virtual Double_t OneOverPt() const { return (Pt() != 0.) ? 1./Pt() : -999.; }
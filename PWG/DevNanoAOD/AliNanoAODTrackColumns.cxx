@@ -0,0 +1,159 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+
+//-------------------------------------------------------------------------
+//     Columnar storage of NanoAOD tracks
+//-------------------------------------------------------------------------
+
+#include <cstring>
+
+#include "AliLog.h"
+#include "AliAODTrack.h"
+#include "AliNanoAODTrack.h"
+
+#include "AliNanoAODTrackColumns.h"
+
+ClassImp(AliNanoAODTrackColumns)
+
+//______________________________________________________________________________
+AliNanoAODTrackColumns::AliNanoAODTrackColumns() :
+  TNamed(),
+  fNTracks(0),
+  fNVars(0),
+  fSize(0),
+  fColumns(0),
+  fCharge(0),
+  fLabel(0),
+  fMaxTracks(0),
+  fAllocatedSize(0),
+  fAllocatedTracks(0)
+{
+  // default constructor: does not allocate memory
+}
+
+//______________________________________________________________________________
+AliNanoAODTrackColumns::AliNanoAODTrackColumns(const char * name) :
+  TNamed(name, name),
+  fNTracks(0),
+  fNVars(0),
+  fSize(0),
+  fColumns(0),
+  fCharge(0),
+  fLabel(0),
+  fMaxTracks(0),
+  fAllocatedSize(0),
+  fAllocatedTracks(0)
+{
+  // named constructor
+}
+
+//______________________________________________________________________________
+AliNanoAODTrackColumns::~AliNanoAODTrackColumns()
+{
+  // destructor
+  delete [] fColumns;
+  delete [] fCharge;
+  delete [] fLabel;
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumns::Clear(Option_t * /*opt*/)
+{
+  // Removes all tracks, keeping the allocated memory
+  fNTracks = 0;
+  fSize    = 0;
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumns::Reset(Int_t nvars, Int_t maxTracks)
+{
+  // Prepares the storage for up to maxTracks tracks with nvars
+  // variables. Memory is only reallocated if the previous buffers are
+  // too small.
+  if(maxTracks < 1) maxTracks = 1;
+  Int_t size = nvars*maxTracks;
+  if(size > fAllocatedSize) {
+    delete [] fColumns;
+    fColumns = new Double32_t[size];
+    fAllocatedSize = size;
+  }
+  if(maxTracks > fAllocatedTracks) {
+    delete [] fCharge;
+    delete [] fLabel;
+    fCharge = new Short_t[maxTracks];
+    fLabel  = new Int_t[maxTracks];
+    fAllocatedTracks = maxTracks;
+  }
+  fMaxTracks = maxTracks;
+  fNVars     = nvars;
+  fNTracks   = 0;
+  fSize      = 0;
+}
+
+//______________________________________________________________________________
+Int_t AliNanoAODTrackColumns::AddTrack(AliAODTrack * aodTrack, const Int_t * codes)
+{
+  // Adds an AOD track, reading directly the variables with the codes
+  // returned by AliNanoAODTrack::GetAODVarCode (one per column,
+  // negative for custom variables, which are set to 0). Returns the
+  // index of the track.
+  if(fNTracks >= fMaxTracks) {
+    AliFatal(Form("Too many tracks (%d), call Reset with a larger size", fNTracks));
+    return -1;
+  }
+  Double_t value = 0;
+  for (Int_t ivar = 0; ivar < fNVars; ivar++) {
+    if(codes[ivar] < 0 || !AliNanoAODTrack::GetAODVarValue(aodTrack, codes[ivar], value)) value = 0;
+    fColumns[ivar*fMaxTracks + fNTracks] = value;
+  }
+  fCharge[fNTracks] = aodTrack->Charge();
+  fLabel[fNTracks]  = aodTrack->GetLabel();
+
+  return fNTracks++;
+}
+
+//______________________________________________________________________________
+Int_t AliNanoAODTrackColumns::AddTrack(const AliNanoAODTrack * track)
+{
+  // Adds a NanoAOD track (e.g. after custom variables were set).
+  // Returns the index of the track.
+  if(fNTracks >= fMaxTracks) {
+    AliFatal(Form("Too many tracks (%d), call Reset with a larger size", fNTracks));
+    return -1;
+  }
+  for (Int_t ivar = 0; ivar < fNVars; ivar++) {
+    fColumns[ivar*fMaxTracks + fNTracks] = track->GetVar(ivar);
+  }
+  fCharge[fNTracks] = track->Charge();
+  fLabel[fNTracks]  = track->GetLabel();
+
+  return fNTracks++;
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumns::Compact()
+{
+  // Removes the unused space between the columns, such that each column
+  // is exactly fNTracks long. Has to be called once all tracks were
+  // added and before the columns are read or written.
+  if(fNTracks < fMaxTracks) {
+    for (Int_t ivar = 1; ivar < fNVars; ivar++) {
+      memmove(fColumns + ivar*fNTracks, fColumns + ivar*fMaxTracks, fNTracks*sizeof(Double32_t));
+    }
+  }
+  fMaxTracks = fNTracks;
+  fSize      = fNVars*fNTracks;
+}
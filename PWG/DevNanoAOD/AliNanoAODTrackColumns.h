@@ -0,0 +1,70 @@
+#ifndef AliNanoAODTrackColumns_H
+#define AliNanoAODTrackColumns_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     Columnar storage of NanoAOD tracks
+//
+//     Instead of one AliNanoAODTrack object per track, all the tracks
+//     of an event are stored in a single object, one contiguous
+//     column per variable. The columns follow the layout defined by
+//     AliNanoAODTrackMapping, so that variable indexes are the same as
+//     for AliNanoAODTrack::GetVar. Contiguous columns of the same
+//     quantity compress much better than interleaved track records.
+//
+//     Tracks are read back without materialising track objects through
+//     AliNanoAODTrackView.
+//-------------------------------------------------------------------------
+
+#include "TNamed.h"
+
+class AliAODTrack;
+class AliNanoAODTrack;
+
+class AliNanoAODTrackColumns : public TNamed {
+
+public:
+
+  AliNanoAODTrackColumns();
+  AliNanoAODTrackColumns(const char * name);
+  virtual ~AliNanoAODTrackColumns();
+
+  virtual void Clear(Option_t * opt = "");
+
+  // Filling: Reset, then AddTrack for each track, then Compact before the event is written
+  void  Reset(Int_t nvars, Int_t maxTracks);
+  Int_t AddTrack(AliAODTrack * aodTrack, const Int_t * codes);
+  Int_t AddTrack(const AliNanoAODTrack * track);
+  void  Compact();
+
+  // Reading
+  Int_t    GetNTracks() const { return fNTracks; }
+  Int_t    GetNVars()   const { return fNVars;   }
+  Double_t GetVar(Int_t itrack, Int_t ivar) const { return fColumns[ivar*fNTracks + itrack]; }
+  const Double32_t * GetColumn(Int_t ivar) const { return fColumns + ivar*fNTracks; }
+  Short_t  GetCharge(Int_t itrack) const { return fCharge[itrack]; }
+  Int_t    GetLabel(Int_t itrack)  const { return fLabel[itrack];  }
+
+  void     SetLabel(Int_t itrack, Int_t label) { fLabel[itrack] = label; }
+
+private:
+
+  AliNanoAODTrackColumns(const AliNanoAODTrackColumns&);
+  AliNanoAODTrackColumns& operator=(const AliNanoAODTrackColumns&);
+
+  Int_t        fNTracks;        // number of tracks in this event
+  Int_t        fNVars;          // number of variables (columns)
+  Int_t        fSize;           // fNVars*fNTracks
+  Double32_t * fColumns;        //[fSize] column-major track variables
+  Short_t    * fCharge;         //[fNTracks] track charges
+  Int_t      * fLabel;          //[fNTracks] track labels, point back to MC tracks
+  Int_t        fMaxTracks;      //! number of tracks allocated while filling (column stride before Compact)
+  Int_t        fAllocatedSize;  //! allocated size of fColumns
+  Int_t        fAllocatedTracks;//! allocated size of fCharge and fLabel
+
+  ClassDef(AliNanoAODTrackColumns, 1);
+};
+
+#endif
@@ -0,0 +1,61 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+
+//-------------------------------------------------------------------------
+//     View of a track stored in AliNanoAODTrackColumns
+//-------------------------------------------------------------------------
+
+#include "AliLog.h"
+
+#include "AliNanoAODTrackView.h"
+
+ClassImp(AliNanoAODTrackView)
+
+//______________________________________________________________________________
+AliNanoAODTrackView::AliNanoAODTrackView() :
+  AliVTrack(),
+  fColumns(0),
+  fIndex(0)
+{
+  // default constructor
+}
+
+//______________________________________________________________________________
+AliNanoAODTrackView::AliNanoAODTrackView(const AliNanoAODTrackColumns * columns, Int_t index) :
+  AliVTrack(),
+  fColumns(columns),
+  fIndex(index)
+{
+  // constructor: view on track "index" of the columns
+}
+
+//______________________________________________________________________________
+Double_t AliNanoAODTrackView::Y(Double_t m) const
+{
+  // Returns the rapidity of a particle of a given mass.
+  
+  if (m >= 0.) { // mass makes sense
+    Double_t e = E(m);
+    Double_t pz = Pz();
+    if (e>=0 && e!=pz) { // energy was positive (e.g. not -999.) and not equal to pz
+      return 0.5*TMath::Log((e+pz)/(e-pz));
+    } else { // energy not known or equal to pz
+      return -999.;
+    }
+  } else { // pid unknown
+    return -999.;
+  }
+}
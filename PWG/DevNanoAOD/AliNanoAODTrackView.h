@@ -0,0 +1,164 @@
+#ifndef AliNanoAODTrackView_H
+#define AliNanoAODTrackView_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     View of a track stored in AliNanoAODTrackColumns
+//
+//     The view implements the AliVTrack accessors directly on top of
+//     the columns: no track object is created when reading a columnar
+//     NanoAOD. A single view can be moved over all the tracks of an
+//     event with SetIndex:
+//
+//       AliNanoAODTrackView track(columns);
+//       for (Int_t i = 0; i < columns->GetNTracks(); i++) {
+//         track.SetIndex(i);
+//         ... track.Pt() ...
+//       }
+//
+//     Variables not available in the NanoAOD produce an AliFatal, as
+//     for AliNanoAODTrack.
+//-------------------------------------------------------------------------
+
+#include "AliVTrack.h"
+#include "AliAODTrack.h"
+#include "AliNanoAODTrackMapping.h"
+#include "AliNanoAODTrackColumns.h"
+
+class AliVVertex;
+class AliDetectorPID;
+class AliExternalTrackParam;
+
+class AliNanoAODTrackView : public AliVTrack {
+
+public:
+
+  using TObject::ClassName;
+
+  AliNanoAODTrackView();
+  AliNanoAODTrackView(const AliNanoAODTrackColumns * columns, Int_t index = 0);
+  virtual ~AliNanoAODTrackView() {}
+
+  void  SetColumns(const AliNanoAODTrackColumns * columns) { fColumns = columns; fIndex = 0; }
+  void  SetIndex(Int_t index) { fIndex = index; }
+  Int_t GetIndex() const { return fIndex; }
+  const AliNanoAODTrackColumns * GetColumns() const { return fColumns; }
+
+  Double_t GetVar(Int_t ivar) const { return fColumns->GetVar(fIndex, ivar); }
+
+  // kinematics
+  virtual Double_t OneOverPt() const { return (Pt() != 0.) ? 1./Pt() : -999.; }
+  virtual Double_t Phi()       const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi());   }
+  virtual Double_t Theta()     const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta()); }
+
+  virtual Double_t Px() const { return Pt() * TMath::Cos(Phi()); }
+  virtual Double_t Py() const { return Pt() * TMath::Sin(Phi()); }
+  virtual Double_t Pz() const { return Pt() / TMath::Tan(Theta()); }
+  virtual Double_t Pt() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPt()); }
+  virtual Double_t P()  const { return TMath::Sqrt(Pt()*Pt()+Pz()*Pz()); }
+  virtual Bool_t   PxPyPz(Double_t p[3]) const { p[0] = Px(); p[1] = Py(); p[2] = Pz(); return kTRUE; }
+
+  virtual Double_t Xv() const { AliFatal("Not Implemented"); return -999.; }
+  virtual Double_t Yv() const { AliFatal("Not Implemented"); return -999.; }
+  virtual Double_t Zv() const { AliFatal("Not Implemented"); return -999.; }
+  virtual Bool_t   XvYvZv(Double_t x[3]) const { x[0] = Xv(); x[1] = Yv(); x[2] = Zv(); return kTRUE; }
+
+  Double_t Chi2perNDF()  const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetChi2PerNDF()); }
+  UShort_t GetTPCNcls()  const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCncls()); }
+
+  virtual Double_t M() const { AliFatal("Not Implemented"); return -1; }
+  virtual Double_t E() const { AliFatal("Not Implemented"); return -1; }
+  Double_t E(Double_t m) const { return TMath::Sqrt(P()*P() + m*m); }
+  virtual Double_t Y() const { AliFatal("Not Implemented"); return  -1; }
+  Double_t Y(Double_t m) const;
+
+  virtual Double_t Eta() const { return -TMath::Log(TMath::Tan(0.5 * Theta())); }
+  virtual Short_t  Charge() const { return fColumns->GetCharge(fIndex); }
+  virtual Bool_t   PropagateToDCA(const AliVVertex * /*vtx*/, Double_t /*b*/, Double_t /*maxd*/, Double_t /*dz*/[2], Double_t /*covar*/[3])
+  { AliFatal("Not Implemented"); return kFALSE; }
+
+  ULong_t GetStatus() const { AliFatal("Not implemented"); return 0; }
+  Int_t   GetID()     const { AliFatal("Not Implemented"); return 0; }
+  Int_t   GetLabel()  const { return fColumns->GetLabel(fIndex); }
+  Int_t   PdgCode()   const { return 0; }
+
+  Bool_t GetXYZ(Double_t *p) const {
+    p[0] = GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosX());
+    p[1] = GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosY());
+    p[2] = GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosZ());
+    return kFALSE; }
+  Bool_t GetXYZAt(Double_t /*x*/, Double_t /*b*/, Double_t * /*r*/) const { AliFatal("Not Implemented"); return kFALSE; }
+  Bool_t GetCovarianceXYZPxPyPz(Double_t /*cv*/[21]) const { AliFatal("Not implemented"); return 0; }
+
+  Double_t XAtDCA()  const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAx()); }
+  Double_t YAtDCA()  const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPosDCAy()); }
+  Double_t PxAtDCA() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAX()); }
+  Double_t PyAtDCA() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAY()); }
+  Double_t PzAtDCA() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPDCAZ()); }
+  Bool_t   PxPyPzAtDCA(Double_t p[3]) const { p[0] = PxAtDCA(); p[1] = PyAtDCA(); p[2] = PzAtDCA(); return kTRUE; }
+
+  Double_t GetRAtAbsorberEnd() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetRAtAbsorberEnd()); }
+
+  UChar_t  GetITSClusterMap() const { AliFatal("Not Implemented"); return 0; }
+  Float_t  GetTPCClusterInfo(Int_t /*nNeighbours=3*/, Int_t /*type=0*/, Int_t /*row0=0*/, Int_t /*row1=159*/, Int_t /*type*/=0) const { AliFatal("Not Implemented"); return 0; }
+
+  UShort_t GetTPCNclsF()         const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCnclsF()); }
+  UShort_t GetTPCNCrossedRows()  const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCNCrossedRows()); }
+  Float_t  GetTPCFoundFraction() const { return GetTPCNCrossedRows()>0 ? float(GetTPCNcls())/GetTPCNCrossedRows() : 0; }
+
+  Double_t GetTrackPhiOnEMCal() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPhiOnEMCal()); }
+  Double_t GetTrackEtaOnEMCal() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackEtaOnEMCal()); }
+  Double_t GetTrackPtOnEMCal()  const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTrackPtOnEMCal()); }
+  Double_t GetTrackPOnEMCal()   const { return TMath::Abs(GetTrackEtaOnEMCal()) < 1 ? GetTrackPtOnEMCal()*TMath::CosH(GetTrackEtaOnEMCal()) : -999; }
+
+  // pid signal interface
+  Double_t  GetITSsignal()            const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetITSsignal()); }
+  Double_t  GetTPCsignal()            const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignal()); }
+  Double_t  GetTPCsignalTunedOnData() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalTuned()); }
+  UShort_t  GetTPCsignalN()           const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCsignalN()); }
+  Double_t  GetTPCmomentum()          const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCmomentum()); }
+  Double_t  GetTPCTgl()               const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTPCTgl()); }
+  Double_t  GetTOFsignal()            const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignal()); }
+  Double_t  GetIntegratedLength()     const { AliFatal("Not implemented"); return 0; }
+  Double_t  GetTOFsignalTunedOnData() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTOFsignalTuned()); }
+  Double_t  GetHMPIDsignal()          const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDsignal()); }
+  Double_t  GetHMPIDoccupancy()       const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetHMPIDoccupancy()); }
+
+  virtual void GetIntegratedTimes(Double_t * /*times*/, Int_t) const { AliFatal("Not implemented"); return; }
+
+  Int_t     GetTOFBunchCrossing(Double_t /*b=0*/, Bool_t /*tpcPIDonly=kFALSE*/) const { AliFatal("Not Implemented"); return 0; }
+  UChar_t   GetTRDncls(Int_t /*layer*/)                           const { AliFatal("Not Implemented"); return 0; }
+  Double_t  GetTRDslice(Int_t /*plane*/, Int_t /*slice*/)         const { AliFatal("Not Implemented"); return 0; }
+  Double_t  GetTRDmomentum(Int_t /*plane*/, Double_t * /*sp*/=0x0) const { AliFatal("Not Implemented"); return 0; }
+
+  Double_t  GetTRDsignal()         const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDsignal()); }
+  Double_t  GetTRDchi2()           const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDChi2()); }
+  UChar_t   GetTRDncls()           const { return GetTRDncls(-1); }
+  Int_t     GetNumberOfTRDslices() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTRDnSlices()); }
+
+  //  needed  to inherit from VTrack, but not implemented
+  virtual void  SetDetectorPID(const AliDetectorPID * /*pid*/) { AliFatal("Not Implemented"); return; }
+  virtual const AliDetectorPID* GetDetectorPID() const { AliFatal("Not Implemented"); return 0; }
+  virtual UChar_t  GetTRDntrackletsPID() const { AliFatal("Not Implemented"); return 0; }
+  virtual void     GetHMPIDpid(Double_t * /*p*/) const { AliFatal("Not Implemented"); return; }
+  virtual Double_t GetBz() const { AliFatal("Not Implemented"); return 0; }
+  virtual void     GetBxByBz(Double_t [3]/*b[3]*/) const { AliFatal("Not Implemented"); return; }
+  virtual const    AliExternalTrackParam * GetOuterParam() const { AliFatal("Not Implemented"); return 0; }
+  virtual const    AliExternalTrackParam * GetInnerParam() const { AliFatal("Not Implemented"); return 0; }
+  virtual Int_t    GetNcls(Int_t /*idet*/) const { AliFatal("Not Implemented"); return 0; }
+  virtual const Double_t *PID() const { AliFatal("Not Implemented"); return 0; }
+
+private:
+
+  AliNanoAODTrackView(const AliNanoAODTrackView&);
+  AliNanoAODTrackView& operator=(const AliNanoAODTrackView&);
+
+  const AliNanoAODTrackColumns * fColumns; //! columns the view points to
+  Int_t                          fIndex;   //! index of the current track in the columns
+
+  ClassDef(AliNanoAODTrackView, 1);
+};
+
+#endif
@@ -13,6 +13,8 @@
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
 #include <RVersion.h>
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 #include <TClonesArray.h>
@@ -24,6 +26,7 @@
 #include <TFile.h>
 #include <TChain.h>
 #include <TKey.h>
+#include <TStopwatch.h>
 
 #include "AliAnalysisTaskEmcal.h"
 #include "AliAnalysisUtils.h"
@@ -33,6 +36,7 @@
 #include "AliAnalysisManager.h"
 #include "AliCentrality.h"
 #include "AliEmcalDownscaleFactorsOCDB.h"
+#include "AliEmcalEventObjectCache.h"
 #include "AliEMCALGeometry.h"
 #include "AliEmcalPythiaInfo.h"
 #include "AliEMCALTriggerPatchInfo.h"
@@ -113,6 +117,8 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal() :
   fPtHardAndJetPtFactor(0.),
   fPtHardAndClusterPtFactor(0.),
   fPtHardAndTrackPtFactor(0.),
+  fTimeRetrieveEventObjects(kFALSE),
+  fCheckInputCollections(kFALSE),
   fRunNumber(-1),
   fAliAnalysisUtils(nullptr),
   fIsEsd(kFALSE),
@@ -136,6 +142,13 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal() :
   fNTrials(0),
   fXsection(0),
   fPythiaInfo(nullptr),
+  fMultSelectionNameId(-1),
+  fAODMCHeaderNameId(-1),
+  fRetrieveEventObjectsTimer(nullptr),
+  fOutputCollections(),
+  fTaskStage(-1),
+  fCheckedCollections(),
+  fCheckedChecksums(),
   fOutput(nullptr),
   fHistEventCount(nullptr),
   fHistTrialsAfterSel(nullptr),
@@ -150,7 +163,8 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal() :
   fHistEventPlane(nullptr),
   fHistEventRejection(nullptr),
   fHistTriggerClasses(nullptr),
-  fHistTriggerClassesCorr(nullptr)
+  fHistTriggerClassesCorr(nullptr),
+  fHistRetrieveEventObjectsTime(nullptr)
 {
   fVertex[0] = 0;
   fVertex[1] = 0;
@@ -224,6 +238,8 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal(const char *name, Bool_t histo) :
   fPtHardAndJetPtFactor(0.),
   fPtHardAndClusterPtFactor(0.),
   fPtHardAndTrackPtFactor(0.),
+  fTimeRetrieveEventObjects(kFALSE),
+  fCheckInputCollections(kFALSE),
   fRunNumber(-1),
   fAliAnalysisUtils(nullptr),
   fIsEsd(kFALSE),
@@ -247,6 +263,13 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal(const char *name, Bool_t histo) :
   fNTrials(0),
   fXsection(0),
   fPythiaInfo(0),
+  fMultSelectionNameId(-1),
+  fAODMCHeaderNameId(-1),
+  fRetrieveEventObjectsTimer(nullptr),
+  fOutputCollections(),
+  fTaskStage(-1),
+  fCheckedCollections(),
+  fCheckedChecksums(),
   fOutput(nullptr),
   fHistEventCount(nullptr),
   fHistTrialsAfterSel(nullptr),
@@ -261,7 +284,8 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal(const char *name, Bool_t histo) :
   fHistEventPlane(nullptr),
   fHistEventRejection(nullptr),
   fHistTriggerClasses(nullptr),
-  fHistTriggerClassesCorr(nullptr)
+  fHistTriggerClassesCorr(nullptr),
+  fHistRetrieveEventObjectsTime(nullptr)
 {
   fVertex[0] = 0;
   fVertex[1] = 0;
@@ -282,6 +306,7 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal(const char *name, Bool_t histo) :
  */
 AliAnalysisTaskEmcal::~AliAnalysisTaskEmcal()
 {
+  delete fRetrieveEventObjectsTimer;
 }
 
 /**
@@ -515,6 +540,14 @@ void AliAnalysisTaskEmcal::UserCreateOutputObjects()
     fOutput->Add(fHistTriggerClassesCorr);
   }
 
+  if (fTimeRetrieveEventObjects) {
+    fRetrieveEventObjectsTimer = new TStopwatch;
+    fHistRetrieveEventObjectsTime = new TH1F("fHistRetrieveEventObjectsTime","fHistRetrieveEventObjectsTime",1000,0,1000);
+    fHistRetrieveEventObjectsTime->GetXaxis()->SetTitle("time (#mus)");
+    fHistRetrieveEventObjectsTime->GetYaxis()->SetTitle("events");
+    fOutput->Add(fHistRetrieveEventObjectsTime);
+  }
+
   fHistEventCount = new TH1F("fHistEventCount","fHistEventCount",2,0,2);
   fHistEventCount->GetXaxis()->SetBinLabel(1,"Accepted");
   fHistEventCount->GetXaxis()->SetBinLabel(2,"Rejected");
@@ -600,12 +633,20 @@ void AliAnalysisTaskEmcal::UserExec(Option_t *option)
   if (!fLocalInitialized){
     ExecOnce();
     UserExecOnce();
+    if (fLocalInitialized) FindTaskStage();
   }
 
   if (!fLocalInitialized)
     return;
 
-  if (!RetrieveEventObjects())
+  if (fRetrieveEventObjectsTimer) fRetrieveEventObjectsTimer->Start(kTRUE);
+  Bool_t retrieved = RetrieveEventObjects();
+  if (fRetrieveEventObjectsTimer) {
+    fRetrieveEventObjectsTimer->Stop();
+    fHistRetrieveEventObjectsTime->Fill(fRetrieveEventObjectsTimer->RealTime() * 1e6);
+  }
+
+  if (!retrieved)
     return;
 
   if(InputEvent()->GetRunNumber() != fRunNumber){
@@ -627,11 +668,17 @@ void AliAnalysisTaskEmcal::UserExec(Option_t *option)
       return;
   }
 
-  if (!Run())
+  if (fCheckInputCollections) SnapshotInputCollections();
+
+  Bool_t res = Run();
+  if (fCheckInputCollections) CheckInputCollections("Run");
+  if (!res)
     return;
 
   if (fCreateHisto) {
-    if (!FillHistograms())
+    res = FillHistograms();
+    if (fCheckInputCollections) CheckInputCollections("FillHistograms");
+    if (!res)
       return;
   }
 
@@ -773,6 +820,9 @@ Bool_t AliAnalysisTaskEmcal::PythiaInfoFromFile(const char* currFile, Float_t &f
  */
 Bool_t AliAnalysisTaskEmcal::UserNotify()
 {
+  // new input file: the tree entries start again, drop the objects cached for the previous file
+  AliEmcalEventObjectCache::Instance()->Reset();
+
   if (!fIsPythia || !fGeneralHistograms || !fCreateHisto)
     return kTRUE;
 
@@ -816,7 +866,7 @@ Bool_t AliAnalysisTaskEmcal::UserNotify()
 void AliAnalysisTaskEmcal::LoadPythiaInfo(AliVEvent *event)
 {
   if (!fPythiaInfoName.IsNull() && !fPythiaInfo) {
-    fPythiaInfo = dynamic_cast<AliEmcalPythiaInfo*>(event->FindListObject(fPythiaInfoName));
+    fPythiaInfo = dynamic_cast<AliEmcalPythiaInfo*>(AliEmcalEventObjectCache::Instance()->GetObject(event, fPythiaInfoName));
     if (!fPythiaInfo) {
       AliError(Form("%s: Could not retrieve parton infos! %s!", GetName(), fPythiaInfoName.Data()));
       return;
@@ -843,6 +893,10 @@ void AliAnalysisTaskEmcal::ExecOnce()
 
   LoadPythiaInfo(InputEvent());
 
+  // names of the objects read on every event
+  fMultSelectionNameId = AliEmcalEventObjectCache::Instance()->GetNameId("MultSelection");
+  fAODMCHeaderNameId = AliEmcalEventObjectCache::Instance()->GetNameId(AliAODMCHeader::StdBranchName());
+
   if (fNeedEmcalGeom) {
     fGeom = AliEMCALGeometry::GetInstanceFromRunNumber(InputEvent()->GetRunNumber());
     if (!fGeom) {
@@ -891,7 +945,7 @@ void AliAnalysisTaskEmcal::ExecOnce()
   }
 
   if (!fCaloCellsName.IsNull() && !fCaloCells) {
-    fCaloCells =  dynamic_cast<AliVCaloCells*>(InputEvent()->FindListObject(fCaloCellsName));
+    fCaloCells =  dynamic_cast<AliVCaloCells*>(AliEmcalEventObjectCache::Instance()->GetObject(InputEvent(), fCaloCellsName));
     if (!fCaloCells) {
       AliError(Form("%s: Could not retrieve cells %s!", GetName(), fCaloCellsName.Data())); 
       return;
@@ -899,7 +953,7 @@ void AliAnalysisTaskEmcal::ExecOnce()
   }
 
   if (!fCaloTriggersName.IsNull() && !fCaloTriggers) {
-    fCaloTriggers =  dynamic_cast<AliVCaloTrigger*>(InputEvent()->FindListObject(fCaloTriggersName));
+    fCaloTriggers =  dynamic_cast<AliVCaloTrigger*>(AliEmcalEventObjectCache::Instance()->GetObject(InputEvent(), fCaloTriggersName));
     if (!fCaloTriggers) {
       AliError(Form("%s: Could not retrieve calo triggers %s!", GetName(), fCaloTriggersName.Data())); 
       return;
@@ -1329,7 +1383,7 @@ TClonesArray *AliAnalysisTaskEmcal::GetArrayFromEvent(const char *name, const ch
   TClonesArray *arr = 0;
   TString sname(name);
   if (!sname.IsNull()) {
-    arr = dynamic_cast<TClonesArray*>(InputEvent()->FindListObject(sname));
+    arr = dynamic_cast<TClonesArray*>(AliEmcalEventObjectCache::Instance()->GetObject(InputEvent(), sname));
     if (!arr) {
       AliWarning(Form("%s: Could not retrieve array with name %s!", GetName(), name)); 
       return 0;
@@ -1387,7 +1441,7 @@ Bool_t AliAnalysisTaskEmcal::RetrieveEventObjects()
 
   if (fBeamType == kAA || fBeamType == kpA ) {
     if (fUseNewCentralityEstimation) {
-      AliMultSelection *MultSelection = static_cast<AliMultSelection*>(InputEvent()->FindListObject("MultSelection"));
+      AliMultSelection *MultSelection = static_cast<AliMultSelection*>(AliEmcalEventObjectCache::Instance()->GetObject(InputEvent(), fMultSelectionNameId));
       if (MultSelection) {
         fCent = MultSelection->GetMultiplicityPercentile(fCentEst.Data());
       }
@@ -1462,7 +1516,7 @@ Bool_t AliAnalysisTaskEmcal::RetrieveEventObjects()
       fPythiaHeader = dynamic_cast<AliGenPythiaEventHeader*>(MCEvent()->GenEventHeader());
       if (!fPythiaHeader) {
         // Check if AOD
-        AliAODMCHeader* aodMCH = dynamic_cast<AliAODMCHeader*>(InputEvent()->FindListObject(AliAODMCHeader::StdBranchName()));
+        AliAODMCHeader* aodMCH = dynamic_cast<AliAODMCHeader*>(AliEmcalEventObjectCache::Instance()->GetObject(InputEvent(), fAODMCHeaderNameId));
 
         if (aodMCH) {
           for (UInt_t i = 0;i<aodMCH->GetNCocktailHeaders();i++) {
@@ -1821,6 +1875,7 @@ void AliAnalysisTaskEmcal::AddObjectToEvent(TObject *obj, Bool_t attempt)
 {
   if (!(InputEvent()->FindListObject(obj->GetName()))) {
     InputEvent()->AddObject(obj);
+    fOutputCollections.push_back(obj->GetName());
   }
   else {
     if (!attempt) {
@@ -1829,6 +1884,176 @@ void AliAnalysisTaskEmcal::AddObjectToEvent(TObject *obj, Bool_t attempt)
   }
 }
 
+/**
+ * Get the names of the objects the task reads from the event: the arrays
+ * of the particle and cluster containers, the cells, the calo triggers
+ * and the trigger patches. Derived tasks reading further objects
+ * from the event should add them.
+ * @param[out] names Names of the objects read from the event
+ */
+void AliAnalysisTaskEmcal::GetInputCollections(std::vector<TString> &names) const
+{
+  for (Int_t i = 0; i < fParticleCollArray.GetEntriesFast(); i++) {
+    AliEmcalContainer *cont = static_cast<AliEmcalContainer*>(fParticleCollArray.At(i));
+    if (!cont->GetArrayName().IsNull()) names.push_back(cont->GetArrayName());
+  }
+  for (Int_t i = 0; i < fClusterCollArray.GetEntriesFast(); i++) {
+    AliEmcalContainer *cont = static_cast<AliEmcalContainer*>(fClusterCollArray.At(i));
+    if (!cont->GetArrayName().IsNull()) names.push_back(cont->GetArrayName());
+  }
+  if (!fCaloCellsName.IsNull()) names.push_back(fCaloCellsName);
+  if (!fCaloTriggersName.IsNull()) names.push_back(fCaloTriggersName);
+  if (!fCaloTriggerPatchInfoName.IsNull()) names.push_back(fCaloTriggerPatchInfoName);
+}
+
+/**
+ * Get the names of the objects the task writes to the event. By default
+ * these are the objects added with AddObjectToEvent. Derived tasks adding
+ * objects to the event in a different way should add them.
+ * @param[out] names Names of the objects written to the event
+ */
+void AliAnalysisTaskEmcal::GetOutputCollections(std::vector<TString> &names) const
+{
+  names.insert(names.end(), fOutputCollections.begin(), fOutputCollections.end());
+}
+
+/**
+ * Determine the dependency stage of the task in the train, once the task
+ * and all the tasks before it are initialized. The stage of a task is
+ * larger than the stage of all the EMCAL tasks producing an object it reads
+ * (or reading an object it produces), and larger than the stage of any
+ * other task before it, whose inputs and outputs are unknown. Tasks in the
+ * same stage do not depend on each other within an event.
+ * The stage is informational only and does not change the execution order.
+ */
+void AliAnalysisTaskEmcal::FindTaskStage()
+{
+  fTaskStage = 0;
+
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if (!mgr || !mgr->GetTasks()) return;
+
+  std::vector<TString> inputs, outputs;
+  GetInputCollections(inputs);
+  GetOutputCollections(outputs);
+
+  Int_t maxStage = -1;
+  Int_t barrier = 0;
+  TIter next(mgr->GetTasks());
+  TObject *obj = 0;
+  while ((obj = next())) {
+    if (obj == this) break;
+
+    AliAnalysisTaskEmcal *task = dynamic_cast<AliAnalysisTaskEmcal*>(obj);
+    if (!task || task->GetTaskStage() < 0) {
+      // reads and writes unknown: the task is a barrier
+      maxStage++;
+      barrier = maxStage + 1;
+      continue;
+    }
+
+    Int_t stage = task->GetTaskStage();
+    if (stage > maxStage) maxStage = stage;
+
+    std::vector<TString> taskInputs, taskOutputs;
+    task->GetInputCollections(taskInputs);
+    task->GetOutputCollections(taskOutputs);
+
+    Bool_t dependent = kFALSE;
+    for (const auto &name : taskOutputs) {
+      if (std::find(inputs.begin(), inputs.end(), name) != inputs.end() ||
+          std::find(outputs.begin(), outputs.end(), name) != outputs.end()) dependent = kTRUE;
+    }
+    for (const auto &name : taskInputs) {
+      if (std::find(outputs.begin(), outputs.end(), name) != outputs.end()) dependent = kTRUE;
+    }
+    if (dependent && stage + 1 > fTaskStage) fTaskStage = stage + 1;
+  }
+
+  if (barrier > fTaskStage) fTaskStage = barrier;
+
+  if (fCheckInputCollections) {
+    AliInfo(Form("%s: task stage %d (%d input and %d output collections)", GetName(), fTaskStage, Int_t(inputs.size()), Int_t(outputs.size())));
+  }
+}
+
+/**
+ * Store the checksums of the arrays read by the task
+ * (not produced by the task itself) before running the user code.
+ */
+void AliAnalysisTaskEmcal::SnapshotInputCollections()
+{
+  fCheckedCollections.clear();
+  fCheckedChecksums.clear();
+
+  std::vector<TString> inputs, outputs;
+  GetInputCollections(inputs);
+  GetOutputCollections(outputs);
+
+  for (const auto &name : inputs) {
+    if (std::find(outputs.begin(), outputs.end(), name) != outputs.end()) continue;
+    const TClonesArray *array = dynamic_cast<const TClonesArray*>(AliEmcalEventObjectCache::Instance()->GetObject(InputEvent(), name));
+    if (!array) continue;
+    fCheckedCollections.push_back(array);
+    fCheckedChecksums.push_back(GetCollectionChecksum(array));
+  }
+}
+
+/**
+ * Compare the arrays read by the task to the checksums stored
+ * by SnapshotInputCollections. A task modifying a shared input
+ * would change the input of all the following tasks: abort.
+ * @param[in] step Step of the task execution just performed
+ */
+void AliAnalysisTaskEmcal::CheckInputCollections(const char *step)
+{
+  for (UInt_t i = 0; i < fCheckedCollections.size(); i++) {
+    if (GetCollectionChecksum(fCheckedCollections[i]) != fCheckedChecksums[i]) {
+      AliFatal(Form("%s: input collection %s was modified in %s!", GetName(), fCheckedCollections[i]->GetName(), step));
+    }
+  }
+}
+
+/**
+ * Checksum of the content of an array: number of entries, address
+ * of the objects and, for particles and clusters, their kinematics.
+ * @param[in] array Array
+ * @return Checksum
+ */
+ULong64_t AliAnalysisTaskEmcal::GetCollectionChecksum(const TClonesArray *array)
+{
+  ULong64_t sum = array->GetEntriesFast();
+  for (Int_t i = 0; i < array->GetEntriesFast(); i++) {
+    TObject *obj = array->UncheckedAt(i);
+    Double_t values[4] = {0};
+    AliVParticle *part = dynamic_cast<AliVParticle*>(obj);
+    if (part) {
+      values[0] = part->Px();
+      values[1] = part->Py();
+      values[2] = part->Pz();
+      values[3] = part->E();
+    }
+    else {
+      AliVCluster *clus = dynamic_cast<AliVCluster*>(obj);
+      if (clus) {
+        values[0] = clus->E();
+        values[1] = clus->GetNonLinCorrEnergy();
+        values[2] = clus->GetHadCorrEnergy();
+        values[3] = clus->GetTOF();
+      }
+    }
+
+    ULong64_t h = reinterpret_cast<ULong_t>(obj);
+    for (Int_t j = 0; j < 4; j++) {
+      ULong64_t bits = 0;
+      memcpy(&bits, &values[j], sizeof(Double_t));
+      h = h * 1099511628211ULL ^ bits;
+    }
+    sum = sum * 31 + h;
+  }
+  return sum;
+}
+
 /**
  * Determines if a track is inside the EMCal acceptance, using \f$\eta\f$/\f$\phi\f$ at the vertex (no propagation).
  * Includes +/- edges. Useful to determine whether track propagation should be attempted.
@@ -21,6 +21,9 @@ class AliAODTrack;
 class AliEmcalPythiaInfo;
 class AliAODInputHandler;
 class AliESDInputHandler;
+class TStopwatch;
+
+#include <vector>
 
 #include "Rtypes.h"
 
@@ -62,6 +65,11 @@ class AliESDInputHandler;
  * provide an easy access to content created by other tasks and
  * attached to the event as a TClonesArray.
  *
+ * The collections read and written by the task are used to determine
+ * its dependency stage in the train (see GetTaskStage). The stage is
+ * informational only: it is printed with SetCheckInputCollections, but
+ * the tasks are still executed in the order they were added.
+ *
  * For more information refer to \subpage EMCALAnalysisTask
  */
 class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
@@ -178,6 +186,7 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   void                        SetEMCalTriggerMode(EMCalTriggerMode_t m)             { fEMCalTriggerMode  = m                              ; }
   void                        SetUseNewCentralityEstimation(Bool_t b)               { fUseNewCentralityEstimation = b                     ; }
   void                        SetGeneratePythiaInfoObject(Bool_t b)                 { fGeneratePythiaInfoObject = b                       ; }
+  void                        SetTimeRetrieveEventObjects(Bool_t b)                 { fTimeRetrieveEventObjects = b                       ; }
   void                        SetPythiaInfoName(const char *n)                      { fPythiaInfoName    = n                              ; }
   const TString&              GetPythiaInfoName()                             const { return fPythiaInfoName                              ; }
   const AliEmcalPythiaInfo   *GetPythiaInfo()                                 const { return fPythiaInfo                                  ; }
@@ -190,6 +199,12 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   Float_t                     ClusterPtFactor()                                     { return fPtHardAndClusterPtFactor                    ; }
   void                        SetTrackPtFactor(Float_t f)                           { fPtHardAndTrackPtFactor = f                         ; }
   Float_t                     TrackPtFactor()                                       { return fPtHardAndTrackPtFactor                      ; }
+  void                        SetCheckInputCollections(Bool_t b)                    { fCheckInputCollections = b                          ; }
+
+  // Collections read from and written to the event
+  virtual void                GetInputCollections(std::vector<TString> &names)  const;
+  virtual void                GetOutputCollections(std::vector<TString> &names) const;
+  Int_t                       GetTaskStage()                                  const { return fTaskStage                                   ; }
 
   // Static Utilities
   static AliAODInputHandler*  AddAODHandler();
@@ -217,6 +232,10 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
 
   void                        GeneratePythiaInfoObject(AliMCEvent* mcEvent);
   Bool_t                      CheckMCOutliers();
+  void                        FindTaskStage();
+  void                        SnapshotInputCollections();
+  void                        CheckInputCollections(const char *step);
+  static ULong64_t            GetCollectionChecksum(const TClonesArray *array);
 
   // Overloaded AliAnalysisTaskSE methods
   void                        UserCreateOutputObjects();
@@ -321,6 +340,8 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   Float_t                     fPtHardAndJetPtFactor;       ///< Factor between ptHard and jet pT to reject/accept event.
   Float_t                     fPtHardAndClusterPtFactor;   ///< Factor between ptHard and cluster pT to reject/accept event.
   Float_t                     fPtHardAndTrackPtFactor;     ///< Factor between ptHard and track pT to reject/accept event.
+  Bool_t                      fTimeRetrieveEventObjects;   ///< Measure the time spent in RetrieveEventObjects (general histograms)
+  Bool_t                      fCheckInputCollections;      ///< Fail if the task modifies a collection it reads from the event
 
   // Service fields
   Int_t                       fRunNumber;                  //!<!run number (triggering RunChanged()
@@ -348,6 +369,13 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   Int_t                       fNTrials;                    //!<!event trials
   Float_t                     fXsection;                   //!<!x-section from pythia header
   AliEmcalPythiaInfo         *fPythiaInfo;                 //!<!event parton info
+  Int_t                       fMultSelectionNameId;        //!<!id of the AliMultSelection object in the event object cache
+  Int_t                       fAODMCHeaderNameId;          //!<!id of the AOD MC header in the event object cache
+  TStopwatch                 *fRetrieveEventObjectsTimer;  //!<!timer of RetrieveEventObjects
+  std::vector<TString>        fOutputCollections;          //!<!names of the objects added to the event by the task
+  Int_t                       fTaskStage;                  //!<!dependency stage of the task in the train (-1 = unknown), informational only
+  std::vector<const TClonesArray*> fCheckedCollections;    //!<!input collections checked for modifications
+  std::vector<ULong64_t>      fCheckedChecksums;           //!<!checksums of the checked input collections
 
   // Output
   AliEmcalList               *fOutput;                     //!<!output list
@@ -365,13 +393,14 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   TH1                        *fHistEventRejection;         //!<!book keep reasons for rejecting event
   TH1                        *fHistTriggerClasses;         //!<!number of events in each trigger class
   TH1                        *fHistTriggerClassesCorr;     //!<!corrected number of events in each trigger class
+  TH1                        *fHistRetrieveEventObjectsTime; //!<!real time spent in RetrieveEventObjects
 
  private:
   AliAnalysisTaskEmcal(const AliAnalysisTaskEmcal&);            // not implemented
   AliAnalysisTaskEmcal &operator=(const AliAnalysisTaskEmcal&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcal, 15) // EMCAL base analysis task
+  ClassDef(AliAnalysisTaskEmcal, 17) // EMCAL base analysis task
   /// \endcond
 };
 
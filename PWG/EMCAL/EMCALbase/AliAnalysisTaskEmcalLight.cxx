@@ -28,6 +28,7 @@
 #include "AliAnalysisManager.h"
 #include "AliCentrality.h"
 #include "AliEMCALGeometry.h"
+#include "AliEmcalEventObjectCache.h"
 #include "AliESDEvent.h"
 #include "AliEmcalParticle.h"
 #include "AliEventplane.h"
@@ -105,6 +106,8 @@ AliAnalysisTaskEmcalLight::AliAnalysisTaskEmcalLight() :
   fPtHardBin(0),
   fNTrials(0),
   fXsection(0),
+  fMultSelectionNameId(-1),
+  fAODMCHeaderNameId(-1),
   fOutput(0),
   fHistEventCount(0),
   fHistTrialsAfterSel(0),
@@ -189,6 +192,8 @@ AliAnalysisTaskEmcalLight::AliAnalysisTaskEmcalLight(const char *name, Bool_t hi
   fPtHardBin(0),
   fNTrials(0),
   fXsection(0),
+  fMultSelectionNameId(-1),
+  fAODMCHeaderNameId(-1),
   fOutput(0),
   fHistEventCount(0),
   fHistTrialsAfterSel(0),
@@ -581,6 +586,9 @@ Bool_t AliAnalysisTaskEmcalLight::PythiaInfoFromFile(const char* currFile, Float
  */
 Bool_t AliAnalysisTaskEmcalLight::UserNotify()
 {
+  // new input file: the tree entries start again, drop the objects cached for the previous file
+  AliEmcalEventObjectCache::Instance()->Reset();
+
   if (!fIsPythia || !fGeneralHistograms || !fCreateHisto)
     return kTRUE;
 
@@ -633,6 +641,10 @@ void AliAnalysisTaskEmcalLight::ExecOnce()
     return;
   }
 
+  // names of the objects read on every event
+  fMultSelectionNameId = AliEmcalEventObjectCache::Instance()->GetNameId("MultSelection");
+  fAODMCHeaderNameId = AliEmcalEventObjectCache::Instance()->GetNameId(AliAODMCHeader::StdBranchName());
+
   if (fNeedEmcalGeom) {
     fGeom = AliEMCALGeometry::GetInstanceFromRunNumber(InputEvent()->GetRunNumber());
     if (!fGeom) {
@@ -654,7 +666,7 @@ void AliAnalysisTaskEmcalLight::ExecOnce()
   }
 
   if (!fCaloCellsName.IsNull() && !fCaloCells) {
-    fCaloCells =  dynamic_cast<AliVCaloCells*>(InputEvent()->FindListObject(fCaloCellsName));
+    fCaloCells =  dynamic_cast<AliVCaloCells*>(AliEmcalEventObjectCache::Instance()->GetObject(InputEvent(), fCaloCellsName));
     if (!fCaloCells) {
       AliError(Form("%s: Could not retrieve cells %s!", GetName(), fCaloCellsName.Data())); 
       return;
@@ -662,7 +674,7 @@ void AliAnalysisTaskEmcalLight::ExecOnce()
   }
 
   if (!fCaloTriggersName.IsNull() && !fCaloTriggers) {
-    fCaloTriggers =  dynamic_cast<AliVCaloTrigger*>(InputEvent()->FindListObject(fCaloTriggersName));
+    fCaloTriggers =  dynamic_cast<AliVCaloTrigger*>(AliEmcalEventObjectCache::Instance()->GetObject(InputEvent(), fCaloTriggersName));
     if (!fCaloTriggers) {
       AliError(Form("%s: Could not retrieve calo triggers %s!", GetName(), fCaloTriggersName.Data())); 
       return;
@@ -871,7 +883,7 @@ TClonesArray *AliAnalysisTaskEmcalLight::GetArrayFromEvent(const char *name, con
   TClonesArray *arr = 0;
   TString sname(name);
   if (!sname.IsNull()) {
-    arr = dynamic_cast<TClonesArray*>(InputEvent()->FindListObject(sname));
+    arr = dynamic_cast<TClonesArray*>(AliEmcalEventObjectCache::Instance()->GetObject(InputEvent(), sname));
     if (!arr) {
       AliWarning(Form("%s: Could not retrieve array with name %s!", GetName(), name)); 
       return 0;
@@ -934,7 +946,7 @@ Bool_t AliAnalysisTaskEmcalLight::RetrieveEventObjects()
 
   if (fBeamType == kAA || fBeamType == kpA ) {
     if (fUseNewCentralityEstimation) {
-      AliMultSelection *MultSelection = static_cast<AliMultSelection*>(InputEvent()->FindListObject("MultSelection"));
+      AliMultSelection *MultSelection = static_cast<AliMultSelection*>(AliEmcalEventObjectCache::Instance()->GetObject(InputEvent(), fMultSelectionNameId));
       if (MultSelection) {
         fCent = MultSelection->GetMultiplicityPercentile(fCentEst.Data());
       }
@@ -1010,7 +1022,7 @@ Bool_t AliAnalysisTaskEmcalLight::RetrieveEventObjects()
       fPythiaHeader = dynamic_cast<AliGenPythiaEventHeader*>(MCEvent()->GenEventHeader());
       if (!fPythiaHeader) {
         // Check if AOD
-        AliAODMCHeader* aodMCH = dynamic_cast<AliAODMCHeader*>(InputEvent()->FindListObject(AliAODMCHeader::StdBranchName()));
+        AliAODMCHeader* aodMCH = dynamic_cast<AliAODMCHeader*>(AliEmcalEventObjectCache::Instance()->GetObject(InputEvent(), fAODMCHeaderNameId));
 
         if (aodMCH) {
           for (UInt_t i = 0;i<aodMCH->GetNCocktailHeaders();i++) {
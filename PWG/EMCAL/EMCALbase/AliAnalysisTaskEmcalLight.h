@@ -240,6 +240,8 @@ class AliAnalysisTaskEmcalLight : public AliAnalysisTaskSE {
   Int_t                       fPtHardBin;                  //!<!event pt hard bin
   Int_t                       fNTrials;                    //!<!event trials
   Float_t                     fXsection;                   //!<!x-section from pythia header
+  Int_t                       fMultSelectionNameId;        //!<!id of the AliMultSelection object in the event object cache
+  Int_t                       fAODMCHeaderNameId;          //!<!id of the AOD MC header in the event object cache
 
   // Output
   TList                      *fOutput;                     //!<!output list
@@ -262,7 +264,7 @@ class AliAnalysisTaskEmcalLight : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalLight &operator=(const AliAnalysisTaskEmcalLight&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalLight, 1);
+  ClassDef(AliAnalysisTaskEmcalLight, 2);
   /// \endcond
 };
 
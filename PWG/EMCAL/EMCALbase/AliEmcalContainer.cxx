@@ -14,6 +14,7 @@
  **************************************************************************/
 #include <TClonesArray.h>
 #include "AliVEvent.h"
+#include "AliEmcalEventObjectCache.h"
 #include "AliLog.h"
 #include "AliNamedArrayI.h"
 #include "AliVParticle.h"
@@ -132,7 +133,7 @@ void AliEmcalContainer::SetArray(const AliVEvent *event)
   if (vertex) vertex->GetXYZ(fVertex);
 
   if (!fClArrayName.IsNull() && !fClArray) {
-    fClArray = dynamic_cast<TClonesArray*>(event->FindListObject(fClArrayName));
+    fClArray = dynamic_cast<TClonesArray*>(AliEmcalEventObjectCache::Instance()->GetObject(event, fClArrayName));
     if (!fClArray) {
       AliError(Form("%s: Could not retrieve array with name %s!", GetName(), fClArrayName.Data())); 
       return;
@@ -152,7 +153,7 @@ void AliEmcalContainer::SetArray(const AliVEvent *event)
     }
   }
 
-  fLabelMap = dynamic_cast<AliNamedArrayI*>(event->FindListObject(fClArrayName + "_Map"));
+  fLabelMap = dynamic_cast<AliNamedArrayI*>(AliEmcalEventObjectCache::Instance()->GetObject(event, fClArrayName + "_Map"));
 }
 
 /**
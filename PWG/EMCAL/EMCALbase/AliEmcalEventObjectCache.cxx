@@ -0,0 +1,97 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include "AliAnalysisManager.h"
+#include "AliVEvent.h"
+
+#include "AliEmcalEventObjectCache.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalEventObjectCache)
+/// \endcond
+
+AliEmcalEventObjectCache *AliEmcalEventObjectCache::fgEventObjectCache = nullptr;
+
+AliEmcalEventObjectCache::AliEmcalEventObjectCache() :
+  TObject(),
+  fNameIds(),
+  fNames(),
+  fObjects(),
+  fEvent(nullptr),
+  fEntry(-1),
+  fEventStamp(-1),
+  fNRequests(0),
+  fNLookups(0)
+{
+}
+
+AliEmcalEventObjectCache *AliEmcalEventObjectCache::Instance(){
+  if(!fgEventObjectCache) {
+    fgEventObjectCache = new AliEmcalEventObjectCache;
+  }
+  return fgEventObjectCache;
+}
+
+Int_t AliEmcalEventObjectCache::GetNameId(const TString &name){
+  if(name.IsNull()) return -1;
+
+  std::map<TString, Int_t>::const_iterator found = fNameIds.find(name);
+  if(found != fNameIds.end()) return found->second;
+
+  Int_t id = fNames.size();
+  fNameIds.insert(std::pair<TString, Int_t>(name, id));
+  fNames.push_back(name);
+  fObjects.push_back(nullptr);
+  return id;
+}
+
+void AliEmcalEventObjectCache::CheckEvent(const AliVEvent *event, Long64_t entry){
+  if(event == fEvent && entry == fEntry) return;
+
+  fEvent = event;
+  fEntry = entry;
+  fEventStamp++;
+  for(auto &obj : fObjects) obj = nullptr;
+}
+
+void AliEmcalEventObjectCache::Reset(){
+  fEvent = nullptr;
+  fEntry = -1;
+  for(auto &obj : fObjects) obj = nullptr;
+}
+
+Long64_t AliEmcalEventObjectCache::GetEventStamp(const AliVEvent *event){
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if(!event || !mgr) return -1;
+  CheckEvent(event, mgr->GetCurrentEntry());
+  return fEventStamp;
+}
+
+TObject *AliEmcalEventObjectCache::GetObject(const AliVEvent *event, Int_t id){
+  if(!event || id < 0 || id >= Int_t(fNames.size())) return nullptr;
+  fNRequests++;
+
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if(!mgr) {
+    fNLookups++;
+    return event->FindListObject(fNames[id]);
+  }
+
+  CheckEvent(event, mgr->GetCurrentEntry());
+  if(!fObjects[id]) {
+    fNLookups++;
+    fObjects[id] = event->FindListObject(fNames[id]);
+  }
+  return fObjects[id];
+}
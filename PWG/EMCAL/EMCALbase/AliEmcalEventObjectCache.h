@@ -0,0 +1,128 @@
+#ifndef ALIEMCALEVENTOBJECTCACHE_H
+#define ALIEMCALEVENTOBJECTCACHE_H
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <map>
+#include <vector>
+#include <TObject.h>
+#include <TString.h>
+
+class AliVEvent;
+
+/**
+ * @class AliEmcalEventObjectCache
+ * @brief Per event cache of the named objects of the input event
+ * @ingroup EMCALCOREFW
+ * @since Oct 19, 2016
+ *
+ * Objects attached to the input event (arrays, cells, trigger objects,
+ * AliMultSelection, MC headers, ...) are found by name with a linear
+ * scan of the list of event objects. When many wagons look up the same
+ * objects this scan is repeated for every wagon and every event. The cache
+ * is shared among all wagons (singleton): names are interned once to integer
+ * ids, and the object found for an id is kept until the input event or the
+ * current entry of the analysis manager changes.
+ *
+ * ~~~{.cxx}
+ * AliEmcalEventObjectCache *cache = AliEmcalEventObjectCache::Instance();
+ * Int_t id = cache->GetNameId("MultSelection");            // once per task
+ * TObject *o = cache->GetObject(InputEvent(), id);         // every event
+ * ~~~
+ *
+ * Objects not found are not cached, so that objects added to the event
+ * later on (i.e. by a following wagon) are found on the next request.
+ * Without analysis manager no entry is available to detect the event
+ * change, in this case every request is resolved in the event directly.
+ *
+ * The cache keeps the pointer found for a name until the event changes.
+ * Objects must therefore not be removed from or replaced in the input
+ * event during an entry: following wagons would get the old pointer.
+ *
+ * The entry of the analysis manager is local to the current tree: the
+ * same (event, entry) comes back after a change of the input file. The
+ * EMCAL base tasks therefore call Reset() in UserNotify, which drops the
+ * cached objects of the previous file.
+ */
+class AliEmcalEventObjectCache : public TObject {
+public:
+
+  /**
+   * Get instance of the event object cache. If called for the
+   * first time a new object is created
+   * @return Event object cache
+   */
+  static AliEmcalEventObjectCache *Instance();
+
+  /**
+   * Destructor
+   */
+  virtual ~AliEmcalEventObjectCache() {}
+
+  /**
+   * Get the id of an object name, registering the name if needed.
+   * @param[in] name Name of the object in the event
+   * @return Id of the name (-1 for an empty name)
+   */
+  Int_t GetNameId(const TString &name);
+
+  /**
+   * Get an object of the event from its name id.
+   * @param[in] event Input event
+   * @param[in] id Name id obtained from GetNameId
+   * @return Object in the event (nullptr if not found)
+   */
+  TObject *GetObject(const AliVEvent *event, Int_t id);
+
+  /**
+   * Get an object of the event from its name.
+   * @param[in] event Input event
+   * @param[in] name Name of the object in the event
+   * @return Object in the event (nullptr if not found)
+   */
+  TObject *GetObject(const AliVEvent *event, const TString &name) { return GetObject(event, GetNameId(name)); }
+
+  /**
+   * Drop all cached objects and the current event, i.e. when a new input file is opened.
+   */
+  void Reset();
+
+  /**
+   * Get a number identifying the current event, unique over the input files
+   * (increased for every new event seen by the cache, also after a Reset).
+   * Can be used to stamp per event data shared among wagons.
+   * @param[in] event Input event
+   * @return Event stamp (-1 without analysis manager)
+   */
+  Long64_t GetEventStamp(const AliVEvent *event);
+
+  /**
+   * Get the number of requests and of the requests resolved in the event
+   * (not served from the cache) since the creation of the cache.
+   */
+  ULong64_t GetNRequests() const { return fNRequests; }
+  ULong64_t GetNLookups()  const { return fNLookups; }
+
+private:
+  void CheckEvent(const AliVEvent *event, Long64_t entry);
+
+  std::map<TString, Int_t>                    fNameIds;                           //!<! Ids of the registered names
+  std::vector<TString>                        fNames;                             //!<! Registered names, by id
+  std::vector<TObject *>                      fObjects;                           //!<! Objects found in the current event, by id
+  const AliVEvent                            *fEvent;                             //!<! Event the cached objects belong to
+  Long64_t                                    fEntry;                             //!<! Entry the cached objects belong to
+  Long64_t                                    fEventStamp;                        //!<! Number of events seen (see GetEventStamp)
+  ULong64_t                                   fNRequests;                         //!<! Number of object requests
+  ULong64_t                                   fNLookups;                          //!<! Number of requests resolved in the event
+  static AliEmcalEventObjectCache            *fgEventObjectCache;                 ///< Singleton object
+
+  AliEmcalEventObjectCache();
+  AliEmcalEventObjectCache(const AliEmcalEventObjectCache &);
+  AliEmcalEventObjectCache &operator=(const AliEmcalEventObjectCache &);
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalEventObjectCache, 1);
+  /// \endcond
+};
+
+#endif /* ALIEMCALEVENTOBJECTCACHE_H */
@@ -9,6 +9,7 @@
 #pragma link C++ class AliClusterContainer+;
 #pragma link C++ class AliEmcalContainer+;
 #pragma link C++ class AliEmcalDownscaleFactorsOCDB+;
+#pragma link C++ class AliEmcalEventObjectCache+;
 #pragma link C++ class AliEmcalAODFilterBitCuts+;
 #pragma link C++ class AliEmcalESDTrackCutsGenerator+;
 #pragma link C++ class AliEmcalParticle+;
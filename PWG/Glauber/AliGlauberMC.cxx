@@ -40,6 +40,29 @@
 using std::flush;
 ClassImp(AliGlauberMC)
 
+//______________________________________________________________________________
+static void GlauberHarmonics(Double_t x, Double_t y, Double_t *rn, Double_t *cosn, Double_t *sinn)
+{
+  // r^n, cos(n*phi) and sin(n*phi) for n=2..5 of the point (x,y);
+  // the angles are obtained by recursion from cos(phi)=x/r and sin(phi)=y/r
+  Double_t r2 = x*x+y*y;
+  Double_t r = TMath::Sqrt(r2);
+  rn[2] = r2;
+  rn[3] = rn[2]*r;
+  rn[4] = rn[3]*r;
+  rn[5] = rn[4]*r;
+  cosn[1] = 1.; // phi=0 for r=0, as for ATan2(0,0)
+  sinn[1] = 0.;
+  if (r>0) {
+    cosn[1] = x/r;
+    sinn[1] = y/r;
+  }
+  for (Int_t n = 2; n<=5; n++) {
+    cosn[n] = cosn[n-1]*cosn[1] - sinn[n-1]*sinn[1];
+    sinn[n] = sinn[n-1]*cosn[1] + cosn[n-1]*sinn[1];
+  }
+}
+
 //______________________________________________________________________________
 AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   TNamed(),
@@ -172,7 +195,17 @@ AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   fOmega(0),
   fSig0(0),
   fLambda(0),
-  fSigFluc(0)
+  fSigFluc(0),
+  fXA(),
+  fYA(),
+  fSigA(),
+  fNCollA(),
+  fXB(),
+  fYB(),
+  fSigB(),
+  fNCollB(),
+  fCellStart(),
+  fCellIndex()
 {
   //ctor
   for (UInt_t i=0; i<(sizeof(fdNdEtaParam)/sizeof(fdNdEtaParam[0])); i++)
@@ -322,7 +355,17 @@ AliGlauberMC::AliGlauberMC(const AliGlauberMC& in):
   fOmega(in.fOmega),
   fSig0(in.fSig0),
   fLambda(in.fLambda),
-  fSigFluc(in.fSigFluc)
+  fSigFluc(in.fSigFluc),
+  fXA(),
+  fYA(),
+  fSigA(),
+  fNCollA(),
+  fXB(),
+  fYB(),
+  fSigB(),
+  fNCollB(),
+  fCellStart(),
+  fCellIndex()
 {
   //copy ctor
   memcpy(fdNdEtaParam,in.fdNdEtaParam,sizeof(fdNdEtaParam));
@@ -511,33 +554,27 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
   Double_t Nco   = 0;
   Double_t Ncohc = 0; // hard core
 
-  // for each of the A nucleons in nucleus B
-  for (Int_t i = 0; i<fBN; i++)
-  {
-    AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
-    for (Int_t j = 0 ; j < fAN ; j++)
-    {
-      AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
-      Double_t dx = nucleonB->GetX()-nucleonA->GetX();
-      Double_t dy = nucleonB->GetY()-nucleonA->GetY();
-      Double_t dij = dx*dx+dy*dy;
-      if (fDoFluc) {
-	//fXSect = nucleonA->GetSigNN();
-	//fXSect = (nucleonA->GetSigNN()+nucleonB->GetSigNN())/2.;
-	fXSect = TMath::Max(nucleonA->GetSigNN(),nucleonB->GetSigNN());
-	d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
-      }
-      if (dij < d2)
-      {
-	bNN += dij;
-	++Nco;
-        nucleonB->Collide();
-        nucleonA->Collide();
-	if (dij<d2/4)
-	  ++Ncohc;
-      }
-    }
+  FillNucleonArrays();
+  if (fDoFluc) {
+    // the pair distance is given by the larger of the two fluctuating cross
+    // sections, so the search range is set by the largest one in the event
+    Double_t sigMax = 0;
+    for (Int_t j = 0; j<fAN; j++)
+      sigMax = TMath::Max(sigMax,fSigA[j]);
+    for (Int_t i = 0; i<fBN; i++)
+      sigMax = TMath::Max(sigMax,fSigB[i]);
+    d2 = sigMax/(TMath::Pi()*10); // in fm^2
+    // as before, keep the cross section of the last nucleon pair
+    if (fAN>0 && fBN>0)
+      fXSect = TMath::Max(fSigA[fAN-1],fSigB[fBN-1]);
   }
+  FindCollisions(d2,bNN,Nco,Ncohc);
+
+  // propagate the collisions to the nucleons (GetNucleons(), Draw())
+  for (Int_t j = 0; j<fAN; j++)
+    ((AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j)))->SetNColl(fNCollA[j]);
+  for (Int_t i = 0; i<fBN; i++)
+    ((AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i)))->SetNColl(fNCollB[i]);
 
   if (Nco>0) {
     fNcollw = Ncohc;
@@ -554,6 +591,139 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
   return CalcResults(bgen);
 }
 
+//______________________________________________________________________________
+void AliGlauberMC::FillNucleonArrays()
+{
+  // copy the transverse positions and cross sections of the nucleons of
+  // both nuclei into flat arrays, used by the collision search and CalcResults
+
+  fXA.Set(fAN);
+  fYA.Set(fAN);
+  fSigA.Set(fAN);
+  fNCollA.Set(fAN);
+  fNCollA.Reset();
+  for (Int_t j = 0; j<fAN; j++)
+  {
+    AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
+    fXA[j]   = nucleonA->GetX();
+    fYA[j]   = nucleonA->GetY();
+    fSigA[j] = nucleonA->GetSigNN();
+  }
+
+  fXB.Set(fBN);
+  fYB.Set(fBN);
+  fSigB.Set(fBN);
+  fNCollB.Set(fBN);
+  fNCollB.Reset();
+  for (Int_t i = 0; i<fBN; i++)
+  {
+    AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
+    fXB[i]   = nucleonB->GetX();
+    fYB[i]   = nucleonB->GetY();
+    fSigB[i] = nucleonB->GetSigNN();
+  }
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::FindCollisions(Double_t d2max, Double_t &bNN, Double_t &nco, Double_t &ncohc)
+{
+  // find the binary collisions between the nucleons of A and B
+  // (d2max = largest squared interaction distance of any pair).
+  // The nucleons of A are sorted into a transverse grid with cells of at
+  // least sqrt(d2max), so each nucleon of B is only tested against the
+  // nucleons of A in its own and the adjacent cells.
+
+  bNN   = 0;
+  nco   = 0;
+  ncohc = 0;
+  if (fAN<=0 || fBN<=0 || d2max<=0) return;
+
+  const Double_t *xA   = fXA.GetArray();
+  const Double_t *yA   = fYA.GetArray();
+  const Double_t *sigA = fSigA.GetArray();
+  const Double_t *xB   = fXB.GetArray();
+  const Double_t *yB   = fYB.GetArray();
+  const Double_t *sigB = fSigB.GetArray();
+  Int_t *ncollA = fNCollA.GetArray();
+  Int_t *ncollB = fNCollB.GetArray();
+
+  Double_t xmin = xA[0], xmax = xA[0];
+  Double_t ymin = yA[0], ymax = yA[0];
+  for (Int_t j = 1; j<fAN; j++)
+  {
+    if (xA[j]<xmin) xmin = xA[j];
+    else if (xA[j]>xmax) xmax = xA[j];
+    if (yA[j]<ymin) ymin = yA[j];
+    else if (yA[j]>ymax) ymax = yA[j];
+  }
+
+  const Int_t kMaxCells = 64; // per dimension
+  const Double_t dmax = TMath::Sqrt(d2max);
+  const Double_t cellX = TMath::Max(dmax,(xmax-xmin)/(kMaxCells-1));
+  const Double_t cellY = TMath::Max(dmax,(ymax-ymin)/(kMaxCells-1));
+  const Int_t nx = (Int_t)((xmax-xmin)/cellX)+1;
+  const Int_t ny = (Int_t)((ymax-ymin)/cellY)+1;
+  const Int_t ncells = nx*ny;
+
+  // counting sort of the nucleons of A by cell
+  fCellStart.Set(ncells+1);
+  fCellStart.Reset();
+  fCellIndex.Set(fAN);
+  Int_t *cellStart = fCellStart.GetArray();
+  Int_t *cellIndex = fCellIndex.GetArray();
+  for (Int_t j = 0; j<fAN; j++)
+  {
+    Int_t cell = (Int_t)((yA[j]-ymin)/cellY)*nx + (Int_t)((xA[j]-xmin)/cellX);
+    ++cellStart[cell+1];
+  }
+  for (Int_t c = 0; c<ncells; c++)
+    cellStart[c+1] += cellStart[c];
+  for (Int_t j = 0; j<fAN; j++)
+  {
+    Int_t cell = (Int_t)((yA[j]-ymin)/cellY)*nx + (Int_t)((xA[j]-xmin)/cellX);
+    cellIndex[cellStart[cell]++] = j;
+  }
+  for (Int_t c = ncells; c>0; c--)
+    cellStart[c] = cellStart[c-1];
+  cellStart[0] = 0;
+
+  Double_t d2 = d2max;
+  for (Int_t i = 0; i<fBN; i++)
+  {
+    Int_t ix = (Int_t)TMath::Floor((xB[i]-xmin)/cellX);
+    Int_t iy = (Int_t)TMath::Floor((yB[i]-ymin)/cellY);
+    if (ix<-1 || ix>nx || iy<-1 || iy>ny) continue;
+    Int_t ix0 = TMath::Max(ix-1,0);
+    Int_t ix1 = TMath::Min(ix+1,nx-1);
+    Int_t iy0 = TMath::Max(iy-1,0);
+    Int_t iy1 = TMath::Min(iy+1,ny-1);
+    for (Int_t jy = iy0; jy<=iy1; jy++)
+    {
+      // the cells of one row are contiguous in cellIndex
+      Int_t first = cellStart[jy*nx+ix0];
+      Int_t last  = cellStart[jy*nx+ix1+1];
+      for (Int_t k = first; k<last; k++)
+      {
+        Int_t j = cellIndex[k];
+        Double_t dx = xB[i]-xA[j];
+        Double_t dy = yB[i]-yA[j];
+        Double_t dij = dx*dx+dy*dy;
+        if (fDoFluc)
+          d2 = TMath::Max(sigA[j],sigB[i])/(TMath::Pi()*10); // in fm^2
+        if (dij < d2)
+        {
+          bNN += dij;
+          ++nco;
+          ++ncollB[i];
+          ++ncollA[j];
+          if (dij<d2/4)
+            ++ncohc;
+        }
+      }
+    }
+  }
+}
+
 //______________________________________________________________________________
 Bool_t AliGlauberMC::CalcResults(Double_t bgen)
 {
@@ -652,17 +822,23 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
   fMeanr5Cos5PhiCom=0.;
   fMeanr5Sin5PhiCom=0.;
 
+  const Double_t *xA = fXA.GetArray();
+  const Double_t *yA = fYA.GetArray();
+  const Int_t *ncollA = fNCollA.GetArray();
+  const Double_t *xB = fXB.GetArray();
+  const Double_t *yB = fYB.GetArray();
+  const Int_t *ncollB = fNCollB.GetArray();
+
   for (Int_t i = 0; i<fAN; i++)
   {
-    AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(i));
-    Double_t oXA = nucleonA->GetX();
-    Double_t oYA = nucleonA->GetY();
+    Double_t oXA = xA[i];
+    Double_t oYA = yA[i];
     //fMeanOXSystem  += oXA;
     //fMeanOYSystem  += oYA;
     fMeanOXA  += oXA;
     fMeanOYA  += oYA;
 
-    if(nucleonA->IsWounded())
+    if(ncollA[i]>0)
     {
       fONpart++;
       fMeanOXParts  += oXA;
@@ -676,13 +852,12 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
 
   for (Int_t i = 0; i<fBN; i++)
   {
-    AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
-    Double_t oXB=nucleonB->GetX();
-    Double_t oYB=nucleonB->GetY();
+    Double_t oXB=xB[i];
+    Double_t oYB=yB[i];
     
-    if(nucleonB->IsWounded())
+    if(ncollB[i]>0)
     {
-      Int_t oNcoll = nucleonB->GetNColl();
+      Int_t oNcoll = ncollB[i];
       fONpart++;
       fMeanOXParts  += oXB;
       fMeanOXColl  += oXB*oNcoll;
@@ -729,45 +904,15 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
   }
   
   //////////////////////////////////////////////////////////////////
+  // the harmonics are only needed for wounded nucleons; they are computed
+  // w.r.t. the participant, collision and combined centres in one pass
+  Double_t rnPart[6], cosnPart[6], sinnPart[6];
+  Double_t rnColl[6], cosnColl[6], sinnColl[6];
+  Double_t rnCom[6], cosnCom[6], sinnCom[6];
   for (Int_t i = 0; i<fAN; i++)
   {
-    AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(i));
-    Double_t xAA = nucleonA->GetX(); // X
-    Double_t yAA = nucleonA->GetY(); // Y
-    Double_t xAPart = xAA - fMeanOXParts; // X'
-    Double_t yAPart = yAA - fMeanOYParts; // Y'
-    Double_t r2APart = xAPart *xAPart+yAPart*yAPart;     // r'^2
-    Double_t rAPart = TMath::Sqrt(r2APart);  // r'
-    Double_t r3APart = r2APart*rAPart;
-    Double_t r4APart = r3APart*rAPart;
-    Double_t r5APart = r4APart*rAPart;
-    Double_t phiAPart = TMath::ATan2(yAPart,xAPart);
-    Double_t sin2PhiAPart = TMath::Sin(2.*phiAPart);
-    Double_t cos2PhiAPart = TMath::Cos(2.*phiAPart);
-    Double_t sin3PhiAPart = TMath::Sin(3.*phiAPart);
-    Double_t cos3PhiAPart = TMath::Cos(3.*phiAPart);
-    Double_t sin4PhiAPart = TMath::Sin(4.*phiAPart);
-    Double_t cos4PhiAPart = TMath::Cos(4.*phiAPart);
-    Double_t sin5PhiAPart = TMath::Sin(5.*phiAPart);
-    Double_t cos5PhiAPart = TMath::Cos(5.*phiAPart);
-   
-    // for combine
-    Double_t xACom = xAA - fMeanOXCom; // X'-Combine
-    Double_t yACom = yAA - fMeanOYCom; // Y'-C
-    Double_t r2ACom = xACom *xACom+yACom*yACom;     // r'^2-C
-    Double_t rACom = TMath::Sqrt(r2ACom);  // r'-C
-    Double_t r3ACom = r2ACom*rACom;
-    Double_t r4ACom = r3ACom*rACom;
-    Double_t r5ACom = r4ACom*rACom;
-    Double_t phiACom = TMath::ATan2(yACom,xACom);
-    Double_t sin2PhiACom = TMath::Sin(2.*phiACom);
-    Double_t cos2PhiACom = TMath::Cos(2.*phiACom);
-    Double_t sin3PhiACom = TMath::Sin(3.*phiACom);
-    Double_t cos3PhiACom = TMath::Cos(3.*phiACom);
-    Double_t sin4PhiACom = TMath::Sin(4.*phiACom);
-    Double_t cos4PhiACom = TMath::Cos(4.*phiACom);
-    Double_t sin5PhiACom = TMath::Sin(5.*phiACom);
-    Double_t cos5PhiACom = TMath::Cos(5.*phiACom);   
+    Double_t xAA = xA[i]; // X
+    Double_t yAA = yA[i]; // Y
     
     fMeanXSystem  += xAA;
     fMeanYSystem  += yAA;
@@ -777,119 +922,73 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
     fMeanY2 += yAA * yAA;
     fMeanXY += xAA * yAA;
     
-    if(nucleonA->IsWounded())
+    if(ncollA[i]>0)
      {
        //Wounded
+      Double_t xAPart = xAA - fMeanOXParts; // X'
+      Double_t yAPart = yAA - fMeanOYParts; // Y'
+      GlauberHarmonics(xAPart,yAPart,rnPart,cosnPart,sinnPart);
       fNpart++;
       fMeanXParts  += xAPart;
       fMeanYParts  += yAPart;
       fMeanX2Parts += xAPart * xAPart;
       fMeanY2Parts += yAPart * yAPart;
       fMeanXYParts += xAPart * yAPart;
-      fMeanr2 += r2APart;
-      fMeanr3 += r3APart;
-      fMeanr4 += r4APart;
-      fMeanr5 += r5APart;
-      fMeanr2Cos2Phi += r2APart*cos2PhiAPart;
-      fMeanr2Sin2Phi += r2APart*sin2PhiAPart;
-      fMeanr2Cos3Phi += r2APart*cos3PhiAPart;
-      fMeanr2Sin3Phi += r2APart*sin3PhiAPart;
-      fMeanr2Cos4Phi += r2APart*cos4PhiAPart;
-      fMeanr2Sin4Phi += r2APart*sin4PhiAPart;
-      fMeanr2Cos5Phi += r2APart*cos5PhiAPart;
-      fMeanr2Sin5Phi += r2APart*sin5PhiAPart;
-      fMeanr3Cos3Phi += r3APart*cos3PhiAPart;
-      fMeanr3Sin3Phi += r3APart*sin3PhiAPart;
-      fMeanr4Cos4Phi += r4APart*cos4PhiAPart;
-      fMeanr4Sin4Phi += r4APart*sin4PhiAPart;
-      fMeanr5Cos5Phi += r5APart*cos5PhiAPart;
-      fMeanr5Sin5Phi += r5APart*sin5PhiAPart;
+      fMeanr2 += rnPart[2];
+      fMeanr3 += rnPart[3];
+      fMeanr4 += rnPart[4];
+      fMeanr5 += rnPart[5];
+      fMeanr2Cos2Phi += rnPart[2]*cosnPart[2];
+      fMeanr2Sin2Phi += rnPart[2]*sinnPart[2];
+      fMeanr2Cos3Phi += rnPart[2]*cosnPart[3];
+      fMeanr2Sin3Phi += rnPart[2]*sinnPart[3];
+      fMeanr2Cos4Phi += rnPart[2]*cosnPart[4];
+      fMeanr2Sin4Phi += rnPart[2]*sinnPart[4];
+      fMeanr2Cos5Phi += rnPart[2]*cosnPart[5];
+      fMeanr2Sin5Phi += rnPart[2]*sinnPart[5];
+      fMeanr3Cos3Phi += rnPart[3]*cosnPart[3];
+      fMeanr3Sin3Phi += rnPart[3]*sinnPart[3];
+      fMeanr4Cos4Phi += rnPart[4]*cosnPart[4];
+      fMeanr4Sin4Phi += rnPart[4]*sinnPart[4];
+      fMeanr5Cos5Phi += rnPart[5]*cosnPart[5];
+      fMeanr5Sin5Phi += rnPart[5]*sinnPart[5];
 
       // Combined
-      fMeanXCom  += xACom*(1-0.150);
-      fMeanYCom += yACom*(1-0.150);
-      fMeanX2Com += xACom*xACom*(1-0.150);
-      fMeanY2Com += yACom*yACom*(1-0.150);
-      fMeanXYCom += xACom*yACom*(1-0.150);
-      fNcom += (1-0.150);
-      fMeanr2Com += r2ACom*(1-0.150);
-      fMeanr3Com += r3ACom*(1-0.150);
-      fMeanr4Com += r4ACom*(1-0.150);
-      fMeanr5Com += r5ACom*(1-0.150);
-      fMeanr2Cos2PhiCom += r2ACom*cos2PhiACom*(1-0.150);
-      fMeanr2Sin2PhiCom += r2ACom*sin2PhiACom*(1-0.150);
-      fMeanr2Cos3PhiCom += r2ACom*cos3PhiACom*(1-0.150);
-      fMeanr2Sin3PhiCom += r2ACom*sin3PhiACom*(1-0.150);
-      fMeanr2Cos4PhiCom += r2ACom*cos4PhiACom*(1-0.150);
-      fMeanr2Sin4PhiCom += r2ACom*sin4PhiACom*(1-0.150);
-      fMeanr2Cos5PhiCom += r2ACom*cos5PhiACom*(1-0.150);
-      fMeanr2Sin5PhiCom += r2ACom*sin5PhiACom*(1-0.150);
-      fMeanr3Cos3PhiCom += r3ACom*cos3PhiACom*(1-0.150);
-      fMeanr3Sin3PhiCom += r3ACom*sin3PhiACom*(1-0.150);
-      fMeanr4Cos4PhiCom += r4ACom*cos4PhiACom*(1-0.150);
-      fMeanr4Sin4PhiCom += r4ACom*sin4PhiACom*(1-0.150);
-      fMeanr5Cos5PhiCom += r5ACom*cos5PhiACom*(1-0.150);
-      fMeanr5Sin5PhiCom += r5ACom*sin5PhiACom*(1-0.150);
-      
+      Double_t xACom = xAA - fMeanOXCom; // X'-Combine
+      Double_t yACom = yAA - fMeanOYCom; // Y'-C
+      GlauberHarmonics(xACom,yACom,rnCom,cosnCom,sinnCom);
+      const Double_t wCom = (1-0.150);
+      fMeanXCom  += xACom*wCom;
+      fMeanYCom += yACom*wCom;
+      fMeanX2Com += xACom*xACom*wCom;
+      fMeanY2Com += yACom*yACom*wCom;
+      fMeanXYCom += xACom*yACom*wCom;
+      fNcom += wCom;
+      fMeanr2Com += rnCom[2]*wCom;
+      fMeanr3Com += rnCom[3]*wCom;
+      fMeanr4Com += rnCom[4]*wCom;
+      fMeanr5Com += rnCom[5]*wCom;
+      fMeanr2Cos2PhiCom += rnCom[2]*cosnCom[2]*wCom;
+      fMeanr2Sin2PhiCom += rnCom[2]*sinnCom[2]*wCom;
+      fMeanr2Cos3PhiCom += rnCom[2]*cosnCom[3]*wCom;
+      fMeanr2Sin3PhiCom += rnCom[2]*sinnCom[3]*wCom;
+      fMeanr2Cos4PhiCom += rnCom[2]*cosnCom[4]*wCom;
+      fMeanr2Sin4PhiCom += rnCom[2]*sinnCom[4]*wCom;
+      fMeanr2Cos5PhiCom += rnCom[2]*cosnCom[5]*wCom;
+      fMeanr2Sin5PhiCom += rnCom[2]*sinnCom[5]*wCom;
+      fMeanr3Cos3PhiCom += rnCom[3]*cosnCom[3]*wCom;
+      fMeanr3Sin3PhiCom += rnCom[3]*sinnCom[3]*wCom;
+      fMeanr4Cos4PhiCom += rnCom[4]*cosnCom[4]*wCom;
+      fMeanr4Sin4PhiCom += rnCom[4]*sinnCom[4]*wCom;
+      fMeanr5Cos5PhiCom += rnCom[5]*cosnCom[5]*wCom;
+      fMeanr5Sin5PhiCom += rnCom[5]*sinnCom[5]*wCom;
     }
   }
   
   for (Int_t i = 0; i<fBN; i++)
     {
-      AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
-      Double_t xBB = nucleonB->GetX();
-      Double_t yBB = nucleonB->GetY();
-      // for Wounded
-      Double_t xBPart = xBB - fMeanOXParts; // X'
-      Double_t yBPart = yBB - fMeanOYParts; // Y'
-      Double_t r2BPart = xBPart*xBPart+yBPart*yBPart;     // r'^2
-      Double_t rBPart = TMath::Sqrt(r2BPart);  // r'
-      Double_t r3BPart = r2BPart*rBPart;
-      Double_t r4BPart = r3BPart*rBPart;
-      Double_t r5BPart = r4BPart*rBPart;
-      Double_t phiBPart = TMath::ATan2(yBPart,xBPart);
-      Double_t sin2PhiBPart = TMath::Sin(2.*phiBPart);
-      Double_t cos2PhiBPart = TMath::Cos(2.*phiBPart);
-      Double_t sin3PhiBPart = TMath::Sin(3.*phiBPart);
-      Double_t cos3PhiBPart = TMath::Cos(3.*phiBPart);
-      Double_t sin4PhiBPart = TMath::Sin(4.*phiBPart);
-      Double_t cos4PhiBPart = TMath::Cos(4.*phiBPart);
-      Double_t sin5PhiBPart = TMath::Sin(5.*phiBPart);
-      Double_t cos5PhiBPart = TMath::Cos(5.*phiBPart);
-      // for Binary
-      Double_t xBColl = xBB - fMeanOXColl; // X'-Binary
-      Double_t yBColl = yBB - fMeanOYColl; // Y'-B
-      Double_t r2BColl = xBColl*xBColl+yBColl*yBColl;     // r'^2-B
-      Double_t rBColl = TMath::Sqrt(r2BColl);  // r'-B
-      Double_t r3BColl = r2BColl*rBColl;
-      Double_t r4BColl = r3BColl*rBColl;
-      Double_t r5BColl = r4BColl*rBColl;
-      Double_t phiBColl = TMath::ATan2(yBColl,xBColl);
-      Double_t sin2PhiBColl = TMath::Sin(2.*phiBColl);
-      Double_t cos2PhiBColl = TMath::Cos(2.*phiBColl);
-      Double_t sin3PhiBColl = TMath::Sin(3.*phiBColl);
-      Double_t cos3PhiBColl = TMath::Cos(3.*phiBColl);
-      Double_t sin4PhiBColl = TMath::Sin(4.*phiBColl);
-      Double_t cos4PhiBColl = TMath::Cos(4.*phiBColl);
-      Double_t sin5PhiBColl = TMath::Sin(5.*phiBColl);
-      Double_t cos5PhiBColl = TMath::Cos(5.*phiBColl);
-      // for combine
-      Double_t xBCom = xBB - fMeanOXCom; // X'-Combine
-      Double_t yBCom = yBB - fMeanOYCom; // Y'-C
-      Double_t r2BCom = xBCom *xBCom+yBCom*yBCom;     // r'^2-C
-      Double_t rBCom = TMath::Sqrt(r2BCom);  // r'-C
-      Double_t r3BCom = r2BCom*rBCom;
-      Double_t r4BCom = r3BCom*rBCom;
-      Double_t r5BCom = r4BCom*rBCom;
-      Double_t phiBCom = TMath::ATan2(yBCom,xBCom);
-      Double_t sin2PhiBCom = TMath::Sin(2.*phiBCom);
-      Double_t cos2PhiBCom = TMath::Cos(2.*phiBCom);
-      Double_t sin3PhiBCom = TMath::Sin(3.*phiBCom);
-      Double_t cos3PhiBCom = TMath::Cos(3.*phiBCom);
-      Double_t sin4PhiBCom = TMath::Sin(4.*phiBCom);
-      Double_t cos4PhiBCom = TMath::Cos(4.*phiBCom);
-      Double_t sin5PhiBCom = TMath::Sin(5.*phiBCom);
-      Double_t cos5PhiBCom = TMath::Cos(5.*phiBCom);   
+      Double_t xBB = xB[i];
+      Double_t yBB = yB[i];
       
       fMeanXSystem  += xBB;
       fMeanYSystem  += yBB;
@@ -899,81 +998,95 @@ Bool_t AliGlauberMC::CalcResults(Double_t bgen)
       fMeanY2 += yBB*yBB;
       fMeanXY += xBB*yBB;
       
-      if(nucleonB->IsWounded())
+      if(ncollB[i]>0)
 	{
-	  Int_t ncoll = nucleonB->GetNColl();
+	  Int_t ncoll = ncollB[i];
+	  const Double_t wCom = (1-0.150)+0.150*ncoll;
+	  // for Wounded
+	  Double_t xBPart = xBB - fMeanOXParts; // X'
+	  Double_t yBPart = yBB - fMeanOYParts; // Y'
+	  GlauberHarmonics(xBPart,yBPart,rnPart,cosnPart,sinnPart);
+	  // for Binary
+	  Double_t xBColl = xBB - fMeanOXColl; // X'-Binary
+	  Double_t yBColl = yBB - fMeanOYColl; // Y'-B
+	  GlauberHarmonics(xBColl,yBColl,rnColl,cosnColl,sinnColl);
+	  // for combine
+	  Double_t xBCom = xBB - fMeanOXCom; // X'-Combine
+	  Double_t yBCom = yBB - fMeanOYCom; // Y'-C
+	  GlauberHarmonics(xBCom,yBCom,rnCom,cosnCom,sinnCom);
+
 	  fNpart++;
 	  fMeanXParts  += xBPart;
 	  fMeanXColl  += xBColl*ncoll;
-	  fMeanXCom  += xBCom*((1-0.150)+0.150*ncoll);
+	  fMeanXCom  += xBCom*wCom;
 	  fMeanYParts  += yBPart;
 	  fMeanYColl += yBColl*ncoll;
-	  fMeanYCom += yBCom*((1-0.150)+0.150*ncoll);
+	  fMeanYCom += yBCom*wCom;
 	  fMeanX2Parts += xBPart * xBPart;
 	  fMeanX2Coll += xBColl*xBColl*ncoll;
-	  fMeanX2Com += xBCom*xBCom*((1-0.150)+0.150*ncoll);
+	  fMeanX2Com += xBCom*xBCom*wCom;
 	  fMeanY2Parts += yBPart * yBPart;
 	  fMeanY2Coll += yBColl*yBColl*ncoll;
-	  fMeanY2Com += yBCom*yBCom*((1-0.150)+0.150*ncoll);
+	  fMeanY2Com += yBCom*yBCom*wCom;
 	  fMeanXYParts += xBPart * yBPart;
 	  fMeanXYColl += xBColl*yBColl*ncoll;
-	  fMeanXYCom += xBCom*yBCom*((1-0.150)+0.150*ncoll);
+	  fMeanXYCom += xBCom*yBCom*wCom;
 	  fNcoll += ncoll;
-	  fNcom += ((1-0.150)+0.150*ncoll);
-	  fMeanr2 += r2BPart;
-	  fMeanr3 += r3BPart;
-	  fMeanr4 += r4BPart;
-	  fMeanr5 += r5BPart;
-	  fMeanr2Cos2Phi += r2BPart*cos2PhiBPart;
-	  fMeanr2Sin2Phi += r2BPart*sin2PhiBPart;
-	  fMeanr2Cos3Phi += r2BPart*cos3PhiBPart;
-	  fMeanr2Sin3Phi += r2BPart*sin3PhiBPart;
-	  fMeanr2Cos4Phi += r2BPart*cos4PhiBPart;
-	  fMeanr2Sin4Phi += r2BPart*sin4PhiBPart;
-	  fMeanr2Cos5Phi += r2BPart*cos5PhiBPart;
-	  fMeanr2Sin5Phi += r2BPart*sin5PhiBPart;
-	  fMeanr3Cos3Phi += r3BPart*cos3PhiBPart;
-	  fMeanr3Sin3Phi += r3BPart*sin3PhiBPart;
-	  fMeanr4Cos4Phi += r4BPart*cos4PhiBPart;
-	  fMeanr4Sin4Phi += r4BPart*sin4PhiBPart;
-	  fMeanr5Cos5Phi += r5BPart*cos5PhiBPart;
-	  fMeanr5Sin5Phi += r5BPart*sin5PhiBPart;
-	  fMeanr2Coll += r2BColl*ncoll;
-	  fMeanr3Coll += r3BColl*ncoll;
-	  fMeanr4Coll += r4BColl*ncoll;
-	  fMeanr5Coll += r5BColl*ncoll;
-	  fMeanr2Cos2PhiColl += r2BColl*cos2PhiBColl*ncoll;
-	  fMeanr2Sin2PhiColl += r2BColl*sin2PhiBColl*ncoll;
-	  fMeanr2Cos3PhiColl += r2BColl*cos3PhiBColl*ncoll;
-	  fMeanr2Sin3PhiColl += r2BColl*sin3PhiBColl*ncoll;
-	  fMeanr2Cos4PhiColl += r2BColl*cos4PhiBColl*ncoll;
-	  fMeanr2Sin4PhiColl += r2BColl*sin4PhiBColl*ncoll;
-	  fMeanr2Cos5PhiColl += r2BColl*cos5PhiBColl*ncoll;
-	  fMeanr2Sin5PhiColl += r2BColl*sin5PhiBColl*ncoll;
-	  fMeanr3Cos3PhiColl += r3BColl*cos3PhiBColl*ncoll;
-	  fMeanr3Sin3PhiColl += r3BColl*sin3PhiBColl*ncoll;
-	  fMeanr4Cos4PhiColl += r4BColl*cos4PhiBColl*ncoll;
-	  fMeanr4Sin4PhiColl += r4BColl*sin4PhiBColl*ncoll;
-	  fMeanr5Cos5PhiColl += r5BColl*cos5PhiBColl*ncoll;
-	  fMeanr5Sin5PhiColl += r5BColl*sin5PhiBColl*ncoll;
-	  fMeanr2Com += r2BCom*((1-0.150)+0.150*ncoll);
-	  fMeanr3Com += r3BCom*((1-0.150)+0.150*ncoll);
-	  fMeanr4Com += r4BCom*((1-0.150)+0.150*ncoll);
-	  fMeanr5Com += r5BCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Cos2PhiCom += r2BCom*cos2PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Sin2PhiCom += r2BCom*sin2PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Cos3PhiCom += r2BCom*cos3PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Sin3PhiCom += r2BCom*sin3PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Cos4PhiCom += r2BCom*cos4PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Sin4PhiCom += r2BCom*sin4PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Cos5PhiCom += r2BCom*cos5PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr2Sin5PhiCom += r2BCom*sin5PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr3Cos3PhiCom += r3BCom*cos3PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr3Sin3PhiCom += r3BCom*sin3PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr4Cos4PhiCom += r4BCom*cos4PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr4Sin4PhiCom += r4BCom*sin4PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr5Cos5PhiCom += r5BCom*cos5PhiBCom*((1-0.150)+0.150*ncoll);
-	  fMeanr5Sin5PhiCom += r5BCom*sin5PhiBCom*((1-0.150)+0.150*ncoll);
+	  fNcom += wCom;
+	  fMeanr2 += rnPart[2];
+	  fMeanr3 += rnPart[3];
+	  fMeanr4 += rnPart[4];
+	  fMeanr5 += rnPart[5];
+	  fMeanr2Cos2Phi += rnPart[2]*cosnPart[2];
+	  fMeanr2Sin2Phi += rnPart[2]*sinnPart[2];
+	  fMeanr2Cos3Phi += rnPart[2]*cosnPart[3];
+	  fMeanr2Sin3Phi += rnPart[2]*sinnPart[3];
+	  fMeanr2Cos4Phi += rnPart[2]*cosnPart[4];
+	  fMeanr2Sin4Phi += rnPart[2]*sinnPart[4];
+	  fMeanr2Cos5Phi += rnPart[2]*cosnPart[5];
+	  fMeanr2Sin5Phi += rnPart[2]*sinnPart[5];
+	  fMeanr3Cos3Phi += rnPart[3]*cosnPart[3];
+	  fMeanr3Sin3Phi += rnPart[3]*sinnPart[3];
+	  fMeanr4Cos4Phi += rnPart[4]*cosnPart[4];
+	  fMeanr4Sin4Phi += rnPart[4]*sinnPart[4];
+	  fMeanr5Cos5Phi += rnPart[5]*cosnPart[5];
+	  fMeanr5Sin5Phi += rnPart[5]*sinnPart[5];
+	  fMeanr2Coll += rnColl[2]*ncoll;
+	  fMeanr3Coll += rnColl[3]*ncoll;
+	  fMeanr4Coll += rnColl[4]*ncoll;
+	  fMeanr5Coll += rnColl[5]*ncoll;
+	  fMeanr2Cos2PhiColl += rnColl[2]*cosnColl[2]*ncoll;
+	  fMeanr2Sin2PhiColl += rnColl[2]*sinnColl[2]*ncoll;
+	  fMeanr2Cos3PhiColl += rnColl[2]*cosnColl[3]*ncoll;
+	  fMeanr2Sin3PhiColl += rnColl[2]*sinnColl[3]*ncoll;
+	  fMeanr2Cos4PhiColl += rnColl[2]*cosnColl[4]*ncoll;
+	  fMeanr2Sin4PhiColl += rnColl[2]*sinnColl[4]*ncoll;
+	  fMeanr2Cos5PhiColl += rnColl[2]*cosnColl[5]*ncoll;
+	  fMeanr2Sin5PhiColl += rnColl[2]*sinnColl[5]*ncoll;
+	  fMeanr3Cos3PhiColl += rnColl[3]*cosnColl[3]*ncoll;
+	  fMeanr3Sin3PhiColl += rnColl[3]*sinnColl[3]*ncoll;
+	  fMeanr4Cos4PhiColl += rnColl[4]*cosnColl[4]*ncoll;
+	  fMeanr4Sin4PhiColl += rnColl[4]*sinnColl[4]*ncoll;
+	  fMeanr5Cos5PhiColl += rnColl[5]*cosnColl[5]*ncoll;
+	  fMeanr5Sin5PhiColl += rnColl[5]*sinnColl[5]*ncoll;
+	  fMeanr2Com += rnCom[2]*wCom;
+	  fMeanr3Com += rnCom[3]*wCom;
+	  fMeanr4Com += rnCom[4]*wCom;
+	  fMeanr5Com += rnCom[5]*wCom;
+	  fMeanr2Cos2PhiCom += rnCom[2]*cosnCom[2]*wCom;
+	  fMeanr2Sin2PhiCom += rnCom[2]*sinnCom[2]*wCom;
+	  fMeanr2Cos3PhiCom += rnCom[2]*cosnCom[3]*wCom;
+	  fMeanr2Sin3PhiCom += rnCom[2]*sinnCom[3]*wCom;
+	  fMeanr2Cos4PhiCom += rnCom[2]*cosnCom[4]*wCom;
+	  fMeanr2Sin4PhiCom += rnCom[2]*sinnCom[4]*wCom;
+	  fMeanr2Cos5PhiCom += rnCom[2]*cosnCom[5]*wCom;
+	  fMeanr2Sin5PhiCom += rnCom[2]*sinnCom[5]*wCom;
+	  fMeanr3Cos3PhiCom += rnCom[3]*cosnCom[3]*wCom;
+	  fMeanr3Sin3PhiCom += rnCom[3]*sinnCom[3]*wCom;
+	  fMeanr4Cos4PhiCom += rnCom[4]*cosnCom[4]*wCom;
+	  fMeanr4Sin4PhiCom += rnCom[4]*sinnCom[4]*wCom;
+	  fMeanr5Cos5PhiCom += rnCom[5]*cosnCom[5]*wCom;
+	  fMeanr5Sin5PhiCom += rnCom[5]*sinnCom[5]*wCom;
 	}
     }
   
@@ -1777,6 +1890,20 @@ void AliGlauberMC::Run(Int_t nevents)
   std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
 }
 
+//---------------------------------------------------------------------------------
+void AliGlauberMC::SetRandomSeed(UInt_t seed, Int_t stream)
+{
+  //seed gRandom reproducibly; jobs using the same seed and different stream
+  //indices get well separated seeds and hence independent samples
+  ULong64_t z = seed + 0x9E3779B97F4A7C15ULL*(ULong64_t)(stream+1);
+  z = (z ^ (z>>30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z>>27)) * 0x94D049BB133111EBULL;
+  z ^= (z>>31);
+  UInt_t s = (UInt_t)(z ^ (z>>32));
+  if (s==0) s = 1; //0 would give a time dependent seed
+  gRandom->SetSeed(s);
+}
+
 //---------------------------------------------------------------------------------
 void AliGlauberMC::RunAndSaveNtuple( Int_t n,
                                      const Option_t *sysA,
@@ -1785,9 +1912,15 @@ void AliGlauberMC::RunAndSaveNtuple( Int_t n,
                                      Double_t mind,
                                      Double_t r,
                                      Double_t a,
-                                     const char *fname)
+                                     const char *fname,
+                                     UInt_t seed,
+                                     Int_t stream)
 {
   //example run
+  //for large samples run several jobs with the same seed and different
+  //stream indices, and merge the resulting ntuples
+  if (seed>0)
+    SetRandomSeed(seed,stream);
   AliGlauberMC mcg(sysA,sysB,signn);
   mcg.SetMinDistance(mind);
   mcg.Setr(r);
@@ -16,6 +16,8 @@
 #include "AliGlauberNucleus.h"
 #include <Riostream.h>
 #include <TNamed.h>
+#include <TArrayD.h>
+#include <TArrayI.h>
 
 class TObjArray;
 class TNtuple;
@@ -100,6 +102,7 @@ public:
    void   Seta(Double_t a)  {fANucleus.SetA(a); fBNucleus.SetA(a);}
    void   SetDoFluc(Double_t omega, Double_t sig0, Double_t lam, Bool_t on=kTRUE) 
             {fDoFluc=on;fOmega=omega;fSig0=sig0;fLambda=lam;}
+   static void       SetRandomSeed(UInt_t seed, Int_t stream=0);
    static void       PrintVersion()         {cout << "AliGlauberMC " << Version() << endl;}
    static const char *Version()             {return "v1.2";}
    static void       RunAndSaveNtuple( Int_t n,
@@ -109,7 +112,9 @@ public:
                                        Double_t mind=0.4,
 				       Double_t r=6.62,
 				       Double_t a=0.546,
-                                       const char *fname="glau_pbpb_ntuple.root");
+                                       const char *fname="glau_pbpb_ntuple.root",
+                                       UInt_t seed=0,
+                                       Int_t stream=0);
    void RunAndSaveNucleons( Int_t n,
                             const Option_t *sysA,
                             const Option_t *sysB,
@@ -251,9 +256,21 @@ private:
    Double_t     fSig0;           //regularization parameter 
    Double_t     fLambda;         //lambda parameter
    TF1         *fSigFluc;        //!parameterization for fluctuating sigNN
+   TArrayD      fXA;             //!x of nucleons in nucleus A (per event copy)
+   TArrayD      fYA;             //!y of nucleons in nucleus A
+   TArrayD      fSigA;           //!sigNN of nucleons in nucleus A
+   TArrayI      fNCollA;         //!number of collisions of nucleons in nucleus A
+   TArrayD      fXB;             //!x of nucleons in nucleus B (per event copy)
+   TArrayD      fYB;             //!y of nucleons in nucleus B
+   TArrayD      fSigB;           //!sigNN of nucleons in nucleus B
+   TArrayI      fNCollB;         //!number of collisions of nucleons in nucleus B
+   TArrayI      fCellStart;      //!first entry of each transverse cell in fCellIndex
+   TArrayI      fCellIndex;      //!nucleons of A sorted by transverse cell
+   void         FillNucleonArrays();
+   void         FindCollisions(Double_t d2max, Double_t &bNN, Double_t &nco, Double_t &ncohc);
    Bool_t       CalcResults(Double_t bgen);
 
-   ClassDef(AliGlauberMC,4)
+   ClassDef(AliGlauberMC,5)
 };
 
 #endif
@@ -376,6 +376,27 @@ AliJetContainer* AliAnalysisTaskEmcalJet::GetJetContainer(const char* name) cons
   return cont;
 }
 
+/**
+ * Get the names of the objects the task reads from the event: in addition
+ * to the collections of the base class the jet arrays and the rho objects.
+ * @param[out] names Names of the objects read from the event
+ */
+void AliAnalysisTaskEmcalJet::GetInputCollections(std::vector<TString> &names) const
+{
+  AliAnalysisTaskEmcal::GetInputCollections(names);
+
+  if (!fRhoName.IsNull()) names.push_back(fRhoName);
+  if (!fLocalRhoName.IsNull()) names.push_back(fLocalRhoName);
+
+  for (Int_t i = 0; i < fJetCollArray.GetEntriesFast(); i++) {
+    AliJetContainer *cont = static_cast<AliJetContainer*>(fJetCollArray.At(i));
+    if (!cont->GetArrayName().IsNull()) names.push_back(cont->GetArrayName());
+    if (!cont->GetRhoName().IsNull()) names.push_back(cont->GetRhoName());
+    if (!cont->GetLocalRhoName().IsNull()) names.push_back(cont->GetLocalRhoName());
+    if (!cont->GetRhoMassName().IsNull()) names.push_back(cont->GetRhoMassName());
+  }
+}
+
 void AliAnalysisTaskEmcalJet::SetJetAcceptanceType(UInt_t t, Int_t c) 
 {
   AliJetContainer *cont = GetJetContainer(c);
@@ -73,6 +73,7 @@ class AliAnalysisTaskEmcalJet : public AliAnalysisTaskEmcal {
   void                        RemoveJetContainer(Int_t i)                        { fJetCollArray.RemoveAt(i);} 
   AliJetContainer            *GetJetContainer(Int_t i=0)                                               const;
   AliJetContainer            *GetJetContainer(const char* name)                                        const;
+  void                        GetInputCollections(std::vector<TString> &names)                         const;
 
  protected:
   virtual Bool_t              AcceptJet(AliEmcalJet* jet, Int_t c =0);
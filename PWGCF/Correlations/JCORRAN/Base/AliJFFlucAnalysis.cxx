@@ -405,9 +405,13 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 				QnB_star[ih] = TComplex(0,0);			
 		}
 		//--------------- Calculate Qn--------------------
+		// all harmonics of both sub events (and the QC Q-vectors) in one pass, same values as CalculateQnSP
+		FillTrackStore( Eta_config );
+		TComplex QnSP[kNSub][kNH];
+		CalculateQvectors( Eta_config, QnSP );
 		for(int ih=0; ih<kNH; ih++){
-				QnA[ih] = CalculateQnSP( Eta_config[kSubA][kMin], Eta_config[kSubA][kMax], ih);
-				QnB[ih] = CalculateQnSP( Eta_config[kSubB][kMin], Eta_config[kSubB][kMax], ih);
+				QnA[ih] = QnSP[kSubA][ih];
+				QnB[ih] = QnSP[kSubB][ih];
 //				fh_Qvector[fCBin][0][ih]->Fill( QnA[ih].Theta() );
 //				fh_Qvector[fCBin][1][ih]->Fill( QnB[ih].Theta() );	
 				QnB_star[ih] = TComplex::Conjugate ( QnB[ih] ) ;
@@ -466,21 +470,38 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 		if( IsEbEWeighted == kTRUE ) ebe_2p_weight = NSubTracks[kSubA] * NSubTracks[kSubB] ; 	
 		if( IsEbEWeighted == kTRUE ) ebe_4p_weight = NSubTracks[kSubA]* NSubTracks[kSubB] * (NSubTracks[kSubA]-1) * (NSubTracks[kSubB]-1) ; 
 
+		// collect the entries and fill them in one batch (same order as the nested loops)
+		int vnIndex[kNH*nKL*3];
+		double vnVal[kNH*nKL], vnW[kNH*nKL];
+		int nvn = 0;
 		for(int ih=2; ih< kNH; ih++){
 				for(int ik=0; ik<nKL; ik++){
-						if(vn2[ih][ik] != -999)	fh_vn[ih][ik][fCBin]->Fill( vn2[ih][ik] , ebe_2p_weight ); // Fill hvn2
+						if(vn2[ih][ik] == -999) continue;
+						int *idx = vnIndex+3*nvn;
+						idx[0] = ih; idx[1] = ik; idx[2] = fCBin;
+						vnW[nvn] = ebe_2p_weight;
+						vnVal[nvn++] = vn2[ih][ik];
 				}
 		}
+		fh_vn.FillBatch( nvn, vnIndex, vnVal, NULL, vnW ); // Fill hvn2
 
+		int vnvnIndex[kNH*nKL*kNH*nKL*5];
+		double vnvnVal[kNH*nKL*kNH*nKL], vnvnW[kNH*nKL*kNH*nKL];
+		int nvnvn = 0;
 		for( int ih=2; ih<kNH; ih++){ 
 				for( int ik=1; ik<nKL; ik++){
 						for( int ihh=2; ihh<kNH; ihh++){ 
 								for(int ikk=1; ikk<nKL; ikk++){
-										if(vn2_vn2[ih][ik][ihh][ikk] != -999 ) fh_vn_vn[ih][ik][ihh][ikk][fCBin]->Fill( vn2_vn2[ih][ik][ihh][ikk], ebe_4p_weight ) ; // Fill hvn_vn 
+										if(vn2_vn2[ih][ik][ihh][ikk] == -999 ) continue;
+										int *idx = vnvnIndex+5*nvnvn;
+										idx[0] = ih; idx[1] = ik; idx[2] = ihh; idx[3] = ikk; idx[4] = fCBin;
+										vnvnW[nvnvn] = ebe_4p_weight;
+										vnvnVal[nvnvn++] = vn2_vn2[ih][ik][ihh][ikk];
 								}
 						}
 				}
 		}
+		fh_vn_vn.FillBatch( nvnvn, vnvnIndex, vnvnVal, NULL, vnvnW ); // Fill hvn_vn
 		///	Fill more correlators in manualy
 		TComplex V4V2starv2_2 =	QnA[4] *TComplex::Power( QnB_star[2] ,2) * vn2[2][1] ;
 		TComplex V4V2starv2_4 = QnA[4] * TComplex::Power( QnB_star[2], 2) * vn2[2][2] ;
@@ -608,20 +629,21 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 				// (c) calculate 2p correaltion
 				// (d) calculate 2p corrleaion with |dEta|>1.0 (for normalized SC)
 
-				//(a)
-				CalculateQvectorsQC(); 
+				//(a) QC q-vectors already filled by CalculateQvectors
 				//(b)
 				Double_t QC_4p_value[6][6] = {-99.};
 				Double_t QC_2p_value[6] = {-99.}; 
 				TComplex four; // declear here
 				TComplex two;
+				Double_t four0 = Four(0,0,0,0).Re(); // number of combinations, same for all harmonics
+				Double_t two0 = Two(0,0).Re();
 
 				for(int ih=2; ih<=5; ih++){
 						for(int ihh=2; ihh<ih; ihh++){
 								Double_t event_weight = 1;
-								if( IsEbEWeighted == kTRUE){event_weight = Four(0,0,0,0).Re();}
+								if( IsEbEWeighted == kTRUE){event_weight = four0;}
 								four = TComplex(-99, -99); // initialize
-								four = Four( ih, ihh, -1*ih, -1*ihh ) / Four(0,0,0,0).Re();
+								four = Four( ih, ihh, -1*ih, -1*ihh ) / four0;
 								fh_SC_with_QC_4corr[ih][ihh][fCBin]->Fill( four.Re(), event_weight );
 								QC_4p_value[ih][ihh] = four.Re();
 						};
@@ -633,9 +655,9 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 						// two(2,2) = Q2 Q2* - Q0 = Q2Q2* - M
 						// two(0,0) = Q0 Q0* - Q0 = M^2 - M 
 						Double_t event_weight = 1;
-						if( IsEbEWeighted == kTRUE){event_weight = Two(0,0).Re();}
+						if( IsEbEWeighted == kTRUE){event_weight = two0;}
 						two = TComplex(-99, -99); // initialize
-						two = Two(ih, -1*ih) / Two(0,0).Re();
+						two = Two(ih, -1*ih) / two0;
 						fh_SC_with_QC_2corr[ih][fCBin]->Fill( two.Re(), event_weight );
 						QC_2p_value[ih] = two.Re();
 						// fill single vn  with QC without EtaGap as mehtod 2
@@ -898,6 +920,98 @@ void AliJFFlucAnalysis::CalculateQvectorsQC(){
 		 */
 }
 //________________________________________________________________________
+void AliJFFlucAnalysis::FillTrackStore( Double_t etaSP[][2] ){
+		// copy phi and eta of the input tracks to flat arrays
+		// the efficiency and phi module correction is only needed (and looked up) for the tracks in the SP eta ranges
+		Long64_t ntracks = fInputList->GetEntriesFast();
+		fTrackPhi.resize( ntracks );
+		fTrackEta.resize( ntracks );
+		fTrackWeight.resize( ntracks );
+		for(Long64_t it=0; it< ntracks; it++){
+				AliJBaseTrack *itrack = (AliJBaseTrack*)fInputList->At(it); // load track
+				Double_t eta = itrack->Eta();
+				Double_t phi = itrack->Phi();
+				fTrackPhi[it] = phi;
+				fTrackEta[it] = eta;
+				fTrackWeight[it] = 0;
+				if( (eta < etaSP[0][0] || eta > etaSP[0][1]) && (eta < etaSP[1][0] || eta > etaSP[1][1]) ) continue; // not in any SP eta range
+
+				Double_t phi_module_corr = 1;
+				int isub = -1;
+				if( eta < 0 ) isub = 0;
+				if( eta > 0 ) isub = 1;
+				if( IsPhiModule == kTRUE && isub >= 0 ){ phi_module_corr = h_phi_module[fCBin][isub]->GetBinContent( (h_phi_module[fCBin][isub]->GetXaxis()->FindBin( phi ) )  );}
+				Double_t effCorr = fEfficiency->GetCorrection( itrack->Pt(), fEffFilterBit, fCent );
+				fTrackWeight[it] = 1./effCorr * phi_module_corr;
+		}
+}
+//________________________________________________________________________
+void AliJFFlucAnalysis::CalculateQvectors( Double_t etaSP[][2], TComplex QnSP[][kNH] ){
+		// Q-vectors of all harmonics in one pass over the track store
+		// SP : weighted Qn of the two sub events, as CalculateQnSP (Qn[0] is the weighted number of tracks)
+		// QC : QvectorQC and QvectorQCeta10, as CalculateQvectorsQC (only with IsSCwithQC)
+		// the sums are done in the same order as in those functions, so the results are identical
+		Double_t qnSP[2][kNH][2] = {{{0.}}}; // isub, ih, re/im
+		Double_t nSP[2] = {0., 0.};
+		Double_t qnQC[kNH][2] = {{0.}};
+		Double_t qnQCeta10[2][kNH][2] = {{{0.}}};
+		Double_t cosn[kNH], sinn[kNH];
+
+		Long64_t ntracks = fTrackPhi.size();
+		for(Long64_t it=0; it< ntracks; it++){
+				Double_t phi = fTrackPhi[it];
+				Double_t eta = fTrackEta[it];
+				Bool_t inSP[2];
+				for(int isub=0; isub<2; isub++) inSP[isub] = !( eta < etaSP[isub][0] || eta > etaSP[isub][1] );
+				Bool_t inQC = IsSCwithQC == kTRUE && !( eta < fQC_eta_cut_min || eta > fQC_eta_cut_max );
+				if( !inSP[0] && !inSP[1] && !inQC ) continue;
+
+				for(int ih=0; ih<kNH; ih++){
+						cosn[ih] = TMath::Cos(ih*phi);
+						sinn[ih] = TMath::Sin(ih*phi);
+				}
+				for(int isub=0; isub<2; isub++){
+						if( !inSP[isub] ) continue;
+						Double_t w = fTrackWeight[it];
+						for(int ih=0; ih<kNH; ih++){
+								qnSP[isub][ih][0] += w * cosn[ih];
+								qnSP[isub][ih][1] += w * sinn[ih];
+						}
+						nSP[isub] += w;
+				}
+				if( !inQC ) continue;
+				for(int ih=0; ih<kNH; ih++){
+						qnQC[ih][0] += cosn[ih];
+						qnQC[ih][1] += sinn[ih];
+				}
+				if( TMath::Abs(eta) > 0.5 ){ // this is for Noramlized SC ( denominator need eta gap )
+						int isub = 0;
+						if( eta > 0 ) isub = 1;
+						for(int ih=0; ih<kNH; ih++){
+								qnQCeta10[isub][ih][0] += cosn[ih];
+								qnQCeta10[isub][ih][1] += sinn[ih];
+						}
+				}
+		}
+
+		for(int isub=0; isub<2; isub++){
+				for(int ih=0; ih<kNH; ih++){
+						QnSP[isub][ih] = TComplex( qnSP[isub][ih][0], qnSP[isub][ih][1] );
+						if( ih !=0 ) QnSP[isub][ih] /= nSP[isub]; // Use Qn[0] as total number of tracks(*eff)
+				}
+		}
+		if( IsSCwithQC != kTRUE ) return;
+		// no weights in the QC Q-vectors : the same for all the powers
+		for(int ih=0; ih<kNH; ih++){
+				for(int ik=0; ik<nKL; ik++){
+						QvectorQC[ih][ik] = TComplex( qnQC[ih][0], qnQC[ih][1] );
+						for(int isub=0; isub<2; isub++){
+								QvectorQCeta10[ih][ik][isub] = TComplex( qnQCeta10[isub][ih][0], qnQCeta10[isub][ih][1] );
+						}
+				}
+		}
+}
+//________________________________________________________________________
 TComplex AliJFFlucAnalysis::Q(int n, int p){
 		// Retrun QvectorQC 
 		// Q{-n, p} = Q{n, p}*
@@ -116,6 +116,14 @@ class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 		TComplex QvectorQC[kNH][nKL]; 
 		TComplex QvectorQCeta10[kNH][nKL][2]; // ksub  
 
+		// Q-vector kernel : all harmonics of the SP sub events and of the QC (and QC |eta|>0.5) Q-vectors
+		// in one pass over a flat copy of the input tracks
+		void FillTrackStore( Double_t etaSP[][2] );
+		void CalculateQvectors( Double_t etaSP[][2], TComplex QnSP[][kNH] );
+		std::vector<Double_t> fTrackPhi;//!
+		std::vector<Double_t> fTrackEta;//!
+		std::vector<Double_t> fTrackWeight;//! 1/eff * phi module correction (only for tracks in the SP eta ranges)
+
 		TH1D *h_phi_module[7][2]; // cent, isub 
 		TFile *inclusFile; // pointer for root file  
 
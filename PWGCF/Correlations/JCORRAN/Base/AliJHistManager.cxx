@@ -260,6 +260,22 @@ void* AliJArrayBase::GetSingleItem(){
     return NULL;
 }
 //_____________________________________________________
+int AliJArrayBase::GlobalIndex( const int * index ){
+    for( int i=0;i<Dimension();i++ )
+        if( OutOf( index[i], 0, SizeOf(i)-1 ) ) return -1;
+    return fAlg->GlobalIndex( index );
+}
+//_____________________________________________________
+void* AliJArrayBase::GetItemAt( int iG ){
+    void * item = fAlg->GetItemAt( iG );
+    if( !item ){
+        fAlg->ReverseIndex( iG ); // BuildItem names the item from the current index
+        BuildItem();
+        item = fAlg->GetItemAt( iG );
+    }
+    return item;
+}
+//_____________________________________________________
 void AliJArrayBase::FixBin(){
     if( Dimension() == 0 ){
         AddDim(1);SetOption("Single");
@@ -636,6 +652,24 @@ AliJTH1Derived<T>::AliJTH1Derived():
 template< typename T>
 AliJTH1Derived<T>::~AliJTH1Derived(){
 }
+//_____________________________________________________
+static void FillItem( TH1D * h, double x, const double * /*y*/, double w ){ h->Fill( x, w ); }
+static void FillItem( TH2D * h, double x, const double * y, double w ){ h->Fill( x, *y, w ); }
+static void FillItem( TProfile * h, double x, const double * y, double w ){ h->Fill( x, *y, w ); }
+//_____________________________________________________
+template< typename T>
+void AliJTH1Derived<T>::FillBatch( int n, const int * index, const double * x, const double * y, const double * w ){
+    // consecutive entries of the same histogram (i.e. the pairs of one trigger) reuse the lookup
+    int nDim = Dimension();
+    int lastG = -1;
+    T * item = NULL;
+    for( int i=0;i<n;i++ ){
+        int iG = GlobalIndex( index+i*nDim );
+        if( iG < 0 ) { JERROR(TString(Form("wrong Index of entry %d in ",i))+GetName()); }
+        if( iG != lastG ){ item = At( iG ); lastG = iG; }
+        FillItem( item, x[i], y?y+i:NULL, w?w[i]:1. );
+    }
+}
 
 
 
@@ -157,6 +157,8 @@ class AliJArrayBase : public AliJNamed{
 
         void * GetItem();
         void * GetSingleItem();
+        int    GlobalIndex( const int * index ); // flat index of a full index tuple, -1 if out of range
+        void * GetItemAt( int iG );              // item at a flat index, built if not yet there
 
         ///void LockBin(bool is=true){}//TODO
         //bool IsBinLocked(){ return fIsBinLocked; }
@@ -215,6 +217,9 @@ class AliJArrayAlgorithm {
         virtual bool IsCurrentPosition(void * pos)=0;
         virtual void SetPosition(void * pos )=0;
         virtual void DeletePosition( void * pos ) =0;
+        virtual int  GlobalIndex( const int * index )=0;
+        virtual void * GetItemAt( int iG )=0;
+        virtual void ReverseIndex( int iG )=0;
     protected:
         AliJArrayBase * fCMD;
 };
@@ -228,7 +233,13 @@ class AliJArrayAlgorithmSimple : public AliJArrayAlgorithm {
         virtual ~AliJArrayAlgorithmSimple();
         virtual int BuildArray();
         int  GlobalIndex();
-        void ReverseIndex(int iG );
+        virtual int  GlobalIndex( const int * index ){
+            int iG = 0;
+            for( int i=0;i<Dimension();i++ ) iG+= index[i]*fDimFactor[i]; // Index is checked by fCMD
+            return iG;
+        }
+        virtual void * GetItemAt( int iG ){ return fArray[iG]; }
+        virtual void ReverseIndex(int iG );
         virtual void * GetItem();
         virtual void SetItem(void * item);
         virtual void InitIterator(){ fPos = 0; }
@@ -317,6 +328,17 @@ class AliJTH1Derived : public AliJTH1 {
         AliJTH1DerivedPlayer<T> & operator[](int i){ fPlayer.Init();fPlayer[i];return fPlayer; }
         T * operator->(){ return static_cast<T*>(GetSingleItem()); }
         operator T*(){ return static_cast<T*>(GetSingleItem()); }
+        // Direct access without the player : one flat array lookup per full index tuple
+        T * At( int iG ){ return static_cast<T*>(GetItemAt(iG)); }
+        T * At( const int * index ){
+            int iG = GlobalIndex( index );
+            if( iG < 0 ) { JERROR(TString("wrong Index in ")+GetName()); }
+            return At( iG );
+        }
+        // Fill n entries, entry i goes to the histogram of the index tuple index[i*Dimension()...]
+        // with Fill(x[i],w[i]) for TH1D, Fill(x[i],y[i],w[i]) for TH2D and TProfile.
+        // y is unused (can be NULL) for TH1D, w=NULL fills with weight 1. An index out of range is an error, as in At().
+        void FillBatch( int n, const int * index, const double * x, const double * y, const double * w );
         // Virtual from AliJArrayBase
 
         // Virtual from AliJTH1
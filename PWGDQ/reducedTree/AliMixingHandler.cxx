@@ -44,7 +44,8 @@ AliMixingHandler::AliMixingHandler() :
   fCentralityVariable(AliReducedVarManager::kNothing),
   fEventVertexVariable(AliReducedVarManager::kNothing),
   fEventPlaneVariable(AliReducedVarManager::kNothing),
-  fHistos(0x0)
+  fHistos(0x0),
+  fHistClassArr(0x0)
 {
   // 
   // default constructor
@@ -79,7 +80,8 @@ AliMixingHandler::AliMixingHandler(const Char_t* name, const Char_t* title) :
   fCentralityVariable(AliReducedVarManager::kNothing),
   fEventVertexVariable(AliReducedVarManager::kNothing),
   fEventPlaneVariable(AliReducedVarManager::kNothing),
-  fHistos(0x0)
+  fHistos(0x0),
+  fHistClassArr(0x0)
 {
   //
   // Named constructor
@@ -99,6 +101,7 @@ AliMixingHandler::~AliMixingHandler() {
   //
   // destructor
   //
+  if(fHistClassArr) {fHistClassArr->Delete(); delete fHistClassArr;}
 }
 
 
@@ -132,10 +135,11 @@ void AliMixingHandler::Init() {
     cout << "AliMixingHandler::Init(): ERROR No names for the histogram classes provided!" << endl;
     return;
   }
-  TObjArray* histClassArr = fHistClassNames.Tokenize(";");
-  if(histClassArr->GetEntries()!=3*fNParallelCuts) {       // 3 because there is one class of histograms for each pair type: ++,+- and --
+  if(fHistClassArr) {fHistClassArr->Delete(); delete fHistClassArr;}
+  fHistClassArr = fHistClassNames.Tokenize(";");
+  if(fHistClassArr->GetEntries()!=3*fNParallelCuts) {       // 3 because there is one class of histograms for each pair type: ++,+- and --
     cout << "AliMixingHandler::Init(): ERROR The number of cuts and the number of hist class names provided do not match!" << endl;
-    cout << "                   hist classes: " << histClassArr->GetEntries() << ";    n-parallel cuts: " << fNParallelCuts << endl;
+    cout << "                   hist classes: " << fHistClassArr->GetEntries() << ";    n-parallel cuts: " << fNParallelCuts << endl;
     return;
   }
   Int_t size = (fCentralityLimits.GetSize()-1)*(fEventVertexLimits.GetSize()-1)*(fEventPlaneLimits.GetSize()-1);
@@ -181,23 +185,28 @@ void AliMixingHandler::FillEvent(TList* leg1List, TList* leg2List, Float_t* valu
   if(category<0) return;   // event characteristics outside the defined ranges
   
   TClonesArray *leg1PoolP = static_cast<TClonesArray*>(fPoolsLeg1.At(category));
-  if(!leg1PoolP) leg1PoolP = new(fPoolsLeg1[category]) TClonesArray("TList",1);
+  if(!leg1PoolP) leg1PoolP = new(fPoolsLeg1[category]) TClonesArray("TClonesArray",fPoolDepth);
   leg1PoolP->SetOwner(kTRUE);
   TClonesArray *leg2PoolP=static_cast<TClonesArray*>(fPoolsLeg2.At(category));
-  if(!leg2PoolP) leg2PoolP = new(fPoolsLeg2[category]) TClonesArray("TList",1);
+  if(!leg2PoolP) leg2PoolP = new(fPoolsLeg2[category]) TClonesArray("TClonesArray",fPoolDepth);
   leg2PoolP->SetOwner(kTRUE);
   
   TClonesArray &leg1Pool=*leg1PoolP;
   TClonesArray &leg2Pool=*leg2PoolP;
   
-  // add the leg lists to the appropriate pools
-  TList *list1 = new(leg1Pool[leg1Pool.GetEntries()]) TList();
-  TList *list2 = new(leg2Pool[leg2Pool.GetEntries()]) TList();
-  list1->SetOwner(kTRUE); list2->SetOwner(kTRUE);
-  for(Int_t it=0; it<leg1List->GetEntries(); ++it) 
-    list1->Add(leg1List->At(it)->Clone());
-  for(Int_t it=0; it<leg2List->GetEntries(); ++it) 
-    list2->Add(leg2List->At(it)->Clone());
+  // add the legs to the appropriate pools
+  // NOTE: only the AliReducedBaseTrack part of the legs is stored, which is all the information needed 
+  //       by AliReducedVarManager::FillPairInfoME(). This keeps the pools compact in memory. 
+  TClonesArray *list1 = new(leg1Pool[leg1Pool.GetEntriesFast()]) TClonesArray("AliReducedBaseTrack",TMath::Max(1,leg1List->GetEntries()));
+  TClonesArray *list2 = new(leg2Pool[leg2Pool.GetEntriesFast()]) TClonesArray("AliReducedBaseTrack",TMath::Max(1,leg2List->GetEntries()));
+  TClonesArray &legs1=*list1;
+  TClonesArray &legs2=*list2;
+  TIter nextLeg1(leg1List); AliReducedBaseTrack* track=0x0;
+  while((track=(AliReducedBaseTrack*)nextLeg1())) 
+    new(legs1[legs1.GetEntriesFast()]) AliReducedBaseTrack(*track);
+  TIter nextLeg2(leg2List);
+  while((track=(AliReducedBaseTrack*)nextLeg2())) 
+    new(legs2[legs2.GetEntriesFast()]) AliReducedBaseTrack(*track);
     
   // increment the size of the pools in this category
   ULong_t mixingMask = IncrementPoolSizes(leg1List,leg2List,category);
@@ -357,7 +366,7 @@ void AliMixingHandler::RunLeftoverMixing(Int_t type) {
   for(Int_t i=0; i<fNParallelCuts; ++i) mixingMask |= (ULong_t(1)<<i);
   Float_t values[AliReducedVarManager::kNVars];
   
-  for(Int_t icateg=0; icateg<fPoolsLeg1.GetEntries(); ++icateg) {
+  for(Int_t icateg=0; icateg<fPoolsLeg1.GetEntriesFast(); ++icateg) {
     TClonesArray *leg1Pool = static_cast<TClonesArray*>(fPoolsLeg1.At(icateg));
     TClonesArray *leg2Pool = static_cast<TClonesArray*>(fPoolsLeg2.At(icateg));
     if(!leg1Pool) continue;
@@ -382,194 +391,124 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
   // Run event mixing
   // NOTE: The mixingMask is a bit map with bits toggled for the pools which need mixing
   //       The type is the pair candidate type. It is used in AliReducedPairInfo::CandidateType, mainly to know which mass assumption to be made for the legs
+  //       The OR of the leg flags is computed once per stored event, such that event pairs and leg lists 
+  //       without any common enabled cut are skipped without looping over their tracks
   //
-  //cout << "AliMixingHandler::RunEventMixing for mask " << flush;
-  //AliReducedVarManager::PrintBits(mixingMask,fNParallelCuts);
-  //cout << ";  (cent/vtx/ep): " << values[fCentralityVariable] << "/"
-  //     << values[fEventVertexVariable] << "/" << values[fEventPlaneVariable] << endl;
-  
-  Int_t entries = leg1Pool->GetEntries();
+  Int_t entries = leg1Pool->GetEntriesFast();
   if(entries<2) return;
+  if(!fHistClassArr) return;
   
-  TObjArray* histClassArr = fHistClassNames.Tokenize(";");
+  ULong_t* leg1Flags = new ULong_t[entries];
+  ULong_t* leg2Flags = new ULong_t[entries];
+  for(Int_t iev=0; iev<entries; ++iev) {
+    leg1Flags[iev] = mixingMask & GetLegsFlags((TClonesArray*)leg1Pool->UncheckedAt(iev));
+    leg2Flags[iev] = mixingMask & GetLegsFlags((TClonesArray*)leg2Pool->UncheckedAt(iev));
+  }
   
-  TIter iterEv1Leg1Pool(leg1Pool);
-  TIter iterEv1Leg2Pool(leg2Pool);
-  ULong_t testFlags1 = 0;
-  ULong_t testFlags2 = 0;
   for(Int_t iev1=0; iev1<entries; ++iev1) {                            // first event loop
+    if(!(leg1Flags[iev1] || leg2Flags[iev1])) continue;
     // get the lists of leg1 and leg2 tracks for the first event
-    TList* ev1Leg1List = (TList*)iterEv1Leg1Pool();
-    TList* ev1Leg2List = (TList*)iterEv1Leg2Pool();
-    //cout << "## iev1 " << iev1 << endl;
+    TClonesArray* ev1Leg1List = (TClonesArray*)leg1Pool->UncheckedAt(iev1);
+    TClonesArray* ev1Leg2List = (TClonesArray*)leg2Pool->UncheckedAt(iev1);
     
-    TIter iterEv2Leg1Pool(leg1Pool);
-    TIter iterEv2Leg2Pool(leg2Pool);
     for(Int_t iev2=0; iev2<entries; ++iev2) {                         // second event loop 
-      TList* ev2Leg1List = (TList*)iterEv2Leg1Pool();
-      TList* ev2Leg2List = (TList*)iterEv2Leg2Pool();
       if(iev1==iev2) continue;
-      //cout << "#### iev2 " << iev2 << endl;
-      
-      //loop over the ev1-leg1 list
-      TIter iterLeg1(ev1Leg1List);
-      AliReducedBaseTrack* ev1Leg1=0x0;
-      while((ev1Leg1=(AliReducedBaseTrack*)iterLeg1())) {
-	// check that this track has at least one common bit with the mixing mask
-	testFlags1 = mixingMask & ev1Leg1->GetFlags();
-        //cout << "###### ev1Leg1 (p/px/testFlags1): " << ev1Leg1->P() << "/" << ev1Leg1->Px() << "/";
-        //AliReducedVarManager::PrintBits(testFlags1, fNParallelCuts); cout << endl;
-	if(!testFlags1) continue;
-	
-	//loop over the ev2-leg2 list 
-	TIter iterLeg2(ev2Leg2List);
-	AliReducedBaseTrack* ev2Leg2=0x0;
-	while((ev2Leg2=(AliReducedBaseTrack*)iterLeg2())) {
-	  // check that this track has at least one common bit with the mixing mask and with ev1-leg1
-	  testFlags2 = testFlags1 & ev2Leg2->GetFlags();
-          //cout << "###### ev2Leg2 (p/px/testFlags1): " << ev2Leg2->P() << "/" << ev2Leg2->Px() << "/";
-          //AliReducedVarManager::PrintBits(testFlags2, fNParallelCuts); cout << endl;
-	  if(!testFlags2) continue;
-	  
-	  // fill cross-pairs (leg1 - leg2) for the enabled bits
-	  AliReducedVarManager::FillPairInfoME(ev1Leg1, ev2Leg2, type, values);
-          //cout << "######## cross-pair (mass): " << values[AliReducedVarManager::kMass] << endl;
-	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-            if((testFlags2)&(ULong_t(1)<<ibit)) 
-              fHistos->FillHistClass(histClassArr->At(ibit*3+1)->GetName(), values);
-          }  
-	}  // end loop over the ev2-leg2 list
-	
-	if(!fMixLikeSign) continue;
-	// loop over the ev2-leg1 list
-	TIter iterLeg1LS(ev2Leg1List);
-	AliReducedBaseTrack* ev2Leg1=0x0;
-	while((ev2Leg1=(AliReducedBaseTrack*)iterLeg1LS())) {
-	  // check that this track has at least one common bit with the mixing mask and with ev1-leg1
-	  testFlags2 = testFlags1 & ev2Leg1->GetFlags();
-          //cout << "###### ev2Leg1 (p/px/testFlags2): " << ev2Leg1->P() << "/" << ev2Leg1->Px() << "/";
-          //AliReducedVarManager::PrintBits(testFlags2, fNParallelCuts); cout << endl;
-	  if(!testFlags2) continue;
-	  
-	  // fill like-pairs (leg1 - leg1) for the enabled bits
-	  AliReducedVarManager::FillPairInfoME(ev1Leg1, ev2Leg1, type, values);
-          //cout << "######## like-pair leg1-leg1 (mass): " << values[AliReducedVarManager::kMass] << endl;
-	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-            if((testFlags2)&(ULong_t(1)<<ibit)) 
-              fHistos->FillHistClass(histClassArr->At(ibit*3+0)->GetName(), values);
-          }  
-	}  // end loop over the ev2-leg1 list
-      }  // end loop over the ev1-leg1 list
+      TClonesArray* ev2Leg1List = (TClonesArray*)leg1Pool->UncheckedAt(iev2);
+      TClonesArray* ev2Leg2List = (TClonesArray*)leg2Pool->UncheckedAt(iev2);
       
+      // cross-pairs (leg1 - leg2)
+      if(leg1Flags[iev1] & leg2Flags[iev2]) 
+        MixLegs(ev1Leg1List, ev2Leg2List, leg1Flags[iev1] & leg2Flags[iev2], type, values, 1);
       if(!fMixLikeSign) continue;
-      //loop over the ev1-leg2 list
-      TIter iterLeg2(ev1Leg2List);
-      AliReducedBaseTrack* ev1Leg2=0x0;
-      while((ev1Leg2=(AliReducedBaseTrack*)iterLeg2())) {
-	// check that this track has at least one common bit with the mixing mask
-	testFlags1 = mixingMask & ev1Leg2->GetFlags();
-        //cout << "###### ev1Leg2 (p/px/testFlags1): " << ev1Leg2->P() << "/" << ev1Leg2->Px() << "/";
-        //AliReducedVarManager::PrintBits(testFlags1, fNParallelCuts); cout << endl;
-	if(!testFlags1) continue;
-	
-	//loop over the ev2-leg2 list 
-	TIter iterLeg2LS(ev2Leg2List);
-	AliReducedBaseTrack* ev2Leg2=0x0;
-	while((ev2Leg2=(AliReducedBaseTrack*)iterLeg2LS())) {
-	  // check that this track has at least one common bit with the mixing mask and with ev1-leg1
-	  testFlags2 = testFlags1 & ev2Leg2->GetFlags();
-          //cout << "###### ev2Leg2 (p/px/testFlags2): " << ev2Leg2->P() << "/" << ev2Leg2->Px() << "/";
-          //AliReducedVarManager::PrintBits(testFlags2, fNParallelCuts); cout << endl;
-	  if(!testFlags2) continue;
-	  
-	  // fill like-pairs (leg2 - leg2) for the enabled bits
-	  AliReducedVarManager::FillPairInfoME(ev1Leg2, ev2Leg2, type, values);
-          //cout << "######## like-pair leg2-leg2 (mass): " << values[AliReducedVarManager::kMass] << endl;
-	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-            if((testFlags2)&(ULong_t(1)<<ibit)) 
-              fHistos->FillHistClass(histClassArr->At(ibit*3+2)->GetName(), values);
-          }  
-	}  // end loop over the ev2-leg2 list
-      }  // end loop over the ev1-leg2 list
+      // like-pairs (leg1 - leg1)
+      if(leg1Flags[iev1] & leg1Flags[iev2]) 
+        MixLegs(ev1Leg1List, ev2Leg1List, leg1Flags[iev1] & leg1Flags[iev2], type, values, 0);
+      // like-pairs (leg2 - leg2)
+      if(leg2Flags[iev1] & leg2Flags[iev2]) 
+        MixLegs(ev1Leg2List, ev2Leg2List, leg2Flags[iev1] & leg2Flags[iev2], type, values, 2);
     }  // end second event loop
   }  // end first event loop
   
-  // unset the mixing flags --------------------------------------
-  iterEv1Leg1Pool.Reset(); 
-  iterEv1Leg2Pool.Reset();
-  //cout << "Unsetting bits for which mixing was performed" << endl;
-  for(Int_t ie1=0; ie1<entries; ++ie1) {
-    TList* leg1List = (TList*)iterEv1Leg1Pool();        
-    TIter iterLeg1(leg1List);
-    AliReducedBaseTrack* track=0x0;
-    while((track=(AliReducedBaseTrack*)iterLeg1())) {
-      //cout << "leg1 p " << track->P() << "     " << flush; 
-      //AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << "/" << flush;
-      testFlags1 = mixingMask & track->GetFlags();
-      if(!testFlags1) {
-	//AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << endl;
-	continue;
-      }
-      for(UShort_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-	if((testFlags1)&(ULong_t(1)<<ibit)) 
-	  track->UnsetFlag(ibit);
-      }
-      //AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << endl;
-    }  // end loop over the first leg list
+  delete [] leg1Flags;
+  delete [] leg2Flags;
+  
+  CleanPool(leg1Pool, leg2Pool, mixingMask);
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::MixLegs(TClonesArray* legs1, TClonesArray* legs2, ULong_t mixingMask,
+                               Int_t type, Float_t* values, Int_t histClassOffset) {
+  //
+  // Make all pairs between the legs in legs1 and legs2 which have at least one common bit with the mixing mask
+  // and fill them into the histogram classes of the enabled cuts
+  // NOTE: histClassOffset selects the pair type in the histogram class list: 0 (++), 1 (+-), 2 (--)
+  //
+  ULong_t testFlags1 = 0;
+  ULong_t testFlags2 = 0;
+  Int_t nLegs1 = legs1->GetEntriesFast();
+  Int_t nLegs2 = legs2->GetEntriesFast();
+  for(Int_t it1=0; it1<nLegs1; ++it1) {
+    AliReducedBaseTrack* leg1 = (AliReducedBaseTrack*)legs1->UncheckedAt(it1);
+    // check that this track has at least one common bit with the mixing mask
+    testFlags1 = mixingMask & leg1->GetFlags();
+    if(!testFlags1) continue;
     
-    TList* leg2List = (TList*)iterEv1Leg2Pool();
-    TIter iterLeg2(leg2List);
-    while((track=(AliReducedBaseTrack*)iterLeg2())) {
-      //cout << "leg2 p " << track->P() << "     " << flush; 
-      //AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << "/" << flush;
-      testFlags1 = mixingMask & track->GetFlags();
-      if(!testFlags1) {
-	//AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << endl;
-	continue;
-      }
-      for(UShort_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-	if((testFlags1)&(ULong_t(1)<<ibit)) 
-	  track->UnsetFlag(ibit);
+    for(Int_t it2=0; it2<nLegs2; ++it2) {
+      AliReducedBaseTrack* leg2 = (AliReducedBaseTrack*)legs2->UncheckedAt(it2);
+      // check that this track has at least one common bit with the mixing mask and with the first leg
+      testFlags2 = testFlags1 & leg2->GetFlags();
+      if(!testFlags2) continue;
+      
+      AliReducedVarManager::FillPairInfoME(leg1, leg2, type, values);
+      for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
+        if((testFlags2)&(ULong_t(1)<<ibit)) 
+          fHistos->FillHistClass(fHistClassArr->At(ibit*3+histClassOffset)->GetName(), values);
       }
-      //AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << endl;
     }  // end loop over the second leg list
-  }  // end loop over events
-  
-  // clean the tracks which don't have enabled mixing flags anymore
-  AliReducedBaseTrack* track=0x0;
-  // leg1 lists
-  iterEv1Leg1Pool.Reset(); TList* leg1List=0x0;
-  while((leg1List=(TList*)iterEv1Leg1Pool())) {
-    TIter iterLeg1(leg1List);
-    while((track=(AliReducedBaseTrack*)iterLeg1())) {
-      //AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << flush;
-      if(!track->GetFlags()) {
-         leg1List->Remove(track); delete track;
-      }
-    }
-  }  // end while
-  // leg2 lists
-  iterEv1Leg2Pool.Reset(); TList* leg2List=0x0;
-  while((leg2List=(TList*)iterEv1Leg2Pool())) {  
-    TIter iterLeg2(leg2List);
-    while((track=(AliReducedBaseTrack*)iterLeg2())) {
-      //AliReducedVarManager::PrintBits(track->GetFlags(),fNParallelCuts); cout << flush;
-      if(!track->GetFlags()) {
-         leg2List->Remove(track); delete track;
+  }  // end loop over the first leg list
+}
+
+
+//_________________________________________________________________________
+ULong_t AliMixingHandler::GetLegsFlags(TClonesArray* legs) const {
+  //
+  // Return the OR of the flags of all the legs in the list
+  //
+  ULong_t flags = 0;
+  for(Int_t it=0; it<legs->GetEntriesFast(); ++it) 
+    flags |= ((AliReducedBaseTrack*)legs->UncheckedAt(it))->GetFlags();
+  return flags;
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::CleanPool(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask) {
+  //
+  // Unset the bits for which mixing was performed, remove the legs without any enabled mixing flags
+  // and the events without any legs left
+  //
+  for(Int_t iev=leg1Pool->GetEntriesFast()-1; iev>=0; --iev) {
+    TClonesArray* legLists[2] = {(TClonesArray*)leg1Pool->UncheckedAt(iev), (TClonesArray*)leg2Pool->UncheckedAt(iev)};
+    for(Int_t ilist=0; ilist<2; ++ilist) {
+      TClonesArray* legs = legLists[ilist];
+      Bool_t removed = kFALSE;
+      for(Int_t it=legs->GetEntriesFast()-1; it>=0; --it) {
+        AliReducedBaseTrack* track = (AliReducedBaseTrack*)legs->UncheckedAt(it);
+        track->SetFlags(track->GetFlags() & ~mixingMask);
+        if(!track->GetFlags()) {legs->RemoveAt(it); removed = kTRUE;}
       }
+      if(removed) legs->Compress();
     }
-  }  // end while
-  
-  // clean the events without any tracks left
-  for(Int_t i=leg1Pool->GetEntries()-1;i>=0;--i) {
-    leg1List=(TList*)leg1Pool->At(i);
-    leg2List=(TList*)leg2Pool->At(i);
-    if(leg1List->GetEntries()==0 && 
-       leg2List->GetEntries()==0) {
-       leg1Pool->RemoveAt(i); leg1Pool->Compress(); //delete leg1List;
-       leg2Pool->RemoveAt(i); leg2Pool->Compress(); //delete leg2List;
+    
+    // clean the events without any tracks left
+    if(legLists[0]->GetEntriesFast()==0 && legLists[1]->GetEntriesFast()==0) {
+      leg1Pool->RemoveAt(iev);
+      leg2Pool->RemoveAt(iev);
     }
   }
+  leg1Pool->Compress();
+  leg2Pool->Compress();
 }
 
 
@@ -634,8 +573,8 @@ void AliMixingHandler::PrintMixingLists(Int_t debugLevel) {
         TIter iterLeg1Pool(leg1PoolP);
 	TIter iterLeg2Pool(leg2PoolP);
 	for(Int_t iev=0; iev<leg1Pool.GetEntries(); ++iev) {
-	  TList* leg1List = (TList*)iterLeg1Pool();
-	  TList* leg2List = (TList*)iterLeg2Pool();
+	  TClonesArray* leg1List = (TClonesArray*)iterLeg1Pool();
+	  TClonesArray* leg2List = (TClonesArray*)iterLeg2Pool();
 	  cout << "	Event #" << iev << ";  No. of tracks (leg1/leg2) :: " 
 	       << leg1List->GetEntries() << " / " << leg2List->GetEntries() << endl;
 	  if(debugLevel<3) continue;
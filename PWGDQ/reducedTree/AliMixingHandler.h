@@ -12,6 +12,7 @@
 #include <TArrayI.h>
 #include <TClonesArray.h>
 #include <TList.h>
+#include <TObjArray.h>
 #include <TString.h>
 
 #include "AliHistogramManager.h"
@@ -68,8 +69,8 @@ private:
   Float_t fDownscaleEvents;      // random downscale adding events to the pools
   Float_t fDownscaleTracks;      // random downscale adding tracks fo the pools
   
-  TClonesArray fPoolsLeg1;         // array of pools
-  TClonesArray fPoolsLeg2;         // array of pools
+  TClonesArray fPoolsLeg1;         // array of pools, one TClonesArray of per-event leg records (AliReducedBaseTrack) per category
+  TClonesArray fPoolsLeg2;         // array of pools, one TClonesArray of per-event leg records (AliReducedBaseTrack) per category
   Int_t fNParallelCuts;            // number of parallel cuts which are run
   TString fHistClassNames;         // name of the histogram classes for each cut, separated by a semicolon ";"
   TArrayI fPoolSize;               // counters for the pool sizes
@@ -84,12 +85,16 @@ private:
   AliReducedVarManager::Variables fEventPlaneVariable;
   
   AliHistogramManager* fHistos;    // histogram manager
+  TObjArray* fHistClassArr;        //! tokenized histogram class names, built once in Init()
   
   void RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask, Int_t type, Float_t* values);
+  void MixLegs(TClonesArray* legs1, TClonesArray* legs2, ULong_t mixingMask, Int_t type, Float_t* values, Int_t histClassOffset);
+  void CleanPool(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask);
+  ULong_t GetLegsFlags(TClonesArray* legs) const;
   ULong_t IncrementPoolSizes(TList* list1, TList* list2, Int_t eventCategory);
   void ResetPoolSizes(ULong_t mixingMask, Int_t category);  
   
-  ClassDef(AliMixingHandler,1);
+  ClassDef(AliMixingHandler,2);
 };
 
 #endif
@@ -12,6 +12,7 @@
 class AliReducedBaseTrack : public TObject {
   
   friend class AliAnalysisTaskReducedTreeMaker;  // friend analysis task which fills the object
+  friend class AliMixingHandler;                 // stores compact copies of the legs in the mixing pools
   
   public:
     AliReducedBaseTrack();
@@ -310,7 +310,8 @@ AliAnalysisTaskGammaCalo::AliAnalysisTaskGammaCalo(): AliAnalysisTaskSE(),
   fMaxTimingCluster(0),
   fEnableSortForClusMC(kFALSE),
   fProduceTreeEOverP(kFALSE),
-  fProduceCellIDPlots(kFALSE)
+  fProduceCellIDPlots(kFALSE),
+  fPhotonPairs(NULL)
 {
   
 }
@@ -565,7 +566,8 @@ AliAnalysisTaskGammaCalo::AliAnalysisTaskGammaCalo(const char *name):
   fMaxTimingCluster(0),
   fEnableSortForClusMC(kFALSE),
   fProduceTreeEOverP(kFALSE),
-  fProduceCellIDPlots(kFALSE)
+  fProduceCellIDPlots(kFALSE),
+  fPhotonPairs(NULL)
 {
   // Define output slots here
   DefineOutput(1, TList::Class());
@@ -577,6 +579,10 @@ AliAnalysisTaskGammaCalo::~AliAnalysisTaskGammaCalo()
     delete fClusterCandidates;
     fClusterCandidates = 0x0;
   }
+  if(fPhotonPairs){
+    delete fPhotonPairs;
+    fPhotonPairs = 0x0;
+  }
   if(fBGHandler){
     delete[] fBGHandler;
     fBGHandler = 0x0;
@@ -698,6 +704,8 @@ void AliAnalysisTaskGammaCalo::UserCreateOutputObjects(){
   // Array of current cut's gammas
   fClusterCandidates  = new TList();
   fClusterCandidates->SetOwner(kTRUE);
+  // Kinematics of the current cut's photon pairs
+  fPhotonPairs        = new AliConversionPhotonPairs();
   
   fCutFolder          = new TList*[fnCuts];
   fESDList            = new TList*[fnCuts];
@@ -3030,89 +3038,92 @@ void AliAnalysisTaskGammaCalo::CalculatePi0Candidates(){
   
   // Conversion Gammas
   if(fClusterCandidates->GetEntries()>0){
-
-    for(Int_t firstGammaIndex=0;firstGammaIndex<fClusterCandidates->GetEntries();firstGammaIndex++){
-      AliAODConversionPhoton *gamma0=dynamic_cast<AliAODConversionPhoton*>(fClusterCandidates->At(firstGammaIndex));
-      if (gamma0==NULL) continue;
+    AliConversionMesonCuts *mesonCuts = (AliConversionMesonCuts*)fMesonCutArray->At(fiCut);
+    Double_t etaShift                 = ((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift();
+    // kinematics of all cluster pairs of the event in one pass
+    Int_t nPairs = fPhotonPairs->ComputePairs(fClusterCandidates);
+    for(Int_t iPair=0;iPair<nPairs;iPair++){
+      Int_t firstGammaIndex  = fPhotonPairs->GetFirst(iPair);
+      Int_t secondGammaIndex = fPhotonPairs->GetSecond(iPair);
+      AliAODConversionPhoton *gamma0=(AliAODConversionPhoton*)(fClusterCandidates->At(firstGammaIndex));
+      AliAODConversionPhoton *gamma1=(AliAODConversionPhoton*)(fClusterCandidates->At(secondGammaIndex));
       if ( fDoInOutTimingCluster ){
-        Double_t tof = fInputEvent->GetCaloCluster(gamma0->GetCaloClusterRef())->GetTOF();
-        if ( tof < fMinTimingCluster || tof > fMaxTimingCluster ) continue;
+        Double_t tof0 = fInputEvent->GetCaloCluster(gamma0->GetCaloClusterRef())->GetTOF();
+        if ( tof0 < fMinTimingCluster || tof0 > fMaxTimingCluster ) continue;
+        Double_t tof1 = fInputEvent->GetCaloCluster(gamma1->GetCaloClusterRef())->GetTOF();
+        if ( tof1 > fMinTimingCluster && tof1 < fMaxTimingCluster ) continue;
       }
-      
-      for(Int_t secondGammaIndex=firstGammaIndex+1;secondGammaIndex<fClusterCandidates->GetEntries();secondGammaIndex++){
-        AliAODConversionPhoton *gamma1=dynamic_cast<AliAODConversionPhoton*>(fClusterCandidates->At(secondGammaIndex));
-        if (gamma1==NULL) continue;
-        if ( fDoInOutTimingCluster ){
-          Double_t tof = fInputEvent->GetCaloCluster(gamma1->GetCaloClusterRef())->GetTOF();
-          if ( tof > fMinTimingCluster && tof < fMaxTimingCluster ) continue;
-        }
+
+      // kinematic meson cuts on the pair columns, the mother is only built for the accepted pairs
+      Int_t cutIndex = 0;
+      if(!mesonCuts->MesonIsSelectedKinematics(fPhotonPairs->GetMass(iPair),fPhotonPairs->GetPt(iPair),fPhotonPairs->GetE(iPair),fPhotonPairs->GetPz(iPair),
+                                               fPhotonPairs->GetOpeningAngle(iPair),fPhotonPairs->GetAlpha(iPair),cutIndex,kTRUE,etaShift)) continue;
+
+      AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
+      pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
+
+      if(mesonCuts->MesonIsSelectedDCA(pi0cand,cutIndex,kTRUE)){
+        fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), fWeightJetJetMC);
+        // fill new histograms
+        if(!fDoLightOutput && TMath::Abs(pi0cand->GetAlpha())<0.1)
+          fHistoMotherInvMassPtAlpha[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), fWeightJetJetMC);
         
-        AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
-        pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
-                
-        if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
-          fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), fWeightJetJetMC);
-          // fill new histograms
-          if(!fDoLightOutput && TMath::Abs(pi0cand->GetAlpha())<0.1)
-            fHistoMotherInvMassPtAlpha[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), fWeightJetJetMC);
-          
-          if (fDoMesonQA > 0 && fDoMesonQA < 3){
-            if ( pi0cand->M() > 0.05 && pi0cand->M() < 0.17){
-              fHistoMotherPi0PtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(), fWeightJetJetMC);
-              fHistoMotherPi0PtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()), fWeightJetJetMC);
-              fHistoMotherPi0PtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(), fWeightJetJetMC);
-            }
-            if ( pi0cand->M() > 0.45 && pi0cand->M() < 0.65){
-              fHistoMotherEtaPtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(), fWeightJetJetMC);
-              fHistoMotherEtaPtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()), fWeightJetJetMC);
-              fHistoMotherEtaPtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(),  fWeightJetJetMC);
-            }
+        if (fDoMesonQA > 0 && fDoMesonQA < 3){
+          if ( pi0cand->M() > 0.05 && pi0cand->M() < 0.17){
+            fHistoMotherPi0PtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(), fWeightJetJetMC);
+            fHistoMotherPi0PtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()), fWeightJetJetMC);
+            fHistoMotherPi0PtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(), fWeightJetJetMC);
           }
-          if(fDoTHnSparse && ((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->DoBGCalculation()){
-            Int_t zbin = 0;
-            Int_t mbin = 0;
-            
-            if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
-              zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
-              if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
-                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
-              } else {
-                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fClusterCandidates->GetEntries());
-              }
-            } 
-            Double_t sparesFill[4] = {pi0cand->M(),pi0cand->Pt(),(Double_t)zbin,(Double_t)mbin};
-            fSparseMotherInvMassPtZM[fiCut]->Fill(sparesFill,1);
+          if ( pi0cand->M() > 0.45 && pi0cand->M() < 0.65){
+            fHistoMotherEtaPtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(), fWeightJetJetMC);
+            fHistoMotherEtaPtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()), fWeightJetJetMC);
+            fHistoMotherEtaPtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(),  fWeightJetJetMC);
           }
-
-          if(fDoMesonQA == 4  && fIsMC == 0 && (pi0cand->Pt() > 13.) ){
-            Int_t zbin = 0;
-            Int_t mbin = 0;
-            if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
-              zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
-              if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
-                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
-              } else {
-                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fClusterCandidates->GetEntries());
-              }
+        }
+        if(fDoTHnSparse && ((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->DoBGCalculation()){
+          Int_t zbin = 0;
+          Int_t mbin = 0;
+          
+          if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
+            zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+            if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
+              mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
+            } else {
+              mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fClusterCandidates->GetEntries());
+            }
+          } 
+          Double_t sparesFill[4] = {pi0cand->M(),pi0cand->Pt(),(Double_t)zbin,(Double_t)mbin};
+          fSparseMotherInvMassPtZM[fiCut]->Fill(sparesFill,1);
+        }
+
+        if(fDoMesonQA == 4  && fIsMC == 0 && (pi0cand->Pt() > 13.) ){
+          Int_t zbin = 0;
+          Int_t mbin = 0;
+          if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
+            zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+            if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
+              mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
+            } else {
+              mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fClusterCandidates->GetEntries());
             }
-            fInvMassTreeInvMass = pi0cand->M();
-            fInvMassTreePt = pi0cand->Pt();
-            fInvMassTreeAlpha = TMath::Abs(pi0cand->GetAlpha());
-            fInvMassTreeTheta = pi0cand->GetOpeningAngle();
-            fInvMassTreeMixPool = zbin*100 + mbin;
-            tSigInvMassPtAlphaTheta[fiCut]->Fill();
           }
-        
-          if(fIsMC> 0){
-            if(fInputEvent->IsA()==AliESDEvent::Class())
-              ProcessTrueMesonCandidates(pi0cand,gamma0,gamma1);
-            if(fInputEvent->IsA()==AliAODEvent::Class())
-              ProcessTrueMesonCandidatesAOD(pi0cand,gamma0,gamma1);
-          }          
-        }        
-        delete pi0cand;
-        pi0cand=0x0;
-      }
+          fInvMassTreeInvMass = pi0cand->M();
+          fInvMassTreePt = pi0cand->Pt();
+          fInvMassTreeAlpha = TMath::Abs(pi0cand->GetAlpha());
+          fInvMassTreeTheta = pi0cand->GetOpeningAngle();
+          fInvMassTreeMixPool = zbin*100 + mbin;
+          tSigInvMassPtAlphaTheta[fiCut]->Fill();
+        }
+      
+        if(fIsMC> 0){
+          if(fInputEvent->IsA()==AliESDEvent::Class())
+            ProcessTrueMesonCandidates(pi0cand,gamma0,gamma1);
+          if(fInputEvent->IsA()==AliAODEvent::Class())
+            ProcessTrueMesonCandidatesAOD(pi0cand,gamma0,gamma1);
+        }          
+      }        
+      delete pi0cand;
+      pi0cand=0x0;
     }
   }
 }
@@ -11,6 +11,7 @@
 #include "AliConvEventCuts.h"
 #include "AliConversionPhotonCuts.h"
 #include "AliConversionMesonCuts.h"
+#include "AliConversionPhotonPairs.h"
 #include "AliAnalysisManager.h"
 #include "TProfile2D.h"
 #include "TH3.h"
@@ -375,12 +376,13 @@ class AliAnalysisTaskGammaCalo : public AliAnalysisTaskSE {
     Bool_t                fEnableSortForClusMC;                                 // switch on sorting for MC labels in cluster
     Bool_t                fProduceCellIDPlots;                                  // switch to produce CellID plots for fDoClusterQA==2
     Bool_t                fProduceTreeEOverP;                                   // flag for producing tree for E/p studies
+    AliConversionPhotonPairs* fPhotonPairs;                                     //! kinematics of the cluster pairs of the current event
 
   private:
     AliAnalysisTaskGammaCalo(const AliAnalysisTaskGammaCalo&);                  // Prevent copy-construction
     AliAnalysisTaskGammaCalo &operator=(const AliAnalysisTaskGammaCalo&);       // Prevent assignment
 
-    ClassDef(AliAnalysisTaskGammaCalo, 31);
+    ClassDef(AliAnalysisTaskGammaCalo, 32);
 };
 
 #endif
@@ -342,7 +342,8 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(): AliAnalysisTaskSE(
   fDoConvGammaShowerShapeTree(kFALSE),
   fEnableSortForClusMC(kFALSE),
   fDoPrimaryTrackMatching(kFALSE),
-  fDoInvMassShowerShapeTree(kFALSE)
+  fDoInvMassShowerShapeTree(kFALSE),
+  fPhotonPairs(NULL)
 {
   
 }
@@ -629,7 +630,8 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(const char *name):
   fDoConvGammaShowerShapeTree(kFALSE),
   fEnableSortForClusMC(kFALSE),
   fDoPrimaryTrackMatching(kFALSE),
-  fDoInvMassShowerShapeTree(kFALSE)
+  fDoInvMassShowerShapeTree(kFALSE),
+  fPhotonPairs(NULL)
 {
   // Define output slots here
   DefineOutput(1, TList::Class());
@@ -645,6 +647,10 @@ AliAnalysisTaskGammaConvCalo::~AliAnalysisTaskGammaConvCalo()
     delete fClusterCandidates;
     fClusterCandidates = 0x0;
   }
+  if(fPhotonPairs){
+    delete fPhotonPairs;
+    fPhotonPairs = 0x0;
+  }
   if(fBGHandler){
     delete[] fBGHandler;
     fBGHandler = 0x0;
@@ -776,6 +782,8 @@ void AliAnalysisTaskGammaConvCalo::UserCreateOutputObjects(){
   fGammaCandidates    = new TList();
   fClusterCandidates  = new TList();
   fClusterCandidates->SetOwner(kTRUE);
+  // Kinematics of the current cut's photon pairs
+  fPhotonPairs        = new AliConversionPhotonPairs();
   
   fCutFolder          = new TList*[fnCuts];
   fESDList            = new TList*[fnCuts];
@@ -3587,190 +3595,196 @@ void AliAnalysisTaskGammaConvCalo::CalculatePi0Candidates(){
 
   // Conversion Gammas
   if(fGammaCandidates->GetEntries()>0){
-    for(Int_t firstGammaIndex=0;firstGammaIndex<fGammaCandidates->GetEntries();firstGammaIndex++){
-      AliAODConversionPhoton *gamma0=dynamic_cast<AliAODConversionPhoton*>(fGammaCandidates->At(firstGammaIndex));
-      if (gamma0==NULL) continue;
-      
-      for(Int_t secondGammaIndex=0;secondGammaIndex<fClusterCandidates->GetEntries();secondGammaIndex++){
-        Bool_t matched = kFALSE;
-        AliAODConversionPhoton *gamma1=dynamic_cast<AliAODConversionPhoton*>(fClusterCandidates->At(secondGammaIndex));
-        if (gamma1==NULL) continue;
-        
-        if (gamma1->GetIsCaloPhoton()){
-          AliVCluster* cluster = fInputEvent->GetCaloCluster(gamma1->GetCaloClusterRef());
-          matched = ((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->MatchConvPhotonToCluster(gamma0,cluster, fInputEvent, fWeightJetJetMC);
-          if(fDoConvGammaShowerShapeTree && matched){
-            Float_t clusPos[3]={0,0,0};
-            cluster->GetPosition(clusPos);
-            TVector3 clusterVector(clusPos[0],clusPos[1],clusPos[2]);
-            tESDClusE = cluster->E();
-            tESDGammaConvR = gamma0->GetConversionRadius();
-            tESDClusterM02 = cluster->GetM02();
-            tESDClusterM20 = cluster->GetM20();
-            tESDClusterEta = clusterVector.Eta();
-            tESDClusterPhi = clusterVector.Phi();
-            tESDClusterNCells = cluster->GetNCells();
-            tESDClusterMaxECell = ((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->FindLargestCellInCluster(cluster, fInputEvent);
-            tESDClusterNLM = ((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->GetNumberOfLocalMaxima(cluster, fInputEvent);
-            tESDGammaERM02[fiCut]->Fill();
-          }
+    AliConversionMesonCuts *mesonCuts = (AliConversionMesonCuts*)fMesonCutArray->At(fiCut);
+    Double_t etaShift                 = ((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift();
+    // kinematics of all photon-cluster pairs of the event in one pass
+    Int_t nPairs = fPhotonPairs->ComputePairs(fGammaCandidates,fClusterCandidates);
+    for(Int_t iPair=0;iPair<nPairs;iPair++){
+      Int_t firstGammaIndex  = fPhotonPairs->GetFirst(iPair);
+      Int_t secondGammaIndex = fPhotonPairs->GetSecond(iPair);
+      AliAODConversionPhoton *gamma0=(AliAODConversionPhoton*)(fGammaCandidates->At(firstGammaIndex));
+      AliAODConversionPhoton *gamma1=(AliAODConversionPhoton*)(fClusterCandidates->At(secondGammaIndex));
+      Bool_t matched = kFALSE;
+
+      if (gamma1->GetIsCaloPhoton()){
+        AliVCluster* cluster = fInputEvent->GetCaloCluster(gamma1->GetCaloClusterRef());
+        matched = ((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->MatchConvPhotonToCluster(gamma0,cluster, fInputEvent, fWeightJetJetMC);
+        if(fDoConvGammaShowerShapeTree && matched){
+          Float_t clusPos[3]={0,0,0};
+          cluster->GetPosition(clusPos);
+          TVector3 clusterVector(clusPos[0],clusPos[1],clusPos[2]);
+          tESDClusE = cluster->E();
+          tESDGammaConvR = gamma0->GetConversionRadius();
+          tESDClusterM02 = cluster->GetM02();
+          tESDClusterM20 = cluster->GetM20();
+          tESDClusterEta = clusterVector.Eta();
+          tESDClusterPhi = clusterVector.Phi();
+          tESDClusterNCells = cluster->GetNCells();
+          tESDClusterMaxECell = ((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->FindLargestCellInCluster(cluster, fInputEvent);
+          tESDClusterNLM = ((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->GetNumberOfLocalMaxima(cluster, fInputEvent);
+          tESDGammaERM02[fiCut]->Fill();
         }
+      }
 
-        AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
-        pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
-        
-        if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
-          if (matched){
-            if(!fDoLightOutput) fHistoMotherMatchedInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
-          }else {
-            fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
-          }
+      // kinematic meson cuts on the pair columns, the mother is only built for the accepted pairs
+      Int_t cutIndex = 0;
+      if(!mesonCuts->MesonIsSelectedKinematics(fPhotonPairs->GetMass(iPair),fPhotonPairs->GetPt(iPair),fPhotonPairs->GetE(iPair),fPhotonPairs->GetPz(iPair),
+                                               fPhotonPairs->GetOpeningAngle(iPair),fPhotonPairs->GetAlpha(iPair),cutIndex,kTRUE,etaShift)) continue;
 
-          // fill invMass cluster shape tree if requested
-          if(fDoInvMassShowerShapeTree){
-            Double_t tempIM = pi0cand->M();
-            if( (tempIM > 0.05 && tempIM < 0.2) || (tempIM > 0.4 && tempIM < 0.6) ){
-              AliVCluster* cluster = fInputEvent->GetCaloCluster(gamma1->GetCaloClusterRef());
-              if(cluster->E()>1.){
-                tESDIMMesonInvMass = pi0cand->M();
-                tESDIMMesonPt = pi0cand->Pt();
-                tESDIMClusE = cluster->E();
-                tESDIMClusterM02 = cluster->GetM02();
-                tESDIMClusterM20 = cluster->GetM20();
-                tESDIMClusterLeadCellID = ((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->FindLargestCellInCluster(cluster,fInputEvent);
-
-                Double_t vertex[3] = {0};
-                InputEvent()->GetPrimaryVertex()->GetXYZ(vertex);
-
-                //determine isolation in cluster Et
-                Float_t clsPos[3] = {0.,0.,0.};
-                Float_t secondClsPos[3] = {0.,0.,0.};
-                TLorentzVector clusterVector;
-                cluster->GetPosition(clsPos);
-                TVector3 clsPosVec(clsPos);
-
-                Float_t sum_Et = 0;
-                Int_t nclus = fInputEvent->GetNumberOfCaloClusters();
-                for(Int_t j=0; j<nclus; j++){
-                  if( tESDmapIsClusterAcceptedWithoutTrackMatch[j] != 1 ) continue;
-
-                  AliVCluster* secondClus = NULL;
-                  if(fInputEvent->IsA()==AliESDEvent::Class()) secondClus = new AliESDCaloCluster(*(AliESDCaloCluster*)fInputEvent->GetCaloCluster(j));
-                  else if(fInputEvent->IsA()==AliAODEvent::Class()) secondClus = new AliAODCaloCluster(*(AliAODCaloCluster*)fInputEvent->GetCaloCluster(j));
-                  if(!secondClus) continue;
-                  if(secondClus->GetID() == cluster->GetID()) continue;
-                  secondClus->GetPosition(secondClsPos);
-                  TVector3 secondClsPosVec(secondClsPos);
-
-                  Float_t dPhi = clsPosVec.DeltaPhi(secondClsPosVec);
-                  Float_t dEta = clsPosVec.Eta()-secondClsPosVec.Eta();
-                  if(TMath::Sqrt(dEta*dEta + dPhi*dPhi) < 0.2){
-                    secondClus->GetMomentum(clusterVector,vertex);
-                    sum_Et += clusterVector.Et();
-                  }
-                  delete secondClus;
-                }
-                tESDIMClusterIsoSumClusterEt = sum_Et;
-
-                //get cluster classification
-                Bool_t isESD = kTRUE;
-                if(fInputEvent->IsA()==AliAODEvent::Class()) isESD = kFALSE;
-                if(fIsMC > 0) tESDIMClusterClassification = ((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->ClassifyClusterForTMEffi(cluster,fInputEvent,fMCEvent,isESD);
-
-                //determine dEta/dPhi of cluster to closest track
-                Int_t labelTrackMatch = -1;
-                AliVTrack* currTrack = 0x0;
-                if(((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->GetClosestMatchedTrackToCluster(fInputEvent,cluster,labelTrackMatch)){
-                  currTrack  = dynamic_cast<AliVTrack*>(fInputEvent->GetTrack(labelTrackMatch));
-                  if(currTrack){
-                    Float_t tempEta = -99999;
-                    Float_t tempPhi = -99999;
-                    ((AliCaloTrackMatcher*)((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->GetCaloTrackMatcherInstance())->GetTrackClusterMatchingResidual(currTrack->GetID(),cluster->GetID(),tempEta,tempPhi);
-                    tESDIMClusMatchedTrackPt = currTrack->Pt();
-                    tESDIMClusTrackDeltaEta = tempEta;
-                    tESDIMClusTrackDeltaPhi = tempPhi;
-                  }
-                }else{
-                  tESDIMClusMatchedTrackPt = 0.;
-                  tESDIMClusTrackDeltaEta = -9999.;
-                  tESDIMClusTrackDeltaPhi = -9999.;
-                }
+      AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
+      pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
+      
+      if(mesonCuts->MesonIsSelectedDCA(pi0cand,cutIndex,kTRUE)){
+        if (matched){
+          if(!fDoLightOutput) fHistoMotherMatchedInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
+        }else {
+          fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
+        }
 
-                //determine isolation in track Et
-                tESDIMClusterIsoSumTrackEt = ((AliCaloTrackMatcher*)((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->GetCaloTrackMatcherInstance())->SumTrackEtAroundCluster(fInputEvent,cluster->GetID(),0.2);
-                //remove Et from matched track
+        // fill invMass cluster shape tree if requested
+        if(fDoInvMassShowerShapeTree){
+          Double_t tempIM = pi0cand->M();
+          if( (tempIM > 0.05 && tempIM < 0.2) || (tempIM > 0.4 && tempIM < 0.6) ){
+            AliVCluster* cluster = fInputEvent->GetCaloCluster(gamma1->GetCaloClusterRef());
+            if(cluster->E()>1.){
+              tESDIMMesonInvMass = pi0cand->M();
+              tESDIMMesonPt = pi0cand->Pt();
+              tESDIMClusE = cluster->E();
+              tESDIMClusterM02 = cluster->GetM02();
+              tESDIMClusterM20 = cluster->GetM20();
+              tESDIMClusterLeadCellID = ((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->FindLargestCellInCluster(cluster,fInputEvent);
+
+              Double_t vertex[3] = {0};
+              InputEvent()->GetPrimaryVertex()->GetXYZ(vertex);
+
+              //determine isolation in cluster Et
+              Float_t clsPos[3] = {0.,0.,0.};
+              Float_t secondClsPos[3] = {0.,0.,0.};
+              TLorentzVector clusterVector;
+              cluster->GetPosition(clsPos);
+              TVector3 clsPosVec(clsPos);
+
+              Float_t sum_Et = 0;
+              Int_t nclus = fInputEvent->GetNumberOfCaloClusters();
+              for(Int_t j=0; j<nclus; j++){
+                if( tESDmapIsClusterAcceptedWithoutTrackMatch[j] != 1 ) continue;
+
+                AliVCluster* secondClus = NULL;
+                if(fInputEvent->IsA()==AliESDEvent::Class()) secondClus = new AliESDCaloCluster(*(AliESDCaloCluster*)fInputEvent->GetCaloCluster(j));
+                else if(fInputEvent->IsA()==AliAODEvent::Class()) secondClus = new AliAODCaloCluster(*(AliAODCaloCluster*)fInputEvent->GetCaloCluster(j));
+                if(!secondClus) continue;
+                if(secondClus->GetID() == cluster->GetID()) continue;
+                secondClus->GetPosition(secondClsPos);
+                TVector3 secondClsPosVec(secondClsPos);
+
+                Float_t dPhi = clsPosVec.DeltaPhi(secondClsPosVec);
+                Float_t dEta = clsPosVec.Eta()-secondClsPosVec.Eta();
+                if(TMath::Sqrt(dEta*dEta + dPhi*dPhi) < 0.2){
+                  secondClus->GetMomentum(clusterVector,vertex);
+                  sum_Et += clusterVector.Et();
+                }
+                delete secondClus;
+              }
+              tESDIMClusterIsoSumClusterEt = sum_Et;
+
+              //get cluster classification
+              Bool_t isESD = kTRUE;
+              if(fInputEvent->IsA()==AliAODEvent::Class()) isESD = kFALSE;
+              if(fIsMC > 0) tESDIMClusterClassification = ((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->ClassifyClusterForTMEffi(cluster,fInputEvent,fMCEvent,isESD);
+
+              //determine dEta/dPhi of cluster to closest track
+              Int_t labelTrackMatch = -1;
+              AliVTrack* currTrack = 0x0;
+              if(((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->GetClosestMatchedTrackToCluster(fInputEvent,cluster,labelTrackMatch)){
+                currTrack  = dynamic_cast<AliVTrack*>(fInputEvent->GetTrack(labelTrackMatch));
                 if(currTrack){
-                  TLorentzVector vecTrack;
-                  vecTrack.SetPxPyPzE(currTrack->Px(),currTrack->Py(),currTrack->Pz(),currTrack->E());
-                  tESDIMClusterIsoSumTrackEt -= vecTrack.Et();
+                  Float_t tempEta = -99999;
+                  Float_t tempPhi = -99999;
+                  ((AliCaloTrackMatcher*)((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->GetCaloTrackMatcherInstance())->GetTrackClusterMatchingResidual(currTrack->GetID(),cluster->GetID(),tempEta,tempPhi);
+                  tESDIMClusMatchedTrackPt = currTrack->Pt();
+                  tESDIMClusTrackDeltaEta = tempEta;
+                  tESDIMClusTrackDeltaPhi = tempPhi;
                 }
+              }else{
+                tESDIMClusMatchedTrackPt = 0.;
+                tESDIMClusTrackDeltaEta = -9999.;
+                tESDIMClusTrackDeltaPhi = -9999.;
+              }
 
-                tESDInvMassShowerShape[fiCut]->Fill();
+              //determine isolation in track Et
+              tESDIMClusterIsoSumTrackEt = ((AliCaloTrackMatcher*)((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->GetCaloTrackMatcherInstance())->SumTrackEtAroundCluster(fInputEvent,cluster->GetID(),0.2);
+              //remove Et from matched track
+              if(currTrack){
+                TLorentzVector vecTrack;
+                vecTrack.SetPxPyPzE(currTrack->Px(),currTrack->Py(),currTrack->Pz(),currTrack->E());
+                tESDIMClusterIsoSumTrackEt -= vecTrack.Et();
               }
+
+              tESDInvMassShowerShape[fiCut]->Fill();
             }
           }
+        }
 
-          // fill new histograms
-          if (!matched){
-            if(!fDoLightOutput){
-              fHistoPhotonPairPtconv[fiCut]->Fill(pi0cand->M(),gamma0->Pt(),fWeightJetJetMC);
-              if(TMath::Abs(pi0cand->GetAlpha())<0.1)
-                fHistoMotherInvMassPtAlpha[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
+        // fill new histograms
+        if (!matched){
+          if(!fDoLightOutput){
+            fHistoPhotonPairPtconv[fiCut]->Fill(pi0cand->M(),gamma0->Pt(),fWeightJetJetMC);
+            if(TMath::Abs(pi0cand->GetAlpha())<0.1)
+              fHistoMotherInvMassPtAlpha[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
+          }
+          
+          if (fDoMesonQA > 0){
+            if ( pi0cand->M() > 0.05 && pi0cand->M() < 0.17){
+              fHistoMotherPi0PtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(),fWeightJetJetMC);
+              fHistoMotherPi0PtAlpha[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetAlpha(),fWeightJetJetMC);
+              fHistoMotherPi0PtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(),fWeightJetJetMC);
+              fHistoMotherPi0ConvPhotonEtaPhi[fiCut]->Fill(gamma0->GetPhotonPhi(), gamma0->GetPhotonEta(),fWeightJetJetMC);
             }
+            if ( pi0cand->M() > 0.45 && pi0cand->M() < 0.65){
+              fHistoMotherEtaPtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(),fWeightJetJetMC);
+              fHistoMotherEtaPtAlpha[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetAlpha(),fWeightJetJetMC);
+              fHistoMotherEtaPtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(),fWeightJetJetMC);
+              fHistoMotherEtaConvPhotonEtaPhi[fiCut]->Fill(gamma0->GetPhotonPhi(), gamma0->GetPhotonEta(),fWeightJetJetMC);
+            }
+          }
+          if(fDoTHnSparse && ((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->DoBGCalculation()){
+            Int_t zbin = 0;
+            Int_t mbin = 0;
             
-            if (fDoMesonQA > 0){
-              if ( pi0cand->M() > 0.05 && pi0cand->M() < 0.17){
-                fHistoMotherPi0PtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(),fWeightJetJetMC);
-                fHistoMotherPi0PtAlpha[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetAlpha(),fWeightJetJetMC);
-                fHistoMotherPi0PtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(),fWeightJetJetMC);
-                fHistoMotherPi0ConvPhotonEtaPhi[fiCut]->Fill(gamma0->GetPhotonPhi(), gamma0->GetPhotonEta(),fWeightJetJetMC);
-              }
-              if ( pi0cand->M() > 0.45 && pi0cand->M() < 0.65){
-                fHistoMotherEtaPtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift(),fWeightJetJetMC);
-                fHistoMotherEtaPtAlpha[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetAlpha(),fWeightJetJetMC);
-                fHistoMotherEtaPtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle(),fWeightJetJetMC);
-                fHistoMotherEtaConvPhotonEtaPhi[fiCut]->Fill(gamma0->GetPhotonPhi(), gamma0->GetPhotonEta(),fWeightJetJetMC);
+            if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
+              zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+              if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
+                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
+              }else {
+                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fGammaCandidates->GetEntries());
               }
-            }
-            if(fDoTHnSparse && ((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->DoBGCalculation()){
-              Int_t zbin = 0;
-              Int_t mbin = 0;
-              
-              if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
-                zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
-                if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
-                  mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
-                }else {
-                  mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fGammaCandidates->GetEntries());
-                }
-              }else{
-                zbin = fBGHandlerRP[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
-                if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
-                  mbin = fBGHandlerRP[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
-                }else {
-                  mbin = fBGHandlerRP[fiCut]->GetMultiplicityBinIndex(fGammaCandidates->GetEntries());
-                }
+            }else{
+              zbin = fBGHandlerRP[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+              if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
+                mbin = fBGHandlerRP[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
+              }else {
+                mbin = fBGHandlerRP[fiCut]->GetMultiplicityBinIndex(fGammaCandidates->GetEntries());
               }
-              Double_t sparesFill[4] = {pi0cand->M(),pi0cand->Pt(),(Double_t)zbin,(Double_t)mbin};
-              fSparseMotherInvMassPtZM[fiCut]->Fill(sparesFill,1);
             }
+            Double_t sparesFill[4] = {pi0cand->M(),pi0cand->Pt(),(Double_t)zbin,(Double_t)mbin};
+            fSparseMotherInvMassPtZM[fiCut]->Fill(sparesFill,1);
           }
-          
-          if(fIsMC>0){
-            if(fInputEvent->IsA()==AliESDEvent::Class())
-              ProcessTrueMesonCandidates(pi0cand,gamma0,gamma1, matched);
-            if(fInputEvent->IsA()==AliAODEvent::Class())
-              ProcessTrueMesonCandidatesAOD(pi0cand,gamma0,gamma1, matched);
-          }
-          if (!matched){
-            if (!fDoLightOutput && fDoMesonQA == 1){
-              fHistoMotherInvMassECalib[fiCut]->Fill(pi0cand->M(),gamma1->E(),fWeightJetJetMC);
-            }
+        }
+        
+        if(fIsMC>0){
+          if(fInputEvent->IsA()==AliESDEvent::Class())
+            ProcessTrueMesonCandidates(pi0cand,gamma0,gamma1, matched);
+          if(fInputEvent->IsA()==AliAODEvent::Class())
+            ProcessTrueMesonCandidatesAOD(pi0cand,gamma0,gamma1, matched);
+        }
+        if (!matched){
+          if (!fDoLightOutput && fDoMesonQA == 1){
+            fHistoMotherInvMassECalib[fiCut]->Fill(pi0cand->M(),gamma1->E(),fWeightJetJetMC);
           }
         }
-        delete pi0cand;
-        pi0cand=0x0;
       }
+      delete pi0cand;
+      pi0cand=0x0;
     }
   }
 }
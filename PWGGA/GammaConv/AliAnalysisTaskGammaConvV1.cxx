@@ -262,7 +262,8 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(): AliAnalysisTaskSE(),
   fDoTHnSparse(kTRUE),
   fWeightJetJetMC(1),
   fEnableClusterCutsForTrigger(kFALSE),
-  fDoMaterialBudgetWeightingOfGammasForTrueMesons(kFALSE)
+  fDoMaterialBudgetWeightingOfGammasForTrueMesons(kFALSE),
+  fPhotonPairs(NULL)
 {
 
 }
@@ -470,7 +471,8 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(const char *name):
   fDoTHnSparse(kTRUE),
   fWeightJetJetMC(1),
   fEnableClusterCutsForTrigger(kFALSE),
-  fDoMaterialBudgetWeightingOfGammasForTrueMesons(kFALSE)
+  fDoMaterialBudgetWeightingOfGammasForTrueMesons(kFALSE),
+  fPhotonPairs(NULL)
 {
   // Define output slots here
   DefineOutput(1, TList::Class());
@@ -482,6 +484,10 @@ AliAnalysisTaskGammaConvV1::~AliAnalysisTaskGammaConvV1()
     delete fGammaCandidates;
     fGammaCandidates = 0x0;
   }
+  if(fPhotonPairs){
+    delete fPhotonPairs;
+    fPhotonPairs = 0x0;
+  }
   if(fBGHandler){
     delete[] fBGHandler;
     fBGHandler = 0x0;
@@ -602,6 +608,8 @@ void AliAnalysisTaskGammaConvV1::UserCreateOutputObjects(){
 
   // Array of current cut's gammas
   fGammaCandidates          = new TList();
+  // Kinematics of the current cut's photon pairs
+  fPhotonPairs              = new AliConversionPhotonPairs();
 
   fCutFolder                = new TList*[fnCuts];
   fESDList                  = new TList*[fnCuts];
@@ -2859,121 +2867,128 @@ void AliAnalysisTaskGammaConvV1::CalculatePi0Candidates(){
 
   // Conversion Gammas
   if(fGammaCandidates->GetEntries()>1){
-    for(Int_t firstGammaIndex=0;firstGammaIndex<fGammaCandidates->GetEntries()-1;firstGammaIndex++){
-      AliAODConversionPhoton *gamma0=dynamic_cast<AliAODConversionPhoton*>(fGammaCandidates->At(firstGammaIndex));
-      if (gamma0==NULL) continue;
-      for(Int_t secondGammaIndex=firstGammaIndex+1;secondGammaIndex<fGammaCandidates->GetEntries();secondGammaIndex++){
-        AliAODConversionPhoton *gamma1=dynamic_cast<AliAODConversionPhoton*>(fGammaCandidates->At(secondGammaIndex));
-        //Check for same Electron ID
-        if (gamma1==NULL) continue;
-        if(gamma0->GetTrackLabelPositive() == gamma1->GetTrackLabelPositive() ||
-        gamma0->GetTrackLabelNegative() == gamma1->GetTrackLabelNegative() ||
-        gamma0->GetTrackLabelNegative() == gamma1->GetTrackLabelPositive() ||
-        gamma0->GetTrackLabelPositive() == gamma1->GetTrackLabelNegative() ) continue;
-
-        AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
-        pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
-        pi0cand->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
+    AliConversionMesonCuts *mesonCuts = (AliConversionMesonCuts*)fMesonCutArray->At(fiCut);
+    Double_t etaShift                 = ((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift();
+    // kinematics of all photon pairs of the event in one pass
+    Int_t nPairs = fPhotonPairs->ComputePairs(fGammaCandidates);
+    for(Int_t iPair=0;iPair<nPairs;iPair++){
+      Int_t firstGammaIndex  = fPhotonPairs->GetFirst(iPair);
+      Int_t secondGammaIndex = fPhotonPairs->GetSecond(iPair);
+      AliAODConversionPhoton *gamma0=(AliAODConversionPhoton*)(fGammaCandidates->At(firstGammaIndex));
+      AliAODConversionPhoton *gamma1=(AliAODConversionPhoton*)(fGammaCandidates->At(secondGammaIndex));
+      //Check for same Electron ID
+      if(gamma0->GetTrackLabelPositive() == gamma1->GetTrackLabelPositive() ||
+      gamma0->GetTrackLabelNegative() == gamma1->GetTrackLabelNegative() ||
+      gamma0->GetTrackLabelNegative() == gamma1->GetTrackLabelPositive() ||
+      gamma0->GetTrackLabelPositive() == gamma1->GetTrackLabelNegative() ) continue;
+
+      // kinematic meson cuts on the pair columns, the mother is only built for the accepted pairs
+      Int_t cutIndex = 0;
+      if(!mesonCuts->MesonIsSelectedKinematics(fPhotonPairs->GetMass(iPair),fPhotonPairs->GetPt(iPair),fPhotonPairs->GetE(iPair),fPhotonPairs->GetPz(iPair),
+                                               fPhotonPairs->GetOpeningAngle(iPair),fPhotonPairs->GetAlpha(iPair),cutIndex,kTRUE,etaShift)) continue;
+
+      AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
+      pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
+      pi0cand->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
+      
+      if(mesonCuts->MesonIsSelectedDCA(pi0cand,cutIndex,kTRUE)){
+        if(fDoCentralityFlat > 0){
+          fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
+          if(TMath::Abs(pi0cand->GetAlpha())<0.1) fHistoMotherInvMassEalpha[fiCut]->Fill(pi0cand->M(),pi0cand->E(), fWeightCentrality[fiCut]*fWeightJetJetMC);
+        } else {
+          fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
+          if(TMath::Abs(pi0cand->GetAlpha())<0.1) fHistoMotherInvMassEalpha[fiCut]->Fill(pi0cand->M(),pi0cand->E(),fWeightJetJetMC);
+        }
         
-        if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
-          if(fDoCentralityFlat > 0){
-            fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
-            if(TMath::Abs(pi0cand->GetAlpha())<0.1) fHistoMotherInvMassEalpha[fiCut]->Fill(pi0cand->M(),pi0cand->E(), fWeightCentrality[fiCut]*fWeightJetJetMC);
-          } else {
-            fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
-            if(TMath::Abs(pi0cand->GetAlpha())<0.1) fHistoMotherInvMassEalpha[fiCut]->Fill(pi0cand->M(),pi0cand->E(),fWeightJetJetMC);
+        if (fDoMesonQA > 0){
+
+          if(fDoMesonQA == 3 && TMath::Abs(gamma0->GetConversionRadius()-gamma1->GetConversionRadius())<10 && pi0cand->GetOpeningAngle()<0.1){
+                  Double_t sparesFill[4] = {gamma0->GetPhotonPt(),gamma0->GetConversionRadius(),TMath::Abs(gamma0->GetConversionRadius()-gamma1->GetConversionRadius()),pi0cand->GetOpeningAngle()};
+                  sPtRDeltaROpenAngle[fiCut]->Fill(sparesFill, 1);
           }
-          
-          if (fDoMesonQA > 0){
 
-            if(fDoMesonQA == 3 && TMath::Abs(gamma0->GetConversionRadius()-gamma1->GetConversionRadius())<10 && pi0cand->GetOpeningAngle()<0.1){
-                    Double_t sparesFill[4] = {gamma0->GetPhotonPt(),gamma0->GetConversionRadius(),TMath::Abs(gamma0->GetConversionRadius()-gamma1->GetConversionRadius()),pi0cand->GetOpeningAngle()};
-                    sPtRDeltaROpenAngle[fiCut]->Fill(sparesFill, 1);
+          if ( pi0cand->M() > 0.05 && pi0cand->M() < 0.17){
+            if (fIsMC < 2){
+              fHistoMotherPi0PtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift());
+              fHistoMotherPi0PtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle());
             }
-
-            if ( pi0cand->M() > 0.05 && pi0cand->M() < 0.17){
-              if (fIsMC < 2){
-                fHistoMotherPi0PtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift());
-                fHistoMotherPi0PtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle());
-              }
-              fHistoMotherPi0PtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()),fWeightJetJetMC);
-              
+            fHistoMotherPi0PtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()),fWeightJetJetMC);
+            
+          } 
+          if ( pi0cand->M() > 0.45 && pi0cand->M() < 0.65){
+            if (fIsMC < 2){
+              fHistoMotherEtaPtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift());
+              fHistoMotherEtaPtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle());
             } 
-            if ( pi0cand->M() > 0.45 && pi0cand->M() < 0.65){
-              if (fIsMC < 2){
-                fHistoMotherEtaPtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift());
-                fHistoMotherEtaPtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle());
-              } 
-              fHistoMotherEtaPtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()),fWeightJetJetMC);
-            }
-          }   
-          if(fDoTHnSparse && ((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->DoBGCalculation()){
-            Int_t psibin = 0;
-            Int_t zbin = 0;
-            Int_t mbin = 0;
-
-            Double_t sparesFill[4];
-            if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
-              zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
-              if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
-                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
-              } else {
-                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fGammaCandidates->GetEntries());
-              }
-              sparesFill[0] = pi0cand->M();
-              sparesFill[1] = pi0cand->Pt();
-              sparesFill[2] = (Double_t)zbin; 
-              sparesFill[3] = (Double_t)mbin;
+            fHistoMotherEtaPtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()),fWeightJetJetMC);
+          }
+        }   
+        if(fDoTHnSparse && ((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->DoBGCalculation()){
+          Int_t psibin = 0;
+          Int_t zbin = 0;
+          Int_t mbin = 0;
+
+          Double_t sparesFill[4];
+          if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
+            zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+            if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
+              mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
             } else {
-              psibin = fBGHandlerRP[fiCut]->GetRPBinIndex(TMath::Abs(fEventPlaneAngle));
-              zbin = fBGHandlerRP[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+              mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fGammaCandidates->GetEntries());
+            }
+            sparesFill[0] = pi0cand->M();
+            sparesFill[1] = pi0cand->Pt();
+            sparesFill[2] = (Double_t)zbin; 
+            sparesFill[3] = (Double_t)mbin;
+          } else {
+            psibin = fBGHandlerRP[fiCut]->GetRPBinIndex(TMath::Abs(fEventPlaneAngle));
+            zbin = fBGHandlerRP[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
 //               if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
 //                 mbin = fBGHandlerRP[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
 //               } else {
 //                 mbin = fBGHandlerRP[fiCut]->GetMultiplicityBinIndex(fGammaCandidates->GetEntries());
 //               }
-              sparesFill[0] = pi0cand->M();
-              sparesFill[1] = pi0cand->Pt();
-              sparesFill[2] = (Double_t)zbin; 
-              sparesFill[3] = (Double_t)psibin;              
-            }
-//             Double_t sparesFill[4] = {pi0cand->M(),pi0cand->Pt(),(Double_t)zbin,(Double_t)mbin};
-            if(fDoCentralityFlat > 0) sESDMotherInvMassPtZM[fiCut]->Fill(sparesFill, fWeightCentrality[fiCut]*fWeightJetJetMC); //instead of weight 1
-            else  sESDMotherInvMassPtZM[fiCut]->Fill(sparesFill, fWeightJetJetMC);
+            sparesFill[0] = pi0cand->M();
+            sparesFill[1] = pi0cand->Pt();
+            sparesFill[2] = (Double_t)zbin; 
+            sparesFill[3] = (Double_t)psibin;              
           }
-          
+//             Double_t sparesFill[4] = {pi0cand->M(),pi0cand->Pt(),(Double_t)zbin,(Double_t)mbin};
+          if(fDoCentralityFlat > 0) sESDMotherInvMassPtZM[fiCut]->Fill(sparesFill, fWeightCentrality[fiCut]*fWeightJetJetMC); //instead of weight 1
+          else  sESDMotherInvMassPtZM[fiCut]->Fill(sparesFill, fWeightJetJetMC);
+        }
+        
 
-          if( fIsMC > 0 ){
-            if(fInputEvent->IsA()==AliESDEvent::Class())
-              ProcessTrueMesonCandidates(pi0cand,gamma0,gamma1);
-            if(fInputEvent->IsA()==AliAODEvent::Class())
-              ProcessTrueMesonCandidatesAOD(pi0cand,gamma0,gamma1);
-          }
-          if (fDoMesonQA == 2){
-            fInvMass = pi0cand->M();
-            fPt  = pi0cand->Pt();
-            if (TMath::Abs(gamma0->GetDCAzToPrimVtx()) < TMath::Abs(gamma1->GetDCAzToPrimVtx())){
-              fDCAzGammaMin = gamma0->GetDCAzToPrimVtx();
-              fDCAzGammaMax = gamma1->GetDCAzToPrimVtx();
-            } else {
-              fDCAzGammaMin = gamma1->GetDCAzToPrimVtx();
-              fDCAzGammaMax = gamma0->GetDCAzToPrimVtx();
-            }
-            iFlag = pi0cand->GetMesonQuality();
-    //                   cout << "gamma 0: " << gamma0->GetV0Index()<< "\t" << gamma0->GetPx() << "\t" << gamma0->GetPy() << "\t" <<  gamma0->GetPz() << "\t" << endl; 
-    //                   cout << "gamma 1: " << gamma1->GetV0Index()<< "\t"<< gamma1->GetPx() << "\t" << gamma1->GetPy() << "\t" <<  gamma1->GetPz() << "\t" << endl; 
-    //                    cout << "pi0: "<<fInvMass << "\t" << fPt <<"\t" << fDCAzGammaMin << "\t" << fDCAzGammaMax << "\t" << (Int_t)iFlag << "\t" << (Int_t)iMesonMCInfo <<endl;
-            if (fIsHeavyIon == 1 && fPt > 0.399 && fPt < 20. ) {
-              if (fInvMass > 0.08 && fInvMass < 0.2) tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
-              if ((fInvMass > 0.45 && fInvMass < 0.6) &&  (fPt > 0.999 && fPt < 20.) )tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
-            } else if (fPt > 0.299 && fPt < 20. )  {
-              if ( (fInvMass > 0.08 && fInvMass < 0.6) ) tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
-            }   
+        if( fIsMC > 0 ){
+          if(fInputEvent->IsA()==AliESDEvent::Class())
+            ProcessTrueMesonCandidates(pi0cand,gamma0,gamma1);
+          if(fInputEvent->IsA()==AliAODEvent::Class())
+            ProcessTrueMesonCandidatesAOD(pi0cand,gamma0,gamma1);
+        }
+        if (fDoMesonQA == 2){
+          fInvMass = pi0cand->M();
+          fPt  = pi0cand->Pt();
+          if (TMath::Abs(gamma0->GetDCAzToPrimVtx()) < TMath::Abs(gamma1->GetDCAzToPrimVtx())){
+            fDCAzGammaMin = gamma0->GetDCAzToPrimVtx();
+            fDCAzGammaMax = gamma1->GetDCAzToPrimVtx();
+          } else {
+            fDCAzGammaMin = gamma1->GetDCAzToPrimVtx();
+            fDCAzGammaMax = gamma0->GetDCAzToPrimVtx();
           }
+          iFlag = pi0cand->GetMesonQuality();
+  //                   cout << "gamma 0: " << gamma0->GetV0Index()<< "\t" << gamma0->GetPx() << "\t" << gamma0->GetPy() << "\t" <<  gamma0->GetPz() << "\t" << endl; 
+  //                   cout << "gamma 1: " << gamma1->GetV0Index()<< "\t"<< gamma1->GetPx() << "\t" << gamma1->GetPy() << "\t" <<  gamma1->GetPz() << "\t" << endl; 
+  //                    cout << "pi0: "<<fInvMass << "\t" << fPt <<"\t" << fDCAzGammaMin << "\t" << fDCAzGammaMax << "\t" << (Int_t)iFlag << "\t" << (Int_t)iMesonMCInfo <<endl;
+          if (fIsHeavyIon == 1 && fPt > 0.399 && fPt < 20. ) {
+            if (fInvMass > 0.08 && fInvMass < 0.2) tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
+            if ((fInvMass > 0.45 && fInvMass < 0.6) &&  (fPt > 0.999 && fPt < 20.) )tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
+          } else if (fPt > 0.299 && fPt < 20. )  {
+            if ( (fInvMass > 0.08 && fInvMass < 0.6) ) tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
+          }   
         }
-        delete pi0cand;
-        pi0cand=0x0;
       }
+      delete pi0cand;
+      pi0cand=0x0;
     }
   }
 }
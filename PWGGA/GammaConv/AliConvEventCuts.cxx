@@ -164,10 +164,18 @@ AliConvEventCuts::AliConvEventCuts(const char *name,const char *title) :
   fNameHistoReweightingMultData(""),
   fNameHistoReweightingMultMC(""), 
   hReweightMultData(NULL),
-  hReweightMultMC(NULL)
+  hReweightMultMC(NULL),
+  fEventCache(NULL),
+  fCacheEvent(NULL),
+  fCacheDone(0),
+  fCacheFlags(0),
+  fCacheNPileVert(0),
+  fCacheDistZMax(0),
+  fCacheCentralityDone(0)
 
 {
   for(Int_t jj=0;jj<kNCuts;jj++){fCuts[jj]=0;}
+  for(Int_t jj=0;jj<12;jj++){fCacheCentrality[jj]=0;}
   fCutString=new TObjString((GetCutNumber()).Data());
 
   fUtils = new AliAnalysisUtils();
@@ -271,11 +279,19 @@ AliConvEventCuts::AliConvEventCuts(const AliConvEventCuts &ref) :
   fNameHistoReweightingMultData(ref.fNameHistoReweightingMultData),
   fNameHistoReweightingMultMC(ref.fNameHistoReweightingMultMC), 
   hReweightMultData(ref.hReweightMultData),
-  hReweightMultMC(ref.hReweightMultMC)
+  hReweightMultMC(ref.hReweightMultMC),
+  fEventCache(NULL),
+  fCacheEvent(NULL),
+  fCacheDone(0),
+  fCacheFlags(0),
+  fCacheNPileVert(0),
+  fCacheDistZMax(0),
+  fCacheCentralityDone(0)
 
 {
   // Copy Constructor
   for(Int_t jj=0;jj<kNCuts;jj++){fCuts[jj]=ref.fCuts[jj];}
+  for(Int_t jj=0;jj<12;jj++){fCacheCentrality[jj]=0;}
   fCutString=new TObjString((GetCutNumber()).Data());
   fUtils = new AliAnalysisUtils();
   // dont copy histograms (if you like histograms, call InitCutHistograms())
@@ -574,23 +590,13 @@ Bool_t AliConvEventCuts::EventIsSelected(AliVEvent *fInputEvent, AliVEvent *fMCE
   if(hSPDClusterTrackletBackgroundBefore) hSPDClusterTrackletBackgroundBefore->Fill(nTracklets, (nClustersLayer0 + nClustersLayer1));
 
   
+  AliConvEventCuts *cache = GetEventCache();
   Double_t distZMax     = 0;
   if(fInputEvent->IsA()==AliESDEvent::Class()){
-    Int_t nPileVert = ((AliESDEvent*)fInputEvent)->GetNumberOfPileupVerticesSPD();
+    Int_t nPileVert = 0;
+    distZMax        = cache->GetPileupVertexDistZMaxCached(fInputEvent,nPileVert);
     if (hNPileupVertices) hNPileupVertices->Fill(nPileVert);
     if (nPileVert > 0){
-      for(Int_t i=0; i<nPileVert;i++){
-        const AliESDVertex* pv  = ((AliESDEvent*)fInputEvent)->GetPileupVertexSPD(i);
-        Int_t nc2               = pv->GetNContributors();
-        if(nc2>=3){
-          Double_t z1     = ((AliESDEvent*)fInputEvent)->GetPrimaryVertexSPD()->GetZ();
-          Double_t z2     = pv->GetZ();
-          Double_t distZ  = z2-z1;
-          if (TMath::Abs(distZMax) <  TMath::Abs(distZ) ){
-            distZMax      = distZ;
-          }
-        }
-      }
       if (hPileupVertexToPrimZ) hPileupVertexToPrimZ->Fill(distZMax);
     }  
   }
@@ -603,13 +609,13 @@ Bool_t AliConvEventCuts::EventIsSelected(AliVEvent *fInputEvent, AliVEvent *fMCE
       return kFALSE;
     }
     if(fRemovePileUp){
-      if(fUtils->IsPileUpEvent(fInputEvent)){
+      if(cache->IsPileUpEventCached(fInputEvent)){
         if(fHistoEventCuts)fHistoEventCuts->Fill(cutindex);
         if (hPileupVertexToPrimZSPDPileup) hPileupVertexToPrimZSPDPileup->Fill(distZMax);
         fEventQuality = 6;
         return kFALSE;
       }
-      if (fUtils->IsSPDClusterVsTrackletBG(fInputEvent)){
+      if (cache->IsSPDClusterVsTrackletBGCached(fInputEvent)){
         if(fHistoEventCuts)fHistoEventCuts->Fill(cutindex);
         if (hPileupVertexToPrimZTrackletvsHits) hPileupVertexToPrimZTrackletvsHits->Fill(distZMax);
         fEventQuality = 11;
@@ -617,13 +623,13 @@ Bool_t AliConvEventCuts::EventIsSelected(AliVEvent *fInputEvent, AliVEvent *fMCE
       }  
     }
   } else if(fRemovePileUp){
-    if(fInputEvent->IsPileupFromSPD(3,0.8,3.,2.,5.) ){
+    if(cache->IsPileupFromSPDCached(fInputEvent) ){
       if(fHistoEventCuts)fHistoEventCuts->Fill(cutindex);
       if (hPileupVertexToPrimZSPDPileup) hPileupVertexToPrimZSPDPileup->Fill(distZMax);
       fEventQuality = 6;
       return kFALSE;
     }
-    if (fUtils->IsSPDClusterVsTrackletBG(fInputEvent)){
+    if (cache->IsSPDClusterVsTrackletBGCached(fInputEvent)){
       if(fHistoEventCuts)fHistoEventCuts->Fill(cutindex);
       if (hPileupVertexToPrimZTrackletvsHits) hPileupVertexToPrimZTrackletvsHits->Fill(distZMax);
       fEventQuality = 11;
@@ -1638,7 +1644,26 @@ Bool_t AliConvEventCuts::GetUseNewMultiplicityFramework(){
 
 //-------------------------------------------------------------
 Float_t AliConvEventCuts::GetCentrality(AliVEvent *event)
-{   // Get Event Centrality
+{   // Get Event Centrality, evaluated once per event for each estimator
+
+  AliConvEventCuts *cache = GetEventCache();
+  if (!event || cache->fCacheEvent != event) return CalculateCentrality(event);
+
+  Int_t slot = 0;
+  if (fDetectorCentrality == 1)      slot = 1;
+  else if (fDetectorCentrality != 0) slot = 2;
+  if (fIsHeavyIon == 2)              slot += 3;
+  if (GetUseNewMultiplicityFramework()) slot += 6;
+  if (!(cache->fCacheCentralityDone & BIT(slot))){
+    cache->fCacheCentrality[slot]  = CalculateCentrality(event);
+    cache->fCacheCentralityDone   |= BIT(slot);
+  }
+  return cache->fCacheCentrality[slot];
+}
+
+//-------------------------------------------------------------
+Float_t AliConvEventCuts::CalculateCentrality(AliVEvent *event)
+{   // Calculate Event Centrality
 
   AliESDEvent *esdEvent=dynamic_cast<AliESDEvent*>(event);
   if(esdEvent){
@@ -3157,6 +3182,11 @@ Int_t AliConvEventCuts::IsEventAcceptedByCut(AliConvEventCuts *ReaderCuts, AliVE
 
   Bool_t isMC = kFALSE;
   if (MCEvent){isMC = kTRUE;}
+
+  // the event quantities which do not depend on the cut are evaluated once per event
+  // for all cut sets and kept in the reader cuts (see ResetEventCache)
+  fEventCache = (ReaderCuts != this) ? ReaderCuts : NULL;
+  AliConvEventCuts *cache = GetEventCache();
   
   if ( !IsTriggerSelected(InputEvent, isMC) )
     return 3;
@@ -3187,35 +3217,12 @@ Int_t AliConvEventCuts::IsEventAcceptedByCut(AliConvEventCuts *ReaderCuts, AliVE
     Int_t runnumber = InputEvent->GetRunNumber();
     if ((runnumber>=144871) && (runnumber<=146860)) { 
 
-      AliVCaloCells *cells   = InputEvent->GetEMCALCells();
-      const Short_t nCells   = cells->GetNumberOfCells();
-      
       if (InputEvent->IsA()==AliESDEvent::Class()) AliAnalysisManager::GetAnalysisManager()->LoadBranch("EMCALCells.");
 
       AliInputEventHandler *fInputHandler=(AliInputEventHandler*)(AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler());
       if (!fInputHandler) return 3;
       
-      // count cells above threshold
-      Int_t nCellCount[12] = {0,0,0,0,0,0,0,0,0,0,0,0};
-      for(Int_t iCell=0; iCell<nCells; ++iCell) {
-        Short_t cellId = cells->GetCellNumber(iCell);
-        Double_t cellE = cells->GetCellAmplitude(cellId);
-        Int_t sm       = cellId / (24*48);
-        if (cellE>0.1) ++nCellCount[sm];
-      }
-
-      Bool_t fIsLedEvent = kFALSE;
-      if (nCellCount[4] > 100) {
-        fIsLedEvent = kTRUE;
-      } else {
-        if ((runnumber>=146858) && (runnumber<=146860)) {
-          if ((fInputHandler->IsEventSelected() & AliVEvent::kMB) && (nCellCount[3]>=21))
-            fIsLedEvent = kTRUE;
-          else if ((fInputHandler->IsEventSelected() & AliVEvent::kEMC1) && (nCellCount[3]>=35))
-            fIsLedEvent = kTRUE;
-        }
-      }
-      if (fIsLedEvent) {
+      if (cache->IsLedEventCached(InputEvent)) {
         return 9;
       }
     }
@@ -3230,41 +3237,30 @@ Int_t AliConvEventCuts::IsEventAcceptedByCut(AliConvEventCuts *ReaderCuts, AliVE
   
   Double_t distZMax     = 0;
   if(InputEvent->IsA()==AliESDEvent::Class()){
-    Int_t nPileVert = ((AliESDEvent*)InputEvent)->GetNumberOfPileupVerticesSPD();
+    Int_t nPileVert = 0;
+    distZMax        = cache->GetPileupVertexDistZMaxCached(InputEvent,nPileVert);
     if (hNPileupVertices) hNPileupVertices->Fill(nPileVert);
     if (nPileVert > 0){
-      for(Int_t i=0; i<nPileVert;i++){
-        const AliESDVertex* pv= ((AliESDEvent*)InputEvent)->GetPileupVertexSPD(i);
-        Int_t nc2             = pv->GetNContributors();
-        if(nc2>=3){
-          Double_t z1 = ((AliESDEvent*)InputEvent)->GetPrimaryVertexSPD()->GetZ();
-          Double_t z2 = pv->GetZ();
-          Double_t distZ  = z2-z1;
-          if (TMath::Abs(distZMax) <  TMath::Abs(distZ) ){
-            distZMax      = distZ;
-          }
-        }
-      }
       if (hPileupVertexToPrimZ) hPileupVertexToPrimZ->Fill(distZMax);
     }  
   }
 
   if( isHeavyIon != 2 && GetIsFromPileup()){
-    if(InputEvent->IsPileupFromSPD(3,0.8,3.,2.,5.) ){
+    if(cache->IsPileupFromSPDCached(InputEvent) ){
       if (hPileupVertexToPrimZSPDPileup) hPileupVertexToPrimZSPDPileup->Fill(distZMax);
       return 6; // Check Pileup --> Not Accepted => eventQuality = 6
     }
-    if (fUtils->IsSPDClusterVsTrackletBG(InputEvent)){
+    if (cache->IsSPDClusterVsTrackletBGCached(InputEvent)){
       if (hPileupVertexToPrimZTrackletvsHits) hPileupVertexToPrimZTrackletvsHits->Fill(distZMax);
       return 11; // Check Pileup --> Not Accepted => eventQuality = 11
     }
   }
   if(isHeavyIon == 2 && GetIsFromPileup()){
-    if(fUtils->IsPileUpEvent(InputEvent) ){
+    if(cache->IsPileUpEventCached(InputEvent) ){
       if (hPileupVertexToPrimZSPDPileup) hPileupVertexToPrimZSPDPileup->Fill(distZMax);
       return 6; // Check Pileup --> Not Accepted => eventQuality = 6
     }
-    if (fUtils->IsSPDClusterVsTrackletBG(InputEvent)){
+    if (cache->IsSPDClusterVsTrackletBGCached(InputEvent)){
       if (hPileupVertexToPrimZTrackletvsHits) hPileupVertexToPrimZTrackletvsHits->Fill(distZMax);
       return 11; // Check Pileup --> Not Accepted => eventQuality = 11
     }
@@ -3290,6 +3286,126 @@ Int_t AliConvEventCuts::IsEventAcceptedByCut(AliConvEventCuts *ReaderCuts, AliVE
 }
 
 
+//_________________________________________________________________________
+void AliConvEventCuts::ResetEventCache(AliVEvent *event){
+  // Starts the cache of the cut independent event quantities for a new event.
+  // The pileup checks, pileup vertices, LED check and centrality are then evaluated
+  // at most once per event for all cut sets using these cuts as ReaderCuts.
+  // Called by the V0 reader at the beginning of each event, the cache is disabled
+  // as long as it is never called.
+  fEventCache           = NULL;
+  fCacheEvent           = event;
+  fCacheDone            = 0;
+  fCacheFlags           = 0;
+  fCacheNPileVert       = 0;
+  fCacheDistZMax        = 0;
+  fCacheCentralityDone  = 0;
+}
+
+//_________________________________________________________________________
+Bool_t AliConvEventCuts::IsPileupFromSPDCached(AliVEvent *event){
+  // SPD pileup vertex check, cached per event
+  if (fCacheEvent != event) return event->IsPileupFromSPD(3,0.8,3.,2.,5.);
+  if (!(fCacheDone & kCachePileupSPD)){
+    if (event->IsPileupFromSPD(3,0.8,3.,2.,5.)) fCacheFlags |= kCachePileupSPD;
+    fCacheDone |= kCachePileupSPD;
+  }
+  return (fCacheFlags & kCachePileupSPD) != 0;
+}
+
+//_________________________________________________________________________
+Bool_t AliConvEventCuts::IsSPDClusterVsTrackletBGCached(AliVEvent *event){
+  // SPD clusters vs tracklets background check, cached per event
+  if (fCacheEvent != event) return fUtils->IsSPDClusterVsTrackletBG(event);
+  if (!(fCacheDone & kCacheSPDBG)){
+    if (fUtils->IsSPDClusterVsTrackletBG(event)) fCacheFlags |= kCacheSPDBG;
+    fCacheDone |= kCacheSPDBG;
+  }
+  return (fCacheFlags & kCacheSPDBG) != 0;
+}
+
+//_________________________________________________________________________
+Bool_t AliConvEventCuts::IsPileUpEventCached(AliVEvent *event){
+  // multi-vertexer pileup check (pPb), cached per event
+  if (fCacheEvent != event) return fUtils->IsPileUpEvent(event);
+  if (!(fCacheDone & kCachePileUpMV)){
+    if (fUtils->IsPileUpEvent(event)) fCacheFlags |= kCachePileUpMV;
+    fCacheDone |= kCachePileUpMV;
+  }
+  return (fCacheFlags & kCachePileUpMV) != 0;
+}
+
+//_________________________________________________________________________
+Double_t AliConvEventCuts::GetPileupVertexDistZMaxCached(AliVEvent *event, Int_t &nPileVert){
+  // number of SPD pileup vertices and largest distance in z of a pileup vertex
+  // with at least 3 contributors to the primary SPD vertex (ESD only), cached per event
+  if (fCacheEvent == event && (fCacheDone & kCacheDistZ)){
+    nPileVert = fCacheNPileVert;
+    return fCacheDistZMax;
+  }
+
+  AliESDEvent *esdEvent = (AliESDEvent*)event;
+  Double_t distZMax     = 0;
+  nPileVert             = esdEvent->GetNumberOfPileupVerticesSPD();
+  for(Int_t i=0; i<nPileVert;i++){
+    const AliESDVertex* pv  = esdEvent->GetPileupVertexSPD(i);
+    Int_t nc2               = pv->GetNContributors();
+    if(nc2>=3){
+      Double_t z1     = esdEvent->GetPrimaryVertexSPD()->GetZ();
+      Double_t z2     = pv->GetZ();
+      Double_t distZ  = z2-z1;
+      if (TMath::Abs(distZMax) <  TMath::Abs(distZ) ){
+        distZMax      = distZ;
+      }
+    }
+  }
+
+  if (fCacheEvent == event){
+    fCacheNPileVert = nPileVert;
+    fCacheDistZMax  = distZMax;
+    fCacheDone     |= kCacheDistZ;
+  }
+  return distZMax;
+}
+
+//_________________________________________________________________________
+Bool_t AliConvEventCuts::IsLedEventCached(AliVEvent *event){
+  // EMCAL LED event check for LHC11a (hardware issues), cached per event
+  if (fCacheEvent == event && (fCacheDone & kCacheLED)) return (fCacheFlags & kCacheLED) != 0;
+
+  Int_t runnumber        = event->GetRunNumber();
+  AliVCaloCells *cells   = event->GetEMCALCells();
+  const Short_t nCells   = cells->GetNumberOfCells();
+  AliInputEventHandler *fInputHandler=(AliInputEventHandler*)(AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler());
+
+  // count cells above threshold
+  Int_t nCellCount[12] = {0,0,0,0,0,0,0,0,0,0,0,0};
+  for(Int_t iCell=0; iCell<nCells; ++iCell) {
+    Short_t cellId = cells->GetCellNumber(iCell);
+    Double_t cellE = cells->GetCellAmplitude(cellId);
+    Int_t sm       = cellId / (24*48);
+    if (cellE>0.1) ++nCellCount[sm];
+  }
+
+  Bool_t fIsLedEvent = kFALSE;
+  if (nCellCount[4] > 100) {
+    fIsLedEvent = kTRUE;
+  } else {
+    if ((runnumber>=146858) && (runnumber<=146860)) {
+      if ((fInputHandler->IsEventSelected() & AliVEvent::kMB) && (nCellCount[3]>=21))
+        fIsLedEvent = kTRUE;
+      else if ((fInputHandler->IsEventSelected() & AliVEvent::kEMC1) && (nCellCount[3]>=35))
+        fIsLedEvent = kTRUE;
+    }
+  }
+
+  if (fCacheEvent == event){
+    if (fIsLedEvent) fCacheFlags |= kCacheLED;
+    fCacheDone |= kCacheLED;
+  }
+  return fIsLedEvent;
+}
+
 //_________________________________________________________________________
 Float_t AliConvEventCuts::GetWeightForCentralityFlattening(AliVEvent *InputEvent){
 
@@ -369,6 +369,9 @@ class AliConvEventCuts : public AliAnalysisCuts {
                                       AliMCEvent *MCEvent, 
                                       Int_t isHeavyIon, 
                                       Bool_t isEMCALAnalysis);
+      // Per event cache of the cut independent event quantities, shared by all
+      // cut sets which pass this object as ReaderCuts (to be called once per event)
+      void      ResetEventCache(AliVEvent *event);
         
       void    PrintCuts();
       void    PrintCutsWithValues();
@@ -527,10 +530,29 @@ class AliConvEventCuts : public AliAnalysisCuts {
       TString                     fNameHistoReweightingMultMC;            // Histogram name for reweighting Eta
       TH1D*                       hReweightMultData;                      // histogram input for reweighting Eta
       TH1D*                       hReweightMultMC;                        // histogram input for reweighting Pi0
+      // per event cache
+      AliConvEventCuts*           fEventCache;                            //! cuts holding the event cache (ReaderCuts of last IsEventAcceptedByCut)
+      AliVEvent*                  fCacheEvent;                            //! event the cache is valid for, NULL if disabled
+      UInt_t                      fCacheDone;                             //! quantities already evaluated for fCacheEvent
+      UInt_t                      fCacheFlags;                            //! results of the pileup and LED checks
+      Int_t                       fCacheNPileVert;                        //! number of SPD pileup vertices
+      Double_t                    fCacheDistZMax;                         //! max distance of SPD pileup vertex to prim vertex in z
+      UInt_t                      fCacheCentralityDone;                   //! centrality slots already evaluated
+      Float_t                     fCacheCentrality[12];                   //! centrality per framework, detector and collision system
      
   private:
 
-      ClassDef(AliConvEventCuts,25)
+      enum EventCacheBits { kCachePileupSPD = BIT(0), kCacheSPDBG = BIT(1), kCachePileUpMV = BIT(2), kCacheDistZ = BIT(3), kCacheLED = BIT(4) };
+
+      AliConvEventCuts* GetEventCache()                                             { return fEventCache ? fEventCache : this                   ; }
+      Float_t   CalculateCentrality(AliVEvent *event);
+      Bool_t    IsPileupFromSPDCached(AliVEvent *event);
+      Bool_t    IsSPDClusterVsTrackletBGCached(AliVEvent *event);
+      Bool_t    IsPileUpEventCached(AliVEvent *event);
+      Double_t  GetPileupVertexDistZMaxCached(AliVEvent *event, Int_t &nPileVert);
+      Bool_t    IsLedEventCached(AliVEvent *event);
+
+      ClassDef(AliConvEventCuts,26)
 };
 
 
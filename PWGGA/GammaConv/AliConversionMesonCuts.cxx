@@ -797,19 +797,35 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
   // Selection of reconstructed Meson candidates
   // Use flag IsSignal in order to fill Fill different
   // histograms for Signal and Background
+  Int_t cutIndex=0;
+  if (!MesonIsSelectedKinematics(pi0->M(), pi0->Pt(), pi0->E(), pi0->Pz(), pi0->GetOpeningAngle(), pi0->GetAlpha(),
+                                 cutIndex, IsSignal, fRapidityShift)) return kFALSE;
+  return MesonIsSelectedDCA(pi0, cutIndex, IsSignal);
+}
+
+//________________________________________________________________________
+Bool_t AliConversionMesonCuts::MesonIsSelectedKinematics(Double_t mass, Double_t pt, Double_t e, Double_t pz,
+                                                         Double_t openingAngle, Double_t alpha,
+                                                         Int_t &cutIndex, Bool_t IsSignal, Double_t fRapidityShift)
+{
+
+  // First part of MesonIsSelected: rapidity, mass, opening angle and alpha cuts,
+  // which only need the kinematics of the pair (see AliConversionPhotonPairs).
+  // Fills the same histograms as MesonIsSelected; if the pair is accepted, the selection
+  // has to be completed with MesonIsSelectedDCA on the mother with the returned cutIndex.
   TH2 *hist=0x0;
 
   if(IsSignal){hist=fHistoMesonCuts;}
   else{hist=fHistoMesonBGCuts;}
 
-  Int_t cutIndex=0;
+  cutIndex=0;
 
-  if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if(hist)hist->Fill(cutIndex, pt);
   cutIndex++;
 
   // Undefined Rapidity -> Floating Point exception
-  if((pi0->E()+pi0->Pz())/(pi0->E()-pi0->Pz())<=0){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if((e+pz)/(e-pz)<=0){
+    if(hist)hist->Fill(cutIndex, pt);
     cutIndex++;
     if (!IsSignal)cout << "undefined rapidity" << endl;
     return kFALSE;
@@ -817,22 +833,22 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
   else{
     // PseudoRapidity Cut --> But we cut on Rapidity !!!
     cutIndex++;
-    if(TMath::Abs(pi0->Rapidity()-fRapidityShift)>fRapidityCutMeson){
-      if(hist)hist->Fill(cutIndex, pi0->Pt());
+    if(TMath::Abs(0.5*TMath::Log((e+pz)/(e-pz))-fRapidityShift)>fRapidityCutMeson){
+      if(hist)hist->Fill(cutIndex, pt);
       return kFALSE;
     }
   }
   cutIndex++;
 
-  if (fHistoInvMassBefore) fHistoInvMassBefore->Fill(pi0->M());
+  if (fHistoInvMassBefore) fHistoInvMassBefore->Fill(mass);
   // Mass cut
   if (fIsMergedClusterCut == 1 ){
     if (fEnableMassCut){
-      Double_t massMin = FunctionMinMassCut(pi0->E());
-      Double_t massMax = FunctionMaxMassCut(pi0->E());
-  //     cout << "Min mass: " << massMin << "\t max Mass: " << massMax << "\t mass current: " <<  pi0->M()<< "\t E current: " << pi0->E() << endl;
-      if (pi0->M() > massMax || pi0->M() < massMin ){
-        if(hist)hist->Fill(cutIndex, pi0->Pt());
+      Double_t massMin = FunctionMinMassCut(e);
+      Double_t massMax = FunctionMaxMassCut(e);
+  //     cout << "Min mass: " << massMin << "\t max Mass: " << massMax << "\t mass current: " <<  mass<< "\t E current: " << e << endl;
+      if (mass > massMax || mass < massMin ){
+        if(hist)hist->Fill(cutIndex, pt);
         return kFALSE;
       }
     }  
@@ -841,46 +857,60 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
   
   // Opening Angle Cut
   //fOpeningAngle=2*TMath::ATan(0.134/pi0->P());// physical minimum opening angle
-  if( fEnableMinOpeningAngleCut && pi0->GetOpeningAngle() < fOpeningAngle){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if( fEnableMinOpeningAngleCut && openingAngle < fOpeningAngle){
+    if(hist)hist->Fill(cutIndex, pt);
     return kFALSE;
   }
 
   // Min Opening Angle
-  if (fMinOpanPtDepCut == kTRUE) fMinOpanCutMeson = fFMinOpanCut->Eval(pi0->Pt());
+  if (fMinOpanPtDepCut == kTRUE) fMinOpanCutMeson = fFMinOpanCut->Eval(pt);
 
-  if (pi0->GetOpeningAngle() < fMinOpanCutMeson){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if (openingAngle < fMinOpanCutMeson){
+    if(hist)hist->Fill(cutIndex, pt);
     return kFALSE;
   }
 
   // Max Opening Angle
-  if (fMaxOpanPtDepCut == kTRUE) fMaxOpanCutMeson = fFMaxOpanCut->Eval(pi0->Pt());
+  if (fMaxOpanPtDepCut == kTRUE) fMaxOpanCutMeson = fFMaxOpanCut->Eval(pt);
 
-  if( pi0->GetOpeningAngle() > fMaxOpanCutMeson){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if( openingAngle > fMaxOpanCutMeson){
+    if(hist)hist->Fill(cutIndex, pt);
     return kFALSE;
   }
   cutIndex++;
   
   // Alpha Max Cut
-  if (fIsMergedClusterCut == 1 && fAlphaPtDepCut) fAlphaCutMeson = fFAlphaCut->Eval(pi0->E());
-  else if (fAlphaPtDepCut == kTRUE) fAlphaCutMeson = fFAlphaCut->Eval(pi0->Pt());
+  if (fIsMergedClusterCut == 1 && fAlphaPtDepCut) fAlphaCutMeson = fFAlphaCut->Eval(e);
+  else if (fAlphaPtDepCut == kTRUE) fAlphaCutMeson = fFAlphaCut->Eval(pt);
   
-  if(TMath::Abs(pi0->GetAlpha())>fAlphaCutMeson){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if(TMath::Abs(alpha)>fAlphaCutMeson){
+    if(hist)hist->Fill(cutIndex, pt);
     return kFALSE;
   }
   cutIndex++;
 
   // Alpha Min Cut
-  if(TMath::Abs(pi0->GetAlpha())<fAlphaMinCutMeson){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if(TMath::Abs(alpha)<fAlphaMinCutMeson){
+    if(hist)hist->Fill(cutIndex, pt);
     return kFALSE;
   }
   cutIndex++;
 
-  if (fHistoInvMassAfter) fHistoInvMassAfter->Fill(pi0->M());
+  if (fHistoInvMassAfter) fHistoInvMassAfter->Fill(mass);
+
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliConversionMesonCuts::MesonIsSelectedDCA(AliAODConversionMother *pi0, Int_t cutIndex, Bool_t IsSignal)
+{
+
+  // Second part of MesonIsSelected: DCA cuts of the mother,
+  // for a candidate accepted by MesonIsSelectedKinematics
+  TH2 *hist=0x0;
+
+  if(IsSignal){hist=fHistoMesonCuts;}
+  else{hist=fHistoMesonBGCuts;}
   
   if (fIsMergedClusterCut == 0){ 
     if (fHistoDCAGGMesonBefore)fHistoDCAGGMesonBefore->Fill(pi0->GetDCABetweenPhotons());
@@ -79,6 +79,11 @@ class AliConversionMesonCuts : public AliAnalysisCuts {
 
     // Cut Selection
     Bool_t MesonIsSelected(AliAODConversionMother *pi0,Bool_t IsSignal=kTRUE, Double_t fRapidityShift=0.);
+    // MesonIsSelected in two steps: the kinematic cuts on the pair kinematics (AliConversionPhotonPairs),
+    // then, for accepted pairs only, the DCA cuts on the mother object
+    Bool_t MesonIsSelectedKinematics(Double_t mass, Double_t pt, Double_t e, Double_t pz, Double_t openingAngle, Double_t alpha,
+                                     Int_t &cutIndex, Bool_t IsSignal=kTRUE, Double_t fRapidityShift=0.);
+    Bool_t MesonIsSelectedDCA(AliAODConversionMother *pi0, Int_t cutIndex, Bool_t IsSignal=kTRUE);
     Bool_t MesonIsSelectedMC(TParticle *fMCMother,AliStack *fMCStack, Double_t fRapidityShift=0.);
     Bool_t MesonIsSelectedAODMC(AliAODMCParticle *MCMother,TClonesArray *AODMCArray, Double_t fRapidityShift=0.);
     Bool_t MesonIsSelectedMCDalitz(TParticle *fMCMother,AliStack *fMCStack, Int_t &labelelectron, Int_t &labelpositron, Int_t &labelgamma,Double_t fRapidityShift=0.);
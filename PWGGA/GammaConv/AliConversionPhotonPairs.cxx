@@ -0,0 +1,195 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+////////////////////////////////////////////////
+//---------------------------------------------
+// Per event buffer of photon candidates and
+// kinematics of all their pairs
+//---------------------------------------------
+////////////////////////////////////////////////
+
+#include "TList.h"
+#include "TMath.h"
+
+#include "AliAODConversionPhoton.h"
+#include "AliConversionPhotonPairs.h"
+
+using namespace std;
+
+ClassImp(AliConversionPhotonPairs)
+
+//________________________________________________________________________
+AliConversionPhotonPairs::AliConversionPhotonPairs() :
+  TObject(),
+  fNPhotons(0),
+  fIndex(),
+  fPhotonPx(),
+  fPhotonPy(),
+  fPhotonPz(),
+  fPhotonE(),
+  fNPairs(0),
+  fFirst(),
+  fSecond(),
+  fMass(),
+  fPt(),
+  fE(),
+  fPz(),
+  fRapidity(),
+  fOpeningAngle(),
+  fAlpha()
+{
+  // default constructor
+}
+
+//________________________________________________________________________
+AliConversionPhotonPairs::~AliConversionPhotonPairs()
+{
+  // destructor
+}
+
+//________________________________________________________________________
+Int_t AliConversionPhotonPairs::LoadPhotons(TList *photons, Int_t offset)
+{
+  // copy the four momenta of the photons of the list behind the first offset photons,
+  // entries which are not AliAODConversionPhoton are skipped as in the pair loops of the tasks
+  Int_t nEntries = photons ? photons->GetEntries() : 0;
+  Int_t size     = offset + nEntries;
+  if (fIndex.GetSize() < size){
+    fIndex.Set(size);
+    fPhotonPx.Set(size);
+    fPhotonPy.Set(size);
+    fPhotonPz.Set(size);
+    fPhotonE.Set(size);
+  }
+
+  Int_t n = offset;
+  for (Int_t i = 0; i < nEntries; i++){
+    AliAODConversionPhoton *gamma = dynamic_cast<AliAODConversionPhoton*>(photons->At(i));
+    if (gamma == NULL) continue;
+    fIndex[n]    = i;
+    fPhotonPx[n] = gamma->Px();
+    fPhotonPy[n] = gamma->Py();
+    fPhotonPz[n] = gamma->Pz();
+    fPhotonE[n]  = gamma->E();
+    n++;
+  }
+  return n - offset;
+}
+
+//________________________________________________________________________
+void AliConversionPhotonPairs::Reserve(Int_t nPairs)
+{
+  // make room for nPairs pairs
+  if (fFirst.GetSize() >= nPairs) return;
+  Int_t size = TMath::Max(nPairs, 2*fFirst.GetSize());
+  fFirst.Set(size);
+  fSecond.Set(size);
+  fMass.Set(size);
+  fPt.Set(size);
+  fE.Set(size);
+  fPz.Set(size);
+  fRapidity.Set(size);
+  fOpeningAngle.Set(size);
+  fAlpha.Set(size);
+}
+
+//________________________________________________________________________
+Int_t AliConversionPhotonPairs::ComputePairs(TList *photons)
+{
+  // all pairs (i,j), i<j, of the photons of the list, in the order of the nested pair loops
+  fNPhotons = LoadPhotons(photons, 0);
+  fNPairs   = fNPhotons*(fNPhotons-1)/2;
+  Reserve(fNPairs);
+
+  Int_t pair = 0;
+  for (Int_t i = 0; i < fNPhotons; i++){
+    for (Int_t j = i+1; j < fNPhotons; j++){
+      fFirst[pair]  = i;
+      fSecond[pair] = j;
+      pair++;
+    }
+  }
+  ComputeKinematics();
+  return fNPairs;
+}
+
+//________________________________________________________________________
+Int_t AliConversionPhotonPairs::ComputePairs(TList *first, TList *second)
+{
+  // all pairs of a photon of the first list with a photon of the second list
+  Int_t nFirst  = LoadPhotons(first, 0);
+  Int_t nSecond = LoadPhotons(second, nFirst);
+  fNPhotons     = nFirst + nSecond;
+  fNPairs       = nFirst*nSecond;
+  Reserve(fNPairs);
+
+  Int_t pair = 0;
+  for (Int_t i = 0; i < nFirst; i++){
+    for (Int_t j = 0; j < nSecond; j++){
+      fFirst[pair]  = i;
+      fSecond[pair] = nFirst + j;
+      pair++;
+    }
+  }
+  ComputeKinematics();
+  return fNPairs;
+}
+
+//________________________________________________________________________
+void AliConversionPhotonPairs::ComputeKinematics()
+{
+  // kinematics of all pairs, with the arithmetic of AliAODConversionMother(y1,y2)
+  // (TLorentzVector::M, TVector3::Angle), so that the cuts give the same decisions
+  const Double_t *px = fPhotonPx.GetArray();
+  const Double_t *py = fPhotonPy.GetArray();
+  const Double_t *pz = fPhotonPz.GetArray();
+  const Double_t *e  = fPhotonE.GetArray();
+  Int_t *first       = fFirst.GetArray();
+  Int_t *second      = fSecond.GetArray();
+
+  for (Int_t pair = 0; pair < fNPairs; pair++){
+    Int_t i = first[pair];
+    Int_t j = second[pair];
+
+    Double_t sx = px[i] + px[j];
+    Double_t sy = py[i] + py[j];
+    Double_t sz = pz[i] + pz[j];
+    Double_t se = e[i] + e[j];
+    Double_t m2 = se*se - (sx*sx + sy*sy + sz*sz);
+    fMass[pair] = m2 < 0.0 ? -TMath::Sqrt(-m2) : TMath::Sqrt(m2);
+    fPt[pair]   = TMath::Sqrt(sx*sx + sy*sy);
+    fE[pair]    = se;
+    fPz[pair]   = sz;
+    Double_t ratio  = (se + sz)/(se - sz);
+    fRapidity[pair] = ratio > 0 ? 0.5*TMath::Log(ratio) : 0.;
+
+    Double_t ptot2 = (px[i]*px[i] + py[i]*py[i] + pz[i]*pz[i])*(px[j]*px[j] + py[j]*py[j] + pz[j]*pz[j]);
+    if (ptot2 <= 0){
+      fOpeningAngle[pair] = 0.0;
+    } else {
+      Double_t arg = (px[i]*px[j] + py[i]*py[j] + pz[i]*pz[j])/TMath::Sqrt(ptot2);
+      if (arg >  1.0) arg =  1.0;
+      if (arg < -1.0) arg = -1.0;
+      fOpeningAngle[pair] = TMath::ACos(arg);
+    }
+    fAlpha[pair] = se != 0 ? (e[i] - e[j])/se : -1;
+  }
+
+  // photon indices in their lists
+  for (Int_t pair = 0; pair < fNPairs; pair++){
+    first[pair]  = fIndex[first[pair]];
+    second[pair] = fIndex[second[pair]];
+  }
+}
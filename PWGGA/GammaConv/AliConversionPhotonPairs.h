@@ -0,0 +1,69 @@
+#ifndef ALICONVERSIONPHOTONPAIRS_H
+#define ALICONVERSIONPHOTONPAIRS_H
+
+// Per event buffer of photon candidates and of the kinematics of all their pairs.
+// The four momenta of the photons are copied into flat arrays and the invariant mass,
+// pt, energy, pz, rapidity, opening angle and alpha of all pairs are computed in one
+// pass over these arrays, with the same arithmetic as AliAODConversionMother, so that
+// the kinematic meson cuts (AliConversionMesonCuts::MesonIsSelectedKinematics) can be
+// applied before any mother object is created.
+
+#include "TObject.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
+
+class TList;
+
+class AliConversionPhotonPairs : public TObject {
+
+ public:
+
+  AliConversionPhotonPairs();
+  virtual ~AliConversionPhotonPairs();
+
+  // pairs i<j of the photons of one list
+  Int_t     ComputePairs(TList *photons);
+  // all pairs of a photon of the first list with a photon of the second list
+  Int_t     ComputePairs(TList *first, TList *second);
+
+  Int_t     GetNPairs()                     const { return fNPairs                ; }
+  Int_t     GetFirst(Int_t pair)            const { return fFirst.At(pair)        ; }
+  Int_t     GetSecond(Int_t pair)           const { return fSecond.At(pair)       ; }
+  Double_t  GetMass(Int_t pair)             const { return fMass.At(pair)         ; }
+  Double_t  GetPt(Int_t pair)               const { return fPt.At(pair)           ; }
+  Double_t  GetE(Int_t pair)                const { return fE.At(pair)            ; }
+  Double_t  GetPz(Int_t pair)               const { return fPz.At(pair)           ; }
+  Double_t  GetRapidity(Int_t pair)         const { return fRapidity.At(pair)     ; }
+  Double_t  GetOpeningAngle(Int_t pair)     const { return fOpeningAngle.At(pair) ; }
+  Double_t  GetAlpha(Int_t pair)            const { return fAlpha.At(pair)        ; }
+
+ private:
+
+  AliConversionPhotonPairs(const AliConversionPhotonPairs&);            // not implemented
+  AliConversionPhotonPairs& operator=(const AliConversionPhotonPairs&); // not implemented
+
+  Int_t     LoadPhotons(TList *photons, Int_t offset);
+  void      Reserve(Int_t nPairs);
+  void      ComputeKinematics();
+
+  Int_t     fNPhotons;            // photons in the buffer
+  TArrayI   fIndex;               // index of each photon in its list
+  TArrayD   fPhotonPx;            // px of the photons
+  TArrayD   fPhotonPy;            // py of the photons
+  TArrayD   fPhotonPz;            // pz of the photons
+  TArrayD   fPhotonE;             // E of the photons
+  Int_t     fNPairs;              // number of pairs
+  TArrayI   fFirst;               // first photon of each pair (in the buffer, then index in its list)
+  TArrayI   fSecond;              // second photon of each pair (in the buffer, then index in its list)
+  TArrayD   fMass;                // invariant mass of each pair
+  TArrayD   fPt;                  // pt of each pair
+  TArrayD   fE;                   // energy of each pair
+  TArrayD   fPz;                  // pz of each pair
+  TArrayD   fRapidity;            // rapidity of each pair (0 if undefined)
+  TArrayD   fOpeningAngle;        // opening angle of each pair
+  TArrayD   fAlpha;               // energy asymmetry of each pair
+
+  ClassDef(AliConversionPhotonPairs,1)
+};
+
+#endif
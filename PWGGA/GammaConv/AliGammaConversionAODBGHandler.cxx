@@ -20,6 +20,7 @@
 //---------------------------------------------
 ////////////////////////////////////////////////
 
+
 #include "AliGammaConversionAODBGHandler.h"
 #include "AliKFParticle.h"
 #include "AliAODConversionPhoton.h"
@@ -44,7 +45,10 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler() :
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(),
 	fBGEventsENeg(),
-	fBGEventsMeson()
+	fBGEventsMeson(),
+	fBGPool(),
+	fBGPoolENeg(),
+	fBGPoolMeson()
 {
 	// constructor
 }
@@ -64,7 +68,10 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t binsZ,Int_t
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
-	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents)))
+	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
+	fBGPool(),
+	fBGPoolENeg(),
+	fBGPoolMeson()
 {
 	// constructor
 }
@@ -86,7 +93,10 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t collisionSy
 	fBinLimitsArrayMultiplicity(NULL),
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
-	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents)))
+	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
+	fBGPool(),
+	fBGPoolENeg(),
+	fBGPoolMeson()
 {
 	// constructor
     if(fNBinsZ>8) fNBinsZ = 8;
@@ -357,9 +367,46 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(const AliGammaCon
 	fBinLimitsArrayMultiplicity(original.fBinLimitsArrayMultiplicity),
 	fBGEvents(original.fBGEvents),
 	fBGEventsENeg(original.fBGEventsENeg),
-	fBGEventsMeson(original.fBGEventsMeson)
+	fBGEventsMeson(original.fBGEventsMeson),
+	fBGPool(),
+	fBGPoolENeg(),
+	fBGPoolMeson()
 {
 	//copy constructor	
+	// the stored particles are copied into the pools of the copy, the copied vectors point to these copies
+	for(UInt_t z=0;z<fBGEvents.size();z++){
+		for(UInt_t m=0;m<fBGEvents[z].size();m++){
+			for(UInt_t e=0;e<fBGEvents[z][m].size();e++){
+				if(fBGEvents[z][m][e].empty()) continue;
+				TClonesArray *pool = GetBGPool(fBGPool,"AliAODConversionPhoton",z,m,e);
+				for(UInt_t i=0;i<fBGEvents[z][m][e].size();i++){
+					fBGEvents[z][m][e][i] = new((*pool)[i]) AliAODConversionPhoton(*(original.fBGEvents[z][m][e][i]));
+				}
+			}
+		}
+	}
+	for(UInt_t z=0;z<fBGEventsENeg.size();z++){
+		for(UInt_t m=0;m<fBGEventsENeg[z].size();m++){
+			for(UInt_t e=0;e<fBGEventsENeg[z][m].size();e++){
+				if(fBGEventsENeg[z][m][e].empty()) continue;
+				TClonesArray *pool = GetBGPool(fBGPoolENeg,"AliAODConversionPhoton",z,m,e);
+				for(UInt_t i=0;i<fBGEventsENeg[z][m][e].size();i++){
+					fBGEventsENeg[z][m][e][i] = new((*pool)[i]) AliAODConversionPhoton(*(original.fBGEventsENeg[z][m][e][i]));
+				}
+			}
+		}
+	}
+	for(UInt_t z=0;z<fBGEventsMeson.size();z++){
+		for(UInt_t m=0;m<fBGEventsMeson[z].size();m++){
+			for(UInt_t e=0;e<fBGEventsMeson[z][m].size();e++){
+				if(fBGEventsMeson[z][m][e].empty()) continue;
+				TClonesArray *pool = GetBGPool(fBGPoolMeson,"AliAODConversionMother",z,m,e);
+				for(UInt_t i=0;i<fBGEventsMeson[z][m][e].size();i++){
+					fBGEventsMeson[z][m][e][i] = new((*pool)[i]) AliAODConversionMother(*(original.fBGEventsMeson[z][m][e][i]));
+				}
+			}
+		}
+	}
 }
 
 //_____________________________________________________________________________________________________________________________
@@ -413,6 +460,11 @@ AliGammaConversionAODBGHandler::~AliGammaConversionAODBGHandler(){
 	if(fBinLimitsArrayMultiplicity){
 		delete[] fBinLimitsArrayMultiplicity;
 	}
+
+	// stored copies of the particles
+	fBGPool.Delete();
+	fBGPoolENeg.Delete();
+	fBGPoolMeson.Delete();
 }
 
 //_____________________________________________________________________________________________________________________________
@@ -496,6 +548,7 @@ void AliGammaConversionAODBGHandler::Initialize(Double_t * const zBinLimitsArray
 			fBGProbability[z][m] = 0;
 		}
 	}
+
 	//filling the probability
 	fBGProbability[0][0] = 0.243594;
 	fBGProbability[0][1] = 0.279477;
@@ -588,15 +641,15 @@ void AliGammaConversionAODBGHandler::AddEvent(TList* const eventGammas,Double_t
 	//  cout<<"Checking the entries: Z="<<z<<", M="<<m<<", eventCounter="<<eventCounter<<endl;
 
 	//  cout<<"The size of this vector is: "<<fBGEvents[z][m][eventCounter].size()<<endl;
-    for(Int_t d=0;d<fBGEvents[z][m][eventCounter].size();d++){
-		delete (AliAODConversionPhoton*)(fBGEvents[z][m][eventCounter][d]);
-	}
+	// the copies are kept in a TClonesArray per stored event, their memory is reused
+	TClonesArray *pool = GetBGPool(fBGPool,"AliAODConversionPhoton",z,m,eventCounter);
+	pool->Delete();
 	fBGEvents[z][m][eventCounter].clear();
 	
 	// add the gammas to the vector
 	for(Int_t i=0; i< eventGammas->GetEntries();i++){
 		//    AliKFParticle *t = new AliKFParticle(*(AliKFParticle*)(eventGammas->At(i)));
-		fBGEvents[z][m][eventCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventGammas->At(i))));
+		fBGEvents[z][m][eventCounter].push_back(new((*pool)[i]) AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventGammas->At(i))));
 	}
 	fBGEventCounter[z][m]++;
 }
@@ -620,14 +673,13 @@ void AliGammaConversionAODBGHandler::AddMesonEvent(TList* const eventMothers, Do
 	fBGEventVertex[z][m][eventCounter].fEP = epvalue;
 
 	//first clear the vector
-    for(Int_t d=0;d<fBGEvents[z][m][eventCounter].size();d++){
-		delete (AliAODConversionMother*)(fBGEventsMeson[z][m][eventCounter][d]);
-	}
+	TClonesArray *pool = GetBGPool(fBGPoolMeson,"AliAODConversionMother",z,m,eventCounter);
+	pool->Delete();
 	fBGEventsMeson[z][m][eventCounter].clear();
 	
 	// add the gammas to the vector
 	for(Int_t i=0; i< eventMothers->GetEntries();i++){
-		fBGEventsMeson[z][m][eventCounter].push_back(new AliAODConversionMother(*(AliAODConversionMother*)(eventMothers->At(i))));
+		fBGEventsMeson[z][m][eventCounter].push_back(new((*pool)[i]) AliAODConversionMother(*(AliAODConversionMother*)(eventMothers->At(i))));
 	}
 	fBGEventMesonCounter[z][m]++;
 }
@@ -649,16 +701,14 @@ void AliGammaConversionAODBGHandler::AddElectronEvent(TClonesArray* const eventE
 	//  cout<<"Checking the entries: Z="<<z<<", M="<<m<<", eventCounter="<<eventCounter<<endl;
 
 	//  cout<<"The size of this vector is: "<<fBGEvents[z][m][eventCounter].size()<<endl;
-    for(Int_t d=0;d<fBGEventsENeg[z][m][eventENegCounter].size();d++){
-		delete (AliAODConversionPhoton*)(fBGEventsENeg[z][m][eventENegCounter][d]);
-	}
-
+	TClonesArray *pool = GetBGPool(fBGPoolENeg,"AliAODConversionPhoton",z,m,eventENegCounter);
+	pool->Delete();
 	fBGEventsENeg[z][m][eventENegCounter].clear();
 
 	// add the electron to the vector
 	for(Int_t i=0; i< eventENeg->GetEntriesFast();i++){
 		//    AliKFParticle *t = new AliKFParticle(*(AliKFParticle*)(eventGammas->At(i)));
-		fBGEventsENeg[z][m][eventENegCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventENeg->At(i))));
+		fBGEventsENeg[z][m][eventENegCounter].push_back(new((*pool)[i]) AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventENeg->At(i))));
 	}
 	fBGEventENegCounter[z][m]++;
 }
@@ -683,6 +733,18 @@ AliGammaConversionAODVector* AliGammaConversionAODBGHandler::GetBGGoodENeg(Int_t
 	return &(fBGEventsENeg[z][m][event]);
 }
 
+//_____________________________________________________________________________________________________________________________
+TClonesArray* AliGammaConversionAODBGHandler::GetBGPool(TObjArray &pools, const char *className, Int_t z, Int_t m, Int_t event){
+	// TClonesArray holding the copies of the particles of a stored event, created on first use
+	Int_t index = (z*fNBinsMultiplicity+m)*fNEvents+event;
+	TClonesArray *pool = (TClonesArray*)pools.At(index);
+	if(!pool){
+		pool = new TClonesArray(className,10);
+		pools.AddAtAndExpand(pool,index);
+	}
+	return pool;
+}
+
 //_____________________________________________________________________________________________________________________________
 void AliGammaConversionAODBGHandler::PrintBGArray(){
 	//see headerfile for documentation
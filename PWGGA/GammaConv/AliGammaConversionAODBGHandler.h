@@ -19,6 +19,7 @@
 #include "AliAODConversionPhoton.h"
 #include "AliAODConversionMother.h"
 #include "TClonesArray.h"
+#include "TObjArray.h"
 #include "AliESDVertex.h"
 
 #if __GNUC__ >= 3
@@ -95,7 +96,12 @@ class AliGammaConversionAODBGHandler : public TObject {
 		AliGammaConversionBGVector 			fBGEvents; 						// photon background events
 		AliGammaConversionBGVector 			fBGEventsENeg; 					// electron background electron events
 		AliGammaConversionMotherBGVector 	fBGEventsMeson; 				// neutral meson background events
+		TObjArray 							fBGPool; 						//! TClonesArray per stored event holding the photon copies
+		TObjArray 							fBGPoolENeg; 					//! TClonesArray per stored event holding the electron copies
+		TObjArray 							fBGPoolMeson; 					//! TClonesArray per stored event holding the meson copies
+
+		TClonesArray* GetBGPool(TObjArray &pools, const char *className, Int_t z, Int_t m, Int_t event);
 		
-	ClassDef(AliGammaConversionAODBGHandler,5)
+	ClassDef(AliGammaConversionAODBGHandler,6)
 };
 #endif
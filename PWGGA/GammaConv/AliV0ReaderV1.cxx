@@ -574,6 +574,9 @@ Bool_t AliV0ReaderV1::ProcessEvent(AliVEvent *inputEvent,AliMCEvent *mcEvent)
   fInputEvent=inputEvent;
   fMCEvent=mcEvent;
 
+  // new event for the quantities the event cuts of the tasks share through the reader cuts
+  if(fEventCuts) fEventCuts->ResetEventCache(fInputEvent);
+
   if(!fInputEvent){
     AliError("No Input event");
     return kFALSE;
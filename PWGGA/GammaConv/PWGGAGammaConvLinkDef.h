@@ -14,6 +14,7 @@
 #pragma link C++ class AliCaloPhotonCuts+;
 #pragma link C++ class AliConvEventCuts+;
 #pragma link C++ class AliConversionPhotonCuts+;
+#pragma link C++ class AliConversionPhotonPairs+;
 #pragma link C++ class AliConversionCuts+;
 #pragma link C++ class AliConversionSelection+;
 #pragma link C++ class AliV0ReaderV1+;
@@ -139,7 +139,9 @@ AliCFTaskVertexingHF::AliCFTaskVertexingHF() :
   fUseAdditionalCuts(kFALSE),
   fUseCutsForTMVA(kFALSE),
   fUseCascadeTaskForLctoV0bachelor(kFALSE),
-  fCutOnMomConservation(0.00001)
+  fCutOnMomConservation(0.00001),
+  fFillBufferSize(0),
+  fFillBufferMaxDenseBins(0)
 {
   //
   //Default ctor
@@ -205,7 +207,9 @@ AliCFTaskVertexingHF::AliCFTaskVertexingHF(const Char_t* name, AliRDHFCuts* cuts
   fUseAdditionalCuts(kFALSE),
   fUseCutsForTMVA(kFALSE),
   fUseCascadeTaskForLctoV0bachelor(kFALSE),
-  fCutOnMomConservation(0.00001)
+  fCutOnMomConservation(0.00001),
+  fFillBufferSize(0),
+  fFillBufferMaxDenseBins(0)
 {
   //
   // Constructor. Initialization of Inputs and Outputs
@@ -303,7 +307,9 @@ AliCFTaskVertexingHF::AliCFTaskVertexingHF(const AliCFTaskVertexingHF& c) :
   fUseAdditionalCuts(c.fUseAdditionalCuts),
   fUseCutsForTMVA(c.fUseCutsForTMVA),
   fUseCascadeTaskForLctoV0bachelor(c.fUseCascadeTaskForLctoV0bachelor),
-  fCutOnMomConservation(c.fCutOnMomConservation)
+  fCutOnMomConservation(c.fCutOnMomConservation),
+  fFillBufferSize(c.fFillBufferSize),
+  fFillBufferMaxDenseBins(c.fFillBufferMaxDenseBins)
 {
   //
   // Copy Constructor
@@ -1232,6 +1238,16 @@ void AliCFTaskVertexingHF::UserExec(Option_t *)
 
 }
 
+//___________________________________________________________________________
+void AliCFTaskVertexingHF::FinishTaskOutput()
+{
+  //
+  // Adds the staged fills to the container before the output is written
+  //
+
+  if (fCFManager && fCFManager->GetParticleContainer()) fCFManager->GetParticleContainer()->FlushFillBuffer();
+}
+
 //___________________________________________________________________________
 void AliCFTaskVertexingHF::Terminate(Option_t*)
 {
@@ -1496,6 +1512,8 @@ void AliCFTaskVertexingHF::UserCreateOutputObjects()
   fHistEventsProcessed->GetXaxis()->SetBinLabel(1,"Events processed (all)");
   fHistEventsProcessed->GetXaxis()->SetBinLabel(2,"Events analyzed (after selection)");
 
+  if (fFillBufferSize>0) fCFManager->GetParticleContainer()->SetFillBuffer(fFillBufferSize,fFillBufferMaxDenseBins);
+
   PostData(1,fHistEventsProcessed) ;
   PostData(2,fCFManager->GetParticleContainer()) ;
   PostData(3,fCorrelation) ;
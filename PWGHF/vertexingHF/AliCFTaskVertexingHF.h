@@ -90,6 +90,7 @@ class AliCFTaskVertexingHF: public AliAnalysisTaskSE {
   void     UserExec(Option_t *option);
   void     Init();
   void     LocalInit() {Init();}
+  void     FinishTaskOutput();
   void     Terminate(Option_t *);
 
   /// UNFOLDING
@@ -262,6 +263,9 @@ class AliCFTaskVertexingHF: public AliAnalysisTaskSE {
   void SetCutOnMomConservation(Float_t cut) {fCutOnMomConservation = cut;}
   Bool_t GetCutOnMomConservation() const {return fCutOnMomConservation;}
 
+  /// stage the container fills in a buffer of 'size' entries (0: fill directly), see AliCFContainer::SetFillBuffer
+  void SetContainerFillBuffer(Int_t size, Long_t maxDenseBins=0) {fFillBufferSize = size; fFillBufferMaxDenseBins = maxDenseBins;}
+
  protected:
   AliCFManager   *fCFManager;   ///  pointer to the CF manager
   TH1I *fHistEventsProcessed;   //!<! simple histo for monitoring the number of events processed
@@ -323,9 +327,11 @@ class AliCFTaskVertexingHF: public AliAnalysisTaskSE {
   /// these are the pre-selection cuts for the TMVA
   Bool_t fUseCascadeTaskForLctoV0bachelor;   /// flag to define which task to use for Lc --> K0S+p
   Float_t fCutOnMomConservation; /// cut on momentum conservation
+  Int_t fFillBufferSize;        /// size of the staging buffer of the container fills (0: fill directly)
+  Long_t fFillBufferMaxDenseBins; /// steps with at most this number of bins are accumulated in dense arrays
 
   /// \cond CLASSIMP     
-  ClassDef(AliCFTaskVertexingHF,25); /// class for HF corrections as a function of many variables
+  ClassDef(AliCFTaskVertexingHF,26); /// class for HF corrections as a function of many variables
   /// \endcond
 };
 
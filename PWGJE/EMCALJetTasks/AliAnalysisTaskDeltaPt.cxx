@@ -21,6 +21,8 @@
 #include "AliJetContainer.h"
 #include "AliParticleContainer.h"
 #include "AliClusterContainer.h"
+#include "AliEmcalConePtGrid.h"
+#include "AliEmcalEventObjectCache.h"
 
 #include "AliAnalysisTaskDeltaPt.h"
 
@@ -37,6 +39,10 @@ AliAnalysisTaskDeltaPt::AliAnalysisTaskDeltaPt() :
   fConeMaxEta(0.9),
   fConeMinPhi(0),
   fConeMaxPhi(TMath::Pi()*2),
+  fUseConePtGrid(kTRUE),
+  fConePtGridName(),
+  fConePtGrid(0),
+  fRandConePtGrid(0),
   fJetsCont(0),
   fTracksCont(0),
   fCaloClustersCont(0),
@@ -107,6 +113,10 @@ AliAnalysisTaskDeltaPt::AliAnalysisTaskDeltaPt(const char *name) :
   fConeMaxEta(0.9),
   fConeMinPhi(0),
   fConeMaxPhi(TMath::Pi()*2),
+  fUseConePtGrid(kTRUE),
+  fConePtGridName(),
+  fConePtGrid(0),
+  fRandConePtGrid(0),
   fJetsCont(0),
   fTracksCont(0),
   fCaloClustersCont(0),
@@ -452,12 +462,14 @@ Bool_t AliAnalysisTaskDeltaPt::FillHistograms()
 
   if (fTracksCont || fCaloClustersCont) {
 
+    FillConePtGrid(fConePtGrid, fTracksCont, fCaloClustersCont);
+
     for (Int_t i = 0; i < fRCperEvent; i++) {
       // Simple random cones
       RCpt = 0;
       RCeta = 0;
       RCphi = 0;
-      GetRandomCone(RCpt, RCeta, RCphi, fTracksCont, fCaloClustersCont, 0);
+      GetRandomCone(RCpt, RCeta, RCphi, fTracksCont, fCaloClustersCont, 0, kFALSE, fConePtGrid);
       if (RCpt > 0) {
         fHistRCPhiEta->Fill(RCeta, RCphi);
         fHistRhoVSRCPt[fCentBin]->Fill(fJetsCont->GetRhoVal() * rcArea, RCpt);
@@ -479,7 +491,7 @@ Bool_t AliAnalysisTaskDeltaPt::FillHistograms()
         RCpt = 0;
         RCeta = 0;
         RCphi = 0;
-        GetRandomCone(RCpt, RCeta, RCphi, fTracksCont, fCaloClustersCont, jet);
+        GetRandomCone(RCpt, RCeta, RCphi, fTracksCont, fCaloClustersCont, jet, kFALSE, fConePtGrid);
         if (RCpt > 0) {
           if (jet) {
             Float_t dphi = RCphi - jet->Phi();
@@ -497,7 +509,7 @@ Bool_t AliAnalysisTaskDeltaPt::FillHistograms()
           RCpt = 0;
           RCeta = 0;
           RCphi = 0;
-          GetRandomCone(RCpt, RCeta, RCphi, fTracksCont, fCaloClustersCont, jet, kTRUE);
+          GetRandomCone(RCpt, RCeta, RCphi, fTracksCont, fCaloClustersCont, jet, kTRUE, fConePtGrid);
 
           if (RCpt > 0) {
             if (jet) {
@@ -519,7 +531,8 @@ Bool_t AliAnalysisTaskDeltaPt::FillHistograms()
     RCpt = 0;
     RCeta = 0;
     RCphi = 0;
-    GetRandomCone(RCpt, RCeta, RCphi, fRandTracksCont, fRandCaloClustersCont, 0);
+    FillConePtGrid(fRandConePtGrid, fRandTracksCont, fRandCaloClustersCont);
+    GetRandomCone(RCpt, RCeta, RCphi, fRandTracksCont, fRandCaloClustersCont, 0, kFALSE, fRandConePtGrid);
     if (RCpt > 0) {
       fHistRCPtRand[fCentBin]->Fill(RCpt);
       fHistDeltaPtRCRand[fCentBin]->Fill(RCpt - rcArea * fJetsCont->GetRhoVal());
@@ -584,7 +597,7 @@ AliEmcalJet* AliAnalysisTaskDeltaPt::NextEmbeddedJet(Bool_t reset)
 //________________________________________________________________________
 void AliAnalysisTaskDeltaPt::GetRandomCone(Float_t &pt, Float_t &eta, Float_t &phi,
     AliParticleContainer* tracks, AliClusterContainer* clusters,
-    AliEmcalJet *jet, Bool_t bPartialExclusion) const
+    AliEmcalJet *jet, Bool_t bPartialExclusion, AliEmcalConePtGrid *grid) const
 {
   // Get rigid cone.
 
@@ -642,6 +655,11 @@ void AliAnalysisTaskDeltaPt::GetRandomCone(Float_t &pt, Float_t &eta, Float_t &p
     return;
   }
 
+  if (grid) {
+    pt = grid->GetConePt(eta, phi, fConeRadius);
+    return;
+  }
+
   if (clusters) {
     clusters->ResetCurrentID();
     AliVCluster* cluster = clusters->GetNextAcceptCluster();
@@ -686,6 +704,33 @@ void AliAnalysisTaskDeltaPt::GetRandomCone(Float_t &pt, Float_t &eta, Float_t &p
   }
 }
 
+//________________________________________________________________________
+AliEmcalConePtGrid* AliAnalysisTaskDeltaPt::GetConePtGrid(const char *name)
+{
+  // Get the grid with this name from the event, or create it and add it to the event.
+
+  AliEmcalConePtGrid *grid = dynamic_cast<AliEmcalConePtGrid*>(InputEvent()->FindListObject(name));
+  if (!grid) {
+    grid = new AliEmcalConePtGrid(name);
+    AddObjectToEvent(grid);
+  }
+  return grid;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskDeltaPt::FillConePtGrid(AliEmcalConePtGrid *grid, AliParticleContainer* tracks, AliClusterContainer* clusters)
+{
+  // Fill the grid, unless another task sharing it already did for this event.
+
+  if (!grid) return;
+
+  // event stamp unique over the input files (the entry of the analysis manager is local to the current tree)
+  Long64_t entry = AliEmcalEventObjectCache::Instance()->GetEventStamp(InputEvent());
+  if (grid->IsFilled(entry)) return;
+
+  grid->Fill(tracks, clusters, fVertex, entry);
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskDeltaPt::SetConeEtaPhiEMCAL()
 {
@@ -731,6 +776,16 @@ void AliAnalysisTaskDeltaPt::ExecOnce()
   if (fMinRC2LJ < 0)
     fMinRC2LJ = fConeRadius * 1.5;
 
+  if (fUseConePtGrid) {
+    if (fTracksCont || fCaloClustersCont) {
+      if (fConePtGridName.IsNull()) fConePtGridName = Form("%s_ConePtGrid", GetName());
+      fConePtGrid = GetConePtGrid(fConePtGridName);
+    }
+    if (fRandTracksCont || fRandCaloClustersCont) {
+      fRandConePtGrid = GetConePtGrid(Form("%s_RandConePtGrid", GetName()));
+    }
+  }
+
   const Float_t maxDist = TMath::Max(fConeMaxPhi - fConeMinPhi, fConeMaxEta - fConeMinEta) / 2;
   if (fMinRC2LJ > maxDist) {
     AliWarning(Form("The parameter fMinRC2LJ = %f is too large for the considered acceptance. "
@@ -11,6 +11,7 @@ class TH3;
 class AliJetContainer;
 class AliParticleContainer;
 class AliClusterContainer;
+class AliEmcalConePtGrid;
 
 #include "AliAnalysisTaskEmcalJet.h"
 
@@ -31,6 +32,8 @@ class AliAnalysisTaskDeltaPt : public AliAnalysisTaskEmcalJet {
   void                        SetConeEtaPhiTPC()   ;
   void                        SetConeEtaLimits(Float_t min, Float_t max)           { fConeMinEta = min, fConeMaxEta = max  ; }
   void                        SetConePhiLimits(Float_t min, Float_t max)           { fConeMinPhi = min, fConeMaxPhi = max  ; }
+  void                        SetUseConePtGrid(Bool_t b)                           { fUseConePtGrid           = b          ; }
+  void                        SetConePtGridName(const char *n)                     { fConePtGridName          = n          ; }
 
  protected:
   void                        AllocateHistogramArrays()                                                                     ;
@@ -41,7 +44,9 @@ class AliAnalysisTaskDeltaPt : public AliAnalysisTaskEmcalJet {
   void                        DoEmbTrackLoop()                                                                              ;
   void                        DoEmbClusterLoop()                                                                            ;
   void                        GetRandomCone(Float_t &pt, Float_t &eta, Float_t &phi, AliParticleContainer* tracks, AliClusterContainer* clusters,
-					    AliEmcalJet *jet = 0, Bool_t bPartialExclusion = 0) const;
+					    AliEmcalJet *jet = 0, Bool_t bPartialExclusion = 0, AliEmcalConePtGrid *grid = 0) const;
+  AliEmcalConePtGrid*         GetConePtGrid(const char *name)                                                               ;
+  void                        FillConePtGrid(AliEmcalConePtGrid *grid, AliParticleContainer* tracks, AliClusterContainer* clusters);
   Double_t                    GetNColl() const;
 
 
@@ -53,6 +58,11 @@ class AliAnalysisTaskDeltaPt : public AliAnalysisTaskEmcalJet {
   Float_t                     fConeMaxEta;                 // Maximum eta of the random cones
   Float_t                     fConeMinPhi;                 // Minimum phi of the random cones
   Float_t                     fConeMaxPhi;                 // Maximum phi of the random cones
+  Bool_t                      fUseConePtGrid;              // Use an eta-phi grid of the tracks and clusters for the random cone pt
+  TString                     fConePtGridName;             // Name of the grid in the event, to share it with other tasks with the same tracks and clusters
+
+  AliEmcalConePtGrid         *fConePtGrid;                 //!Grid of the tracks and clusters
+  AliEmcalConePtGrid         *fRandConePtGrid;             //!Grid of the randomized tracks and clusters
 
   AliJetContainer            *fJetsCont;                   //!Jets
   AliParticleContainer       *fTracksCont;                 //!Tracks
@@ -98,6 +108,6 @@ class AliAnalysisTaskDeltaPt : public AliAnalysisTaskEmcalJet {
   AliAnalysisTaskDeltaPt(const AliAnalysisTaskDeltaPt&);            // not implemented
   AliAnalysisTaskDeltaPt &operator=(const AliAnalysisTaskDeltaPt&); // not implemented
 
-  ClassDef(AliAnalysisTaskDeltaPt, 5) // deltaPt analysis task
+  ClassDef(AliAnalysisTaskDeltaPt, 6) // deltaPt analysis task
 };
 #endif
@@ -438,6 +438,29 @@ void AliAnalysisTaskRhoBase::ExecOnce()
   AliAnalysisTaskEmcalJet::ExecOnce();
 }
 
+//________________________________________________________________________
+void AliAnalysisTaskRhoBase::GetInputCollections(std::vector<TString> &names) const
+{
+  // Names of the objects read from the event, including the rho objects to compare.
+
+  AliAnalysisTaskEmcalJet::GetInputCollections(names);
+
+  if (!fCompareRhoName.IsNull()) names.push_back(fCompareRhoName);
+  if (!fCompareRhoScaledName.IsNull()) names.push_back(fCompareRhoScaledName);
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskRhoBase::GetOutputCollections(std::vector<TString> &names) const
+{
+  // Names of the objects written to the event: the output rho objects.
+
+  AliAnalysisTaskEmcalJet::GetOutputCollections(names);
+
+  if (!fAttachToEvent) return;
+  if (fOutRho) names.push_back(fOutRhoName);
+  if (fOutRhoScaled) names.push_back(fOutRhoScaledName);
+}
+
 //________________________________________________________________________
 Double_t AliAnalysisTaskRhoBase::GetRhoFactor(Double_t cent)
 {
@@ -33,6 +33,8 @@ class AliAnalysisTaskRhoBase : public AliAnalysisTaskEmcalJet {
 
   const char*            GetOutRhoName() const                                 { return fOutRhoName.Data()       ;                   }
   const char*            GetOutRhoScaledName() const                           { return fOutRhoScaledName.Data() ;                   }
+  void                   GetInputCollections(std::vector<TString> &names) const;
+  void                   GetOutputCollections(std::vector<TString> &names) const;
 
  protected:
   void                   ExecOnce();
@@ -0,0 +1,299 @@
+/**************************************************************************
+ * Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+//
+// Per event eta-phi grid of the accepted tracks and clusters, for fast cone pt sums.
+//
+
+#include "AliEmcalConePtGrid.h"
+
+#include <TLorentzVector.h>
+#include <TMath.h>
+#include <TVector2.h>
+
+#include "AliVCluster.h"
+#include "AliVParticle.h"
+#include "AliParticleContainer.h"
+#include "AliClusterContainer.h"
+
+ClassImp(AliEmcalConePtGrid)
+
+//________________________________________________________________________
+AliEmcalConePtGrid::AliEmcalConePtGrid() :
+  TNamed(),
+  fNEta(20),
+  fEtaMin(-1),
+  fEtaMax(1),
+  fNPhi(63),
+  fEtaWidth(0.1),
+  fPhiWidth(TMath::TwoPi()/63),
+  fFilledEntry(-1),
+  fNParticles(0),
+  fParticleEta(),
+  fParticlePhi(),
+  fParticlePt(),
+  fParticleCell(),
+  fCellStart(),
+  fCellEta(),
+  fCellPhi(),
+  fCellPt(),
+  fRowSum()
+{
+  // Default constructor.
+}
+
+//________________________________________________________________________
+AliEmcalConePtGrid::AliEmcalConePtGrid(const char *name, Int_t nEta, Double_t etaMin, Double_t etaMax, Int_t nPhi) :
+  TNamed(name, name),
+  fNEta(nEta > 0 ? nEta : 1),
+  fEtaMin(etaMin),
+  fEtaMax(etaMax > etaMin ? etaMax : etaMin + 1),
+  fNPhi(nPhi > 0 ? nPhi : 1),
+  fEtaWidth(0),
+  fPhiWidth(0),
+  fFilledEntry(-1),
+  fNParticles(0),
+  fParticleEta(),
+  fParticlePhi(),
+  fParticlePt(),
+  fParticleCell(),
+  fCellStart(),
+  fCellEta(),
+  fCellPhi(),
+  fCellPt(),
+  fRowSum()
+{
+  // Standard constructor.
+
+  fEtaWidth = (fEtaMax - fEtaMin) / fNEta;
+  fPhiWidth = TMath::TwoPi() / fNPhi;
+}
+
+//________________________________________________________________________
+void AliEmcalConePtGrid::Fill(AliParticleContainer *tracks, AliClusterContainer *clusters, const Double_t *vertex, Long64_t entry)
+{
+  // Fill the grid with the accepted clusters and tracks of the event.
+
+  fNParticles = 0;
+  fEtaWidth = (fEtaMax - fEtaMin) / fNEta;
+  fPhiWidth = TMath::TwoPi() / fNPhi;
+
+  if (clusters) {
+    clusters->ResetCurrentID();
+    AliVCluster* cluster = clusters->GetNextAcceptCluster();
+    while (cluster) {
+      TLorentzVector nPart;
+      cluster->GetMomentum(nPart, const_cast<Double_t*>(vertex));
+
+      AddParticle(nPart.Eta(), nPart.Phi(), nPart.Pt());
+
+      cluster = clusters->GetNextAcceptCluster();
+    }
+  }
+
+  if (tracks) {
+    tracks->ResetCurrentID();
+    AliVParticle* track = tracks->GetNextAcceptParticle();
+    while (track) {
+      AddParticle(track->Eta(), track->Phi(), track->Pt());
+
+      track = tracks->GetNextAcceptParticle();
+    }
+  }
+
+  // sort the particles by cell (counting sort)
+  const Int_t nCells = fNEta * fNPhi;
+  fCellStart.Set(nCells + 1);
+  fCellStart.Reset(0);
+  if (fCellEta.GetSize() < fNParticles) {
+    fCellEta.Set(fNParticles);
+    fCellPhi.Set(fNParticles);
+    fCellPt.Set(fNParticles);
+  }
+
+  for (Int_t i = 0; i < fNParticles; i++) fCellStart[fParticleCell[i] + 1]++;
+  for (Int_t icell = 0; icell < nCells; icell++) fCellStart[icell + 1] += fCellStart[icell];
+
+  for (Int_t i = 0; i < fNParticles; i++) {
+    Int_t pos = fCellStart[fParticleCell[i]]++;
+    fCellEta[pos] = fParticleEta[i];
+    fCellPhi[pos] = fParticlePhi[i];
+    fCellPt[pos] = fParticlePt[i];
+  }
+
+  for (Int_t icell = nCells; icell > 0; icell--) fCellStart[icell] = fCellStart[icell - 1];
+  fCellStart[0] = 0;
+
+  // prefix sums of the cell pt along each row
+  fRowSum.Set(fNEta * (fNPhi + 1));
+  for (Int_t row = 0; row < fNEta; row++) {
+    Int_t offset = row * (fNPhi + 1);
+    Double_t sum = 0;
+    fRowSum[offset] = 0;
+    for (Int_t c = 0; c < fNPhi; c++) {
+      Int_t icell = row * fNPhi + c;
+      for (Int_t i = fCellStart[icell]; i < fCellStart[icell + 1]; i++) sum += fCellPt[i];
+      fRowSum[offset + c + 1] = sum;
+    }
+  }
+
+  fFilledEntry = entry;
+}
+
+//________________________________________________________________________
+void AliEmcalConePtGrid::AddParticle(Float_t eta, Float_t phi, Double_t pt)
+{
+  // Add a particle, phi is kept as given for the distance calculation.
+
+  if (fParticleEta.GetSize() <= fNParticles) {
+    Int_t size = 2 * fNParticles + 64;
+    fParticleEta.Set(size);
+    fParticlePhi.Set(size);
+    fParticlePt.Set(size);
+    fParticleCell.Set(size);
+  }
+
+  fParticleEta[fNParticles] = eta;
+  fParticlePhi[fNParticles] = phi;
+  fParticlePt[fNParticles] = pt;
+  fParticleCell[fNParticles] = GetEtaBin(eta) * fNPhi + GetPhiBin(TVector2::Phi_0_2pi(phi));
+  fNParticles++;
+}
+
+//________________________________________________________________________
+Int_t AliEmcalConePtGrid::GetEtaBin(Double_t eta) const
+{
+  // Eta row, particles out of the grid range are in the edge rows.
+
+  if (!(eta > fEtaMin)) return 0; // also NaN
+  Double_t bin = (eta - fEtaMin) / fEtaWidth;
+  if (bin >= fNEta) return fNEta - 1;
+  return Int_t(bin);
+}
+
+//________________________________________________________________________
+Int_t AliEmcalConePtGrid::GetPhiBin(Double_t phi) const
+{
+  // Phi cell, phi in [0,2pi].
+
+  if (!(phi > 0)) return 0; // also NaN
+  Int_t bin = Int_t(phi / fPhiWidth);
+  if (bin >= fNPhi) return fNPhi - 1;
+  return bin;
+}
+
+//________________________________________________________________________
+Double_t AliEmcalConePtGrid::GetRowSum(Int_t row, Int_t first, Int_t last) const
+{
+  // Sum of the pt of the cells first..last (0 <= first <= last < fNPhi) of a row.
+
+  Int_t offset = row * (fNPhi + 1);
+  return fRowSum[offset + last + 1] - fRowSum[offset + first];
+}
+
+//________________________________________________________________________
+Double_t AliEmcalConePtGrid::GetCellConePt(Int_t cell, Float_t eta, Float_t phi, Double_t r) const
+{
+  // Sum of the pt of the particles of a cell inside the cone,
+  // same distance calculation as AliAnalysisTaskDeltaPt::GetRandomCone.
+
+  Double_t pt = 0;
+  for (Int_t i = fCellStart[cell]; i < fCellStart[cell + 1]; i++) {
+    Float_t parteta = fCellEta[i];
+    Float_t partphi = fCellPhi[i];
+
+    if (TMath::Abs(partphi - phi) > TMath::Abs(partphi - phi + 2 * TMath::Pi()))
+      partphi += 2 * TMath::Pi();
+    if (TMath::Abs(partphi - phi) > TMath::Abs(partphi - phi - 2 * TMath::Pi()))
+      partphi -= 2 * TMath::Pi();
+
+    Float_t d = TMath::Sqrt((parteta - eta) * (parteta - eta) + (partphi - phi) * (partphi - phi));
+    if (d <= r)
+      pt += fCellPt[i];
+  }
+  return pt;
+}
+
+//________________________________________________________________________
+Float_t AliEmcalConePtGrid::GetConePt(Float_t eta, Float_t phi, Double_t r) const
+{
+  // Sum of the pt of the particles in the cone of radius r around (eta,phi).
+  // In each row the cells entirely inside the cone are summed from the prefix sums,
+  // the particles of the cells crossed by the cone edge are tested one by one.
+  // The edge rows also contain the particles out of the grid range and are always tested.
+
+  if (fNParticles == 0 || r < 0) return 0;
+
+  const Double_t margin = 1e-5;
+  const Double_t rOut = r * (1 + margin) + margin; // cells possibly overlapping the cone
+  const Double_t rIn = r * (1 - margin);           // cells inside the cone, safe against rounding
+
+  Int_t rowFirst = GetEtaBin(eta - rOut);
+  Int_t rowLast = GetEtaBin(eta + rOut);
+
+  Double_t pt = 0;
+  for (Int_t row = rowFirst; row <= rowLast; row++) {
+    Double_t hOut = rOut;
+    Double_t hIn = -1;
+
+    if (row > 0 && row < fNEta - 1) {
+      Double_t e0 = fEtaMin + row * fEtaWidth;
+      Double_t e1 = e0 + fEtaWidth;
+      Double_t dMin = eta < e0 ? e0 - eta : (eta > e1 ? eta - e1 : 0.);
+      if (dMin > rOut) continue;
+      hOut = TMath::Sqrt(rOut * rOut - dMin * dMin);
+      Double_t dMax = TMath::Max(TMath::Abs(eta - e0), TMath::Abs(eta - e1));
+      if (dMax < rIn) hIn = TMath::Sqrt(rIn * rIn - dMax * dMax);
+    }
+
+    // cells crossed by [phi-hOut,phi+hOut], indices not wrapped
+    Int_t cFirst = TMath::FloorNint((phi - hOut) / fPhiWidth);
+    Int_t cLast = TMath::FloorNint((phi + hOut) / fPhiWidth);
+    if (cLast - cFirst + 1 > fNPhi) cLast = cFirst + fNPhi - 1;
+
+    // cells inside [phi-hIn,phi+hIn]
+    Int_t inFirst = cLast + 1;
+    Int_t inLast = cLast;
+    if (hIn > 0) {
+      inFirst = TMath::Max(TMath::CeilNint((phi - hIn) / fPhiWidth), cFirst);
+      inLast = TMath::Min(TMath::FloorNint((phi + hIn) / fPhiWidth) - 1, cLast);
+      if (inLast < inFirst) {
+        inFirst = cLast + 1;
+        inLast = cLast;
+      }
+    }
+
+    for (Int_t c = cFirst; c < inFirst; c++) {
+      pt += GetCellConePt(row * fNPhi + ((c % fNPhi) + fNPhi) % fNPhi, eta, phi, r);
+    }
+
+    if (inFirst <= inLast) {
+      Int_t c0 = ((inFirst % fNPhi) + fNPhi) % fNPhi;
+      Int_t c1 = c0 + inLast - inFirst;
+      if (c1 < fNPhi) {
+        pt += GetRowSum(row, c0, c1);
+      }
+      else {
+        pt += GetRowSum(row, c0, fNPhi - 1);
+        pt += GetRowSum(row, 0, c1 - fNPhi);
+      }
+    }
+
+    for (Int_t c = inLast + 1; c <= cLast; c++) {
+      pt += GetCellConePt(row * fNPhi + ((c % fNPhi) + fNPhi) % fNPhi, eta, phi, r);
+    }
+  }
+
+  return pt;
+}
@@ -0,0 +1,65 @@
+#ifndef ALIEMCALCONEPTGRID_H
+#define ALIEMCALCONEPTGRID_H
+
+// Per event eta-phi grid of the accepted tracks and clusters, for fast cone pt sums.
+//
+// The particles are sorted by cell and the pt of the cells is summed along each
+// eta row (prefix sums), so that the cells entirely inside a cone are added in
+// one step per row; only the particles of the cells crossed by the cone edge are
+// tested one by one, with the same distance definition as the random cones of
+// AliAnalysisTaskDeltaPt. The grid can be published in the event and shared
+// by all the tasks using the same track and cluster selection.
+
+#include <TNamed.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
+#include <TArrayI.h>
+
+class AliParticleContainer;
+class AliClusterContainer;
+
+class AliEmcalConePtGrid : public TNamed {
+ public:
+  AliEmcalConePtGrid();
+  AliEmcalConePtGrid(const char *name, Int_t nEta = 20, Double_t etaMin = -1, Double_t etaMax = 1, Int_t nPhi = 63);
+  virtual ~AliEmcalConePtGrid() {;}
+
+  void                        Fill(AliParticleContainer *tracks, AliClusterContainer *clusters, const Double_t *vertex, Long64_t entry);
+  Bool_t                      IsFilled(Long64_t entry) const                       { return fFilledEntry >= 0 && fFilledEntry == entry; }
+  void                        Reset()                                              { fFilledEntry = -1; fNParticles = 0; }
+
+  Float_t                     GetConePt(Float_t eta, Float_t phi, Double_t r) const;
+  Int_t                       GetNParticles() const                                { return fNParticles; }
+
+ protected:
+  Int_t                       GetEtaBin(Double_t eta) const;
+  Int_t                       GetPhiBin(Double_t phi) const;
+  void                        AddParticle(Float_t eta, Float_t phi, Double_t pt);
+  Double_t                    GetRowSum(Int_t row, Int_t first, Int_t last) const;
+  Double_t                    GetCellConePt(Int_t cell, Float_t eta, Float_t phi, Double_t r) const;
+
+  Int_t                       fNEta;                       // number of eta rows
+  Double_t                    fEtaMin;                     // lower eta edge (particles below are in the first row)
+  Double_t                    fEtaMax;                     // upper eta edge (particles above are in the last row)
+  Int_t                       fNPhi;                       // number of phi cells in [0,2pi]
+  Double_t                    fEtaWidth;                   //!eta width of a row
+  Double_t                    fPhiWidth;                   //!phi width of a cell
+  Long64_t                    fFilledEntry;                //!stamp of the event the grid was filled for (see AliEmcalEventObjectCache::GetEventStamp, -1 = not filled)
+  Int_t                       fNParticles;                 //!number of particles in the grid
+  TArrayF                     fParticleEta;                //!eta of the particles, in input order while filling
+  TArrayF                     fParticlePhi;                //!phi of the particles, in input order while filling
+  TArrayD                     fParticlePt;                 //!pt of the particles, in input order while filling
+  TArrayI                     fParticleCell;               //!cell of the particles
+  TArrayI                     fCellStart;                  //!first particle of each cell in the sorted arrays, nEta*nPhi+1 entries
+  TArrayF                     fCellEta;                    //!eta of the particles sorted by cell
+  TArrayF                     fCellPhi;                    //!phi of the particles sorted by cell
+  TArrayD                     fCellPt;                     //!pt of the particles sorted by cell
+  TArrayD                     fRowSum;                     //!prefix sums of the cell pt along each row, nEta*(nPhi+1) entries
+
+ private:
+  AliEmcalConePtGrid(const AliEmcalConePtGrid&);            // not implemented
+  AliEmcalConePtGrid &operator=(const AliEmcalConePtGrid&); // not implemented
+
+  ClassDef(AliEmcalConePtGrid, 1) // Eta-phi grid of tracks and clusters for cone pt sums
+};
+#endif
@@ -0,0 +1,391 @@
+/**************************************************************************
+ * Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+//
+// Event-wide constituent subtraction on flat particle and ghost arrays.
+//
+
+#include "AliEmcalConstituentSubtractor.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <TMath.h>
+
+ClassImp(AliEmcalConstituentSubtractor)
+
+//________________________________________________________________________
+AliEmcalConstituentSubtractor::AliEmcalConstituentSubtractor() :
+  TObject(),
+  fJetParticleStart(1, 0),
+  fJetGhostStart(1, 0),
+  fParticleRap(),
+  fParticlePhi(),
+  fParticlePt(),
+  fParticleMtMinusPt(),
+  fParticlePtFraction(),
+  fParticleMtFraction(),
+  fGhostRap(),
+  fGhostPhi(),
+  fGhostArea(),
+  fGhostPtFraction(),
+  fGhostMtFraction(),
+  fNRap(0),
+  fNPhi(0),
+  fCellSize(0),
+  fRapMin(0),
+  fPhiMin(0),
+  fPhiRef(0),
+  fCellStart(),
+  fCellGhosts(),
+  fParticleCellRap(),
+  fParticleCellPhi(),
+  fParticleNextRing(),
+  fBands(),
+  fNPtParticles(0),
+  fNPtGhosts(0),
+  fNMtParticles(0),
+  fNMtGhosts(0)
+{
+  // Default constructor.
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractor::Clear(Option_t * /*opt*/)
+{
+  // Remove all the jets, keeping the allocated memory.
+
+  fJetParticleStart.assign(1, 0);
+  fJetGhostStart.assign(1, 0);
+  fParticleRap.clear();
+  fParticlePhi.clear();
+  fParticlePt.clear();
+  fParticleMtMinusPt.clear();
+  fParticlePtFraction.clear();
+  fParticleMtFraction.clear();
+  fGhostRap.clear();
+  fGhostPhi.clear();
+  fGhostArea.clear();
+  fGhostPtFraction.clear();
+  fGhostMtFraction.clear();
+}
+
+//________________________________________________________________________
+Int_t AliEmcalConstituentSubtractor::AddJet()
+{
+  // Start a new jet, the following particles and ghosts belong to it.
+
+  fJetParticleStart.push_back(fParticleRap.size());
+  fJetGhostStart.push_back(fGhostRap.size());
+  return fJetParticleStart.size() - 2;
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractor::AddParticle(Double_t rap, Double_t phi, Double_t pt, Double_t mtMinusPt)
+{
+  // Add a particle to the last jet, phi in [0,2pi).
+
+  fParticleRap.push_back(rap);
+  fParticlePhi.push_back(phi);
+  fParticlePt.push_back(pt);
+  fParticleMtMinusPt.push_back(mtMinusPt);
+  fParticlePtFraction.push_back(1.);
+  fParticleMtFraction.push_back(1.);
+  fJetParticleStart.back() = fParticleRap.size();
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractor::AddGhost(Double_t rap, Double_t phi, Double_t area)
+{
+  // Add a ghost to the last jet, phi in [0,2pi).
+
+  fGhostRap.push_back(rap);
+  fGhostPhi.push_back(phi);
+  fGhostArea.push_back(area);
+  fGhostPtFraction.push_back(1.);
+  fGhostMtFraction.push_back(1.);
+  fJetGhostStart.back() = fGhostRap.size();
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractor::Subtract(Double_t rho, Double_t rhom)
+{
+  // Subtract the background of all the jets.
+
+  for (Int_t ij = 0; ij < GetNJets(); ij++) SubtractJet(ij, rho, rhom);
+}
+
+//________________________________________________________________________
+Double_t AliEmcalConstituentSubtractor::GetSubtractedPt(Int_t ip) const
+{
+  // Subtracted pt of a particle.
+
+  if (fParticlePtFraction[ip] > 0) return fParticlePt[ip] * fParticlePtFraction[ip];
+  return 0;
+}
+
+//________________________________________________________________________
+Double_t AliEmcalConstituentSubtractor::GetSubtractedMtMinusPt(Int_t ip) const
+{
+  // Subtracted mt-pt of a particle.
+
+  if (fParticleMtFraction[ip] > 0) return fParticleMtMinusPt[ip] * fParticleMtFraction[ip];
+  return 0;
+}
+
+//________________________________________________________________________
+Double_t AliEmcalConstituentSubtractor::SquaredDistance(Double_t rap1, Double_t phi1, Double_t rap2, Double_t phi2)
+{
+  // Squared rapidity-phi distance, as fastjet::PseudoJet::squared_distance.
+
+  Double_t dphi = std::abs(phi1 - phi2);
+  if (dphi > TMath::Pi()) dphi = TMath::TwoPi() - dphi;
+  Double_t drap = rap1 - rap2;
+  return (dphi*dphi + drap*drap);
+}
+
+//________________________________________________________________________
+Double_t AliEmcalConstituentSubtractor::GetLocalPhi(Double_t phi) const
+{
+  // Phi relative to the reference phi of the current jet, in [-pi,pi).
+
+  Double_t dphi = phi - fPhiRef;
+  if (dphi >= TMath::Pi()) dphi -= TMath::TwoPi();
+  else if (dphi < -TMath::Pi()) dphi += TMath::TwoPi();
+  return dphi;
+}
+
+//________________________________________________________________________
+Bool_t AliEmcalConstituentSubtractor::IsPairNeeded(Int_t ip, Int_t ig) const
+{
+  // Whether the pair can still transfer pt or mt-pt.
+
+  return (fParticlePtFraction[ip] > 0 && fGhostPtFraction[ig] > 0) ||
+         (fParticleMtFraction[ip] > 0 && fGhostMtFraction[ig] > 0);
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractor::FillGrid(Int_t firstParticle, Int_t nParticles, Int_t firstGhost, Int_t nGhosts)
+{
+  // Index the ghosts of a jet in a rapidity-phi grid (phi relative to the first particle).
+
+  fPhiRef = fParticlePhi[firstParticle];
+
+  Double_t rapMin = fParticleRap[firstParticle], rapMax = rapMin;
+  Double_t phiMin = 0, phiMax = 0;
+  Double_t area = 0;
+  for (Int_t ig = firstGhost; ig < firstGhost + nGhosts; ig++) {
+    Double_t phi = GetLocalPhi(fGhostPhi[ig]);
+    rapMin = TMath::Min(rapMin, fGhostRap[ig]);
+    rapMax = TMath::Max(rapMax, fGhostRap[ig]);
+    phiMin = TMath::Min(phiMin, phi);
+    phiMax = TMath::Max(phiMax, phi);
+    area += fGhostArea[ig];
+  }
+  for (Int_t ip = firstParticle; ip < firstParticle + nParticles; ip++) {
+    Double_t phi = GetLocalPhi(fParticlePhi[ip]);
+    rapMin = TMath::Min(rapMin, fParticleRap[ip]);
+    rapMax = TMath::Max(rapMax, fParticleRap[ip]);
+    phiMin = TMath::Min(phiMin, phi);
+    phiMax = TMath::Max(phiMax, phi);
+  }
+
+  // about four ghosts per cell
+  fCellSize = 2 * TMath::Sqrt(area / nGhosts);
+  fRapMin = rapMin;
+  fPhiMin = phiMin;
+
+  const Int_t maxCells = 200;
+  if (!(fCellSize > 0) || phiMax - phiMin > TMath::PiOver2()) {
+    // local phi not reliable (or no area): one cell, i.e. all the pairs at once
+    fNRap = 1;
+    fNPhi = 1;
+    fCellSize = 1;
+  }
+  else {
+    fCellSize = TMath::Max(fCellSize, TMath::Max(rapMax - rapMin, phiMax - phiMin) / maxCells);
+    fNRap = Int_t((rapMax - rapMin) / fCellSize) + 1;
+    fNPhi = Int_t((phiMax - phiMin) / fCellSize) + 1;
+  }
+
+  const Int_t nCells = fNRap * fNPhi;
+  fCellStart.assign(nCells + 1, 0);
+  fCellGhosts.resize(nGhosts);
+
+  // ghosts sorted by cell (counting sort), fCellGhosts temporarily holds the cell of each ghost
+  for (Int_t ig = 0; ig < nGhosts; ig++) {
+    Int_t cr = 0, cp = 0;
+    if (nCells > 1) {
+      cr = TMath::Min(Int_t((fGhostRap[firstGhost + ig] - fRapMin) / fCellSize), fNRap - 1);
+      cp = TMath::Min(Int_t((GetLocalPhi(fGhostPhi[firstGhost + ig]) - fPhiMin) / fCellSize), fNPhi - 1);
+    }
+    fCellGhosts[ig] = cr * fNPhi + cp;
+    fCellStart[fCellGhosts[ig] + 1]++;
+  }
+  for (Int_t icell = 0; icell < nCells; icell++) fCellStart[icell + 1] += fCellStart[icell];
+
+  std::vector<Int_t> cellOf(fCellGhosts.begin(), fCellGhosts.begin() + nGhosts);
+  std::vector<Int_t> pos(fCellStart.begin(), fCellStart.end() - 1);
+  for (Int_t ig = 0; ig < nGhosts; ig++) fCellGhosts[pos[cellOf[ig]]++] = ig;
+
+  fParticleCellRap.resize(nParticles);
+  fParticleCellPhi.resize(nParticles);
+  fParticleNextRing.assign(nParticles, 0);
+  for (Int_t ip = 0; ip < nParticles; ip++) {
+    Int_t cr = 0, cp = 0;
+    if (nCells > 1) {
+      cr = TMath::Min(Int_t((fParticleRap[firstParticle + ip] - fRapMin) / fCellSize), fNRap - 1);
+      cp = TMath::Min(Int_t((GetLocalPhi(fParticlePhi[firstParticle + ip]) - fPhiMin) / fCellSize), fNPhi - 1);
+    }
+    fParticleCellRap[ip] = cr;
+    fParticleCellPhi[ip] = cp;
+  }
+}
+
+//________________________________________________________________________
+Int_t AliEmcalConstituentSubtractor::GetMaxRing(Int_t ip) const
+{
+  // Last ring of cells around a particle (local index) containing grid cells.
+
+  Int_t cr = fParticleCellRap[ip];
+  Int_t cp = fParticleCellPhi[ip];
+  return TMath::Max(TMath::Max(cr, fNRap - 1 - cr), TMath::Max(cp, fNPhi - 1 - cp));
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractor::AddRingPairs(Int_t ip, Int_t ring, Int_t band, Int_t firstParticle, Int_t firstGhost, Int_t nGhosts)
+{
+  // Add the pairs of a particle (local index) with the ghosts of the cells at the given ring distance
+  // to their distance band (not before the current band).
+
+  const Int_t cr = fParticleCellRap[ip];
+  const Int_t cp = fParticleCellPhi[ip];
+  const Int_t gp = firstParticle + ip;
+
+  for (Int_t r = TMath::Max(cr - ring, 0); r <= TMath::Min(cr + ring, fNRap - 1); r++) {
+    Bool_t edgeRow = (r == cr - ring || r == cr + ring);
+    Int_t step = edgeRow ? 1 : 2 * ring;
+    for (Int_t c = cp - ring; c <= cp + ring; c += (step > 0 ? step : 1)) {
+      if (c < 0 || c >= fNPhi) continue;
+      Int_t icell = r * fNPhi + c;
+      for (Int_t i = fCellStart[icell]; i < fCellStart[icell + 1]; i++) {
+        Int_t ig = fCellGhosts[i];
+        Int_t gg = firstGhost + ig;
+        if (!IsPairNeeded(gp, gg)) continue;
+        Double_t d2 = SquaredDistance(fGhostRap[gg], fGhostPhi[gg], fParticleRap[gp], fParticlePhi[gp]);
+        Int_t b = TMath::Max(GetBand(d2), band);
+        if (b >= Int_t(fBands.size())) fBands.resize(b + 1);
+        fBands[b].push_back(std::make_pair(d2, Long64_t(ip) * nGhosts + ig));
+      }
+    }
+  }
+}
+
+//________________________________________________________________________
+Int_t AliEmcalConstituentSubtractor::GetBand(Double_t d2) const
+{
+  // Distance band of a squared distance: band*size <= distance < (band+1)*size.
+
+  Int_t band = Int_t(TMath::Sqrt(d2) / fCellSize);
+  while (band > 0 && d2 < band * fCellSize * band * fCellSize) band--;
+  while (d2 >= (band + 1) * fCellSize * (band + 1) * fCellSize) band++;
+  return band;
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractor::SweepPair(Int_t ip, Int_t ig, Double_t rho, Double_t rhom)
+{
+  // Transfer the pt and mt-pt of a particle to a ghost (global indices).
+
+  if (fGhostPtFraction[ig] > 0 && fParticlePtFraction[ip] > 0) {
+    Double_t ratio = fParticlePt[ip] * fParticlePtFraction[ip] / rho / fGhostArea[ig] / fGhostPtFraction[ig];
+    if (ratio > 1) {
+      fParticlePtFraction[ip] *= 1 - 1. / ratio;
+      fGhostPtFraction[ig] = -1;
+    }
+    else {
+      fGhostPtFraction[ig] *= 1 - ratio;
+      fParticlePtFraction[ip] = -1;
+    }
+    if (!(fParticlePtFraction[ip] > 0)) fNPtParticles--;
+    if (!(fGhostPtFraction[ig] > 0)) fNPtGhosts--;
+  }
+
+  if (fGhostMtFraction[ig] > 0 && fParticleMtFraction[ip] > 0) {
+    Double_t ratio = fParticleMtMinusPt[ip] * fParticleMtFraction[ip] / rhom / fGhostArea[ig] / fGhostMtFraction[ig];
+    if (ratio > 1) {
+      fParticleMtFraction[ip] *= 1 - 1. / ratio;
+      fGhostMtFraction[ig] = -1;
+    }
+    else {
+      fGhostMtFraction[ig] *= 1 - ratio;
+      fParticleMtFraction[ip] = -1;
+    }
+    if (!(fParticleMtFraction[ip] > 0)) fNMtParticles--;
+    if (!(fGhostMtFraction[ig] > 0)) fNMtGhosts--;
+  }
+}
+
+//________________________________________________________________________
+void AliEmcalConstituentSubtractor::SubtractJet(Int_t ij, Double_t rho, Double_t rhom)
+{
+  // Subtract the background of one jet.
+  // The pairs are swept in distance bands of the cell size: a pair in a ring of cells k
+  // around the particle is at least (k-1) cell sizes apart, so once the rings up to b+2
+  // are paired all the pairs closer than (b+1) cell sizes are known and can be swept.
+
+  const Int_t firstParticle = fJetParticleStart[ij];
+  const Int_t nParticles = fJetParticleStart[ij + 1] - firstParticle;
+  const Int_t firstGhost = fJetGhostStart[ij];
+  const Int_t nGhosts = fJetGhostStart[ij + 1] - firstGhost;
+  if (nParticles == 0 || nGhosts == 0) return;
+
+  FillGrid(firstParticle, nParticles, firstGhost, nGhosts);
+
+  fNPtParticles = nParticles;
+  fNMtParticles = nParticles;
+  fNPtGhosts = nGhosts;
+  fNMtGhosts = nGhosts;
+  for (UInt_t b = 0; b < fBands.size(); b++) fBands[b].clear();
+
+  for (Int_t band = 0; ; band++) {
+    if ((fNPtParticles == 0 || fNPtGhosts == 0) && (fNMtParticles == 0 || fNMtGhosts == 0)) break;
+
+    Bool_t allPaired = kTRUE;
+    for (Int_t ip = 0; ip < nParticles; ip++) {
+      Int_t gp = firstParticle + ip;
+      if (!(fParticlePtFraction[gp] > 0) && !(fParticleMtFraction[gp] > 0)) continue;
+      Int_t maxRing = GetMaxRing(ip);
+      while (fParticleNextRing[ip] <= band + 2 && fParticleNextRing[ip] <= maxRing) {
+        AddRingPairs(ip, fParticleNextRing[ip], band, firstParticle, firstGhost, nGhosts);
+        fParticleNextRing[ip]++;
+      }
+      if (fParticleNextRing[ip] <= maxRing) allPaired = kFALSE;
+    }
+
+    if (band >= Int_t(fBands.size())) {
+      if (allPaired) break;
+      continue;
+    }
+
+    std::vector<std::pair<Double_t,Long64_t> > &pairs = fBands[band];
+    std::sort(pairs.begin(), pairs.end());
+    for (UInt_t i = 0; i < pairs.size(); i++) {
+      Int_t ip = Int_t(pairs[i].second / nGhosts);
+      Int_t ig = Int_t(pairs[i].second % nGhosts);
+      SweepPair(firstParticle + ip, firstGhost + ig, rho, rhom);
+    }
+    pairs.clear();
+  }
+}
@@ -0,0 +1,87 @@
+#ifndef ALIEMCALCONSTITUENTSUBTRACTOR_H
+#define ALIEMCALCONSTITUENTSUBTRACTOR_H
+
+// Event-wide constituent subtraction on flat particle and ghost arrays.
+//
+// Same algorithm as fastjet::contrib::ConstituentSubtractor with external rho and rho_m
+// (alpha = 0, no maximum distance): the particle-ghost pairs of a jet are processed in
+// increasing distance order and the pt (and mt-pt) of each particle is transferred to
+// the background ghosts until either is exhausted. Instead of computing and sorting the
+// distances of all the pairs of a jet, the ghosts are indexed in a rapidity-phi grid and
+// the pairs are generated ring by ring around each particle, in distance bands of the cell
+// size; only the pairs of the current band are sorted, and the particles and ghosts already
+// exhausted are no longer paired. The sweep order, and therefore the result, is the one
+// of the full sorted list of pairs.
+
+#include <utility>
+#include <vector>
+#include <TObject.h>
+
+class AliEmcalConstituentSubtractor : public TObject {
+ public:
+  AliEmcalConstituentSubtractor();
+  virtual ~AliEmcalConstituentSubtractor() {;}
+
+  void                        Clear(Option_t *opt = "");
+  Int_t                       AddJet();
+  void                        AddParticle(Double_t rap, Double_t phi, Double_t pt, Double_t mtMinusPt);
+  void                        AddGhost(Double_t rap, Double_t phi, Double_t area);
+  void                        Subtract(Double_t rho, Double_t rhom);
+
+  Int_t                       GetNJets() const                         { return fJetParticleStart.size() - 1; }
+  Int_t                       GetFirstParticle(Int_t ij) const         { return fJetParticleStart[ij]; }
+  Int_t                       GetNParticles(Int_t ij) const            { return fJetParticleStart[ij + 1] - fJetParticleStart[ij]; }
+  Bool_t                      IsParticleKept(Int_t ip) const           { return fParticlePtFraction[ip] > 0; }
+  Double_t                    GetSubtractedPt(Int_t ip) const;
+  Double_t                    GetSubtractedMtMinusPt(Int_t ip) const;
+
+ protected:
+  void                        SubtractJet(Int_t ij, Double_t rho, Double_t rhom);
+  void                        FillGrid(Int_t firstParticle, Int_t nParticles, Int_t firstGhost, Int_t nGhosts);
+  void                        AddRingPairs(Int_t ip, Int_t ring, Int_t band, Int_t firstParticle, Int_t firstGhost, Int_t nGhosts);
+  Int_t                       GetBand(Double_t d2) const;
+  Int_t                       GetMaxRing(Int_t ip) const;
+  void                        SweepPair(Int_t ip, Int_t ig, Double_t rho, Double_t rhom);
+  Bool_t                      IsPairNeeded(Int_t ip, Int_t ig) const;
+  Double_t                    GetLocalPhi(Double_t phi) const;
+  static Double_t             SquaredDistance(Double_t rap1, Double_t phi1, Double_t rap2, Double_t phi2);
+
+  std::vector<Int_t>          fJetParticleStart;       //!first particle of each jet, nJets+1 entries
+  std::vector<Int_t>          fJetGhostStart;          //!first ghost of each jet, nJets+1 entries
+  std::vector<Double_t>       fParticleRap;            //!particle rapidity
+  std::vector<Double_t>       fParticlePhi;            //!particle phi
+  std::vector<Double_t>       fParticlePt;             //!particle pt
+  std::vector<Double_t>       fParticleMtMinusPt;      //!particle mt-pt
+  std::vector<Double_t>       fParticlePtFraction;     //!remaining fraction of the particle pt (<= 0: exhausted)
+  std::vector<Double_t>       fParticleMtFraction;     //!remaining fraction of the particle mt-pt (<= 0: exhausted)
+  std::vector<Double_t>       fGhostRap;               //!ghost rapidity
+  std::vector<Double_t>       fGhostPhi;               //!ghost phi
+  std::vector<Double_t>       fGhostArea;              //!ghost area
+  std::vector<Double_t>       fGhostPtFraction;        //!remaining fraction of the ghost pt (<= 0: exhausted)
+  std::vector<Double_t>       fGhostMtFraction;        //!remaining fraction of the ghost mt-pt (<= 0: exhausted)
+
+  // grid of the current jet
+  Int_t                       fNRap;                   //!number of rapidity cells
+  Int_t                       fNPhi;                   //!number of phi cells
+  Double_t                    fCellSize;               //!cell size
+  Double_t                    fRapMin;                 //!lower rapidity edge
+  Double_t                    fPhiMin;                 //!lower phi edge (local phi)
+  Double_t                    fPhiRef;                 //!reference phi of the local phi
+  std::vector<Int_t>          fCellStart;              //!first ghost of each cell in fCellGhosts, nRap*nPhi+1 entries
+  std::vector<Int_t>          fCellGhosts;             //!ghost indices sorted by cell
+  std::vector<Int_t>          fParticleCellRap;        //!rapidity cell of the particles of the current jet
+  std::vector<Int_t>          fParticleCellPhi;        //!phi cell of the particles of the current jet
+  std::vector<Int_t>          fParticleNextRing;       //!next ring of cells to pair for the particles of the current jet
+  std::vector<std::vector<std::pair<Double_t,Long64_t> > > fBands; //!pending pairs of the current jet by distance band: squared distance, particle*nGhosts+ghost
+  Int_t                       fNPtParticles;           //!particles of the current jet with pt left
+  Int_t                       fNPtGhosts;              //!ghosts of the current jet with pt left
+  Int_t                       fNMtParticles;           //!particles of the current jet with mt-pt left
+  Int_t                       fNMtGhosts;              //!ghosts of the current jet with mt-pt left
+
+ private:
+  AliEmcalConstituentSubtractor(const AliEmcalConstituentSubtractor&);            // not implemented
+  AliEmcalConstituentSubtractor &operator=(const AliEmcalConstituentSubtractor&); // not implemented
+
+  ClassDef(AliEmcalConstituentSubtractor, 1) // Event-wide constituent subtraction
+};
+#endif
@@ -0,0 +1,337 @@
+/**************************************************************************
+ * Copyright(c) 1998-2009, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+//
+// Candidate selection and closest-jet bookkeeping for jet matching.
+//
+
+#include "AliEmcalJetMatcher.h"
+
+#include <algorithm>
+
+#include <TMath.h>
+
+#include "AliEmcalJet.h"
+#include "AliJetContainer.h"
+#include "AliLog.h"
+
+ClassImp(AliEmcalJetMatcher)
+
+//________________________________________________________________________
+AliEmcalJetMatcher::AliEmcalJetMatcher() :
+  TObject(),
+  fNJets(0),
+  fNEta(1),
+  fNPhi(1),
+  fEtaMin(0),
+  fEtaWidth(1),
+  fPhiWidth(TMath::TwoPi()),
+  fCellStart(2),
+  fCellJets(),
+  fTrackStart(),
+  fTrackJets(),
+  fClusterStart(),
+  fClusterJets(),
+  fJetSelected()
+{
+  // Default constructor.
+}
+
+//________________________________________________________________________
+void AliEmcalJetMatcher::FillGrid(AliJetContainer *jets, Double_t maxDist)
+{
+  // Sort the jets in eta-phi cells at least as large as maxDist,
+  // so that all the jets closer than maxDist to a given direction are in the neighbouring cells.
+
+  const Int_t maxCells = 1000;
+
+  fNJets = jets->GetNJets();
+
+  Double_t etaMin = 0, etaMax = 0;
+  Bool_t first = kTRUE;
+  for (Int_t i = 0; i < fNJets; i++) {
+    AliEmcalJet *jet = jets->GetJet(i);
+    if (!jet) continue;
+    if (first || jet->Eta() < etaMin) etaMin = jet->Eta();
+    if (first || jet->Eta() > etaMax) etaMax = jet->Eta();
+    first = kFALSE;
+  }
+
+  // small margin against rounding at the cell edges
+  Double_t width = maxDist * 1.001;
+
+  fEtaMin = etaMin;
+  fNEta = 1;
+  fEtaWidth = etaMax - etaMin + 1;
+  if (width > 0 && (etaMax - etaMin) / width < maxCells) {
+    fEtaWidth = width;
+    fNEta = Int_t((etaMax - etaMin) / width) + 1;
+  }
+
+  // with less than 3 phi cells all jets are neighbours in phi
+  fNPhi = 1;
+  if (width > 0) fNPhi = Int_t(TMath::TwoPi() / width);
+  if (fNPhi < 3) fNPhi = 1;
+  if (fNPhi > maxCells) fNPhi = maxCells;
+  fPhiWidth = TMath::TwoPi() / fNPhi;
+
+  const Int_t nCells = fNEta * fNPhi;
+  fCellStart.Set(nCells + 1);
+  fCellStart.Reset(0);
+  if (fCellJets.GetSize() < fNJets) fCellJets.Set(fNJets);
+  if (fJetSelected.GetSize() < fNJets) fJetSelected.Set(fNJets);
+
+  // counting sort, keeps the jet order inside each cell
+  TArrayI jetCell(fNJets);
+  for (Int_t i = 0; i < fNJets; i++) {
+    AliEmcalJet *jet = jets->GetJet(i);
+    if (!jet) {
+      jetCell[i] = -1;
+      continue;
+    }
+    Int_t etaBin = TMath::Min(TMath::Max(GetEtaBin(jet->Eta()), 0), fNEta - 1);
+    jetCell[i] = etaBin * fNPhi + GetPhiBin(jet->Phi_0_2pi());
+    fCellStart[jetCell[i] + 1]++;
+  }
+
+  for (Int_t icell = 0; icell < nCells; icell++) fCellStart[icell + 1] += fCellStart[icell];
+
+  for (Int_t i = 0; i < fNJets; i++) {
+    if (jetCell[i] < 0) continue;
+    fCellJets[fCellStart[jetCell[i]]++] = i;
+  }
+
+  for (Int_t icell = nCells; icell > 0; icell--) fCellStart[icell] = fCellStart[icell - 1];
+  fCellStart[0] = 0;
+}
+
+//________________________________________________________________________
+void AliEmcalJetMatcher::FillConstituentMaps(AliJetContainer *jets)
+{
+  // Index the jets by the indices of their track and cluster constituents.
+
+  fNJets = jets->GetNJets();
+  if (fJetSelected.GetSize() < fNJets) fJetSelected.Set(fNJets);
+
+  FillIndexMap(jets, kFALSE, fTrackStart, fTrackJets);
+  FillIndexMap(jets, kTRUE, fClusterStart, fClusterJets);
+}
+
+//________________________________________________________________________
+void AliEmcalJetMatcher::FillIndexMap(AliJetContainer *jets, Bool_t clusters, TArrayI &start, TArrayI &map)
+{
+  // For each constituent index, the indices of the jets containing it (increasing).
+
+  Int_t maxIndex = -1;
+  Int_t nEntries = 0;
+  for (Int_t i = 0; i < fNJets; i++) {
+    AliEmcalJet *jet = jets->GetJet(i);
+    if (!jet) continue;
+    const Int_t n = clusters ? jet->GetNumberOfClusters() : jet->GetNumberOfTracks();
+    for (Int_t j = 0; j < n; j++) {
+      Int_t index = clusters ? jet->ClusterAt(j) : jet->TrackAt(j);
+      if (index > maxIndex) maxIndex = index;
+    }
+    nEntries += n;
+  }
+
+  start.Set(maxIndex + 2);
+  start.Reset(0);
+  if (map.GetSize() < nEntries) map.Set(nEntries);
+
+  for (Int_t i = 0; i < fNJets; i++) {
+    AliEmcalJet *jet = jets->GetJet(i);
+    if (!jet) continue;
+    const Int_t n = clusters ? jet->GetNumberOfClusters() : jet->GetNumberOfTracks();
+    for (Int_t j = 0; j < n; j++) {
+      Int_t index = clusters ? jet->ClusterAt(j) : jet->TrackAt(j);
+      if (index < 0) continue;
+      start[index + 1]++;
+    }
+  }
+
+  for (Int_t index = 0; index <= maxIndex; index++) start[index + 1] += start[index];
+
+  for (Int_t i = 0; i < fNJets; i++) {
+    AliEmcalJet *jet = jets->GetJet(i);
+    if (!jet) continue;
+    const Int_t n = clusters ? jet->GetNumberOfClusters() : jet->GetNumberOfTracks();
+    for (Int_t j = 0; j < n; j++) {
+      Int_t index = clusters ? jet->ClusterAt(j) : jet->TrackAt(j);
+      if (index < 0) continue;
+      map[start[index]++] = i;
+    }
+  }
+
+  for (Int_t index = maxIndex + 1; index > 0; index--) start[index] = start[index - 1];
+  start[0] = 0;
+}
+
+//________________________________________________________________________
+Int_t AliEmcalJetMatcher::GetEtaBin(Double_t eta) const
+{
+  // Eta cell, -1 and fNEta below and above the grid.
+
+  if (!(eta >= fEtaMin)) return -1; // also NaN
+  Double_t bin = (eta - fEtaMin) / fEtaWidth;
+  if (bin >= fNEta) return fNEta;
+  return Int_t(bin);
+}
+
+//________________________________________________________________________
+Int_t AliEmcalJetMatcher::GetPhiBin(Double_t phi) const
+{
+  // Phi cell, phi in [0,2pi].
+
+  if (!(phi > 0)) return 0; // also NaN
+  Int_t bin = Int_t(phi / fPhiWidth);
+  if (bin >= fNPhi) return fNPhi - 1;
+  return bin;
+}
+
+//________________________________________________________________________
+Int_t AliEmcalJetMatcher::GetGeometricalCandidates(const AliEmcalJet *jet, TArrayI &candidates)
+{
+  // Indices of the jets of the neighbouring cells, a superset of the jets closer than the grid distance.
+
+  if (candidates.GetSize() < fNJets) candidates.Set(fNJets);
+
+  Int_t etaBin = GetEtaBin(jet->Eta());
+  Int_t etaFirst = TMath::Max(etaBin - 1, 0);
+  Int_t etaLast = TMath::Min(etaBin + 1, fNEta - 1);
+
+  Int_t phiBins[3] = {0, 0, 0};
+  Int_t nPhiBins = 1;
+  if (fNPhi >= 3) {
+    Int_t phiBin = GetPhiBin(jet->Phi_0_2pi());
+    phiBins[0] = (phiBin + fNPhi - 1) % fNPhi;
+    phiBins[1] = phiBin;
+    phiBins[2] = (phiBin + 1) % fNPhi;
+    nPhiBins = 3;
+  }
+
+  Int_t n = 0;
+  for (Int_t ieta = etaFirst; ieta <= etaLast; ieta++) {
+    for (Int_t iphi = 0; iphi < nPhiBins; iphi++) {
+      Int_t icell = ieta * fNPhi + phiBins[iphi];
+      n = AddCandidates(fCellStart, fCellJets, icell, icell, candidates, n);
+    }
+  }
+
+  return SortCandidates(candidates, n);
+}
+
+//________________________________________________________________________
+Int_t AliEmcalJetMatcher::GetConstituentCandidates(const TArrayI &tracks, Int_t nTracks, const TArrayI &clusters, Int_t nClusters, TArrayI &candidates)
+{
+  // Indices of the jets containing at least one of the given track or cluster indices.
+
+  if (candidates.GetSize() < fNJets) candidates.Set(fNJets);
+
+  const Int_t maxTrack = fTrackStart.GetSize() - 2;
+  const Int_t maxCluster = fClusterStart.GetSize() - 2;
+
+  Int_t n = 0;
+  for (Int_t i = 0; i < nTracks; i++) {
+    if (tracks[i] < 0 || tracks[i] > maxTrack) continue;
+    n = AddCandidates(fTrackStart, fTrackJets, tracks[i], tracks[i], candidates, n);
+  }
+  for (Int_t i = 0; i < nClusters; i++) {
+    if (clusters[i] < 0 || clusters[i] > maxCluster) continue;
+    n = AddCandidates(fClusterStart, fClusterJets, clusters[i], clusters[i], candidates, n);
+  }
+
+  return SortCandidates(candidates, n);
+}
+
+//________________________________________________________________________
+Int_t AliEmcalJetMatcher::AddCandidates(const TArrayI &start, const TArrayI &map, Int_t first, Int_t last, TArrayI &candidates, Int_t n)
+{
+  // Append the jets of the entries first..last of the map which are not yet selected.
+
+  for (Int_t i = start[first]; i < start[last + 1]; i++) {
+    Int_t ijet = map[i];
+    if (fJetSelected[ijet]) continue;
+    fJetSelected[ijet] = 1;
+    candidates[n++] = ijet;
+  }
+  return n;
+}
+
+//________________________________________________________________________
+Int_t AliEmcalJetMatcher::SortCandidates(TArrayI &candidates, Int_t n)
+{
+  // Same order as a loop over the jet array, and clear the selection flags.
+
+  std::sort(candidates.GetArray(), candidates.GetArray() + n);
+  for (Int_t i = 0; i < n; i++) fJetSelected[candidates[i]] = 0;
+  return n;
+}
+
+//________________________________________________________________________
+void AliEmcalJetMatcher::SetClosestJets(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t d1, Double_t d2)
+{
+  // Update the closest and second closest jets of jet1 and jet2 (negative distance = not comparable).
+
+  if (d1 >= 0) {
+
+    if (d1 < jet1->ClosestJetDistance()) {
+      jet1->SetSecondClosestJet(jet1->ClosestJet(), jet1->ClosestJetDistance());
+      jet1->SetClosestJet(jet2, d1);
+    }
+    else if (d1 < jet1->SecondClosestJetDistance()) {
+      jet1->SetSecondClosestJet(jet2, d1);
+    }
+  }
+
+  if (d2 >= 0) {
+
+    if (d2 < jet2->ClosestJetDistance()) {
+      jet2->SetSecondClosestJet(jet2->ClosestJet(), jet2->ClosestJetDistance());
+      jet2->SetClosestJet(jet1, d2);
+    }
+    else if (d2 < jet2->SecondClosestJetDistance()) {
+      jet2->SetSecondClosestJet(jet1, d2);
+    }
+  }
+}
+
+//________________________________________________________________________
+Int_t AliEmcalJetMatcher::MatchClosestJets(AliJetContainer *jets1, Double_t maxDist1, Double_t maxDist2, UShort_t matchingType)
+{
+  // Match the pairs of jets which are mutually the closest ones, within the maximum distances.
+
+  Int_t nMatched = 0;
+  AliEmcalJet* jet1 = 0;
+
+  jets1->ResetCurrentID();
+  while ((jet1 = jets1->GetNextJet())) {
+
+    AliEmcalJet *jet2 = jet1->ClosestJet();
+
+    if (!jet2) continue;
+    if (jet2->ClosestJet() != jet1) continue;
+    if (jet1->ClosestJetDistance() > maxDist1 || jet2->ClosestJetDistance() > maxDist2) continue;
+
+    // Matched jet found
+    jet1->SetMatchedToClosest(matchingType);
+    jet2->SetMatchedToClosest(matchingType);
+    nMatched++;
+    AliDebugClass(2,Form("Found matching: jet1 pt = %f, eta = %f, phi = %f, jet2 pt = %f, eta = %f, phi = %f",
+        jet1->Pt(), jet1->Eta(), jet1->Phi(),
+        jet2->Pt(), jet2->Eta(), jet2->Phi()));
+  }
+
+  return nMatched;
+}
@@ -0,0 +1,60 @@
+#ifndef ALIEMCALJETMATCHER_H
+#define ALIEMCALJETMATCHER_H
+
+// Candidate selection and closest-jet bookkeeping for jet matching.
+//
+// The jets of the second collection are indexed once per event, in eta-phi cells
+// of the size of the maximum matching distance and by the indices of their track
+// and cluster constituents. For a jet of the first collection only the jets of
+// the neighbouring cells (geometrical matching) or the jets sharing at least one
+// constituent (constituent based matching) are then returned, in increasing index
+// order, i.e. in the order of a loop over the full collection.
+
+#include <TObject.h>
+#include <TArrayI.h>
+
+class AliEmcalJet;
+class AliJetContainer;
+
+class AliEmcalJetMatcher : public TObject {
+ public:
+  AliEmcalJetMatcher();
+  virtual ~AliEmcalJetMatcher() {;}
+
+  void                        FillGrid(AliJetContainer *jets, Double_t maxDist);
+  void                        FillConstituentMaps(AliJetContainer *jets);
+
+  Int_t                       GetGeometricalCandidates(const AliEmcalJet *jet, TArrayI &candidates);
+  Int_t                       GetConstituentCandidates(const TArrayI &tracks, Int_t nTracks, const TArrayI &clusters, Int_t nClusters, TArrayI &candidates);
+
+  static void                 SetClosestJets(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t d1, Double_t d2);
+  static Int_t                MatchClosestJets(AliJetContainer *jets1, Double_t maxDist1, Double_t maxDist2, UShort_t matchingType);
+
+ protected:
+  Int_t                       GetEtaBin(Double_t eta) const;
+  Int_t                       GetPhiBin(Double_t phi) const;
+  void                        FillIndexMap(AliJetContainer *jets, Bool_t clusters, TArrayI &start, TArrayI &map);
+  Int_t                       AddCandidates(const TArrayI &start, const TArrayI &map, Int_t first, Int_t last, TArrayI &candidates, Int_t n);
+  Int_t                       SortCandidates(TArrayI &candidates, Int_t n);
+
+  Int_t                       fNJets;                    //!number of entries of the indexed jet array
+  Int_t                       fNEta;                     //!number of eta cells
+  Int_t                       fNPhi;                     //!number of phi cells
+  Double_t                    fEtaMin;                   //!lower eta edge of the grid
+  Double_t                    fEtaWidth;                 //!eta width of a cell
+  Double_t                    fPhiWidth;                 //!phi width of a cell
+  TArrayI                     fCellStart;                //!first entry of each cell in fCellJets, fNEta*fNPhi+1 entries
+  TArrayI                     fCellJets;                 //!jet indices sorted by cell
+  TArrayI                     fTrackStart;               //!first entry of each track index in fTrackJets
+  TArrayI                     fTrackJets;                //!indices of the jets containing each track
+  TArrayI                     fClusterStart;             //!first entry of each cluster index in fClusterJets
+  TArrayI                     fClusterJets;              //!indices of the jets containing each cluster
+  TArrayI                     fJetSelected;              //!jets already in the candidate list
+
+ private:
+  AliEmcalJetMatcher(const AliEmcalJetMatcher&);            // not implemented
+  AliEmcalJetMatcher &operator=(const AliEmcalJetMatcher&); // not implemented
+
+  ClassDef(AliEmcalJetMatcher, 1) // Jet matching candidate finder
+};
+#endif
@@ -387,6 +387,18 @@ void AliEmcalJetTask::ExecOnce()
   AliAnalysisTaskEmcal::ExecOnce();
 }
 
+/**
+ * Get the names of the objects written to the event: the jet collection
+ * added in ExecOnce in addition to the objects of the base class.
+ * @param[out] names Names of the objects written to the event
+ */
+void AliEmcalJetTask::GetOutputCollections(std::vector<TString> &names) const
+{
+  AliAnalysisTaskEmcal::GetOutputCollections(names);
+
+  if (fJets) names.push_back(fJetsName);
+}
+
 /**
  * This method is called for each jet. It loops over the jet constituents and
  * adds them to the jet object.
@@ -90,6 +90,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Double_t               GetJetPhiMin()                   { return fJetPhiMin         ; }
   Double_t               GetJetPhiMax()                   { return fJetPhiMax         ; }
   UInt_t                 GetJetType()                     { return fJetType           ; }
+  void                   GetOutputCollections(std::vector<TString> &names) const;
   UInt_t                 GetJetAlgo()                     { return fJetAlgo           ; }
   Bool_t                 GetLegacyMode()                  { return fLegacyMode        ; }
   Double_t               GetMinJetArea()                  { return fMinJetArea        ; }
@@ -11,6 +11,7 @@ AliEmcalJetUtilityConstSubtractor::AliEmcalJetUtilityConstSubtractor() :
   fJetsSubName(""),
   fParticlesSubName(""),
   fUseExternalBkg(kFALSE),
+  fUseFastSubtraction(kFALSE),
   fRhoName(""),
   fRhomName(""),
   fRho(1e-6),
@@ -30,6 +31,7 @@ AliEmcalJetUtilityConstSubtractor::AliEmcalJetUtilityConstSubtractor(const char*
   fJetsSubName(""),
   fParticlesSubName(""),
   fUseExternalBkg(kFALSE),
+  fUseFastSubtraction(kFALSE),
   fRhoName(""),
   fRhomName(""),
   fRho(1e-6),
@@ -48,6 +50,7 @@ AliEmcalJetUtilityConstSubtractor::AliEmcalJetUtilityConstSubtractor(const AliEm
   fJetsSubName(other.fJetsSubName),
   fParticlesSubName(other.fParticlesSubName),
   fUseExternalBkg(other.fUseExternalBkg),
+  fUseFastSubtraction(other.fUseFastSubtraction),
   fRhoName(other.fRhoName),
   fRhomName(other.fRhomName),
   fRho(other.fRho),
@@ -70,6 +73,7 @@ AliEmcalJetUtilityConstSubtractor& AliEmcalJetUtilityConstSubtractor::operator=(
   fJetsSubName = other.fJetsSubName;
   fParticlesSubName = other.fParticlesSubName;
   fUseExternalBkg = other.fUseExternalBkg;
+  fUseFastSubtraction = other.fUseFastSubtraction;
   fRhoName = other.fRhoName;
   fRhomName = other.fRhomName;
   fRho = other.fRho;
@@ -150,6 +154,7 @@ void AliEmcalJetUtilityConstSubtractor::Prepare(AliFJWrapper& fjw)
   if (fJetsSub) fJetsSub->Delete();
 
   fjw.SetUseExternalBkg(fUseExternalBkg, fRho, fRhom);
+  fjw.SetUseFastConstituentSubtraction(fUseFastSubtraction);
   fjw.DoConstituentSubtraction();
 }
 
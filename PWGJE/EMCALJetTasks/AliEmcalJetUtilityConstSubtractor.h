@@ -25,6 +25,7 @@ class AliEmcalJetUtilityConstSubtractor : public AliEmcalJetUtility
   void                   SetRhoName(const char *n)           { fRhoName      = n         ; }
   void                   SetRhomName(const char *n)          { fRhomName     = n         ; }
   void                   SetUseExternalBkg(Bool_t b)         { fUseExternalBkg   = b     ; }
+  void                   SetUseFastSubtraction(Bool_t b)     { fUseFastSubtraction = b   ; }
 
   void                   SetJetsSubName(const char *n)       { fJetsSubName      = n     ; }
   void                   SetParticlesSubName(const char *n)  { fParticlesSubName = n     ; }
@@ -39,6 +40,7 @@ class AliEmcalJetUtilityConstSubtractor : public AliEmcalJetUtility
   TString                fJetsSubName;                        // name of subtracted jet collection
   TString                fParticlesSubName;                   // name of subtracted particle collection
   Bool_t                 fUseExternalBkg;                     // use external background for generic subtractor
+  Bool_t                 fUseFastSubtraction;                 // use AliEmcalConstituentSubtractor (only with external background)
   TString                fRhoName;                            // name of rho
   TString                fRhomName;                           // name of rhom
   Double_t               fRho;                                // pT background density
@@ -49,6 +51,6 @@ class AliEmcalJetUtilityConstSubtractor : public AliEmcalJetUtility
   AliRhoParameter       *fRhoParam;                           //!event rho
   AliRhoParameter       *fRhomParam;                          //!event rhom
 
-  ClassDef(AliEmcalJetUtilityConstSubtractor, 1) // Emcal jet utility that implements the constituent subtractor form the fastjet contrib
+  ClassDef(AliEmcalJetUtilityConstSubtractor, 2) // Emcal jet utility that implements the constituent subtractor form the fastjet contrib
 };
 #endif
@@ -8,6 +8,7 @@
 #include "AliLog.h"
 #include "FJ_includes.h"
 #include "AliJetShape.h"
+#include "AliEmcalConstituentSubtractor.h"
 
 
 class AliFJWrapper
@@ -87,6 +88,7 @@ class AliFJWrapper
   virtual Int_t DoGenericSubtractionJet3subjettiness_kt();
   virtual Int_t DoGenericSubtractionJetOpeningAngle_kt();
   virtual Int_t DoConstituentSubtraction();
+  virtual Int_t DoFastConstituentSubtraction();
   virtual Int_t DoSoftDrop();
   
   void SetName(const char* name)        { fName           = name;    }
@@ -114,6 +116,7 @@ class AliFJWrapper
   void SetRMaxAndStep(Double_t rmax, Double_t dr) {fRMax = rmax; fDRStep = dr; }
   void SetRhoRhom (Double_t rho, Double_t rhom) { fUseExternalBkg = kTRUE; fRho = rho; fRhom = rhom;} // if using rho,rhom then fUseExternalBkg is true
   void SetMinJetPt(Double_t MinPt) {fMinJetPt=MinPt;}
+  void SetUseFastConstituentSubtraction(Bool_t b) { fUseFastConstituentSubtraction = b; } // only with external rho,rhom
 
  protected:
   TString                                fName;               //!
@@ -183,6 +186,8 @@ class AliFJWrapper
   Bool_t                                   fUseExternalBkg;       //!
   Double_t                                 fRho;                  //  pT background density
   Double_t                                 fRhom;                 //  mT background density
+  Bool_t                                   fUseFastConstituentSubtraction; //!
+  AliEmcalConstituentSubtractor            fFastConstituentSubtractor;     //!
   Double_t                                 fRMax;             //!
   Double_t                                 fDRStep;           //!
   std::vector<double>                      fGRNumerator;      //!
@@ -269,6 +274,8 @@ AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   , fUseExternalBkg    (false)
   , fRho               (0)
   , fRhom              (0)
+  , fUseFastConstituentSubtraction(kFALSE)
+  , fFastConstituentSubtractor()
   , fRMax(2.)
   , fDRStep(0.04)
   , fGRNumerator()
@@ -333,6 +340,7 @@ void AliFJWrapper::CopySettingsFrom(const AliFJWrapper& wrapper)
   fUseExternalBkg   = wrapper.fUseExternalBkg;
   fRho              = wrapper.fRho;
   fRhom             = wrapper.fRhom;
+  fUseFastConstituentSubtraction = wrapper.fUseFastConstituentSubtraction;
 }
 
 //_________________________________________________________________________________________________
@@ -1024,6 +1032,8 @@ Int_t AliFJWrapper::DoGenericSubtractionJetOpeningAngle_kt() {
 Int_t AliFJWrapper::DoConstituentSubtraction() {
   //Do constituent subtraction
 #ifdef FASTJET_VERSION
+  if (fUseFastConstituentSubtraction && fUseExternalBkg) return DoFastConstituentSubtraction();
+
   CreateConstituentSub();
   // fConstituentSubtractor->set_alpha(/* double alpha */);
   // fConstituentSubtractor->set_max_deltaR(/* double max_deltaR */);
@@ -1042,6 +1052,57 @@ Int_t AliFJWrapper::DoConstituentSubtraction() {
   return 0;
 }
 
+//_________________________________________________________________________________________________
+Int_t AliFJWrapper::DoFastConstituentSubtraction() {
+  // Do constituent subtraction of all the jets at once with AliEmcalConstituentSubtractor.
+  // Same result as fastjet::contrib::ConstituentSubtractor with external rho and rhom,
+  // without sorting the distances of all the particle-ghost pairs of each jet.
+#ifdef FASTJET_VERSION
+  fFastConstituentSubtractor.Clear();
+  std::vector<std::vector<fj::PseudoJet> > particles(fInclusiveJets.size());
+  for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
+    fFastConstituentSubtractor.AddJet();
+    if (!(fInclusiveJets[i].perp()>0.)) continue;
+    std::vector<fj::PseudoJet> constituents = fInclusiveJets[i].constituents();
+    for (unsigned ic = 0; ic < constituents.size(); ic++) {
+      const fj::PseudoJet &c = constituents[ic];
+      if (c.is_pure_ghost()) {
+        fFastConstituentSubtractor.AddGhost(c.rap(), c.phi(), c.area());
+      }
+      else {
+        fFastConstituentSubtractor.AddParticle(c.rap(), c.phi(), c.pt(), c.mt() - c.pt());
+        particles[i].push_back(c);
+      }
+    }
+  }
+  fFastConstituentSubtractor.Subtract(fRho, fRhom);
+
+  //clear constituent subtracted jets
+  fConstituentSubtrJets.clear();
+  for (unsigned i = 0; i < fInclusiveJets.size(); i++) {
+    fj::PseudoJet subtracted_jet(0.,0.,0.,0.);
+    if (fInclusiveJets[i].perp()>0.) {
+      std::vector<fj::PseudoJet> subtracted_particles;
+      Int_t first = fFastConstituentSubtractor.GetFirstParticle(i);
+      for (unsigned ip = 0; ip < particles[i].size(); ip++) {
+        if (!fFastConstituentSubtractor.IsParticleKept(first + ip)) continue;
+        Double_t pt  = fFastConstituentSubtractor.GetSubtractedPt(first + ip);
+        Double_t mtm = fFastConstituentSubtractor.GetSubtractedMtMinusPt(first + ip);
+        Double_t rap = particles[i][ip].rap();
+        Double_t phi = particles[i][ip].phi();
+        fj::PseudoJet subtracted_particle(pt*TMath::Cos(phi), pt*TMath::Sin(phi), (pt+mtm)*TMath::SinH(rap), (pt+mtm)*TMath::CosH(rap));
+        subtracted_particle.set_user_index(ip);
+        subtracted_particles.push_back(subtracted_particle);
+      }
+      if (subtracted_particles.size() > 0) subtracted_jet = fj::join(subtracted_particles);
+    }
+    fConstituentSubtrJets.push_back(subtracted_jet);
+  }
+
+#endif
+  return 0;
+}
+
 //_________________________________________________________________________________________________
 Int_t AliFJWrapper::DoSoftDrop() {
   //Do grooming
@@ -22,6 +22,7 @@
 #include <TRandom.h>
 #include <TSystem.h>
 #include <TLorentzVector.h>
+#include <TStopwatch.h>
 
 // AliRoot
 #include "AliVEvent.h"
@@ -81,6 +82,8 @@ AliJetEmbeddingFromAODTask::AliJetEmbeddingFromAODTask() :
   fTotalFiles(2050),
   fAttempts(5),
   fEmbedCentrality(kFALSE),
+  fPrefetchFiles(1),
+  fTreeCacheSize(0),
   fEsdTreeMode(kFALSE),
   fCurrentFileID(0),
   fCurrentAODFileID(0),
@@ -102,7 +105,12 @@ AliJetEmbeddingFromAODTask::AliJetEmbeddingFromAODTask() :
   fHistNotEmbedded(0),
   fHistEmbeddingQA(0),
   fHistRejectedEvents(0),
-  fEmbeddingCount(0)
+  fEmbeddingCount(0),
+  fPrefetchHandles(),
+  fPrefetchFirstID(-1),
+  fIOTimer(),
+  fHistFileOpenTime(0),
+  fHistEmbeddingIOTime(0)
 {
   // Default constructor.
   SetSuffix("AODEmbedding");
@@ -154,6 +162,8 @@ AliJetEmbeddingFromAODTask::AliJetEmbeddingFromAODTask(const char *name, Bool_t
   fTotalFiles(2050),
   fAttempts(5),
   fEmbedCentrality(kFALSE),
+  fPrefetchFiles(1),
+  fTreeCacheSize(0),
   fEsdTreeMode(kFALSE),
   fCurrentFileID(0),
   fCurrentAODFileID(0),
@@ -175,7 +185,12 @@ AliJetEmbeddingFromAODTask::AliJetEmbeddingFromAODTask(const char *name, Bool_t
   fHistNotEmbedded(0),
   fHistEmbeddingQA(0),
   fHistRejectedEvents(0),
-  fEmbeddingCount(0)
+  fEmbeddingCount(0),
+  fPrefetchHandles(),
+  fPrefetchFirstID(-1),
+  fIOTimer(),
+  fHistFileOpenTime(0),
+  fHistEmbeddingIOTime(0)
 {
   // Standard constructor.
   SetSuffix("AODEmbedding");
@@ -194,6 +209,8 @@ AliJetEmbeddingFromAODTask::~AliJetEmbeddingFromAODTask()
 {
   // Destructor
 
+  ClearPrefetchedFiles();
+
   if (fCurrentAODFile) {
     fCurrentAODFile->Close();
     delete fCurrentAODFile;
@@ -236,6 +253,16 @@ void AliJetEmbeddingFromAODTask::UserCreateOutputObjects()
   fHistRejectedEvents->GetYaxis()->SetTitle("counts");
   fOutput->Add(fHistRejectedEvents);
 
+  fHistFileOpenTime = new TH1F("fHistFileOpenTime", "fHistFileOpenTime", 1000, 0, 10000);
+  fHistFileOpenTime->GetXaxis()->SetTitle("Time to open the embedding file (ms)");
+  fHistFileOpenTime->GetYaxis()->SetTitle("files");
+  fOutput->Add(fHistFileOpenTime);
+
+  fHistEmbeddingIOTime = new TH1F("fHistEmbeddingIOTime", "fHistEmbeddingIOTime", 1000, 0, 1000);
+  fHistEmbeddingIOTime->GetXaxis()->SetTitle("Time waiting on embedding I/O per event (ms)");
+  fHistEmbeddingIOTime->GetYaxis()->SetTitle("counts");
+  fOutput->Add(fHistEmbeddingIOTime);
+
   PostData(1, fOutput);
 }
 
@@ -286,6 +313,8 @@ Bool_t AliJetEmbeddingFromAODTask::OpenNextFile()
     fCurrentAODFile = 0;
   }
 
+  TStopwatch openTimer;
+
   Int_t i = 0;
 
   while ((!fCurrentAODFile || fCurrentAODFile->IsZombie()) && i < fAttempts) {
@@ -334,6 +363,13 @@ Bool_t AliJetEmbeddingFromAODTask::OpenNextFile()
   
   if (!fAODMCParticlesName.IsNull()) 
     fCurrentAODTree->SetBranchAddress(fAODMCParticlesName, &fAODMCParticles);
+
+  if (fTreeCacheSize > 0) {
+    // all the branches are read in GetEntry, no need for the learning phase
+    fCurrentAODTree->SetCacheSize(fTreeCacheSize);
+    fCurrentAODTree->AddBranchToCache("*", kTRUE);
+    fCurrentAODTree->StopCacheLearningPhase();
+  }
   
   if (fRandomAccess) {
     fFirstAODEntry = TMath::Nint(gRandom->Rndm()*fCurrentAODTree->GetEntries())-1;
@@ -351,6 +387,9 @@ Bool_t AliJetEmbeddingFromAODTask::OpenNextFile()
     fHistFileMatching->Fill(fCurrentFileID, fCurrentAODFileID-1);
 
   fEmbeddingCount = 0;
+
+  if (fHistFileOpenTime)
+    fHistFileOpenTime->Fill(openTimer.RealTime()*1000);
   
   return kTRUE;
 }
@@ -387,22 +426,107 @@ TFile* AliJetEmbeddingFromAODTask::GetNextFile()
     return 0;
   }
 
-  AliDebug(3,Form("Trying to open file %s...", fileName.Data()));
-  TFile *file = TFile::Open(fileName);
+  TFile *file = 0;
+  TFileOpenHandle *handle = TakePrefetchedFile(fCurrentAODFileID);
+  if (handle) {
+    AliDebug(3,Form("Completing the opening of file %s...", fileName.Data()));
+    file = TFile::Open(handle);
+  }
+  else {
+    AliDebug(3,Form("Trying to open file %s...", fileName.Data()));
+    file = TFile::Open(fileName);
+  }
+
+  // the next files are opened while this one is processed
+  PrefetchFiles();
 
   if (!file || file->IsZombie()) {
     AliError(Form("Unable to open file: %s!", fileName.Data()));
+    delete file;
     return 0;
   }
 
   return file;
 }
 
+//________________________________________________________________________
+void AliJetEmbeddingFromAODTask::PrefetchFiles()
+{
+  // Start the asynchronous opening of the files following the current one.
+  // Only in sequential mode: in random access mode the next file is not known in advance.
+
+  if (fRandomAccess || fPrefetchFiles <= 0)
+    return;
+
+  Int_t nextID = fCurrentAODFileID + 1;
+  if (fPrefetchHandles.GetEntries() == 0)
+    fPrefetchFirstID = nextID;
+
+  Int_t id = fPrefetchFirstID + fPrefetchHandles.GetEntries();
+  while (id < nextID + fPrefetchFiles && id < fFileList->GetEntriesFast()) {
+    TString fileName(static_cast<TObjString*>(fFileList->At(id))->GetString());
+    if (fileName.BeginsWith("alien://") && !gGrid) 
+      break;
+
+    AliDebug(3,Form("Starting to open file %s...", fileName.Data()));
+    TFileOpenHandle *handle = TFile::AsyncOpen(fileName);
+    if (!handle) 
+      break;
+
+    fPrefetchHandles.Add(handle);
+    id++;
+  }
+}
+
+//________________________________________________________________________
+TFileOpenHandle* AliJetEmbeddingFromAODTask::TakePrefetchedFile(Int_t fileID)
+{
+  // Return the pending open of file fileID, if it was started.
+  // Pending opens of previous files are dropped, all of them if fileID was not requested.
+
+  if (fPrefetchHandles.GetEntries() == 0)
+    return 0;
+
+  if (fileID < fPrefetchFirstID || fileID >= fPrefetchFirstID + fPrefetchHandles.GetEntries()) {
+    ClearPrefetchedFiles();
+    return 0;
+  }
+
+  while (fPrefetchFirstID < fileID) {
+    TFileOpenHandle *handle = static_cast<TFileOpenHandle*>(fPrefetchHandles.First());
+    fPrefetchHandles.RemoveFirst();
+    fPrefetchFirstID++;
+    delete TFile::Open(handle);
+  }
+
+  TFileOpenHandle *handle = static_cast<TFileOpenHandle*>(fPrefetchHandles.First());
+  fPrefetchHandles.RemoveFirst();
+  fPrefetchFirstID++;
+
+  return handle;
+}
+
+//________________________________________________________________________
+void AliJetEmbeddingFromAODTask::ClearPrefetchedFiles()
+{
+  // Complete and close the pending opens.
+
+  TIter next(&fPrefetchHandles);
+  TFileOpenHandle *handle = 0;
+  while ((handle = static_cast<TFileOpenHandle*>(next()))) 
+    delete TFile::Open(handle);
+
+  fPrefetchHandles.Clear();
+  fPrefetchFirstID = -1;
+}
+
 //________________________________________________________________________
 Bool_t AliJetEmbeddingFromAODTask::GetNextEntry() 
 {
   Int_t attempts = -1;
 
+  fIOTimer.Reset();
+
   do {
     if (fCurrentAODEntry+1 >= fLastAODEntry) { // in case it did not start from the first entry, it will go back
       fLastAODEntry = fFirstAODEntry;
@@ -410,7 +534,10 @@ Bool_t AliJetEmbeddingFromAODTask::GetNextEntry()
       fCurrentAODEntry = -1;
     }
     if (!fCurrentAODFile || !fCurrentAODTree || fCurrentAODEntry+1 >= fLastAODEntry) {
-      if (!OpenNextFile()) {
+      fIOTimer.Start(kFALSE);
+      Bool_t opened = OpenNextFile();
+      fIOTimer.Stop();
+      if (!opened) {
 	AliError("Could not open the next file!");
 	return kFALSE;
       }
@@ -422,7 +549,9 @@ Bool_t AliJetEmbeddingFromAODTask::GetNextEntry()
     }
     
     fCurrentAODEntry++;
+    fIOTimer.Start(kFALSE);
     fCurrentAODTree->GetEntry(fCurrentAODEntry);
+    fIOTimer.Stop();
 
     attempts++;
     if (attempts == 1000) 
@@ -433,6 +562,9 @@ Bool_t AliJetEmbeddingFromAODTask::GetNextEntry()
   if (fHistRejectedEvents)
     fHistRejectedEvents->Fill(attempts);
 
+  if (fHistEmbeddingIOTime)
+    fHistEmbeddingIOTime->Fill(fIOTimer.RealTime()*1000);
+
   if (!fCurrentAODTree)
     return kFALSE;
 
@@ -9,6 +9,7 @@
 // $Id$
 
 class TFile;
+class TFileOpenHandle;
 class TObjArray;
 class TClonesArray;
 class TString;
@@ -19,6 +20,9 @@ class TH1;
 class TLorentzVector;
 class AliNamedString;
 
+#include <TList.h>
+#include <TStopwatch.h>
+
 #include "AliJetModelBaseTask.h"
 
 class AliJetEmbeddingFromAODTask : public AliJetModelBaseTask {
@@ -59,6 +63,8 @@ class AliJetEmbeddingFromAODTask : public AliJetModelBaseTask {
   void           SetMaxVertexDist(Double_t d)                      { fMaxVertexDist      = d     ; }
   void           SetParticlePtRange(Double_t min, Double_t max, Byte_t t=1) { fParticleMinPt = min; fParticleMaxPt = max; fParticleSelection = t; }
   void           SetEmbedCentrality(Bool_t d)                      { fEmbedCentrality    = d     ; }
+  void           SetPrefetchFiles(Int_t n)                         { fPrefetchFiles      = n     ; }
+  void           SetTreeCacheSize(Long64_t s)                      { fTreeCacheSize      = s     ; }
 
  protected:
   Bool_t          ExecOnce()            ;// intialize task
@@ -66,6 +72,9 @@ class AliJetEmbeddingFromAODTask : public AliJetModelBaseTask {
   virtual TFile  *GetNextFile()         ;// get next file from fFileList
   virtual Bool_t  OpenNextFile()        ;// open next file
   virtual Bool_t  GetNextEntry()        ;// get next entry in current tree
+  void            PrefetchFiles()       ;// start opening the next files of fFileList
+  TFileOpenHandle *TakePrefetchedFile(Int_t fileID);// pending open of file fileID, if any
+  void            ClearPrefetchedFiles();// drop pending opens
   virtual Bool_t  IsAODEventSelected()  ;// AOD event trigger/centrality selection
   TLorentzVector  GetLeadingJet(TClonesArray *tracks, TClonesArray *clusters=0);  // get the leading jet
   Bool_t          FindParticleInRange(TClonesArray *array);// Find particle in array within range (fParticleMinPt, fParticleMaxPt)
@@ -106,6 +115,8 @@ class AliJetEmbeddingFromAODTask : public AliJetModelBaseTask {
   Int_t          fTotalFiles          ;//  Total number of files per pt hard bin
   Int_t          fAttempts            ;//  Attempts to be tried before giving up in opening the next file
   Bool_t         fEmbedCentrality     ;//  If true, embed centrality (only works when running on AOD) - carefull: it overwrites the event centrality (if any) 
+  Int_t          fPrefetchFiles       ;//  Number of next files of fFileList opened asynchronously in advance (sequential access only)
+  Long64_t       fTreeCacheSize       ;//  Size of the TTreeCache of the embedded tree (0 = no cache)
   Bool_t         fEsdTreeMode         ;//! True = embed from ESD (must be a skimmed ESD!)
   Int_t          fCurrentFileID       ;//! Current file being processed (via the event handler)
   Int_t          fCurrentAODFileID    ;//! Current file ID
@@ -128,11 +139,16 @@ class AliJetEmbeddingFromAODTask : public AliJetModelBaseTask {
   TH1           *fHistEmbeddingQA     ;//! Embedding QA
   TH1           *fHistRejectedEvents  ;//! Rejected events
   Int_t          fEmbeddingCount      ;//! Number of embedded events from the current file
+  TList          fPrefetchHandles     ;//! Pending asynchronous opens of the next files (not owned, deleted by TFile::Open)
+  Int_t          fPrefetchFirstID     ;//! File ID of the first pending open, the others follow
+  TStopwatch     fIOTimer             ;//! Time spent waiting on embedding I/O
+  TH1           *fHistFileOpenTime    ;//! Time spent opening each embedding file
+  TH1           *fHistEmbeddingIOTime ;//! Time spent on embedding I/O per embedded event
 
  private:
   AliJetEmbeddingFromAODTask(const AliJetEmbeddingFromAODTask&);            // not implemented
   AliJetEmbeddingFromAODTask &operator=(const AliJetEmbeddingFromAODTask&); // not implemented
 
-  ClassDef(AliJetEmbeddingFromAODTask, 13) // Jet embedding from AOD task
+  ClassDef(AliJetEmbeddingFromAODTask, 14) // Jet embedding from AOD task
 };
 #endif
@@ -19,6 +19,10 @@
 
 #include "AliJetResponseMaker.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include <TClonesArray.h>
 #include <TH2F.h>
 #include <THnSparse.h>
@@ -34,6 +38,7 @@
 #include "AliJetContainer.h"
 #include "AliParticleContainer.h"
 #include "AliClusterContainer.h"
+#include "AliEmcalJetMatcher.h"
 
 ClassImp(AliJetResponseMaker)
 
@@ -45,6 +50,7 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
   fMinJetMCPt(1),
+  fUseMatchingCandidates(kTRUE),
   fHistoType(0),
   fDeltaPtAxis(0),
   fDeltaEtaDeltaPhiAxis(0),
@@ -117,7 +123,11 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fHistDeltaMCPtvsArea1(0),
   fHistDeltaMCPtvsArea2(0),
   fHistDeltaMCPtvsDeltaArea(0),
-  fHistJet1MCPtvsJet2Pt(0)
+  fHistJet1MCPtvsJet2Pt(0),
+  fJetMatcher(0),
+  fMatchCandidates(),
+  fMatchTracks(),
+  fMatchClusters()
 {
   // Default constructor.
 
@@ -132,6 +142,7 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
   fMinJetMCPt(1),
+  fUseMatchingCandidates(kTRUE),
   fHistoType(0),
   fDeltaPtAxis(0),
   fDeltaEtaDeltaPhiAxis(0),
@@ -204,7 +215,11 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fHistDeltaMCPtvsArea1(0),
   fHistDeltaMCPtvsArea2(0),
   fHistDeltaMCPtvsDeltaArea(0),
-  fHistJet1MCPtvsJet2Pt(0)
+  fHistJet1MCPtvsJet2Pt(0),
+  fJetMatcher(0),
+  fMatchCandidates(),
+  fMatchTracks(),
+  fMatchClusters()
 {
   // Standard constructor.
 
@@ -215,6 +230,8 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
 AliJetResponseMaker::~AliJetResponseMaker()
 {
   // Destructor
+
+  delete fJetMatcher;
 }
 
 
@@ -1339,24 +1356,7 @@ Bool_t AliJetResponseMaker::DoJetMatching()
 
   DoJetLoop();
 
-  AliEmcalJet* jet1 = 0;
-
-  jets1->ResetCurrentID();
-  while ((jet1 = jets1->GetNextJet())) {
-
-    AliEmcalJet *jet2 = jet1->ClosestJet();
-
-    if (!jet2) continue;
-    if (jet2->ClosestJet() != jet1) continue;
-    if (jet1->ClosestJetDistance() > fMatchingPar1 || jet2->ClosestJetDistance() > fMatchingPar2) continue;
-
-    // Matched jet found
-    jet1->SetMatchedToClosest(fMatching);
-    jet2->SetMatchedToClosest(fMatching);
-    AliDebug(2,Form("Found matching: jet1 pt = %f, eta = %f, phi = %f, jet2 pt = %f, eta = %f, phi = %f", 
-        jet1->Pt(), jet1->Eta(), jet1->Phi(),
-        jet2->Pt(), jet2->Eta(), jet2->Phi()));
-  }
+  AliEmcalJetMatcher::MatchClosestJets(jets1, fMatchingPar1, fMatchingPar2, fMatching);
 
   return kTRUE;
 }
@@ -1377,12 +1377,24 @@ void AliJetResponseMaker::DoJetLoop()
   jets2->ResetCurrentID();
   while ((jet2 = jets2->GetNextJet())) jet2->ResetMatching();
 
+  Bool_t useCandidates = PrepareMatchingCandidates();
+
   jets1->ResetCurrentID();
   while ((jet1 = jets1->GetNextJet())) {
     jet1->ResetMatching();
 
     if (jet1->MCPt() < fMinJetMCPt) continue;
 
+    if (useCandidates) {
+      // only the jets which can be matched to jet1, in the order of the jet2 loop
+      Int_t nCandidates = GetMatchingCandidates(jet1);
+      for (Int_t i = 0; i < nCandidates; i++) {
+        jet2 = jets2->GetJet(fMatchCandidates[i]);
+        SetMatchingLevel(jet1, jet2, fMatching);
+      }
+      continue;
+    }
+
     jets2->ResetCurrentID();
     while ((jet2 = jets2->GetNextJet())) {
       SetMatchingLevel(jet1, jet2, fMatching);
@@ -1390,6 +1402,93 @@ void AliJetResponseMaker::DoJetLoop()
   } // jet1 loop
 }
 
+//________________________________________________________________________
+Bool_t AliJetResponseMaker::PrepareMatchingCandidates()
+{
+  // Index the jets 2 so that only the jets which can be matched are compared with each jet 1.
+  // Geometrical matching: jets farther than the matching distances are never matched.
+  // MC label / same collections: jets without common constituents have a matching level of 1,
+  // they are never matched if both matching parameters are below 1.
+
+  if (!fUseMatchingCandidates) return kFALSE;
+
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  if (!fJetMatcher) fJetMatcher = new AliEmcalJetMatcher();
+
+  switch (fMatching) {
+  case kGeometrical:
+    fJetMatcher->FillGrid(jets2, TMath::Max(fMatchingPar1, fMatchingPar2));
+    return kTRUE;
+  case kMCLabel:
+    if (fMatchingPar1 >= 1 || fMatchingPar2 >= 1) return kFALSE;
+    if (!jets1->GetParticleContainer() || !jets2->GetParticleContainer()) return kFALSE;
+    fJetMatcher->FillConstituentMaps(jets2);
+    return kTRUE;
+  case kSameCollections:
+    if (fMatchingPar1 >= 1 || fMatchingPar2 >= 1) return kFALSE;
+    if (fUseCellsToMatch && fCaloCells) return kFALSE; // common cells of different clusters are not indexed
+    fJetMatcher->FillConstituentMaps(jets2);
+    return kTRUE;
+  default:
+    return kFALSE;
+  }
+}
+
+//________________________________________________________________________
+Int_t AliJetResponseMaker::GetMatchingCandidates(AliEmcalJet *jet1)
+{
+  // Fill fMatchCandidates with the indices of the jets 2 which can be matched to jet1 (increasing).
+
+  if (fMatching == kGeometrical) return fJetMatcher->GetGeometricalCandidates(jet1, fMatchCandidates);
+
+  Int_t nTracks = 0;
+  Int_t nClusters = 0;
+
+  if (fMatching == kSameCollections) {
+    if (fMatchTracks.GetSize() < jet1->GetNumberOfTracks()) fMatchTracks.Set(jet1->GetNumberOfTracks());
+    if (fMatchClusters.GetSize() < jet1->GetNumberOfClusters()) fMatchClusters.Set(jet1->GetNumberOfClusters());
+    for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) fMatchTracks[nTracks++] = jet1->TrackAt(iTrack);
+    for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) fMatchClusters[nClusters++] = jet1->ClusterAt(iClus);
+  }
+  else {
+    // MC particles associated with the tracks and clusters (or cells) of jet1, as in GetMCLabelMatchingLevel
+    AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+    AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+    AliParticleContainer *tracks1 = jets1->GetParticleContainer();
+    AliParticleContainer *tracks2 = jets2->GetParticleContainer();
+
+    for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
+      AliVParticle *track = jet1->TrackAt(iTrack, tracks1->GetArray());
+      if (!track) continue;
+      Int_t MClabel = TMath::Abs(track->GetLabel()) - fMCLabelShift;
+      if (MClabel <= 0) continue;
+      Int_t index = tracks2->GetIndexFromLabel(MClabel);
+      if (index < 0) continue;
+      if (fMatchTracks.GetSize() <= nTracks) fMatchTracks.Set(2*nTracks+16);
+      fMatchTracks[nTracks++] = index;
+    }
+
+    for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
+      AliVCluster *clus = jet1->ClusterAt(iClus, fCaloClusters);
+      if (!clus) continue;
+      Int_t nLabels = (fUseCellsToMatch && fCaloCells) ? clus->GetNCells() : 1;
+      for (Int_t iLabel = 0; iLabel < nLabels; iLabel++) {
+        Int_t label = (fUseCellsToMatch && fCaloCells) ? fCaloCells->GetCellMCLabel(clus->GetCellAbsId(iLabel)) : clus->GetLabel();
+        Int_t MClabel = TMath::Abs(label) - fMCLabelShift;
+        if (MClabel <= 0) continue;
+        Int_t index = tracks2->GetIndexFromLabel(MClabel);
+        if (index < 0) continue;
+        if (fMatchTracks.GetSize() <= nTracks) fMatchTracks.Set(2*nTracks+16);
+        fMatchTracks[nTracks++] = index;
+      }
+    }
+  }
+
+  return fJetMatcher->GetConstituentCandidates(fMatchTracks, nTracks, fMatchClusters, nClusters, fMatchCandidates);
+}
+
 //________________________________________________________________________
 void AliJetResponseMaker::GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const
 {
@@ -1480,11 +1579,14 @@ void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet
     }
   }
 
-  for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
-    Bool_t track2Found = kFALSE;
-    Int_t index2 = jet2->TrackAt(iTrack2);
+  // jet1 constituents associated with a MC particle, sorted by particle index and, for the same
+  // particle, in the order of the loops over the tracks and then over the clusters (or cells) of jet1
+  const Int_t nTracks2 = jet2->GetNumberOfTracks();
+  std::vector<std::pair<Int_t, Int_t> > shared; // (index of the MC particle, constituent)
+  std::vector<Double_t> sharedPt;               // pt of the constituent (or of its cell)
+  std::vector<Double_t> sharedFrac;             // fraction of the MC particle pt (cell fraction)
 
-    // now look for common particles in the track array
+  if (nTracks2 > 0) {
     for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
       AliVParticle *track = jet1->TrackAt(iTrack,tracks1->GetArray());
       if (!track) {
@@ -1492,7 +1594,7 @@ void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet
         continue;
       }
       Int_t MClabel = TMath::Abs(track->GetLabel());
-      MClabel -= fMCLabelShift;	  
+      MClabel -= fMCLabelShift;
       if (MClabel <= 0) continue;
 
       Int_t index = -1;
@@ -1502,22 +1604,11 @@ void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet
         continue;
       }
 
-      if (index2 != index) continue;
-
-      // found common particle
-      d1 -= track->Pt();
-
-      if (!track2Found) {
-        AliVParticle *MCpart = tracks2->GetParticle(index2);
-        AliDebug(3,Form("Track %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-            iTrack,track->Pt(),track->Eta(),track->Phi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
-        d2 -= MCpart->Pt();
-      }
-
-      track2Found = kTRUE;
+      shared.push_back(std::make_pair(index, Int_t(sharedPt.size())));
+      sharedPt.push_back(track->Pt());
+      sharedFrac.push_back(1.);
     }
 
-    // now look for common particles in the cluster array
     if (fUseCellsToMatch && fCaloCells) { // if the cell colection is available, look for cells with a matched MC particle
       for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
         AliVCluster *clus = jet1->ClusterAt(iClus,fCaloClusters);
@@ -1543,19 +1634,9 @@ void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet
             continue;
           }
 
-          if (index2 != index1) continue;
-
-          // found common particle
-          d1 -= part.Pt() * cellFrac;
-
-          if (!track2Found) { // only if it is not already found among charged tracks (charged particles are most likely already found)
-            AliVParticle *MCpart = tracks2->GetParticle(index2);
-            AliDebug(3,Form("Cell %d belonging to cluster %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-                iCell,iClus,part.Pt(),part.Eta(),part.Phi_0_2pi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
-            d2 -= MCpart->Pt() * cellFrac;
-          }
-
-          track2Found = kTRUE;
+          shared.push_back(std::make_pair(index1, Int_t(sharedPt.size())));
+          sharedPt.push_back(part.Pt() * cellFrac);
+          sharedFrac.push_back(cellFrac);
         }
       }
     }
@@ -1581,21 +1662,32 @@ void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet
           continue;
         }
 
-        if (index2 != index) continue;
+        shared.push_back(std::make_pair(index, Int_t(sharedPt.size())));
+        sharedPt.push_back(part.Pt());
+        sharedFrac.push_back(1.);
+      }
+    }
 
-        // found common particle
-        d1 -= part.Pt();
+    std::sort(shared.begin(), shared.end());
+  }
 
-        if (!track2Found) { // only if it is not already found among charged tracks (charged particles are most likely already found)
-          AliVParticle *MCpart = tracks2->GetParticle(index2);
-          AliDebug(3,Form("Cluster %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-              iClus,part.Pt(),part.Eta(),part.Phi_0_2pi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
+  for (Int_t iTrack2 = 0; iTrack2 < nTracks2; iTrack2++) {
+    Bool_t track2Found = kFALSE;
+    Int_t index2 = jet2->TrackAt(iTrack2);
 
-          d2 -= MCpart->Pt();
-        }
+    // common particles: the jet1 constituents associated with index2
+    std::vector<std::pair<Int_t, Int_t> >::const_iterator it = std::lower_bound(shared.begin(), shared.end(), std::make_pair(index2, -1));
+    for (; it != shared.end() && it->first == index2; ++it) {
+      d1 -= sharedPt[it->second];
 
-        track2Found = kTRUE;
+      if (!track2Found) { // only for the first constituent (charged particles are most likely found among the tracks)
+        AliVParticle *MCpart = tracks2->GetParticle(index2);
+        AliDebug(3,Form("Constituent %d (pT = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
+            it->second,sharedPt[it->second],index2,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
+        d2 -= MCpart->Pt() * sharedFrac[it->second];
       }
+
+      track2Found = kTRUE;
     }
   }
 
@@ -1635,27 +1727,29 @@ void AliJetResponseMaker::GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, Ali
 
   if (tracks1 && tracks2) {
 
+    // sorted track indices of jet1, looked up for each track of jet2
+    std::vector<Int_t> sortedTracks1(jet1->GetNumberOfTracks());
+    for (Int_t iTrack1 = 0; iTrack1 < jet1->GetNumberOfTracks(); iTrack1++) sortedTracks1[iTrack1] = jet1->TrackAt(iTrack1);
+    std::sort(sortedTracks1.begin(), sortedTracks1.end());
+
     for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
       Int_t index2 = jet2->TrackAt(iTrack2);
-      for (Int_t iTrack1 = 0; iTrack1 < jet1->GetNumberOfTracks(); iTrack1++) {
-        Int_t index1 = jet1->TrackAt(iTrack1);
-        if (index2 == index1) { // found common particle
-          AliVParticle *part1 = tracks1->GetParticle(index1);
-          if (!part1) {
-            AliWarning(Form("Could not find track %d!", index1));
-            continue;
-          }
-          AliVParticle *part2 = tracks2->GetParticle(index2);
-          if (!part2) {
-            AliWarning(Form("Could not find track %d!", index2));
-            continue;
-          }
+      if (!std::binary_search(sortedTracks1.begin(), sortedTracks1.end(), index2)) continue;
 
-          d1 -= part1->Pt();
-          d2 -= part2->Pt();
-          break;
-        }
+      // found common particle
+      AliVParticle *part1 = tracks1->GetParticle(index2);
+      if (!part1) {
+        AliWarning(Form("Could not find track %d!", index2));
+        continue;
       }
+      AliVParticle *part2 = tracks2->GetParticle(index2);
+      if (!part2) {
+        AliWarning(Form("Could not find track %d!", index2));
+        continue;
+      }
+
+      d1 -= part1->Pt();
+      d2 -= part2->Pt();
     }
 
   }
@@ -1765,30 +1859,31 @@ void AliJetResponseMaker::GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, Ali
       }
     }
     else {
+      std::vector<Int_t> sortedClusters1(jet1->GetNumberOfClusters());
+      for (Int_t iClus1 = 0; iClus1 < jet1->GetNumberOfClusters(); iClus1++) sortedClusters1[iClus1] = jet1->ClusterAt(iClus1);
+      std::sort(sortedClusters1.begin(), sortedClusters1.end());
+
       for (Int_t iClus2 = 0; iClus2 < jet2->GetNumberOfClusters(); iClus2++) {
         Int_t index2 = jet2->ClusterAt(iClus2);
-        for (Int_t iClus1 = 0; iClus1 < jet1->GetNumberOfClusters(); iClus1++) {
-          Int_t index1 = jet1->ClusterAt(iClus1);
-          if (index2 == index1) { // found common particle
-            AliVCluster *clus1 = clusters1->GetCluster(index1);
-            if (!clus1) {
-              AliWarning(Form("Could not find cluster %d!", index1));
-              continue;
-            }
-            AliVCluster *clus2 =  clusters2->GetCluster(index2);
-            if (!clus2) {
-              AliWarning(Form("Could not find cluster %d!", index2));
-              continue;
-            }
-            TLorentzVector part1, part2;
-            clus1->GetMomentum(part1, fVertex);
-            clus2->GetMomentum(part2, fVertex);
+        if (!std::binary_search(sortedClusters1.begin(), sortedClusters1.end(), index2)) continue;
 
-            d1 -= part1.Pt();
-            d2 -= part2.Pt();
-            break;
-          }
+        // found common particle
+        AliVCluster *clus1 = clusters1->GetCluster(index2);
+        if (!clus1) {
+          AliWarning(Form("Could not find cluster %d!", index2));
+          continue;
+        }
+        AliVCluster *clus2 =  clusters2->GetCluster(index2);
+        if (!clus2) {
+          AliWarning(Form("Could not find cluster %d!", index2));
+          continue;
         }
+        TLorentzVector part1, part2;
+        clus1->GetMomentum(part1, fVertex);
+        clus2->GetMomentum(part2, fVertex);
+
+        d1 -= part1.Pt();
+        d2 -= part2.Pt();
       }
     }
   }
@@ -1831,27 +1926,7 @@ void AliJetResponseMaker::SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2,
     ;
   }
 
-  if (d1 >= 0) {
-
-    if (d1 < jet1->ClosestJetDistance()) {
-      jet1->SetSecondClosestJet(jet1->ClosestJet(), jet1->ClosestJetDistance());
-      jet1->SetClosestJet(jet2, d1);
-    }
-    else if (d1 < jet1->SecondClosestJetDistance()) {
-      jet1->SetSecondClosestJet(jet2, d1);
-    }
-  }
-
-  if (d2 >= 0) {
-
-    if (d2 < jet2->ClosestJetDistance()) {
-      jet2->SetSecondClosestJet(jet2->ClosestJet(), jet2->ClosestJetDistance());
-      jet2->SetClosestJet(jet1, d2);
-    }
-    else if (d2 < jet2->SecondClosestJetDistance()) {
-      jet2->SetSecondClosestJet(jet1, d2);
-    }
-  }
+  AliEmcalJetMatcher::SetClosestJets(jet1, jet2, d1, d2);
 }
 
 //________________________________________________________________________
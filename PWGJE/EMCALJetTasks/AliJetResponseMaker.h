@@ -23,6 +23,9 @@ class TClonesArray;
 class TH2;
 class THnSparse;
 class AliNamedArrayI;
+class AliEmcalJetMatcher;
+
+#include <TArrayI.h>
 
 #include "AliEmcalJet.h"
 #include "AliAnalysisTaskEmcalJet.h"
@@ -46,6 +49,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   void                        SetPtHardBin(Int_t b)                                           { fSelectPtHardBin   = b         ; }
   void                        SetUseCellsToMatch(Bool_t i)                                    { fUseCellsToMatch   = i         ; }
   void                        SetMinJetMCPt(Float_t pt)                                       { fMinJetMCPt        = pt        ; }
+  void                        SetUseMatchingCandidates(Bool_t b)                              { fUseMatchingCandidates = b     ; }
   void                        SetHistoType(Int_t b)                                           { fHistoType         = b         ; }
   void                        SetDeltaPtAxis(Int_t b)                                         { fDeltaPtAxis       = b         ; }
   void                        SetDeltaEtaDeltaPhiAxis(Int_t b)                                { fDeltaEtaDeltaPhiAxis= b       ; }
@@ -61,6 +65,8 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
  protected:
   void                        ExecOnce();
   void                        DoJetLoop();
+  Bool_t                      PrepareMatchingCandidates();
+  Int_t                       GetMatchingCandidates(AliEmcalJet *jet1);
   Bool_t                      FillHistograms();
   Bool_t                      Run();
   Bool_t                      DoJetMatching();
@@ -78,6 +84,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   Double_t                    fMatchingPar2;                           // matching parameter for jet2-jet1 matching
   Bool_t                      fUseCellsToMatch;                        // use cells instead of clusters to match jets (slower but sometimes needed)
   Double_t                    fMinJetMCPt;                             // minimum jet MC pt
+  Bool_t                      fUseMatchingCandidates;                  // compare each jet 1 only with the jets 2 which can be matched (eta-phi grid / common constituents)
   Int_t                       fHistoType;                              // histogram type (0=TH2, 1=THnSparse)
   Int_t                       fDeltaPtAxis;                            // add delta pt axis in THnSparse (default=0)
   Int_t                       fDeltaEtaDeltaPhiAxis;                   // add delta eta and delta phi axes in THnSparse (default=0)
@@ -166,10 +173,15 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   TH2                        *fHistDeltaMCPtvsDeltaArea;               //!jet 1 MC pt - jet2 pt vs delta area
   TH2                        *fHistJet1MCPtvsJet2Pt;                   //!correlation jet 1 MC pt vs jet 2 pt
 
+  AliEmcalJetMatcher         *fJetMatcher;                             //!index of the jets 2 for the matching candidates
+  TArrayI                     fMatchCandidates;                        //!indices of the jets 2 which can be matched to the current jet 1
+  TArrayI                     fMatchTracks;                            //!track (MC particle) indices of the current jet 1
+  TArrayI                     fMatchClusters;                          //!cluster indices of the current jet 1
+
  private:
   AliJetResponseMaker(const AliJetResponseMaker&);            // not implemented
   AliJetResponseMaker &operator=(const AliJetResponseMaker&); // not implemented
 
-  ClassDef(AliJetResponseMaker, 28) // Jet response matrix producing task
+  ClassDef(AliJetResponseMaker, 29) // Jet response matrix producing task
 };
 #endif
@@ -15,7 +15,10 @@
 #pragma link C++ class AliAnalysisTaskLocalRho+;
 #pragma link C++ class AliAnalysisTaskDeltaPt+;
 #pragma link C++ class AliAnalysisTaskScale+;
+#pragma link C++ class AliEmcalConePtGrid+;
+#pragma link C++ class AliEmcalConstituentSubtractor+;
 #pragma link C++ class AliEmcalJetByJetCorrection+;
+#pragma link C++ class AliEmcalJetMatcher+;
 #pragma link C++ class AliEmcalPicoTrackInGridMaker+;
 #pragma link C++ class AliJetEmbeddingTask+;
 #pragma link C++ class AliJetEmbeddingFromGenTask+;
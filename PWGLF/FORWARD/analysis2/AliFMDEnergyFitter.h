@@ -299,6 +299,15 @@ public:
    * @param use If true, enable extra shift @f$\delta\Delta_p(\sigma/\xi)@f$  
    */
   void SetEnableDeltaShift(Bool_t use=true);
+  /**
+   * Whether to evaluate the Landau-Gauss convolution from a
+   * pre-calculated table rather than by numerical integration (see
+   * AliLandauGaus::EnableTable).  This speeds up the fits
+   * considerably, with a relative deviation of order @f$10^{-4}@f$.
+   *
+   * @param use If true, use the tabulated kernel
+   */
+  void SetEnableTable(Bool_t use=true);
 
   /* @} */
   // -----------------------------------------------------------------
@@ -162,6 +162,37 @@ public:
    * Number of steps to do in the Landau, Gaussiam convolution 
    */
   static Int_t NSteps() { return 100; }
+  /** 
+   * Lower edge of the tabulated kernel in the reduced variable
+   * @f$ t(u)@f$ (see TableT)
+   */
+  static Double_t TableTMin() { return -10; }
+  /** 
+   * Upper edge of the tabulated kernel in @f$ t(u)@f$.  This
+   * corresponds to @f$ u\approx 1000@f$
+   */
+  static Double_t TableTMax() { return 56; }
+  /** 
+   * Number of points in @f$ t@f$ of the tabulated kernel 
+   */
+  static Int_t TableNT() { return 1321; }
+  /** 
+   * Value of @f$ u@f$ above which the table is spaced logarithmically
+   */
+  static Double_t TableUC() { return 10; }
+  /** 
+   * Least value of @f$ s=\sigma'/\xi@f$ in the tabulated kernel
+   */
+  static Double_t TableSMin() { return 0.01; }
+  /** 
+   * Largest value of @f$ s=\sigma'/\xi@f$ in the tabulated kernel
+   */
+  static Double_t TableSMax() { return 10; }
+  /** 
+   * Number of (logarithmically spaced) points in @f$ s@f$ of the
+   * tabulated kernel
+   */
+  static Int_t TableNS() { return 100; }
   /* @} */
 
   //__________________________________________________________________
@@ -211,6 +242,23 @@ public:
   static Double_t F(Double_t x, Double_t delta, Double_t xi, 
 		    Double_t sigma, Double_t sigma_n);
   //------------------------------------------------------------------
+  /** 
+   * Calculate the value of a Landau convolved with a Gaussian by
+   * numerical integration.  This is what F evaluates when the
+   * tabulated kernel is not enabled (see EnableTable), or when the
+   * arguments fall outside the table.
+   * 
+   * @param x         where to evaluate @f$ f@f$
+   * @param delta     @f$ \Delta_p@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
+   * @param xi        @f$ \xi@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
+   * @param sigma     @f$ \sigma@f$ of @f$\sigma'^2=\sigma^2-\sigma_n^2 @f$
+   * @param sigma_n   @f$ \sigma_n@f$ of @f$\sigma'^2=\sigma^2-\sigma_n^2 @f$
+   * 
+   * @return @f$ f@f$ evaluated at @f$ x@f$.  
+   */
+  static Double_t FDirect(Double_t x, Double_t delta, Double_t xi, 
+			  Double_t sigma, Double_t sigma_n);
+  //------------------------------------------------------------------
   /** 
    * Evaluate 
    * @f[ 
@@ -283,6 +331,83 @@ public:
   static Double_t Fn(Double_t x, Double_t delta, Double_t xi, 
 		     Double_t sigma, Double_t sigma_n, Int_t n, 
 		     const Double_t* a);
+  //------------------------------------------------------------------
+  /** 
+   * Add @f$ w f(x_j;\Delta_p,\xi,\sigma')@f$ to @f$ f_j@f$ for all
+   * @f$ j=0,\ldots,n_x-1@f$.  Quantities that do not depend on
+   * @f$ x@f$ - in particular the @f$ s@f$ interpolation weights of
+   * the tabulated kernel - are calculated once only.
+   * 
+   * @param nx       Number of points 
+   * @param x        Points to evaluate at (size @f$ n_x@f$) 
+   * @param f        Output: Incremented values (size @f$ n_x@f$)
+   * @param w        Weight @f$ w@f$
+   * @param delta    @f$ \Delta_p@f$ 
+   * @param xi       @f$ \xi@f$ 
+   * @param sigma    @f$ \sigma@f$ 
+   * @param sigma_n  @f$ \sigma_n@f$
+   */
+  static void FAdd(Int_t nx, const Double_t* x, Double_t* f, Double_t w,
+		   Double_t delta, Double_t xi, 
+		   Double_t sigma, Double_t sigma_n);
+  //------------------------------------------------------------------
+  /** 
+   * Add @f$ w f_i(x_j;\Delta_p,\xi,\sigma')@f$ to @f$ f_j@f$ for
+   * all @f$ j=0,\ldots,n_x-1@f$.  The @f$ i@f$ particle parameters
+   * (see IPars) are calculated once only.
+   * 
+   * @param nx       Number of points 
+   * @param x        Points to evaluate at (size @f$ n_x@f$) 
+   * @param f        Output: Incremented values (size @f$ n_x@f$)
+   * @param w        Weight @f$ w@f$
+   * @param delta    @f$ \Delta_p@f$ 
+   * @param xi       @f$ \xi@f$ 
+   * @param sigma    @f$ \sigma@f$ 
+   * @param sigma_n  @f$ \sigma_n@f$
+   * @param i        @f$ i @f$
+   */
+  static void FiAdd(Int_t nx, const Double_t* x, Double_t* f, Double_t w,
+		    Double_t delta, Double_t xi, 
+		    Double_t sigma, Double_t sigma_n, Int_t i);
+  //------------------------------------------------------------------
+  /** 
+   * Evaluate @f$ f_i(x_j;\Delta_p,\xi,\sigma')@f$ for all
+   * @f$ j=0,\ldots,n_x-1@f$ 
+   * 
+   * @param nx       Number of points 
+   * @param x        Points to evaluate at (size @f$ n_x@f$) 
+   * @param f        Output: values (size @f$ n_x@f$)
+   * @param delta    @f$ \Delta_p@f$ 
+   * @param xi       @f$ \xi@f$ 
+   * @param sigma    @f$ \sigma@f$ 
+   * @param sigma_n  @f$ \sigma_n@f$
+   * @param i        @f$ i @f$
+   */
+  static void Fi(Int_t nx, const Double_t* x, Double_t* f, 
+		 Double_t delta, Double_t xi, 
+		 Double_t sigma, Double_t sigma_n, Int_t i);
+  //------------------------------------------------------------------
+  /** 
+   * Evaluate @f$ f_N(x_j;\Delta_p,\xi,\sigma')@f$ for all
+   * @f$ j=0,\ldots,n_x-1@f$.  This gives the same as calling Fn for
+   * each point, but the @f$ i@f$ particle parameters are only
+   * calculated once per @f$ i@f$.
+   * 
+   * @param nx       Number of points 
+   * @param x        Points to evaluate at (size @f$ n_x@f$) 
+   * @param f        Output: values (size @f$ n_x@f$)
+   * @param delta    @f$ \Delta_1@f$ 
+   * @param xi       @f$ \xi_1@f$
+   * @param sigma    @f$ \sigma_1@f$ 
+   * @param sigma_n  @f$ \sigma_n@f$ 
+   * @param n        @f$ N@f$ 
+   * @param a        Array of size @f$ N-1@f$ of the weights @f$ a_i@f$ for 
+   *                 @f$ i > 1@f$ 
+   */
+  static void Fn(Int_t nx, const Double_t* x, Double_t* f, 
+		 Double_t delta, Double_t xi, 
+		 Double_t sigma, Double_t sigma_n, Int_t n, 
+		 const Double_t* a);
   /** 
    * Get parameters for the @f$ i@f$ particle response.
    *
@@ -326,6 +451,92 @@ public:
   static Double_t SigmaShift(Int_t i, Double_t xi, Double_t sigma);
   /* @} */
 
+  //__________________________________________________________________
+  /** 
+   * @{ 
+   * @name Tabulated kernel 
+   *
+   * Since both the Landau and the Gaussian scale with @f$\xi@f$ we
+   * have
+   *
+   * @f[ 
+   *   f(x;\Delta_p,\xi,\sigma') = \frac{1}{\xi}K(u,s)\quad
+   *   u = \frac{x-\Delta_p}{\xi},\quad s = \frac{\sigma'}{\xi}
+   * @f] 
+   *
+   * where @f$ K(u,s)=f(u;0,1,s)@f$.  If enabled (see EnableTable),
+   * @f$ K@f$ is tabulated once (with the same quadrature as FDirect)
+   * on a grid in @f$ t(u)@f$ and @f$\log s@f$, and F interpolates
+   * the table with a bicubic (Catmull-Rom) spline.  Outside the
+   * table, F falls back to FDirect.
+   */
+  //------------------------------------------------------------------
+  /** 
+   * Set and check if the tabulated kernel is used 
+   * 
+   * @param val if <0, then only check.  Otherwise set enabled (>0) or not (=0)
+   * 
+   * @return whether the tabulated kernel is used or not 
+   */
+  static Bool_t EnableTable(Short_t val=-1);
+  /** 
+   * Get the tabulated kernel @f$ K(u(t_k),s_l)@f$, stored at 
+   * @f$ l N_t + k@f$.  The table is calculated on first use. 
+   * 
+   * @return Pointer to the table 
+   */
+  static const Double_t* Table();
+  /** 
+   * The table variable 
+   * @f[ 
+   *   t(u) = \left\{\begin{array}{ll} 
+   *     u & u \le u_c\\
+   *     u_c(1+\log(u/u_c)) & u > u_c
+   *   \end{array}\right.
+   * @f] 
+   * so that the slowly falling Landau tail is spaced logarithmically. 
+   * 
+   * @param u @f$ u@f$
+   * 
+   * @return @f$ t(u)@f$ 
+   */
+  static Double_t TableT(Double_t u);
+  /** 
+   * Inverse of TableT 
+   * 
+   * @param t @f$ t@f$
+   * 
+   * @return @f$ u(t)@f$
+   */
+  static Double_t TableU(Double_t t);
+  /** 
+   * Find the first of the four points and the Catmull-Rom weights
+   * needed to interpolate at @f$ v@f$ on the grid
+   * @f$ v_k=v_{\min}+k\delta v,\ k=0,\ldots,n-1@f$.
+   * 
+   * @param v     Where to interpolate 
+   * @param vmin  @f$ v_{\min}@f$
+   * @param dv    @f$ \delta v@f$ 
+   * @param n     @f$ n@f$
+   * @param k     Output: index of first point 
+   * @param w     Output: the four weights 
+   * 
+   * @return false if @f$ v@f$ is outside @f$[v_1,v_{n-2})@f$
+   */
+  static Bool_t CatmullRom(Double_t v, Double_t vmin, Double_t dv, Int_t n,
+			   Int_t& k, Double_t* w);
+  /** 
+   * Interpolate the kernel @f$ K(u,s)@f$ 
+   * 
+   * @param u  @f$ u@f$ 
+   * @param s  @f$ s@f$ 
+   * @param k  Output: @f$ K(u,s)@f$ 
+   * 
+   * @return false if @f$(u,s)@f$ is outside the table 
+   */
+  static Bool_t TableK(Double_t u, Double_t s, Double_t& k);
+  /* @} */
+
   
   //__________________________________________________________________
   /** 
@@ -484,6 +695,93 @@ AliLandauGaus::EnableSigmaShift(Short_t val)
   return enabled;
 }
 //____________________________________________________________________
+inline Bool_t
+AliLandauGaus::EnableTable(Short_t val)
+{
+  static Bool_t enabled = false;
+  if (val >= 0) enabled = val == 1;
+  return enabled;
+}
+//____________________________________________________________________
+inline Double_t
+AliLandauGaus::TableT(Double_t u)
+{
+  const Double_t uc = TableUC();
+  if (u <= uc) return u;
+  return uc * (1 + TMath::Log(u / uc));
+}
+//____________________________________________________________________
+inline Double_t
+AliLandauGaus::TableU(Double_t t)
+{
+  const Double_t uc = TableUC();
+  if (t <= uc) return t;
+  return uc * TMath::Exp(t / uc - 1);
+}
+//____________________________________________________________________
+inline const Double_t*
+AliLandauGaus::Table()
+{
+  static Double_t* table = 0;
+  if (table) return table;
+
+  const Int_t    nt   = TableNT();
+  const Int_t    ns   = TableNS();
+  const Double_t dt   = (TableTMax() - TableTMin()) / (nt - 1);
+  const Double_t lmin = TMath::Log(TableSMin());
+  const Double_t dl   = (TMath::Log(TableSMax()) - lmin) / (ns - 1);
+  Double_t*      tab  = new Double_t[nt * ns];
+  for (Int_t l = 0; l < ns; l++) { 
+    const Double_t s = TMath::Exp(lmin + l * dl);
+    for (Int_t k = 0; k < nt; k++) 
+      tab[l * nt + k] = FDirect(TableU(TableTMin() + k * dt), 0, 1, s, 0);
+  }
+  table = tab;
+  return table;
+}
+//____________________________________________________________________
+inline Bool_t
+AliLandauGaus::CatmullRom(Double_t v, Double_t vmin, Double_t dv, Int_t n,
+			  Int_t& k, Double_t* w)
+{
+  const Double_t r = (v - vmin) / dv;
+  if (!(r >= 1) || r >= n - 2) return false;
+  const Int_t    k1 = Int_t(r);
+  const Double_t f  = r - k1;
+  const Double_t f2 = f * f;
+  const Double_t f3 = f2 * f;
+  k    = k1 - 1;
+  w[0] = .5 * (-f3 + 2 * f2 - f);
+  w[1] = .5 * (3 * f3 - 5 * f2 + 2);
+  w[2] = .5 * (-3 * f3 + 4 * f2 + f);
+  w[3] = .5 * (f3 - f2);
+  return true;
+}
+//____________________________________________________________________
+inline Bool_t
+AliLandauGaus::TableK(Double_t u, Double_t s, Double_t& k)
+{
+  if (s <= 0) return false;
+  const Int_t    nt   = TableNT();
+  const Int_t    ns   = TableNS();
+  const Double_t dt   = (TableTMax() - TableTMin()) / (nt - 1);
+  const Double_t lmin = TMath::Log(TableSMin());
+  const Double_t dl   = (TMath::Log(TableSMax()) - lmin) / (ns - 1);
+  Int_t          ks, kt;
+  Double_t       ws[4], wt[4];
+  if (!CatmullRom(TMath::Log(s), lmin, dl, ns, ks, ws)) return false;
+  if (!CatmullRom(TableT(u), TableTMin(), dt, nt, kt, wt)) return false;
+
+  const Double_t* tab = Table() + ks * nt + kt;
+  Double_t        sum = 0;
+  for (Int_t l = 0; l < 4; l++, tab += nt) 
+    sum += ws[l] * (wt[0] * tab[0] + wt[1] * tab[1] + 
+		    wt[2] * tab[2] + wt[3] * tab[3]);
+  // The spline may overshoot slightly where the kernel vanishes 
+  k = TMath::Max(sum, 0.);
+  return true;
+}
+//____________________________________________________________________
 inline void
 AliLandauGaus::IPars(Int_t i, Double_t& delta, Double_t& xi, Double_t& sigma)
 {
@@ -529,6 +827,20 @@ AliLandauGaus::F(Double_t x, Double_t delta, Double_t xi,
 {
   if (xi <= 0) return 0;
 
+  if (EnableTable()) { 
+    const Double_t s = TMath::Sqrt(sigmaN*sigmaN + sigma*sigma) / xi;
+    Double_t       k = 0;
+    if (TableK((x - delta) / xi, s, k)) return k / xi;
+  }
+  return FDirect(x, delta, xi, sigma, sigmaN);
+}
+//____________________________________________________________________
+inline Double_t 
+AliLandauGaus::FDirect(Double_t x, Double_t delta, Double_t xi,
+		       Double_t sigma, Double_t sigmaN)
+{
+  if (xi <= 0) return 0;
+
   const Int_t    nSteps = NSteps();
   const Double_t nSigma = NSigma();
   const Double_t deltaP = delta; // - sigma * sigmaShift; // + sigma * mpshift;
@@ -574,6 +886,82 @@ AliLandauGaus::Fn(Double_t x, Double_t delta, Double_t xi,
     result += a[i-2] * Fi(x,delta,xi,sigma,sigmaN,i);
   return result;
 }
+//____________________________________________________________________
+inline void
+AliLandauGaus::FAdd(Int_t nx, const Double_t* x, Double_t* f, Double_t w,
+		    Double_t delta, Double_t xi, 
+		    Double_t sigma, Double_t sigmaN)
+{
+  if (xi <= 0 || w == 0) return;
+
+  // Interpolation weights in s are the same for all x 
+  const Int_t     nt   = TableNT();
+  const Double_t  dt   = (TableTMax() - TableTMin()) / (nt - 1);
+  const Double_t  s    = TMath::Sqrt(sigmaN*sigmaN + sigma*sigma) / xi;
+  const Double_t  wxi  = w / xi;
+  const Double_t* col  = 0;
+  Int_t           ks   = 0;
+  Double_t        ws[4];
+  if (EnableTable() && s > 0) {
+    const Double_t lmin = TMath::Log(TableSMin());
+    const Double_t dl   = (TMath::Log(TableSMax()) - lmin) / (TableNS() - 1);
+    if (CatmullRom(TMath::Log(s), lmin, dl, TableNS(), ks, ws)) 
+      col = Table() + ks * nt;
+  }
+  
+  for (Int_t j = 0; j < nx; j++) { 
+    Int_t    kt;
+    Double_t wt[4];
+    if (!col || 
+	!CatmullRom(TableT((x[j] - delta) / xi), TableTMin(), dt, nt, kt, wt)) {
+      f[j] += w * FDirect(x[j], delta, xi, sigma, sigmaN);
+      continue;
+    }
+    const Double_t* tab = col + kt;
+    Double_t        sum = 0;
+    for (Int_t l = 0; l < 4; l++, tab += nt) 
+      sum += ws[l] * (wt[0] * tab[0] + wt[1] * tab[1] + 
+		      wt[2] * tab[2] + wt[3] * tab[3]);
+    f[j] += wxi * TMath::Max(sum, 0.);
+  }
+}
+//____________________________________________________________________
+inline void
+AliLandauGaus::FiAdd(Int_t nx, const Double_t* x, Double_t* f, Double_t w,
+		     Double_t delta, Double_t xi, 
+		     Double_t sigma, Double_t sigmaN, Int_t i)
+{
+  Double_t deltaI = delta;
+  Double_t xiI    = xi;
+  Double_t sigmaI = sigma;
+  IPars(i, deltaI, xiI, sigmaI);
+  if (sigmaI < 1e-10) { 
+    // Fall back to landau 
+    for (Int_t j = 0; j < nx; j++) f[j] += w * Fl(x[j], deltaI, xiI);
+    return;
+  }
+  FAdd(nx, x, f, w, deltaI, xiI, sigmaI, sigmaN);
+}
+//____________________________________________________________________
+inline void
+AliLandauGaus::Fi(Int_t nx, const Double_t* x, Double_t* f, 
+		  Double_t delta, Double_t xi, 
+		  Double_t sigma, Double_t sigmaN, Int_t i)
+{
+  for (Int_t j = 0; j < nx; j++) f[j] = 0;
+  FiAdd(nx, x, f, 1, delta, xi, sigma, sigmaN, i);
+}
+//____________________________________________________________________
+inline void
+AliLandauGaus::Fn(Int_t nx, const Double_t* x, Double_t* f, 
+		  Double_t delta, Double_t xi, 
+		  Double_t sigma, Double_t sigmaN, Int_t n, 
+		  const Double_t* a)
+{
+  Fi(nx, x, f, delta, xi, sigma, sigmaN, 1);
+  for (Int_t i = 2; i <= n; i++) 
+    FiAdd(nx, x, f, a[i-2], delta, xi, sigma, sigmaN, i);
+}
 
 //____________________________________________________________________
 inline Double_t 
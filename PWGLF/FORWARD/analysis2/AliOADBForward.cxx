@@ -8,6 +8,7 @@
 #include <TFile.h>
 #include <TError.h>
 #include <TSystem.h>
+#include <TMath.h>
 
 #ifndef ALIROOT_SVN_REVISION
 # define ALIROOT_SVN_REVISION 0
@@ -146,7 +147,15 @@ AliOADBForward::Entry::Print(Option_t* /*option*/) const
 }
 //====================================================================
 AliOADBForward::Table::Table(TTree* tree, Bool_t isNew, ERunSelectMode mode)
-  : fTree(tree), fEntry(0), fVerbose(false), fMode(mode), fFallBack(false)
+  : fTree(tree), fEntry(0), fVerbose(false), fMode(mode), fFallBack(false),
+    fNIndexed(-1),
+    fIdxRun(),
+    fIdxEntry(),
+    fIdxSys(),
+    fIdxSNN(),
+    fIdxField(),
+    fIdxFlags(),
+    fCache()
 {
   if (!tree) return;
 
@@ -177,10 +186,19 @@ AliOADBForward::Table::Table(const Table& o)
     fEntry(o.fEntry), 
     fVerbose(o.fVerbose),
     fMode(o.fMode), 
-    fFallBack(o.fFallBack)
+    fFallBack(o.fFallBack),
+    fNIndexed(-1),
+    fIdxRun(),
+    fIdxEntry(),
+    fIdxSys(),
+    fIdxSNN(),
+    fIdxField(),
+    fIdxFlags(),
+    fCache()
 {
   //
-  // Copy constructor 
+  // Copy constructor.  The index and cache are not copied, but
+  // rebuilt on demand
   if (!fTree) return;
   fTree->SetBranchAddress("e", &fEntry);
 }
@@ -201,6 +219,7 @@ AliOADBForward::Table::operator=(const Table& o)
   // Assignment operator 
   // 
   if (this == &o) return *this;
+  ClearCache();
   fTree    = o.fTree;
   fEntry   = o.fEntry;
   fVerbose = o.fVerbose;
@@ -269,6 +288,7 @@ AliOADBForward::Table::Close()
   
   // if (fTree)  delete fTree; 
   // if (fEntry) delete fEntry;
+  ClearCache();
   fTree  = 0;
   fEntry = 0;
   return true;
@@ -284,11 +304,236 @@ AliOADBForward::Table::Query(ULong_t        runNo,
 			     Bool_t         sat) const
 {
   // 
-  // Query the tree 
+  // Query the table.  If possible, the in-memory index is used, 
+  // otherwise the tree is queried 
   //
+  if (BuildIndex()) return Lookup(runNo, mode, sys, sNN, fld, mc, sat);
   return Query(runNo, mode, Conditions(sys, sNN, fld, mc, sat));
 }
 
+//____________________________________________________________________
+Bool_t
+AliOADBForward::Table::BuildIndex() const
+{
+  // 
+  // Build the in-memory index of the table: the run numbers and
+  // conditions of all rows (but not the correction objects) are read
+  // once, and sorted on run number, and then on entry number.
+  //
+  if (!IsOpen()) return false;
+  Int_t n = fTree->GetEntries();
+  if (n == fNIndexed) return true;
+
+  fNIndexed = -1;
+  fIdxRun.Set(n);
+  fIdxEntry.Set(n);
+  fIdxSys.Set(n);
+  fIdxSNN.Set(n);
+  fIdxField.Set(n);
+  fIdxFlags.Set(n);
+  if (n <= 0) {
+    fNIndexed = 0;
+    return true;
+  }
+
+  if (fTree->GetEstimate() < n) fTree->SetEstimate(n);
+  if (fTree->Draw("fRunNo:fSys:fSNN:fField", "", "goff") != n) {
+    Warning("BuildIndex", "Failed to read conditions of %s", GetName());
+    return false;
+  }
+  // Sort key: run number in the upper, entry number in the lower bits
+  TArrayL64 keys(n);
+  TArrayI   sys(n), sNN(n), fld(n), flags(n);
+  for (Int_t i = 0; i < n; i++) {
+    keys[i] = (Long64_t(fTree->GetV1()[i]) << 31) | i;
+    sys[i]  = Int_t(fTree->GetV2()[i]);
+    sNN[i]  = Int_t(fTree->GetV3()[i]);
+    fld[i]  = Int_t(fTree->GetV4()[i]);
+  }
+  if (fTree->Draw("fMC:fSatellite", "", "goff") != n) {
+    Warning("BuildIndex", "Failed to read flags of %s", GetName());
+    return false;
+  }
+  for (Int_t i = 0; i < n; i++) 
+    flags[i] = ((fTree->GetV1()[i] != 0 ? 0x1 : 0) | 
+		(fTree->GetV2()[i] != 0 ? 0x2 : 0));
+
+  TArrayI order(n);
+  TMath::Sort(n, keys.GetArray(), order.GetArray(), false);
+  for (Int_t i = 0; i < n; i++) { 
+    Int_t j       = order[i];
+    fIdxRun[i]    = keys[j] >> 31;
+    fIdxEntry[i]  = j;
+    fIdxSys[i]    = sys[j];
+    fIdxSNN[i]    = sNN[j];
+    fIdxField[i]  = fld[j];
+    fIdxFlags[i]  = flags[j];
+  }
+  fNIndexed = n;
+  if (fVerbose) Printf("%s: Indexed %d entries", GetName(), n);
+  return true;
+}
+
+//____________________________________________________________________
+void
+AliOADBForward::Table::ClearCache()
+{
+  // 
+  // Forget the index and the entries read so far.  The correction
+  // objects are left alone, since clients may hold on to them.
+  //
+  fNIndexed = -1;
+  fCache.Delete();
+}
+
+//____________________________________________________________________
+Bool_t
+AliOADBForward::Table::IsMatch(Int_t    i,
+			       UShort_t sys,
+			       UShort_t sNN, 
+			       Short_t  fld,
+			       Bool_t   mc,
+			       Bool_t   sat) const
+{
+  // 
+  // Check if indexed row matches the conditions.  This must be kept
+  // in sync with AliOADBForward::Conditions
+  //
+  if (sys > 0 && fIdxSys[i] != sys)                      return false;
+  if (sNN > 0 && TMath::Abs(fIdxSNN[i] - sNN) >= 11)     return false;
+  if (TMath::Abs(fld) < 10 && fIdxField[i] != fld)       return false;
+  if (((fIdxFlags[i] & 0x1) != 0) != mc)                 return false;
+  if (((fIdxFlags[i] & 0x2) != 0) != sat)                return false;
+  return true;
+}
+
+//____________________________________________________________________
+Int_t
+AliOADBForward::Table::FindRun(ULong_t runNo, Bool_t upper) const
+{
+  // 
+  // Binary search for the first indexed row with run number not
+  // smaller than (upper=false) or larger than (upper=true) runNo
+  //
+  Int_t lo = 0;
+  Int_t hi = fNIndexed;
+  while (lo < hi) { 
+    Int_t    mid = (lo + hi) / 2;
+    Long64_t run = fIdxRun[mid];
+    if (run < Long64_t(runNo) || (upper && run == Long64_t(runNo))) 
+      lo = mid + 1;
+    else 
+      hi = mid;
+  }
+  return lo;
+}
+
+//____________________________________________________________________
+Int_t
+AliOADBForward::Table::Lookup(ULong_t        runNo,
+			      ERunSelectMode mode,
+			      UShort_t       sys,
+			      UShort_t       sNN, 
+			      Short_t        fld,
+			      Bool_t         mc,
+			      Bool_t         sat) const
+{
+  // 
+  // Look up the entry selected by the query using the index.  This
+  // gives the same result as Query(runNo,mode,Conditions(...)): of
+  // the matching rows, the one with the best run number according
+  // to the mode is selected, and for equally good rows the latest
+  // entry.
+  //
+  Int_t n     = fNIndexed;
+  Int_t entry = -1;
+  if (runNo > 0) {
+    if (mode <= kDefault || mode > kNewer) mode = fMode;
+    if (mode == kDefault) Fatal("Lookup", "Mode should never be 'default'");
+  }
+  else if (mode != kNewest && mode != kOlder && mode != kNewer) {
+    // No run number given - take the last matching entry
+    for (Int_t i = 0; i < n; i++) 
+      if (fIdxEntry[i] > entry && IsMatch(i, sys, sNN, fld, mc, sat))
+	entry = fIdxEntry[i];
+    if (fVerbose) Printf("%s: Look-up returns entry # %d", GetName(), entry);
+    return entry;
+  }
+
+  // Rows of the same run are sorted on entry number, so walking down
+  // the first match is the latest entry of that run, while walking
+  // up we need to continue to the end of the run.
+  switch (mode) { 
+  case kExact: {
+    Int_t i = FindRun(runNo, true);
+    while (--i >= 0 && fIdxRun[i] == Long64_t(runNo)) {
+      if (!IsMatch(i, sys, sNN, fld, mc, sat)) continue;
+      entry = fIdxEntry[i];
+      break;
+    }
+  }
+    break;
+  case kNewest: // Fall-through 
+  case kOlder: {
+    Int_t i = (mode == kOlder && runNo > 0 ? FindRun(runNo, true) : n);
+    while (--i >= 0) {
+      if (!IsMatch(i, sys, sNN, fld, mc, sat)) continue;
+      entry = fIdxEntry[i];
+      break;
+    }
+  }
+    break;
+  case kNewer: {
+    Int_t i = (runNo > 0 ? FindRun(runNo, false) : 0);
+    for (; i < n; i++) 
+      if (IsMatch(i, sys, sNN, fld, mc, sat)) break;
+    if (i >= n) break;
+    Long64_t run = fIdxRun[i];
+    for (; i < n && fIdxRun[i] == run; i++) 
+      if (IsMatch(i, sys, sNN, fld, mc, sat)) entry = fIdxEntry[i];
+  }
+    break;
+  case kNear: {
+    // Best candidate at or below, and above the given run 
+    Int_t    j    = FindRun(runNo, true);
+    Int_t    lo   = j;
+    Int_t    eLo  = -1;
+    Long64_t dLo  = 0;
+    while (--lo >= 0) {
+      if (!IsMatch(lo, sys, sNN, fld, mc, sat)) continue;
+      dLo = Long64_t(runNo) - fIdxRun[lo];
+      if (dLo <= kMaxNearDistance) eLo = fIdxEntry[lo];
+      break;
+    }
+    Int_t    hi   = j;
+    Int_t    eHi  = -1;
+    Long64_t dHi  = 0;
+    for (; hi < n; hi++) 
+      if (IsMatch(hi, sys, sNN, fld, mc, sat)) break;
+    if (hi < n) {
+      Long64_t run = fIdxRun[hi];
+      dHi = run - Long64_t(runNo);
+      if (dHi <= kMaxNearDistance) {
+	for (; hi < n && fIdxRun[hi] == run; hi++) 
+	  if (IsMatch(hi, sys, sNN, fld, mc, sat)) eHi = fIdxEntry[hi];
+      }
+    }
+    if      (eHi < 0)   entry = eLo;
+    else if (eLo < 0)   entry = eHi;
+    else if (dLo < dHi) entry = eLo;
+    else if (dHi < dLo) entry = eHi;
+    else                entry = TMath::Max(eLo, eHi);
+  }
+    break;
+  case kDefault:
+    break;
+  }
+  if (fVerbose) 
+    Printf("%s: Look-up for run %lu (%s) returns entry # %d", 
+	   GetName(), runNo, Mode2String(mode), entry);
+  return entry;
+}
+
 //____________________________________________________________________
 Int_t
 AliOADBForward::Table::Query(ULong_t        runNo,
@@ -558,13 +803,30 @@ AliOADBForward::Table::Get(ULong_t        run,
   Int_t entry  = GetEntry(run, mode, sys, sNN, fld, mc, sat);
   if (entry < 0) return 0;
 
+  // Entries already read are kept, so that jobs going through many
+  // runs do not read and decode the same object again and again
+  Entry* e = 0;
+  if (entry < fCache.GetSize()) 
+    e = static_cast<Entry*>(fCache.UncheckedAt(entry));
+  if (e) { 
+    if (fVerbose) e->Print();
+    return e;
+  }
+
   Int_t nBytes = fTree->GetEntry(entry);
   if (nBytes <= 0) { 
     Warning("Get", "Failed to get entry # %d\n", entry);
     return 0;
   }
   if (fVerbose) fEntry->Print();
-  return fEntry;
+
+  // Take over the read entry and its object, so that the next read
+  // does not overwrite it
+  e = new Entry;
+  *e = *fEntry;
+  fEntry->fData = 0;
+  fCache.AddAtAndExpand(e, entry);
+  return e;
 }
 //____________________________________________________________________
 TObject*
@@ -4,6 +4,9 @@
 #include <TNamed.h>
 #include <TString.h>
 #include <TMap.h>
+#include <TObjArray.h>
+#include <TArrayI.h>
+#include <TArrayL64.h>
 class TFile;
 class TTree;
 class TBrowser;
@@ -418,14 +421,95 @@ public:
      * @return true if everything is dandy
      */
     Bool_t IsOpen(Bool_t rw=false) const; 
+    // -----------------------------------------------------------------
+    /** 
+     * @{ 
+     * @name Index and cache 
+     */
+    /** 
+     * Build the in-memory index of the table.  The run number and
+     * conditions of all rows are read once and sorted on run number,
+     * so that queries do not have to scan the tree.  This is done
+     * automatically on the first query, and again if the number of
+     * rows has changed since.
+     * 
+     * @return true if the index is usable 
+     */
+    Bool_t BuildIndex() const;
+    /** 
+     * Clear the index and the cache of entries read by Get.  The
+     * correction objects themselves are not deleted, as clients may
+     * still refer to them.
+     */
+    void ClearCache();
+    /* @} */
 
     TTree*         fTree;     // Our tree
     Entry*         fEntry;    // Entry cache 
     Bool_t         fVerbose;  // To be verbose or not 
     ERunSelectMode fMode;     // Run query mode 
     Bool_t         fFallBack; // Enable fall-back
+  protected:
+    /** 
+     * Look up an entry using the index 
+     * 
+     * @param runNo  Run number 
+     * @param mode   Run selection mode 
+     * @param sys    Collision system (1: pp, 2: PbPb, 3: pPb)
+     * @param sNN    Center of mass energy (GeV)
+     * @param fld    L3 magnetic field (kG)
+     * @param mc     For MC only 
+     * @param sat    For satellite events
+     * 
+     * @return Entry number of selected entry, or -1
+     */
+    Int_t Lookup(ULong_t        runNo,
+		 ERunSelectMode mode,
+		 UShort_t       sys,
+		 UShort_t       sNN, 
+		 Short_t        fld,
+		 Bool_t         mc,
+		 Bool_t         sat) const;
+    /** 
+     * Check if an indexed row fulfills the conditions (see
+     * AliOADBForward::Conditions)
+     * 
+     * @param i      Index of row 
+     * @param sys    Collision system (1: pp, 2: PbPb, 3: pPb)
+     * @param sNN    Center of mass energy (GeV)
+     * @param fld    L3 magnetic field (kG)
+     * @param mc     For MC only 
+     * @param sat    For satellite events
+     * 
+     * @return true if the row matches 
+     */
+    Bool_t IsMatch(Int_t    i,
+		   UShort_t sys,
+		   UShort_t sNN, 
+		   Short_t  fld,
+		   Bool_t   mc,
+		   Bool_t   sat) const;
+    /** 
+     * Find the first indexed row with a run number not smaller than
+     * (or, if @a upper is true, larger than) the given run
+     * 
+     * @param runNo Run number 
+     * @param upper If true, find first row with larger run number 
+     * 
+     * @return Index of row, or number of indexed rows 
+     */
+    Int_t FindRun(ULong_t runNo, Bool_t upper) const;
+
+    mutable Int_t     fNIndexed;   //! Number of tree entries indexed 
+    mutable TArrayL64 fIdxRun;     //! Run numbers of rows, sorted
+    mutable TArrayI   fIdxEntry;   //! Entry numbers of sorted rows 
+    mutable TArrayI   fIdxSys;     //! Collision systems of sorted rows
+    mutable TArrayI   fIdxSNN;     //! Energies of sorted rows
+    mutable TArrayI   fIdxField;   //! Fields of sorted rows 
+    mutable TArrayI   fIdxFlags;   //! MC (bit 0) and satellite (bit 1) flags
+    mutable TObjArray fCache;      //! Entries read by Get, by entry number
 
-    ClassDef(Table,1); 
+    ClassDef(Table,2); 
   };
   // === Interface ===================================================
   /** 
@@ -13,11 +13,13 @@
 // Developers: F. Bellini (fbellini@cern.ch)
 //
 
+#include <algorithm>
 #include <Riostream.h>
 
 #include <TH1.h>
 #include <TList.h>
-#include <TTree.h>
+#include <TArrayI.h>
+#include <TArrayL64.h>
 #include <TStopwatch.h>
 #include "TRandom.h"
 
@@ -40,6 +42,7 @@
 #include "AliRsnCutSet.h"
 #include "AliRsnMiniPair.h"
 #include "AliRsnMiniEvent.h"
+#include "AliRsnMiniEventStore.h"
 #include "AliRsnMiniParticle.h"
 
 #include "AliRsnMiniAnalysisTask.h"
@@ -77,7 +80,7 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
    fEventCuts(0x0),
    fTrackCuts(0),
    fRsnEvent(),
-   fEvBuffer(0x0),
+   fEvStore(0x0),
    fTriggerAna(0x0),
    fESDtrackCuts(0x0),
    fMiniEvent(0x0),
@@ -129,7 +132,7 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const char *name, Bool_t useMC) :
    fEventCuts(0x0),
    fTrackCuts(0),
    fRsnEvent(),
-   fEvBuffer(0x0),
+   fEvStore(0x0),
    fTriggerAna(0x0),
    fESDtrackCuts(0x0),
    fMiniEvent(0x0),
@@ -186,7 +189,7 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const AliRsnMiniAnalysisTask &cop
    fEventCuts(copy.fEventCuts),
    fTrackCuts(copy.fTrackCuts),
    fRsnEvent(),
-   fEvBuffer(0x0),
+   fEvStore(0x0),
    fTriggerAna(copy.fTriggerAna),
    fESDtrackCuts(copy.fESDtrackCuts),
    fMiniEvent(0x0),
@@ -276,7 +279,7 @@ AliRsnMiniAnalysisTask::~AliRsnMiniAnalysisTask()
 
    if (fOutput && !AliAnalysisManager::GetAnalysisManager()->IsProofMode()) {
       delete fOutput;
-      delete fEvBuffer;
+      delete fEvStore;
    }
 }
 
@@ -372,10 +375,10 @@ void AliRsnMiniAnalysisTask::UserCreateOutputObjects()
       cs->Init(fOutput);
    }
 
-   // create temporary tree for filtered events
+   // create temporary buffer for filtered events
    if (fMiniEvent) delete fMiniEvent;
-   fEvBuffer = new TTree("EventBuffer", "Temporary buffer for mini events");
-   fEvBuffer->Branch("events", "AliRsnMiniEvent", &fMiniEvent);
+   fMiniEvent = 0x0;
+   fEvStore = new AliRsnMiniEventStore;
 
    // create one histogram per each stored definition (event histograms)
    Int_t i, ndef = fHistograms.GetEntries();
@@ -432,10 +435,10 @@ void AliRsnMiniAnalysisTask::UserExec(Option_t *)
    if (fMiniEvent->IsEmpty()) {
       AliDebugClass(2, Form("Rejecting empty event #%d", fEvNum));
    } else {
-      Int_t id = fEvBuffer->GetEntries();
+      Int_t id = fEvStore->GetNEvents();
       AliDebugClass(2, Form("Adding event #%d with ID = %d", fEvNum, id));
       fMiniEvent->ID() = id;
-      fEvBuffer->Fill();
+      fEvStore->Add(fMiniEvent);
    }
 
    // post data for computed stuff
@@ -452,16 +455,24 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
 // Here a loop is done on each of these events, and both single-event and mixing are computed
 //
 
-   // security code: reassign the buffer to the mini-event cursor
-   fEvBuffer->SetBranchAddress("events", &fMiniEvent);
+   // the mini-event cursor is re-used to read events from the buffer
+   if (!fMiniEvent) fMiniEvent = new AliRsnMiniEvent;
    TStopwatch timer;
    // prepare variables
-   Int_t ievt, nEvents = (Int_t)fEvBuffer->GetEntries();
+   Int_t ievt, nEvents = fEvStore->GetNEvents();
    Int_t idef, nDefs   = fHistograms.GetEntries();
-   Int_t imix, iloop, ifill;
+   Int_t imix, ifill, k, igroup;
    AliRsnMiniOutput *def = 0x0;
    AliRsnMiniOutput::EComputation compType;
 
+   // group the pair definitions which select the daughters in the same way,
+   // so that each group builds its pairs only once per event
+   AliRsnMiniOutput **pairDefs = new AliRsnMiniOutput*[nDefs + 1];
+   AliRsnMiniOutput **mixDefs  = new AliRsnMiniOutput*[nDefs + 1];
+   TArrayI pairStart, mixStart;
+   Int_t nPairGroups = GroupPairDefinitions(kFALSE, pairDefs, pairStart);
+   Int_t nMixGroups  = GroupPairDefinitions(kTRUE, mixDefs, mixStart);
+
    Int_t printNum = fMixPrintRefresh;
    if (printNum < 0) {
       if (nEvents>1e5) printNum=nEvents/100;
@@ -476,132 +487,77 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    timer.Start();
    for (ievt = 0; ievt < nEvents; ievt++) {
       // get next entry
-      fEvBuffer->GetEntry(ievt);
+      fEvStore->Load(ievt, fMiniEvent);
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] Std.Event %d/%d",GetName(), ievt,nEvents));
          timer.Stop(); timer.Print(); fflush(stdout); timer.Start(kFALSE);
       }
-      // fill
+      // fill event-based outputs
       for (idef = 0; idef < nDefs; idef++) {
          def = (AliRsnMiniOutput *)fHistograms[idef];
          if (!def) continue;
          compType = def->GetComputation();
-         // execute computation in the appropriate way
-         switch (compType) {
-            case AliRsnMiniOutput::kEventOnly:
-               //AliDebugClass(1, Form("Event %d, def '%s': event-value histogram filling", ievt, def->GetName()));
-               ifill = 1;
-               def->FillEvent(fMiniEvent, &fValues);
-               break;
-            case AliRsnMiniOutput::kTruePair:
-               //AliDebugClass(1, Form("Event %d, def '%s': true-pair histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
-            case AliRsnMiniOutput::kTrackPair:
-               //AliDebugClass(1, Form("Event %d, def '%s': pair-value histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
-            case AliRsnMiniOutput::kTrackPairRotated1:
-               //AliDebugClass(1, Form("Event %d, def '%s': rotated (1) background histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
-            case AliRsnMiniOutput::kTrackPairRotated2:
-               //AliDebugClass(1, Form("Event %d, def '%s': rotated (2) background histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
-               break;
-            default:
-               // other kinds are processed elsewhere
-               ifill = 0;
-               AliDebugClass(2, Form("Computation = %d", (Int_t)compType));
+         if (compType != AliRsnMiniOutput::kEventOnly) {
+            // pairs are processed below, other kinds elsewhere
+            AliDebugClass(2, Form("Computation = %d", (Int_t)compType));
+            continue;
          }
-         // message
-         AliDebugClass(1, Form("Event %6d: def = '%15s' -- fills = %5d", ievt, def->GetName(), ifill));
+         def->FillEvent(fMiniEvent, &fValues);
+         AliDebugClass(1, Form("Event %6d: def = '%15s' -- fills = %5d", ievt, def->GetName(), 1));
+      }
+      // fill pair-based outputs (track pairs, true pairs, rotated background)
+      for (igroup = 0; igroup < nPairGroups; igroup++) {
+         k = pairStart[igroup];
+         ifill = AliRsnMiniOutput::FillPairs(pairStart[igroup + 1] - k, pairDefs + k, fMiniEvent, fMiniEvent, &fValues);
+         AliDebugClass(1, Form("Event %6d: defs = %d from '%15s' -- fills = %5d", ievt, pairStart[igroup + 1] - k, pairDefs[k]->GetName(), ifill));
       }
    }
 
    // if no mixing is required, stop here and post the output
-   if (fNMix < 1) {
+   if (fNMix < 1 || nMixGroups < 1) {
       AliDebugClass(2, "Stopping here, since no mixing is required");
+      delete [] pairDefs;
+      delete [] mixDefs;
       PostData(1, fOutput);
       return;
    }
 
-   // initialize mixing counter
-   Int_t    nmatched[nEvents];
-   TString *smatched = new TString[nEvents];
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      smatched[ievt] = "|";
-      nmatched[ievt] = 0;
-   }
-
-
    AliInfo(Form("[%s] Std.Event %d/%d",GetName(), nEvents,nEvents));
    timer.Stop(); timer.Print(); timer.Start(); fflush(stdout);
 
    // search for good matchings
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      if (printNum&&(ievt%printNum==0)) {
-         AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),ievt,nEvents));
-         timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
-      }
-      if (nmatched[ievt] >= fNMix) continue;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      for (iloop = 1; iloop < nEvents; iloop++) {
-         imix = ievt + iloop;
-         if (imix >= nEvents) imix -= nEvents;
-         if (imix == ievt) continue;
-         // text next entry
-         fEvBuffer->GetEntry(imix);
-         // skip if events are not matched
-         if (!EventsMatch(&evMain, fMiniEvent)) continue;
-         // check that the array of good matches for mixed does not already contain main event
-         if (smatched[imix].Contains(Form("|%d|", ievt))) continue;
-         // check that the found good events has not enough matches already
-         if (nmatched[imix] >= fNMix) continue;
-         // add new mixing candidate
-         smatched[ievt].Append(Form("%d|", imix));
-         nmatched[ievt]++;
-         nmatched[imix]++;
-         if (nmatched[ievt] >= fNMix) break;
-      }
-      AliDebugClass(1, Form("Matches for event %5d = %d [%s] (missing are declared above)", evMain.ID(), nmatched[ievt], smatched[ievt].Data()));
-   }
+   TArrayI matches, nchosen;
+   FindMixingMatches(matches, nchosen, printNum);
 
    AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout); timer.Start();
 
    // perform mixing
-   TObjArray *list = 0x0;
-   TObjString *os = 0x0;
+   AliRsnMiniEvent evMain;
    for (ievt = 0; ievt < nEvents; ievt++) {
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] EventMixing %d/%d",GetName(),ievt,nEvents));
          timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
       }
       ifill = 0;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      list = smatched[ievt].Tokenize("|");
-      TObjArrayIter next(list);
-      while ( (os = (TObjString *)next()) ) {
-         imix = os->GetString().Atoi();
-         fEvBuffer->GetEntry(imix);
-         for (idef = 0; idef < nDefs; idef++) {
-            def = (AliRsnMiniOutput *)fHistograms[idef];
-            if (!def) continue;
-            if (!def->IsTrackPairMix()) continue;
-            ifill += def->FillPair(&evMain, fMiniEvent, &fValues, kTRUE);
-            if (!def->IsSymmetric()) {
+      if (nchosen[ievt] < 1) continue;
+      fEvStore->Load(ievt, &evMain);
+      for (k = 0; k < nchosen[ievt]; k++) {
+         imix = matches[ievt * fNMix + k];
+         fEvStore->Load(imix, fMiniEvent);
+         for (igroup = 0; igroup < nMixGroups; igroup++) {
+            idef = mixStart[igroup];
+            ifill += AliRsnMiniOutput::FillPairs(mixStart[igroup + 1] - idef, mixDefs + idef, &evMain, fMiniEvent, &fValues, kTRUE);
+            if (!mixDefs[idef]->IsSymmetric()) {
                AliDebugClass(2, "Reflecting non symmetric pair");
-               ifill += def->FillPair(fMiniEvent, &evMain, &fValues, kFALSE);
+               ifill += AliRsnMiniOutput::FillPairs(mixStart[igroup + 1] - idef, mixDefs + idef, fMiniEvent, &evMain, &fValues, kFALSE);
             }
          }
       }
-      delete list;
    }
 
-   delete [] smatched;
+   delete [] pairDefs;
+   delete [] mixDefs;
 
    AliInfo(Form("[%s] EventMixing %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout);
@@ -1376,6 +1332,42 @@ void AliRsnMiniAnalysisTask::SetDselection(UShort_t originDselection)
 	
 	return;	
 }
+//__________________________________________________________________________________________________
+Int_t AliRsnMiniAnalysisTask::GroupPairDefinitions(Bool_t mix, AliRsnMiniOutput **defs, TArrayI &start)
+{
+//
+// Collect the pair-based definitions (mixing ones if 'mix' is true,
+// the same-event ones otherwise) into groups which share the daughter selection.
+// The definitions of group 'i' are defs[start[i]] ... defs[start[i + 1] - 1],
+// in the order they were added to the task; returns the number of groups.
+//
+
+   Int_t i, j, n = 0, ngroups = 0, nDefs = fHistograms.GetEntries();
+   AliRsnMiniOutput *def = 0x0, *other = 0x0;
+   TArrayI use(nDefs);
+   for (i = 0; i < nDefs; i++) {
+      def = (AliRsnMiniOutput *)fHistograms[i];
+      use[i] = (def && def->IsPairComputation() && def->IsTrackPairMix() == mix) ? 1 : 0;
+   }
+
+   start.Set(nDefs + 1);
+   for (i = 0; i < nDefs; i++) {
+      if (!use[i]) continue;
+      def = (AliRsnMiniOutput *)fHistograms[i];
+      start[ngroups++] = n;
+      for (j = i; j < nDefs; j++) {
+         if (!use[j]) continue;
+         other = (AliRsnMiniOutput *)fHistograms[j];
+         if (!def->IsSamePairSelection(other)) continue;
+         defs[n++] = other;
+         use[j] = 0;
+      }
+   }
+   start[ngroups] = n;
+
+   return ngroups;
+}
+
 //__________________________________________________________________________________________________
 Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2)
 {
@@ -1387,33 +1379,34 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
 //
 
    if (!event1 || !event2) return kFALSE;
+   return EventsMatch(event1->Vz(), event1->Mult(), event1->Angle(), event2->Vz(), event2->Mult(), event2->Angle());
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniAnalysisTask::EventsMatch(Float_t vz1, Float_t mult1, Float_t angle1, Float_t vz2, Float_t mult2, Float_t angle2)
+{
+//
+// Check if two events are compatible, from the values of the mixing variables.
+//
+
    Int_t ivz1, ivz2, imult1, imult2, iangle1, iangle2;
    Double_t dv, dm, da;
 
    if (fContinuousMix) {
-      dv = TMath::Abs(event1->Vz()    - event2->Vz()   );
-      dm = TMath::Abs(event1->Mult()  - event2->Mult() );
-      da = TMath::Abs(event1->Angle() - event2->Angle());
-      if (dv > fMaxDiffVz) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Vz = %f", event1->ID(), event2->ID(), dv));
-         return kFALSE;
-      }
-      if (dm > fMaxDiffMult ) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Mult = %f", event1->ID(), event2->ID(), dm));
-         return kFALSE;
-      }
-      if (da > fMaxDiffAngle) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Angle = %f", event1->ID(), event2->ID(), da));
-         return kFALSE;
-      }
+      dv = TMath::Abs(vz1    - vz2   );
+      dm = TMath::Abs(mult1  - mult2 );
+      da = TMath::Abs(angle1 - angle2);
+      if (dv > fMaxDiffVz) return kFALSE;
+      if (dm > fMaxDiffMult ) return kFALSE;
+      if (da > fMaxDiffAngle) return kFALSE;
       return kTRUE;
    } else {
-      ivz1 = (Int_t)(event1->Vz() / fMaxDiffVz);
-      ivz2 = (Int_t)(event2->Vz() / fMaxDiffVz);
-      imult1 = (Int_t)(event1->Mult() / fMaxDiffMult);
-      imult2 = (Int_t)(event2->Mult() / fMaxDiffMult);
-      iangle1 = (Int_t)(event1->Angle() / fMaxDiffAngle);
-      iangle2 = (Int_t)(event2->Angle() / fMaxDiffAngle);
+      ivz1 = (Int_t)(vz1 / fMaxDiffVz);
+      ivz2 = (Int_t)(vz2 / fMaxDiffVz);
+      imult1 = (Int_t)(mult1 / fMaxDiffMult);
+      imult2 = (Int_t)(mult2 / fMaxDiffMult);
+      iangle1 = (Int_t)(angle1 / fMaxDiffAngle);
+      iangle2 = (Int_t)(angle2 / fMaxDiffAngle);
       if (ivz1 != ivz2) return kFALSE;
       if (imult1 != imult2) return kFALSE;
       if (iangle1 != iangle2) return kFALSE;
@@ -1421,6 +1414,185 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
    }
 }
 
+//__________________________________________________________________________________________________
+Long64_t AliRsnMiniAnalysisTask::MixingCell(Float_t value, Double_t maxDiff)
+{
+//
+// Cell of one mixing variable, used to group events before matching them.
+// In binned mixing this is the mixing bin itself, in continuous mixing
+// the cells are slightly larger than the maximum difference, so that
+// compatible events are always in the same or in adjacent cells.
+// Cells are limited to 21 bits; when the maximum difference is not
+// usable as cell width all events share cell 0.
+//
+
+   const Double_t maxCell = 1048575.0;
+   if (!(maxDiff > 0.0) || !(maxDiff < 1E10)) return 0;
+
+   Double_t q;
+   if (fContinuousMix) {
+      q = TMath::Floor(value / (maxDiff * (1.0 + 1E-5)));
+   } else {
+      q = value / maxDiff;
+      q = (q < 0.0) ? TMath::Ceil(q) : TMath::Floor(q);
+   }
+   if (!(q > -maxCell)) q = -maxCell;
+   if (!(q <  maxCell)) q =  maxCell;
+
+   return (Long64_t)q;
+}
+
+//__________________________________________________________________________________________________
+static Int_t NextAlive(Int_t *next, Int_t pos)
+{
+//
+// First position >= pos whose event still needs mixing partners
+// (positions of events with enough partners point beyond themselves).
+//
+
+   Int_t last = pos;
+   while (next[last] != last) last = next[last];
+   while (next[pos] != last) {
+      Int_t tmp = next[pos];
+      next[pos] = last;
+      pos = tmp;
+   }
+   return last;
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::FindMixingMatches(TArrayI &matches, TArrayI &nchosen, Int_t printNum)
+{
+//
+// Search for mixing partners of all buffered events.
+// For each event, candidates are tried in the order ievt+1, ievt+2, ... (cyclic),
+// and accepted if they match, still need partners and were not already paired
+// with this event; the search stops when fNMix partners are found.
+// Instead of testing all events, only those in the same cell of vz, mult and angle
+// (binned mixing) or in the adjacent ones (continuous mixing) are tried,
+// and events which have already enough partners are skipped.
+// The partners chosen by event 'ievt' are stored in matches[ievt * fNMix + k],
+// for k < nchosen[ievt].
+//
+
+   Int_t i, k, ievt, imix, nEvents = fEvStore->GetNEvents();
+   matches.Set(nEvents * fNMix);
+   nchosen.Set(nEvents);
+   nchosen.Reset();
+   if (nEvents < 1) return;
+   TArrayI nmatched(nEvents);
+
+   // cell of each event, packed in one key
+   const Long64_t cellOffset = 1048576, cellBits = 21;
+   TArrayL64 cell(3 * nEvents), key(nEvents);
+   for (i = 0; i < nEvents; i++) {
+      cell[3 * i]     = MixingCell(fEvStore->Vz(i), fMaxDiffVz) + cellOffset;
+      cell[3 * i + 1] = MixingCell(fEvStore->Mult(i), fMaxDiffMult) + cellOffset;
+      cell[3 * i + 2] = MixingCell(fEvStore->Angle(i), fMaxDiffAngle) + cellOffset;
+      key[i] = (((cell[3 * i] << cellBits) | cell[3 * i + 1]) << cellBits) | cell[3 * i + 2];
+   }
+
+   // sort events by cell, keeping the event order inside each cell
+   TArrayI order(nEvents), pos(nEvents), next(nEvents + 1);
+   for (i = 0; i < nEvents; i++) order[i] = i;
+   std::stable_sort(order.GetArray(), order.GetArray() + nEvents, TMath::CompareAsc<const Long64_t *>(key.GetArray()));
+   TArrayL64 cellKey(nEvents);
+   TArrayI   cellStart(nEvents + 1);
+   Int_t     nCells = 0;
+   for (i = 0; i < nEvents; i++) {
+      pos[order[i]] = i;
+      next[i] = i;
+      if (i == 0 || key[order[i]] != cellKey[nCells - 1]) {
+         cellKey[nCells] = key[order[i]];
+         cellStart[nCells++] = i;
+      }
+   }
+   cellStart[nCells] = nEvents;
+   next[nEvents] = nEvents;
+
+   // the candidates of one event are read from (at most 27) cells, each one
+   // scanned first after the event index, then from the start of the cell
+   Double_t maxDiff[3] = {fMaxDiffVz, fMaxDiffMult, fMaxDiffAngle};
+   Int_t    span[3], ncur, icur, best, p, d, dbest, di[3];
+   Int_t    curPos[27], curEnd[27], curBegin[27], curSplit[27], curPhase[27];
+   Long64_t c[3], ckey;
+   for (k = 0; k < 3; k++) span[k] = (fContinuousMix && maxDiff[k] > 0.0 && maxDiff[k] < 1E10) ? 1 : 0;
+
+   for (ievt = 0; ievt < nEvents; ievt++) {
+      if (printNum&&(ievt%printNum==0)) {
+         AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),ievt,nEvents));
+         fflush(stdout);
+      }
+      if (nmatched[ievt] >= fNMix) continue;
+
+      // open one cursor per neighbouring cell
+      ncur = 0;
+      for (di[0] = -span[0]; di[0] <= span[0]; di[0]++) {
+         for (di[1] = -span[1]; di[1] <= span[1]; di[1]++) {
+            for (di[2] = -span[2]; di[2] <= span[2]; di[2]++) {
+               for (k = 0; k < 3; k++) c[k] = cell[3 * ievt + k] + di[k];
+               if (c[0] < 0 || c[1] < 0 || c[2] < 0 || c[0] >= 2 * cellOffset || c[1] >= 2 * cellOffset || c[2] >= 2 * cellOffset) continue;
+               ckey = (((c[0] << cellBits) | c[1]) << cellBits) | c[2];
+               i = TMath::BinarySearch(nCells, cellKey.GetArray(), ckey);
+               if (i < 0 || cellKey[i] != ckey) continue;
+               curBegin[ncur] = cellStart[i];
+               curEnd[ncur]   = cellStart[i + 1];
+               curSplit[ncur] = curBegin[ncur] + TMath::BinarySearch(curEnd[ncur] - curBegin[ncur], order.GetArray() + curBegin[ncur], ievt) + 1;
+               curPos[ncur]   = curSplit[ncur];
+               curPhase[ncur] = 0;
+               ncur++;
+            }
+         }
+      }
+
+      // merge the cursors in the cyclic order of event index
+      while (kTRUE) {
+         best = -1;
+         dbest = nEvents + 1;
+         for (icur = 0; icur < ncur; icur++) {
+            while (curPhase[icur] < 2) {
+               p = NextAlive(next.GetArray(), curPos[icur]);
+               if (p < curEnd[icur]) {
+                  curPos[icur] = p;
+                  break;
+               }
+               if (++curPhase[icur] == 1) {
+                  curPos[icur] = curBegin[icur];
+                  curEnd[icur] = curSplit[icur];
+               }
+            }
+            if (curPhase[icur] >= 2) continue;
+            d = order[curPos[icur]] - ievt;
+            if (d <= 0) d += nEvents;
+            if (d < dbest) {
+               dbest = d;
+               best = icur;
+            }
+         }
+         if (best < 0) break;
+         imix = order[curPos[best]++];
+         if (imix == ievt) continue;
+         // skip if events are not matched
+         if (!EventsMatch(fEvStore->Vz(ievt), fEvStore->Mult(ievt), fEvStore->Angle(ievt), fEvStore->Vz(imix), fEvStore->Mult(imix), fEvStore->Angle(imix))) continue;
+         // check that the good matches for mixed do not already contain main event
+         for (k = 0; k < nchosen[imix]; k++) if (matches[imix * fNMix + k] == ievt) break;
+         if (k < nchosen[imix]) continue;
+         // check that the found good events has not enough matches already
+         if (nmatched[imix] >= fNMix) continue;
+         // add new mixing candidate
+         matches[ievt * fNMix + nchosen[ievt]++] = imix;
+         nmatched[ievt]++;
+         nmatched[imix]++;
+         if (nmatched[imix] >= fNMix) next[pos[imix]] = pos[imix] + 1;
+         if (nmatched[ievt] >= fNMix) {
+            next[pos[ievt]] = pos[ievt] + 1;
+            break;
+         }
+      }
+      AliDebugClass(1, Form("Matches for event %5d = %d (%d chosen)", ievt, nmatched[ievt], nchosen[ievt]));
+   }
+}
+
 //---------------------------------------------------------------------
 Double_t AliRsnMiniAnalysisTask::ApplyCentralityPatchPbPb2011(){
   //This part rejects randomly events such that the centrality gets flat for LHC11h Pb-Pb data
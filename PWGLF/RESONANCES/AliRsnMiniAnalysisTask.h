@@ -24,9 +24,11 @@
 #include "AliRsnCutPrimaryVertex.h"
 
 class TList;
+class TArrayI;
 
 class AliTriggerAnalysis;
 class AliRsnMiniEvent;
+class AliRsnMiniEventStore;
 class AliRsnCutSet;
 
 class AliRsnMiniAnalysisTask : public AliAnalysisTaskSE {
@@ -95,6 +97,10 @@ private:
    void     FillTrueMotherAOD(AliRsnMiniEvent *event);
    void     StoreTrueMother(AliRsnMiniPair *pair, AliRsnMiniEvent *event);
    Bool_t   EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2);
+   Bool_t   EventsMatch(Float_t vz1, Float_t mult1, Float_t angle1, Float_t vz2, Float_t mult2, Float_t angle2);
+   Long64_t MixingCell(Float_t value, Double_t maxDiff);
+   void     FindMixingMatches(TArrayI &matches, TArrayI &nchosen, Int_t printNum);
+   Int_t    GroupPairDefinitions(Bool_t mix, AliRsnMiniOutput **defs, TArrayI &start);
 
    Bool_t               fUseMC;           //  use or not MC info
    Int_t                fEvNum;           //! absolute event counter
@@ -126,7 +132,7 @@ private:
    AliRsnCutSet        *fEventCuts;       //  cuts on events
    TObjArray            fTrackCuts;       //  list of single track cuts
    AliRsnEvent          fRsnEvent;        //! interface object to the event
-   TTree               *fEvBuffer;        //! mini-event buffer
+   AliRsnMiniEventStore *fEvStore;        //! mini-event buffer
    AliTriggerAnalysis  *fTriggerAna;      //! trigger analysis
    AliESDtrackCuts     *fESDtrackCuts;    //! quality cut for ESD tracks
    AliRsnMiniEvent     *fMiniEvent;       //! mini-event cursor
@@ -144,7 +150,7 @@ private:
    Float_t              fMotherAcceptanceCutMaxEta;             // cut value to apply when selecting the mothers inside a defined acceptance
    Bool_t               fKeepMotherInAcceptance;                // flag to keep also mothers in acceptance
 
-   ClassDef(AliRsnMiniAnalysisTask, 12);   // AliRsnMiniAnalysisTask
+   ClassDef(AliRsnMiniAnalysisTask, 13);   // AliRsnMiniAnalysisTask
 };
 
 
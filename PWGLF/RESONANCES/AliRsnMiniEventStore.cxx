@@ -0,0 +1,127 @@
+//
+// In-memory buffer of mini-events.
+// The particles of all events are kept in one flat array,
+// with the offset of the first particle of each event,
+// and the event variables used for mixing in plain arrays.
+// An event is retrieved by copying its particles into
+// a mini-event, without any deserialization.
+//
+
+#include <TMath.h>
+
+#include "AliRsnMiniParticle.h"
+#include "AliRsnMiniEvent.h"
+#include "AliRsnMiniEventStore.h"
+
+ClassImp(AliRsnMiniEventStore)
+
+//__________________________________________________________________________________________________
+AliRsnMiniEventStore::AliRsnMiniEventStore() :
+   TObject(),
+   fNEvents(0),
+   fNParticles(0),
+   fOffset(1),
+   fVz(0),
+   fMult(0),
+   fRefMult(0),
+   fTracklets(0),
+   fAngle(0),
+   fParticles("AliRsnMiniParticle", 0)
+{
+//
+// Constructor
+//
+}
+
+//__________________________________________________________________________________________________
+AliRsnMiniEventStore::~AliRsnMiniEventStore()
+{
+//
+// Destructor
+//
+
+   fParticles.Delete();
+}
+
+//__________________________________________________________________________________________________
+Int_t AliRsnMiniEventStore::Add(AliRsnMiniEvent *event)
+{
+//
+// Append a copy of the event and its particles,
+// and return its index in the store
+//
+
+   if (!event) return -1;
+
+   Int_t id = fNEvents;
+   if (id + 1 >= fOffset.GetSize()) {
+      Int_t size = TMath::Max(1024, 2 * fOffset.GetSize());
+      fOffset.Set(size + 1);
+      fVz.Set(size);
+      fMult.Set(size);
+      fRefMult.Set(size);
+      fTracklets.Set(size);
+      fAngle.Set(size);
+   }
+   fVz[id]        = event->Vz();
+   fMult[id]      = event->Mult();
+   fRefMult[id]   = event->RefMult();
+   fTracklets[id] = event->Tracklets();
+   fAngle[id]     = event->Angle();
+
+   TClonesArray &particles = event->Particles();
+   Int_t i, n = particles.GetEntriesFast();
+   for (i = 0; i < n; i++) {
+      new (fParticles[fNParticles]) AliRsnMiniParticle(*(AliRsnMiniParticle *)particles.UncheckedAt(i));
+      fNParticles++;
+   }
+   fOffset[id + 1] = fNParticles;
+   fNEvents++;
+
+   return id;
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniEventStore::Load(Int_t i, AliRsnMiniEvent *event) const
+{
+//
+// Copy the event with index 'i' into the passed mini-event,
+// replacing its content
+//
+
+   if (!event || i < 0 || i >= fNEvents) return kFALSE;
+
+   event->ID()        = i;
+   event->Vz()        = fVz[i];
+   event->Mult()      = fMult[i];
+   event->RefMult()   = fRefMult[i];
+   event->Tracklets() = fTracklets[i];
+   event->Angle()     = fAngle[i];
+
+   TClonesArray &particles = event->Particles();
+   particles.Clear();
+   Int_t j, first = fOffset[i], n = fOffset[i + 1] - first;
+   for (j = 0; j < n; j++)
+      new (particles[j]) AliRsnMiniParticle(*(AliRsnMiniParticle *)fParticles.UncheckedAt(first + j));
+
+   return kTRUE;
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniEventStore::Clear(Option_t *)
+{
+//
+// Remove all events
+//
+
+   fParticles.Delete();
+   fNEvents = 0;
+   fNParticles = 0;
+   fOffset.Set(1);
+   fOffset[0] = 0;
+   fVz.Set(0);
+   fMult.Set(0);
+   fRefMult.Set(0);
+   fTracklets.Set(0);
+   fAngle.Set(0);
+}
@@ -0,0 +1,54 @@
+#ifndef ALIRSNMINIEVENTSTORE_H
+#define ALIRSNMINIEVENTSTORE_H
+
+//
+// In-memory buffer of mini-events.
+// The particles of all events are kept in one flat array,
+// with the offset of the first particle of each event,
+// and the event variables used for mixing in plain arrays.
+// An event is retrieved by copying its particles into
+// a mini-event, without any deserialization.
+//
+
+#include <TArrayF.h>
+#include <TArrayI.h>
+#include <TClonesArray.h>
+
+class AliRsnMiniEvent;
+
+class AliRsnMiniEventStore : public TObject {
+public:
+
+   AliRsnMiniEventStore();
+   virtual ~AliRsnMiniEventStore();
+
+   Int_t     GetNEvents() const           {return fNEvents;}
+   Int_t     GetNParticles() const        {return fNParticles;}
+   Int_t     GetNParticles(Int_t i) const {return fOffset[i + 1] - fOffset[i];}
+   Float_t   Vz(Int_t i) const            {return fVz[i];}
+   Float_t   Mult(Int_t i) const          {return fMult[i];}
+   Float_t   Angle(Int_t i) const         {return fAngle[i];}
+
+   Int_t     Add(AliRsnMiniEvent *event);
+   Bool_t    Load(Int_t i, AliRsnMiniEvent *event) const;
+   virtual void Clear(Option_t *option = "");
+
+private:
+
+   AliRsnMiniEventStore(const AliRsnMiniEventStore &copy);
+   AliRsnMiniEventStore &operator=(const AliRsnMiniEventStore &copy);
+
+   Int_t         fNEvents;     //  number of stored events
+   Int_t         fNParticles;  //  number of stored particles
+   TArrayI       fOffset;      //  index of first particle of each event (fNEvents + 1)
+   TArrayF       fVz;          //  z-position of vertex
+   TArrayF       fMult;        //  multiplicity or centrality
+   TArrayF       fRefMult;     //  reference multiplicity
+   TArrayF       fTracklets;   //  tracklets
+   TArrayF       fAngle;       //  angle of reaction plane
+   TClonesArray  fParticles;   //  particles of all events
+
+   ClassDef(AliRsnMiniEventStore, 1)
+};
+
+#endif
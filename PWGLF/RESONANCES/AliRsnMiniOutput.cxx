@@ -484,46 +484,63 @@ Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event
 //
 
    // check computation type
-   Bool_t okComp = kFALSE;
-   if (fComputation == kTrackPair)         okComp = kTRUE;
-   if (fComputation == kTrackPairMix)      okComp = kTRUE;
-   if (fComputation == kTrackPairRotated1) okComp = kTRUE;
-   if (fComputation == kTrackPairRotated2) okComp = kTRUE;
-   if (fComputation == kTruePair)          okComp = kTRUE;
-   if (!okComp) {
+   if (!IsPairComputation()) {
       AliError(Form("[%s] This method can be called only for pair-based computations", GetName()));
       return kFALSE;
    }
 
+   AliRsnMiniOutput *self = this;
+   return FillPairs(1, &self, event1, event2, valueList, refFirst);
+}
+
+//__________________________________________________________________________________________________
+Int_t AliRsnMiniOutput::FillPairs(Int_t ndef, AliRsnMiniOutput **defs, AliRsnMiniEvent *event1, AliRsnMiniEvent *event2, TClonesArray *valueList, Bool_t refFirst)
+{
+//
+// Same as FillPair(), for a group of pair-based definitions which select
+// the daughters in the same way (see IsSamePairSelection()).
+// The pairs are built only once, with the selection of the first definition,
+// and each of them is passed to all definitions of the group,
+// which apply their own rotation, true-pair check, pair cuts and axes.
+// Returns the number of successful fillings summed over the definitions.
+//
+
+   if (ndef < 1 || !defs || !defs[0]) return 0;
+   AliRsnMiniOutput *first = defs[0];
+
    // loop variables
-   Int_t i1, i2, start, nadded = 0;
+   Int_t i1, i2, idef, start, nadded = 0;
    AliRsnMiniParticle *p1, *p2;
 
    // it is necessary to know if criteria for the two daughters are the same
    // and if the two events are the same or not (mixing)
    //Bool_t sameCriteria = ((fCharge[0] == fCharge[1]) && (fCutID[0] == fCutID[1]));
-   Bool_t sameCriteria = ((fCharge[0] == fCharge[1]) && (fDaughter[0] == fDaughter[1]));
+   Bool_t sameCriteria = ((first->fCharge[0] == first->fCharge[1]) && (first->fDaughter[0] == first->fDaughter[1]));
    Bool_t sameEvent = (event1->ID() == event2->ID());
 
+   TArrayI &sel1 = first->fSel1;
+   TArrayI &sel2 = first->fSel2;
    TString selList1  = "";
    TString selList2  = "";
-   Int_t   n1 = event1->CountParticles(fSel1, fCharge[0], fCutID[0]);
-   Int_t   n2 = event2->CountParticles(fSel2, fCharge[1], fCutID[1]);
-   for (i1 = 0; i1 < n1; i1++) selList1.Append(Form("%d ", fSel1[i1]));
-   for (i2 = 0; i2 < n2; i2++) selList2.Append(Form("%d ", fSel2[i2]));
-   AliDebugClass(1, Form("[%10s] Part #1: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", GetName(), (event1 == event2 ? "def" : "mix"), event1->ID(), fCharge[0], fCutID[0], n1, selList1.Data()));
-   AliDebugClass(1, Form("[%10s] Part #2: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", GetName(), (event1 == event2 ? "def" : "mix"), event2->ID(), fCharge[1], fCutID[1], n2, selList2.Data()));
+   Int_t   n1 = event1->CountParticles(sel1, first->fCharge[0], first->fCutID[0]);
+   Int_t   n2 = event2->CountParticles(sel2, first->fCharge[1], first->fCutID[1]);
+   for (i1 = 0; i1 < n1; i1++) selList1.Append(Form("%d ", sel1[i1]));
+   for (i2 = 0; i2 < n2; i2++) selList2.Append(Form("%d ", sel2[i2]));
+   AliDebugClass(1, Form("[%10s] Part #1: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", first->GetName(), (event1 == event2 ? "def" : "mix"), event1->ID(), first->fCharge[0], first->fCutID[0], n1, selList1.Data()));
+   AliDebugClass(1, Form("[%10s] Part #2: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", first->GetName(), (event1 == event2 ? "def" : "mix"), event2->ID(), first->fCharge[1], first->fCutID[1], n2, selList2.Data()));
    if (!n1 || !n2) {
       AliDebugClass(1, "No pairs to mix");
       return 0;
    }
 
+   // the pair kinematics is shared by all definitions
+   AliRsnMiniPair pair;
+   Double_t m1 = first->GetMass(0), m2 = first->GetMass(1), refMass = first->fMotherMass;
+   AliRsnMiniEvent *refEvent = (refFirst ? event1 : event2);
+
    // external loop
    for (i1 = 0; i1 < n1; i1++) {
-      p1 = event1->GetParticle(fSel1[i1]);
-      //p1 = event1->GetParticle(i1);
-      //if (p1->Charge() != fCharge[0]) continue;
-      //if (!p1->HasCutBit(fCutID[0])) continue;
+      p1 = event1->GetParticle(sel1[i1]);
       // define starting point for inner loop
       // if daughter selection criteria (charge, cuts) are the same
       // and the two events coincide, internal loop must start from
@@ -533,37 +550,54 @@ Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event
       AliDebugClass(2, Form("Start point = %d", start));
       // internal loop
       for (i2 = start; i2 < n2; i2++) {
-         p2 = event2->GetParticle(fSel2[i2]);
-         //p2 = event2->GetParticle(i2);
-         //if (p2->Charge() != fCharge[1]) continue;
-         //if (!p2->HasCutBit(fCutID[1])) continue;
+         p2 = event2->GetParticle(sel2[i2]);
          // avoid to mix a particle with itself
          if (sameEvent && (p1->Index() == p2->Index())) {
             AliDebugClass(2, "Skipping same index");
             continue;
          }
          // sum momenta
-         fPair.Fill(p1, p2, GetMass(0), GetMass(1), fMotherMass);
-         // do rotation if needed
-         if (fComputation == kTrackPairRotated1) fPair.InvertP(kTRUE);
-         if (fComputation == kTrackPairRotated2) fPair.InvertP(kFALSE);
-         // if required, check that this is a true pair
-         if (fComputation == kTruePair) {
-            if (fPair.Mother() < 0)  {
-               continue;
-            } else if (fPair.MotherPDG() != fMotherPDG) {
-               continue;
-            }
-            Bool_t decayMatch = kFALSE;
-            if (p1->PDGAbs() == AliRsnDaughter::SpeciesPDG(fDaughter[0]) && p2->PDGAbs() == AliRsnDaughter::SpeciesPDG(fDaughter[1]))
-               decayMatch = kTRUE;
-            if (p2->PDGAbs() == AliRsnDaughter::SpeciesPDG(fDaughter[0]) && p1->PDGAbs() == AliRsnDaughter::SpeciesPDG(fDaughter[1]))
-               decayMatch = kTRUE;
-            if (!decayMatch) continue;
-	    if ( (fMaxNSisters>0) && (p1->NTotSisters()==p2->NTotSisters()) && (p1->NTotSisters()>fMaxNSisters)) continue;
+         pair.Fill(p1, p2, m1, m2, refMass);
+         // pass to all definitions
+         for (idef = 0; idef < ndef; idef++)
+            if (defs[idef]->ProcessPair(pair, p1, p2, refEvent, valueList)) nadded++;
+      } // end internal loop
+   } // end external loop
+
+   AliDebugClass(1, Form("Pairs added in total = %4d", nadded));
+   return nadded;
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniOutput::ProcessPair(const AliRsnMiniPair &pair, AliRsnMiniParticle *p1, AliRsnMiniParticle *p2, AliRsnMiniEvent *event, TClonesArray *valueList)
+{
+//
+// Process one pair built from particles 'p1' and 'p2', filled by the caller:
+// apply rotation and true-pair checks when needed, pair cuts, and fill the output.
+// The pair is copied since some computed values modify it.
+//
+
+   fPair = pair;
+   // do rotation if needed
+   if (fComputation == kTrackPairRotated1) fPair.InvertP(kTRUE);
+   if (fComputation == kTrackPairRotated2) fPair.InvertP(kFALSE);
+   // if required, check that this is a true pair
+   if (fComputation == kTruePair) {
+      if (fPair.Mother() < 0)  {
+         return kFALSE;
+      } else if (fPair.MotherPDG() != fMotherPDG) {
+         return kFALSE;
+      }
+      Bool_t decayMatch = kFALSE;
+      if (p1->PDGAbs() == AliRsnDaughter::SpeciesPDG(fDaughter[0]) && p2->PDGAbs() == AliRsnDaughter::SpeciesPDG(fDaughter[1]))
+         decayMatch = kTRUE;
+      if (p2->PDGAbs() == AliRsnDaughter::SpeciesPDG(fDaughter[0]) && p1->PDGAbs() == AliRsnDaughter::SpeciesPDG(fDaughter[1]))
+         decayMatch = kTRUE;
+      if (!decayMatch) return kFALSE;
+	    if ( (fMaxNSisters>0) && (p1->NTotSisters()==p2->NTotSisters()) && (p1->NTotSisters()>fMaxNSisters)) return kFALSE;
 	    if ( fCheckP &&(TMath::Abs(fPair.PmotherX()-(p1->Px(1)+p2->Px(1)))/(TMath::Abs(fPair.PmotherX())+1.e-13)) > 0.00001 && 	  
 		          (TMath::Abs(fPair.PmotherY()-(p1->Py(1)+p2->Py(1)))/(TMath::Abs(fPair.PmotherY())+1.e-13)) > 0.00001 &&
-     			  (TMath::Abs(fPair.PmotherZ()-(p1->Pz(1)+p2->Pz(1)))/(TMath::Abs(fPair.PmotherZ())+1.e-13)) > 0.00001 ) continue;
+  			  (TMath::Abs(fPair.PmotherZ()-(p1->Pz(1)+p2->Pz(1)))/(TMath::Abs(fPair.PmotherZ())+1.e-13)) > 0.00001 ) return kFALSE;
 	    if ( fCheckFeedDown ){
 	    		Int_t pdgGranma = 0;
 	  		Bool_t isFromB=kFALSE;
@@ -580,33 +614,48 @@ Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event
 			  } 
 	  		if (pdgGranma == -99999){
 	  			AliDebug(2,"This particle does not have a quark in his genealogy\n");
-	  			continue;
+	  			return kFALSE;
 	  		}
 	  		if (pdgGranma == -9999){
 	  			AliDebug(2,"This particle come from a B decay channel but according to the settings of the task, we keep only the prompt charm particles\n");	
-	  			continue;
+	  			return kFALSE;
 	  		}	
 	 
 	  		if (pdgGranma == -999){
 	  			AliDebug(2,"This particle come from a prompt charm particles but according to the settings of the task, we want only the ones coming from B\n");  
-	  			continue;
+	  			return kFALSE;
 	  		}	
 		    }
-         }
-         // check pair against cuts
-         if (fPairCuts) {
-            if (!fPairCuts->IsSelected(&fPair)) continue;
-         }
-         // get computed values & fill histogram
-         nadded++;
-         if (refFirst) ComputeValues(event1, valueList); else ComputeValues(event2, valueList);
-         FillHistogram();
-      } // end internal loop
-   } // end external loop
+   }
+   // check pair against cuts
+   if (fPairCuts) {
+      if (!fPairCuts->IsSelected(&fPair)) return kFALSE;
+   }
+   // get computed values & fill histogram
+   ComputeValues(event, valueList);
+   FillHistogram();
+   return kTRUE;
+}
 
-   AliDebugClass(1, Form("Pairs added in total = %4d", nadded));
-   return nadded;
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniOutput::IsSamePairSelection(const AliRsnMiniOutput *other) const
+{
+//
+// Check if another definition builds pairs from the same daughters,
+// i.e. same charges, cut IDs, species and nominal mother mass,
+// so that the two can share one pair loop (see FillPairs()).
+//
+
+   if (!other) return kFALSE;
+   Int_t i;
+   for (i = 0; i < 2; i++) {
+      if (fCharge[i] != other->fCharge[i]) return kFALSE;
+      if (fCutID[i] != other->fCutID[i]) return kFALSE;
+      if (fDaughter[i] != other->fDaughter[i]) return kFALSE;
+   }
+   return (fMotherMass == other->fMotherMass);
 }
+
 //___________________________________________________________
 void AliRsnMiniOutput::SetDselection(UShort_t originDselection)
 {
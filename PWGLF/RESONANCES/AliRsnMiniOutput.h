@@ -65,6 +65,8 @@ public:
    Bool_t          IsSameDaughter()     const {return (fDaughter[0] == fDaughter[1]);}
    //Bool_t          IsSymmetric()        const {return (IsLikeSign() && IsSameCut());}
    Bool_t          IsSymmetric()        const {return (IsLikeSign() && IsSameDaughter());}
+   Bool_t          IsPairComputation()  const {return (IsTrackPair() || IsTrackPairMix() || IsTruePair() || fComputation == kTrackPairRotated1 || fComputation == kTrackPairRotated2);}
+   Bool_t          IsSamePairSelection(const AliRsnMiniOutput *other) const;
 
    EOutputType     GetOutputType()      const {return fOutputType;}
    EComputation    GetComputation()     const {return fComputation;}
@@ -105,6 +107,7 @@ public:
    Bool_t          FillMotherInAcceptance(const AliRsnMiniPair *pair, AliRsnMiniEvent *event, TClonesArray *valueList);
    Bool_t          FillEvent(AliRsnMiniEvent *event, TClonesArray *valueList);
    Int_t           FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2, TClonesArray *valueList, Bool_t refFirst = kTRUE);
+   static Int_t    FillPairs(Int_t ndef, AliRsnMiniOutput **defs, AliRsnMiniEvent *event1, AliRsnMiniEvent *event2, TClonesArray *valueList, Bool_t refFirst = kTRUE);
 
 private:
 
@@ -112,6 +115,7 @@ private:
    void   CreateHistogramSparse(const char *name);
    void   ComputeValues(AliRsnMiniEvent *event, TClonesArray *valueList);
    void   FillHistogram();
+   Bool_t ProcessPair(const AliRsnMiniPair &pair, AliRsnMiniParticle *p1, AliRsnMiniParticle *p2, AliRsnMiniEvent *event, TClonesArray *valueList);
 
    EOutputType      fOutputType;       //  type of output
    EComputation     fComputation;      //  type of computation
@@ -42,6 +42,7 @@
 
 #pragma link C++ class AliPerformanceTask+;
 #pragma link C++ class AliPerformanceObject+;
+#pragma link C++ class AliPerformanceSparseBuffer+;
 #pragma link C++ class AliPerformanceRes+;
 #pragma link C++ class AliPerformanceEff+;
 #pragma link C++ class AliPerformanceDEdx+;
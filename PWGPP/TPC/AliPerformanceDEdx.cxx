@@ -249,7 +249,7 @@ void AliPerformanceDEdx::ProcessInnerTPC(AliStack* const stack, AliESDtrack *con
 
   //Double_t vDeDxHisto[10] = {dedx,phi,y,z,snp,tgl,ncls,p,TPCSignalN,nCrossedRows};
   Double_t vDeDxHisto[10] = {dedx,phi,y,z,snp,tgl,Double_t(ncls),p,Double_t(TPCSignalN),nClsF};
-  fDeDxHisto->Fill(vDeDxHisto); 
+  FillSparse(fDeDxHisto, vDeDxHisto); 
 
   if(!stack) return;
 }
@@ -295,7 +295,8 @@ Long64_t AliPerformanceDEdx::Merge(TCollection* const list)
     AliPerformanceDEdx* entry = dynamic_cast<AliPerformanceDEdx*>(obj);
     if (entry == 0) continue; 
     if (merge) {
-        if ((fDeDxHisto) && (entry->fDeDxHisto)) { fDeDxHisto->Add(entry->fDeDxHisto); }        
+        entry->FlushSparse();
+        if ((fDeDxHisto) && (entry->fDeDxHisto)) { MergeSparse(fDeDxHisto, entry->fDeDxHisto); }        
     }
     // the analysisfolder is only merged if present
     if (entry->fFolderObj) { objArrayList->Add(entry->fFolderObj); }
@@ -303,6 +304,7 @@ Long64_t AliPerformanceDEdx::Merge(TCollection* const list)
     count++;
   }
   if (fFolderObj) { fFolderObj->Merge(objArrayList); } 
+  FlushSparse();
   // to signal that track histos were not merged: reset
   if (!merge) { fDeDxHisto->Reset(); }
   // delete
@@ -407,6 +409,7 @@ void AliPerformanceDEdx::Analyse()
   // Analyze comparison information and store output histograms
   // in the folder "folderDEdx"
   //
+  FlushSparse();
   //Atti h_tpc_dedx_mips_0 
   //fai fit con range p(.32,.38) and dEdx(65- 120 or 100) e ripeti cosa fatta per pion e fai trending della media e res, poio la loro differenza
   //fai dedx vs lamda ma for e e pion separati
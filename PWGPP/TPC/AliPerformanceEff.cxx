@@ -293,7 +293,7 @@ void AliPerformanceEff::ProcessTPC(AliMCEvent* const mcEvent, AliESDEvent *const
 
     // Fill histograms
     Double_t vEffHisto[9] = {mceta, mcphi, mcpt, static_cast<Double_t>(pid), static_cast<Double_t>(recStatus), static_cast<Double_t>(findable), static_cast<Double_t>(charge), static_cast<Double_t>(nClones), static_cast<Double_t>(nFakes)}; 
-    fEffHisto->Fill(vEffHisto);
+    FillSparse(fEffHisto, vEffHisto);
   }
   if(labelsRec) delete [] labelsRec; labelsRec = 0;
   if(labelsAllRec) delete [] labelsAllRec; labelsAllRec = 0;
@@ -432,7 +432,7 @@ void AliPerformanceEff::ProcessTPCSec(AliMCEvent* const mcEvent, AliESDEvent *co
 
     // Fill histograms
     Double_t vEffSecHisto[12] = { mceta, mcphi, mcpt, static_cast<Double_t>(pid), static_cast<Double_t>(recStatus), static_cast<Double_t>(findable), mcR, mother_phi, mother_eta, static_cast<Double_t>(charge), static_cast<Double_t>(nClones), static_cast<Double_t>(nFakes) }; 
-    fEffSecHisto->Fill(vEffSecHisto);
+    FillSparse(fEffSecHisto, vEffSecHisto);
   }
   }
   }
@@ -556,7 +556,7 @@ void AliPerformanceEff::ProcessTPCITS(AliMCEvent* const mcEvent, AliESDEvent *co
     
     // Fill histograms
     Double_t vEffHisto[9] = { mceta, mcphi, mcpt, static_cast<Double_t>(pid), static_cast<Double_t>(recStatus), static_cast<Double_t>(findable), static_cast<Double_t>(charge), static_cast<Double_t>(nClones), static_cast<Double_t>(nFakes)}; 
-    fEffHisto->Fill(vEffHisto);
+    FillSparse(fEffHisto, vEffHisto);
   }
 
   if(labelsRecTPCITS) delete [] labelsRecTPCITS; labelsRecTPCITS = 0;
@@ -677,7 +677,7 @@ void AliPerformanceEff::ProcessConstrained(AliMCEvent* const mcEvent, AliESDEven
 
     // Fill histograms
     Double_t vEffHisto[9] = { mceta, mcphi, mcpt, static_cast<Double_t>(pid), static_cast<Double_t>(recStatus), static_cast<Double_t>(findable), static_cast<Double_t>(charge), static_cast<Double_t>(nClones), static_cast<Double_t>(nFakes) }; 
-    fEffHisto->Fill(vEffHisto);
+    FillSparse(fEffHisto, vEffHisto);
   }
 
   if(labelsRecConstrained) delete [] labelsRecConstrained; labelsRecConstrained = 0;
@@ -903,10 +903,12 @@ Long64_t AliPerformanceEff::Merge(TCollection* const list)
     AliPerformanceEff* entry = dynamic_cast<AliPerformanceEff*>(obj);
     if (entry == 0) continue; 
   
-     fEffHisto->Add(entry->fEffHisto);
-     fEffSecHisto->Add(entry->fEffSecHisto);
+     entry->FlushSparse();
+     MergeSparse(fEffHisto, entry->fEffHisto);
+     MergeSparse(fEffSecHisto, entry->fEffSecHisto);
   count++;
   }
+  FlushSparse();
 
 return count;
 }
@@ -917,6 +919,7 @@ void AliPerformanceEff::Analyse()
   // Analyse comparison information and store output histograms
   // in the folder "folderEff" 
   //
+  FlushSparse();
   TH1::AddDirectory(kFALSE);
   TObjArray *aFolderObj = new TObjArray;
   if(!aFolderObj) return;
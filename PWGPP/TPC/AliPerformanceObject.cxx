@@ -31,10 +31,12 @@
 #include "TPostScript.h"
 #include "TList.h"
 #include "TMath.h"
+#include "TObjArray.h"
 
 #include "AliLog.h" 
 #include "AliESDVertex.h" 
 #include "AliPerformanceObject.h" 
+#include "AliPerformanceSparseBuffer.h" 
 
 using namespace std;
 
@@ -52,7 +54,9 @@ AliPerformanceObject::AliPerformanceObject():
   fHighMultiplicity(kFALSE),
   fUseKinkDaughters(kTRUE),
   fUseCentralityBin(0),
-  fUseTOFBunchCrossing(kTRUE)
+  fUseTOFBunchCrossing(kTRUE),
+  fUseSparseBuffer(kFALSE),
+  fSparseBuffers(0)
 {
   // constructor
 }
@@ -69,7 +73,9 @@ AliPerformanceObject::AliPerformanceObject(const char* name, const char* title,
   fHighMultiplicity(highMult),
   fUseKinkDaughters(kTRUE),
   fUseCentralityBin(0),
-  fUseTOFBunchCrossing(kTRUE)
+  fUseTOFBunchCrossing(kTRUE),
+  fUseSparseBuffer(kFALSE),
+  fSparseBuffers(0)
 {
   // constructor
 }
@@ -77,6 +83,8 @@ AliPerformanceObject::AliPerformanceObject(const char* name, const char* title,
 //_____________________________________________________________________________
 AliPerformanceObject::~AliPerformanceObject(){
   // destructor 
+  // staged fills are lost, the histograms may already be deleted
+  if (fSparseBuffers) { fSparseBuffers->Delete(); delete fSparseBuffers; }
 }
 
 //_____________________________________________________________________________
@@ -243,3 +251,58 @@ void AliPerformanceObject::AddProjection(TObjArray* aFolderObj, TString nameSpar
   h3->SetTitle(title.Data());  
   aFolderObj->Add(h3);
 }
+
+
+//_____________________________________________________________________________
+AliPerformanceSparseBuffer* AliPerformanceObject::GetSparseBuffer(THnSparse* hSparse) const
+{
+  // staging buffer of hSparse, created on first use
+  if (!hSparse) return 0;
+  if (!fSparseBuffers) fSparseBuffers = new TObjArray;
+
+  AliPerformanceSparseBuffer* buffer = 0;
+  for (Int_t i = 0; i < fSparseBuffers->GetEntriesFast(); i++) {
+    buffer = static_cast<AliPerformanceSparseBuffer*>(fSparseBuffers->UncheckedAt(i));
+    if (buffer->GetTarget() == hSparse) return buffer;
+  }
+  buffer = new AliPerformanceSparseBuffer(hSparse);
+  fSparseBuffers->Add(buffer);
+  return buffer;
+}
+
+//_____________________________________________________________________________
+void AliPerformanceObject::FillSparse(THnSparse* hSparse, const Double_t* x, Double_t w)
+{
+  // fill hSparse, staged if enabled
+  if (!hSparse) return;
+  if (!fUseSparseBuffer) { hSparse->Fill(x, w); return; }
+  GetSparseBuffer(hSparse)->Fill(x, w);
+}
+
+//_____________________________________________________________________________
+void AliPerformanceObject::MergeSparse(THnSparse* hSparse, const THnSparse* other)
+{
+  // add other to hSparse, streamed through the staging buffer if enabled
+  if (!hSparse || !other) return;
+  if (!fUseSparseBuffer || !GetSparseBuffer(hSparse)->Merge(other)) 
+    hSparse->Add(other);
+}
+
+//_____________________________________________________________________________
+Double_t AliPerformanceObject::GetSparseEntries(THnSparse* hSparse) const
+{
+  // number of entries of hSparse including staged ones
+  if (!hSparse) return 0;
+  Double_t entries = hSparse->GetEntries();
+  if (fUseSparseBuffer && fSparseBuffers) entries += GetSparseBuffer(hSparse)->GetEntries();
+  return entries;
+}
+
+//_____________________________________________________________________________
+void AliPerformanceObject::FlushSparse()
+{
+  // add all staged fills to the histograms
+  if (!fSparseBuffers) return;
+  for (Int_t i = 0; i < fSparseBuffers->GetEntriesFast(); i++)
+    static_cast<AliPerformanceSparseBuffer*>(fSparseBuffers->UncheckedAt(i))->Flush();
+}
@@ -20,6 +20,7 @@ class AliRecInfoCuts;
 class AliMCInfoCuts;
 class AliESDfriend;
 class AliESDVertex;
+class AliPerformanceSparseBuffer;
 
 class AliPerformanceObject : public TNamed {
 public :
@@ -105,12 +106,28 @@ public :
   void SetUseTOFBunchCrossing(Bool_t tofBunching = kTRUE) { fUseTOFBunchCrossing = tofBunching; }
   Bool_t IsUseTOFBunchCrossing() { return fUseTOFBunchCrossing; }
 
+  // stage THnSparse fills and merges in sorted batches
+  // (see AliPerformanceSparseBuffer)
+  void SetUseSparseBuffer(Bool_t useBuffer = kTRUE) { fUseSparseBuffer = useBuffer; }
+  Bool_t IsUseSparseBuffer() const { return fUseSparseBuffer; }
+
+  // add all staged fills to the THnSparse objects
+  // has to be called before the histograms are used or written
+  void FlushSparse();
+
 protected: 
 
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, TString* selString = 0);
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, Int_t yDim, TString* selString = 0);
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, Int_t yDim, Int_t zDim, TString* selString = 0);
 
+  // fill and merge THnSparse, through the staging buffer if enabled
+  void FillSparse(THnSparse* hSparse, const Double_t* x, Double_t w = 1.);
+  void MergeSparse(THnSparse* hSparse, const THnSparse* other);
+  // entries including those still staged
+  Double_t GetSparseEntries(THnSparse* hSparse) const;
+  AliPerformanceSparseBuffer* GetSparseBuffer(THnSparse* hSparse) const;
+
   // merge THnSparse
   Bool_t fMergeTHnSparseObj;
   
@@ -137,10 +154,13 @@ protected:
 
   Bool_t fUseTOFBunchCrossing; // use TOFBunchCrossing, default is yes
 
+  Bool_t fUseSparseBuffer; // stage THnSparse fills, default is no
+  mutable TObjArray* fSparseBuffers; //! staging buffers, one per THnSparse
+
   AliPerformanceObject(const AliPerformanceObject&); // not implemented
   AliPerformanceObject& operator=(const AliPerformanceObject&); // not implemented
 
-  ClassDef(AliPerformanceObject,7);
+  ClassDef(AliPerformanceObject,8);
 };
 
 #endif
@@ -301,10 +301,10 @@ void AliPerformanceRes::ProcessTPC(AliStack* const stack, AliESDtrack *const esd
     else pull1PtTPC = 0.; 
 
     Double_t vResolHisto[10] = {deltaYTPC,deltaZTPC,deltaPhiTPC,deltaLambdaTPC,deltaPtTPC,particle->Vy(),particle->Vz(),mcphi,mceta,mcpt};
-    fResolHisto->Fill(vResolHisto);
+    FillSparse(fResolHisto, vResolHisto);
 
     Double_t vPullHisto[10] = {pullYTPC,pullZTPC,pullPhiTPC,pullLambdaTPC,pull1PtTPC,particle->Vy(),particle->Vz(),mcsnp,mctgl,1./mcpt};
-    fPullHisto->Fill(vPullHisto);
+    FillSparse(fPullHisto, vPullHisto);
   }
 }
 
@@ -394,10 +394,10 @@ void AliPerformanceRes::ProcessTPCITS(AliStack* const stack, AliESDtrack *const
     else pull1PtTPC = 0.;
 
     Double_t vResolHisto[10] = {deltaYTPC,deltaZTPC,deltaPhiTPC,deltaLambdaTPC,deltaPtTPC,particle->Vy(),particle->Vz(),mcphi,mceta,mcpt};
-    fResolHisto->Fill(vResolHisto);
+    FillSparse(fResolHisto, vResolHisto);
 
     Double_t vPullHisto[10] = {pullYTPC,pullZTPC,pullPhiTPC,pullLambdaTPC,pull1PtTPC,particle->Vy(),particle->Vz(),mcsnp,mctgl,1./mcpt};
-    fPullHisto->Fill(vPullHisto);
+    FillSparse(fPullHisto, vPullHisto);
 
    
     /*
@@ -421,10 +421,10 @@ void AliPerformanceRes::ProcessTPCITS(AliStack* const stack, AliESDtrack *const
     else pull1PtTPC = 0.;
 
     Double_t vResolHisto[10] = {deltaYTPC,deltaZTPC,deltaPhiTPC,deltaLambdaTPC,delta1PtTPC,particle->Vy(),particle->Vz(),mceta,mcphi,mcpt};
-    fResolHisto->Fill(vResolHisto);
+    FillSparse(fResolHisto, vResolHisto);
 
     Double_t vPullHisto[10] = {pullYTPC,pullZTPC,pullPhiTPC,pullLambdaTPC,pull1PtTPC,particle->Vy(),particle->Vz(),mceta,mcphi,mcpt};
-    fPullHisto->Fill(vPullHisto);
+    FillSparse(fPullHisto, vPullHisto);
     */
   }
 }
@@ -519,10 +519,10 @@ void AliPerformanceRes::ProcessConstrained(AliStack* const stack, AliESDtrack *c
     else pull1PtTPC = 0.;
 
     Double_t vResolHisto[10] = {deltaYTPC,deltaZTPC,deltaPhiTPC,deltaLambdaTPC,deltaPtTPC,particle->Vy(),particle->Vz(),mcphi,mceta,mcpt};
-    fResolHisto->Fill(vResolHisto);
+    FillSparse(fResolHisto, vResolHisto);
 
     Double_t vPullHisto[10] = {pullYTPC,pullZTPC,pullPhiTPC,pullLambdaTPC,pull1PtTPC,particle->Vy(),particle->Vz(),mcsnp,mctgl,1./mcpt};
-    fPullHisto->Fill(vPullHisto);
+    FillSparse(fPullHisto, vPullHisto);
 
     /*
 
@@ -547,10 +547,10 @@ void AliPerformanceRes::ProcessConstrained(AliStack* const stack, AliESDtrack *c
     else pull1PtTPC = 0.;
 
     Double_t vResolHisto[10] = {deltaYTPC,deltaZTPC,deltaPhiTPC,deltaLambdaTPC,delta1PtTPC,particle->Vy(),particle->Vz(),mceta,mcphi,mcpt};
-    fResolHisto->Fill(vResolHisto);
+    FillSparse(fResolHisto, vResolHisto);
 
     Double_t vPullHisto[10] = {pullYTPC,pullZTPC,pullPhiTPC,pullLambdaTPC,pull1PtTPC,particle->Vy(),particle->Vz(),mceta,mcphi,mcpt};
-    fPullHisto->Fill(vPullHisto);
+    FillSparse(fPullHisto, vPullHisto);
 
     */
   }
@@ -690,10 +690,10 @@ void AliPerformanceRes::ProcessInnerTPC(AliMCEvent *const mcEvent, AliESDtrack *
     else pull1PtTPC = 0.;
 
     Double_t vResolHisto[10] = {deltaYTPC,deltaZTPC,deltaPhiTPC,deltaLambdaTPC,deltaPtTPC,ref0->Y(),ref0->Z(),mcphi,mceta,mcpt};
-    fResolHisto->Fill(vResolHisto);
+    FillSparse(fResolHisto, vResolHisto);
 
     Double_t vPullHisto[10] = {pullYTPC,pullZTPC,pullPhiTPC,pullLambdaTPC,pull1PtTPC,ref0->Y(),ref0->Z(),mcsnp,mctgl,1./mcpt};
-    fPullHisto->Fill(vPullHisto);
+    FillSparse(fPullHisto, vPullHisto);
   }
 
   if(track) delete track;
@@ -811,10 +811,10 @@ void AliPerformanceRes::ProcessOuterTPC(AliMCEvent *const mcEvent, AliESDtrack *
     else pull1PtTPC = 0.;
 
     Double_t vResolHisto[10] = {deltaYTPC,deltaZTPC,deltaPhiTPC,deltaLambdaTPC,deltaPtTPC,ref0->Y(),ref0->Z(),mcphi,mceta,mcpt};
-    fResolHisto->Fill(vResolHisto);
+    FillSparse(fResolHisto, vResolHisto);
 
     Double_t vPullHisto[10] = {pullYTPC,pullZTPC,pullPhiTPC,pullLambdaTPC,pull1PtTPC,ref0->Y(),ref0->Z(),mcsnp,mctgl,1./mcpt};
-    fPullHisto->Fill(vPullHisto);
+    FillSparse(fPullHisto, vPullHisto);
   }
 
   if(track) delete track;
@@ -1010,6 +1010,7 @@ void AliPerformanceRes::Analyse() {
   // Analyse comparison information and store output histograms
   // in the folder "folderRes"
   //
+  FlushSparse();
   TH1::AddDirectory(kFALSE);
   TH1F *h=0;
   TH2F *h2D=0;
@@ -1173,13 +1174,15 @@ Long64_t AliPerformanceRes::Merge(TCollection* const list)
   {
   AliPerformanceRes* entry = dynamic_cast<AliPerformanceRes*>(obj);
   if (entry == 0) continue; 
-  if (fResolHisto->GetEntries()<fgkMergeEntriesCut){
-    fResolHisto->Add(entry->fResolHisto);  
-    fPullHisto->Add(entry->fPullHisto);
+  if (GetSparseEntries(fResolHisto)<fgkMergeEntriesCut){
+    entry->FlushSparse();
+    MergeSparse(fResolHisto, entry->fResolHisto);  
+    MergeSparse(fPullHisto, entry->fPullHisto);
   }
 
   count++;
   }
+  FlushSparse();
 
 return count;
 }
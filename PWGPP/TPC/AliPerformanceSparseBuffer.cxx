@@ -0,0 +1,191 @@
+/**************************************************************************
+* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+//------------------------------------------------------------------------------
+// Implementation of AliPerformanceSparseBuffer, a staging buffer which
+// collects THnSparse fills as 64 bit linear bin numbers and adds them
+// to the THnSparse in sorted batches (see header).
+//------------------------------------------------------------------------------
+
+#include "TAxis.h"
+#include "TMath.h"
+#include "THnSparse.h"
+
+#include "AliLog.h"
+#include "AliPerformanceSparseBuffer.h"
+
+ClassImp(AliPerformanceSparseBuffer)
+
+//_____________________________________________________________________________
+AliPerformanceSparseBuffer::AliPerformanceSparseBuffer(THnSparse* target, Int_t capacity):
+  TObject(),
+  fTarget(target),
+  fNdim(0),
+  fEncodable(kFALSE),
+  fErrors(kFALSE),
+  fStride(),
+  fCoord(),
+  fCapacity(capacity > 0 ? capacity : 1),
+  fN(0),
+  fEntries(0),
+  fKeys(),
+  fW(),
+  fW2(),
+  fIndex()
+{
+  // constructor
+  if (!fTarget) return;
+
+  fNdim   = fTarget->GetNdimensions();
+  fErrors = fTarget->GetCalculateErrors();
+  fStride.Set(fNdim);
+  fCoord.Set(fNdim);
+
+  // mixed radix with nbins+2 (under- and overflow) digits per axis
+  fEncodable = kTRUE;
+  Double_t range  = 1;
+  Long64_t stride = 1;
+  for (Int_t i = 0; i < fNdim; i++) {
+    Int_t n = fTarget->GetAxis(i)->GetNbins() + 2;
+    range *= n;
+    if (range > 9.e18) { fEncodable = kFALSE; break; }
+    fStride[i] = stride;
+    stride *= n;
+  }
+  if (!fEncodable) {
+    AliDebug(AliLog::kWarning, Form("%s: bins do not fit into 64 bits, filling directly", fTarget->GetName()));
+    return;
+  }
+
+  fKeys.Set(fCapacity);
+  fW.Set(fCapacity);
+  fIndex.Set(fCapacity);
+  if (fErrors) fW2.Set(fCapacity);
+}
+
+//_____________________________________________________________________________
+AliPerformanceSparseBuffer::~AliPerformanceSparseBuffer()
+{
+  // destructor
+  // the target is not owned and may already be gone, so nothing is flushed
+}
+
+//_____________________________________________________________________________
+Long64_t AliPerformanceSparseBuffer::Encode(const Int_t* coord) const
+{
+  // linear bin number of bin coordinates
+  Long64_t key = 0;
+  for (Int_t i = 0; i < fNdim; i++) key += fStride[i] * coord[i];
+  return key;
+}
+
+//_____________________________________________________________________________
+void AliPerformanceSparseBuffer::Decode(Long64_t key, Int_t* coord) const
+{
+  // bin coordinates of linear bin number
+  for (Int_t i = fNdim-1; i >= 0; i--) {
+    coord[i] = Int_t(key / fStride[i]);
+    key     -= coord[i] * fStride[i];
+  }
+}
+
+//_____________________________________________________________________________
+void AliPerformanceSparseBuffer::Push(Long64_t key, Double_t w, Double_t w2)
+{
+  // append to the buffer, flush if full
+  if (fN >= fCapacity) Flush();
+  fKeys[fN] = key;
+  fW[fN]    = w;
+  if (fErrors) fW2[fN] = w2;
+  fN++;
+}
+
+//_____________________________________________________________________________
+void AliPerformanceSparseBuffer::Fill(const Double_t* x, Double_t w)
+{
+  // buffer one fill of the target
+  if (!fTarget) return;
+  if (!fEncodable) { fTarget->Fill(x, w); return; }
+
+  Long64_t key = 0;
+  for (Int_t i = 0; i < fNdim; i++)
+    key += fStride[i] * fTarget->GetAxis(i)->FindFixBin(x[i]);
+  Push(key, w, w*w);
+  fEntries += 1;
+}
+
+//_____________________________________________________________________________
+void AliPerformanceSparseBuffer::Flush()
+{
+  // add the buffered bins to the target, one THnSparse bin look-up
+  // per distinct bin
+  if (!fTarget) return;
+
+  if (fN > 0) {
+    Long64_t* keys  = fKeys.GetArray();
+    Int_t*    index = fIndex.GetArray();
+    TMath::Sort(fN, keys, index, kFALSE);
+
+    Int_t i = 0;
+    while (i < fN) {
+      Long64_t key = keys[index[i]];
+      Double_t w   = 0;
+      Double_t w2  = 0;
+      for (; i < fN && keys[index[i]] == key; i++) {
+        w += fW[index[i]];
+        if (fErrors) w2 += fW2[index[i]];
+      }
+      Decode(key, fCoord.GetArray());
+      Long64_t bin = fTarget->GetBin(fCoord.GetArray(), kTRUE);
+      fTarget->AddBinContent(bin, w);
+      if (fErrors) fTarget->AddBinError2(bin, w2);
+    }
+  }
+  if (fEntries > 0) fTarget->SetEntries(fTarget->GetEntries() + fEntries);
+
+  fN       = 0;
+  fEntries = 0;
+}
+
+//_____________________________________________________________________________
+Bool_t AliPerformanceSparseBuffer::Merge(const THnSparse* other)
+{
+  // stream the filled bins of other through the buffer;
+  // returns kFALSE if the binning differs (nothing is added then)
+  if (!fTarget || !other) return kFALSE;
+  if (other->GetNdimensions() != fNdim) return kFALSE;
+  for (Int_t i = 0; i < fNdim; i++) {
+    const TAxis* a = fTarget->GetAxis(i);
+    const TAxis* b = other->GetAxis(i);
+    if (a->GetNbins() != b->GetNbins() ||
+        a->GetXmin()  != b->GetXmin()  ||
+        a->GetXmax()  != b->GetXmax()) return kFALSE;
+  }
+  if (!fEncodable || other->GetCalculateErrors() != fErrors) {
+    Flush();
+    fTarget->Add(other);
+    return kTRUE;
+  }
+
+  Int_t*   coord = fCoord.GetArray();
+  Long64_t nBins = other->GetNbins();
+  for (Long64_t i = 0; i < nBins; i++) {
+    Double_t v  = other->GetBinContent(i, coord);
+    Double_t e2 = fErrors ? other->GetBinError2(i) : 0;
+    Push(Encode(coord), v, e2);
+  }
+  fEntries += other->GetEntries();
+  return kTRUE;
+}
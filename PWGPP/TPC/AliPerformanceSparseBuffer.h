@@ -0,0 +1,72 @@
+#ifndef ALIPERFORMANCESPARSEBUFFER_H
+#define ALIPERFORMANCESPARSEBUFFER_H
+
+//------------------------------------------------------------------------------
+// Staging buffer in front of a THnSparse.
+//
+// Fills are pre-binned into a single 64 bit linear bin number (per-axis
+// bin including under/overflow, mixed radix over the axes) and kept in a
+// flat buffer. When the buffer is full (or on Flush()) it is sorted, equal
+// bins are summed and every distinct bin is added to the THnSparse once,
+// so the sparse hash is looked up once per distinct bin instead of once
+// per fill. Merge() streams the bins of another THnSparse through the
+// same buffer. The target THnSparse is not owned and stays the output
+// object, so downstream code is unaffected.
+//------------------------------------------------------------------------------
+
+#include "TObject.h"
+#include "TArrayD.h"
+#include "TArrayI.h"
+#include "TArrayL64.h"
+
+class THnSparse;
+
+class AliPerformanceSparseBuffer : public TObject {
+public :
+  AliPerformanceSparseBuffer(THnSparse* target=0, Int_t capacity=65536);
+  virtual ~AliPerformanceSparseBuffer();
+
+  // target histogram (not owned)
+  THnSparse* GetTarget() const { return fTarget; }
+
+  // buffer a fill; falls back to THnSparse::Fill() if the bins
+  // do not fit into 64 bits
+  void Fill(const Double_t* x, Double_t w=1.);
+
+  // add all buffered fills to the target
+  void Flush();
+
+  // add the content of another THnSparse with the same binning
+  // to the target, streamed through the buffer
+  Bool_t Merge(const THnSparse* other);
+
+  // number of buffered bins and entries not yet in the target
+  Int_t    GetN() const       { return fN; }
+  Double_t GetEntries() const { return fEntries; }
+
+private:
+  Long64_t Encode(const Int_t* coord) const;
+  void     Decode(Long64_t key, Int_t* coord) const;
+  void     Push(Long64_t key, Double_t w, Double_t w2);
+
+  THnSparse* fTarget;     //! target histogram (not owned)
+  Int_t      fNdim;       //! number of dimensions
+  Bool_t     fEncodable;  //! whether all bins fit into 64 bits
+  Bool_t     fErrors;     //! whether the target keeps sum of w^2
+  TArrayL64  fStride;     //! mixed radix strides (nbins+2 per axis)
+  TArrayI    fCoord;      //! bin coordinates work space
+  Int_t      fCapacity;   //! buffer size
+  Int_t      fN;          //! number of buffered bins
+  Double_t   fEntries;    //! number of buffered entries
+  TArrayL64  fKeys;       //! buffered linear bins
+  TArrayD    fW;          //! buffered weights
+  TArrayD    fW2;         //! buffered squared weights (if fErrors)
+  TArrayI    fIndex;      //! sort index
+
+  AliPerformanceSparseBuffer(const AliPerformanceSparseBuffer&); // not implemented
+  AliPerformanceSparseBuffer& operator=(const AliPerformanceSparseBuffer&); // not implemented
+
+  ClassDef(AliPerformanceSparseBuffer,1);
+};
+
+#endif
@@ -349,7 +349,7 @@ void AliPerformanceTPC::ProcessTPC(AliStack* const stack, AliESDtrack *const esd
 
   //Double_t vTPCTrackHisto[10] = {nClust,chi2PerCluster,clustPerFindClust,dca[0],dca[1],eta,phi,pt,qpt,vertStatus};
   Double_t vTPCTrackHisto[10] = {static_cast<Double_t>(nClust),static_cast<Double_t>(chi2PerCluster),static_cast<Double_t>(clustPerFindClust),static_cast<Double_t>(dca[0]),static_cast<Double_t>(dca[1]),static_cast<Double_t>(eta),static_cast<Double_t>(phi),static_cast<Double_t>(pt),static_cast<Double_t>(q),static_cast<Double_t>(vertStatus)};
-  fTPCTrackHisto->Fill(vTPCTrackHisto); 
+  FillSparse(fTPCTrackHisto, vTPCTrackHisto); 
  
   //
   // Fill rec vs MC information
@@ -420,7 +420,7 @@ void AliPerformanceTPC::ProcessTPCITS(AliStack* const stack, AliESDtrack *const
   if(!fCutsRC->GetDCAToVertex2D() && TMath::Abs(dca[1]) > fCutsRC->GetMaxDCAToVertexZ()) return;
 
   Double_t vTPCTrackHisto[10] = {static_cast<Double_t>(nClust),static_cast<Double_t>(chi2PerCluster),static_cast<Double_t>(clustPerFindClust),static_cast<Double_t>(dca[0]),static_cast<Double_t>(dca[1]),static_cast<Double_t>(eta),static_cast<Double_t>(phi),static_cast<Double_t>(pt),static_cast<Double_t>(q),static_cast<Double_t>(vertStatus)};
-  fTPCTrackHisto->Fill(vTPCTrackHisto); 
+  FillSparse(fTPCTrackHisto, vTPCTrackHisto); 
  
   //
   // Fill rec vs MC information
@@ -558,7 +558,7 @@ void AliPerformanceTPC::Exec(AliMCEvent* const mcEvent, AliESDEvent *const esdEv
              //Int_t detector = cluster->GetDetector();
              //Double_t vTPCClust[6] = { irow, phi, TPCside, pad, detector, gclf[2] };
              Double_t vTPCClust[3] = { static_cast<Double_t>(irow), phi, static_cast<Double_t>(TPCside) };
-             fTPCClustHisto->Fill(vTPCClust);
+             FillSparse(fTPCClustHisto, vTPCClust);
         }
       }
     }
@@ -604,7 +604,7 @@ void AliPerformanceTPC::Exec(AliMCEvent* const mcEvent, AliESDEvent *const esdEv
   }
 
   Double_t vTPCEvent[7] = {vtxESD->GetX(),vtxESD->GetY(),vtxESD->GetZ(),static_cast<Double_t>(mult),static_cast<Double_t>(multP),static_cast<Double_t>(multN),static_cast<Double_t>(vtxESD->GetStatus())};
-  fTPCEventHisto->Fill(vTPCEvent);
+  FillSparse(fTPCEventHisto, vTPCEvent);
 }
 
 
@@ -615,6 +615,7 @@ void AliPerformanceTPC::Analyse()
     // Analyse comparison information and store output histograms
     // in the folder "folderTPC"
     //
+    FlushSparse();
     TH1::AddDirectory(kFALSE);
     TH1::SetDefaultSumw2(kFALSE);
     TObjArray *aFolderObj = new TObjArray;
@@ -794,9 +795,10 @@ Long64_t AliPerformanceTPC::Merge(TCollection* const list)
     AliPerformanceTPC* entry = dynamic_cast<AliPerformanceTPC*>(obj);
     if (entry == 0) continue; 
     if (merge) {
-        if ((fTPCClustHisto) && (entry->fTPCClustHisto)) { fTPCClustHisto->Add(entry->fTPCClustHisto); }
-        if ((fTPCEventHisto) && (entry->fTPCEventHisto)) { fTPCEventHisto->Add(entry->fTPCEventHisto); }
-        if ((fTPCTrackHisto) && (entry->fTPCTrackHisto)) { fTPCTrackHisto->Add(entry->fTPCTrackHisto); }
+        entry->FlushSparse();
+        if ((fTPCClustHisto) && (entry->fTPCClustHisto)) { MergeSparse(fTPCClustHisto, entry->fTPCClustHisto); }
+        if ((fTPCEventHisto) && (entry->fTPCEventHisto)) { MergeSparse(fTPCEventHisto, entry->fTPCEventHisto); }
+        if ((fTPCTrackHisto) && (entry->fTPCTrackHisto)) { MergeSparse(fTPCTrackHisto, entry->fTPCTrackHisto); }
     }
     // the analysisfolder is only merged if present
     if (entry->fFolderObj) { objArrayList->Add(entry->fFolderObj); }
@@ -804,6 +806,7 @@ Long64_t AliPerformanceTPC::Merge(TCollection* const list)
     count++;
   }
   if (fFolderObj) { fFolderObj->Merge(objArrayList); } 
+  FlushSparse();
   // to signal that track histos were not merged: reset
   if (!merge) { fTPCTrackHisto->Reset(); fTPCClustHisto->Reset(); fTPCEventHisto->Reset(); }
   // delete
@@ -323,7 +323,7 @@ void AliPerformanceTask::FinishTaskOutput()
 {
     // called once at the end of each job (on the workernode)
     //
-    // projects THnSparse to TH1,2,3
+    // flushes staged THnSparse fills and projects THnSparse to TH1,2,3
     
     fOutput = dynamic_cast<TList*> (GetOutputData(1));
     if (!fOutput) {
@@ -336,6 +336,7 @@ void AliPerformanceTask::FinishTaskOutput()
       itOut->Reset();
       while(( pObj = dynamic_cast<AliPerformanceObject*>(itOut->Next())) != NULL) {
           pObj->SetRunNumber(fCurrentRunNumber);
+          pObj->FlushSparse();
           pObj->Analyse();
       }
       